@@ -148,6 +148,11 @@ class Options(object):
         "--precompiled-builtins", action="store",
         dest="precompiled_builtins", default=None,
         help="Use the supplied file as precompiled builtins pytd.")
+    o.add_option(
+        "--parse-cache-dir", type="string", action="store",
+        dest="parse_cache_dir", default=None,
+        help=("Store the ASTs of parsed pytd files in this directory, and "
+              "reuse them instead of parsing unchanged files again."))
     o.add_option(
         "--python_exe", type="string", action="store",
         dest="python_exe", default=None,
@@ -0,0 +1,86 @@
+#include "batch_parser.h"
+
+#include <errno.h>
+
+#include <algorithm>
+#include <memory>
+
+#include "lexer.h"
+#include "mapped_file.h"
+#include "parser.h"
+
+namespace pytype {
+
+BatchParser::BatchParser(std::vector<Input>* inputs, int threads,
+                         bool locations)
+    : next_(0), taken_(0), stopping_(false), locations_(locations) {
+  inputs_.swap(*inputs);
+  results_.resize(inputs_.size());
+  done_.resize(inputs_.size());
+  size_t count = std::max(1, threads);
+  count = std::min(count, inputs_.size());
+  window_ = 4 * count;
+  for (size_t i = 0; i < count; i++) {
+    workers_.push_back(std::thread(&BatchParser::Work, this));
+  }
+}
+
+BatchParser::~BatchParser() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  changed_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+void BatchParser::Take(size_t index, Result* result) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  changed_.wait(lock, [this, index] { return done_[index]; });
+  std::swap(*result, results_[index]);
+  results_[index] = Result();
+  taken_++;
+  lock.unlock();
+  changed_.notify_all();
+}
+
+void BatchParser::Work() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    changed_.wait(lock, [this] {
+      return stopping_ || next_ >= inputs_.size() || next_ < taken_ + window_;
+    });
+    if (stopping_ || next_ >= inputs_.size()) {
+      return;
+    }
+    size_t index = next_++;
+    lock.unlock();
+    Result result;
+    Parse(inputs_[index], &result);
+    lock.lock();
+    std::swap(results_[index], result);
+    done_[index] = true;
+    changed_.notify_all();
+  }
+}
+
+void BatchParser::Parse(const Input& input, Result* result) const {
+  result->status = 0;
+  result->error_number = 0;
+  MappedFile file;
+  std::unique_ptr<Lexer> lexer;
+  if (input.is_path) {
+    if (!file.Open(input.text.c_str())) {
+      result->error_number = errno;
+      return;
+    }
+    lexer.reset(new Lexer(file));
+  } else {
+    lexer.reset(new Lexer(input.text.data(), input.text.size()));
+  }
+  result->status = ParseToIr(lexer.get(), locations_, &result->ir);
+}
+
+}  // end namespace pytype
@@ -0,0 +1,79 @@
+#ifndef PYTYPE_PYI_BATCH_PARSER_H_
+#define PYTYPE_PYI_BATCH_PARSER_H_
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace pytype {
+
+// Parses many inputs into IR (see ir.h) on a pool of threads that don't
+// hold the GIL, so that lexing and parsing run in parallel while the caller
+// decodes the results one at a time.  Workers only run a bounded number of
+// inputs ahead of the results taken, which bounds the memory held by
+// results.
+class BatchParser {
+ public:
+  // Source text, or the path of a file to read it from.
+  struct Input {
+    std::string text;
+    bool is_path;
+  };
+
+  // The result for an input: the status returned by the parser (0, or 1 for
+  // a syntax error, which is recorded in the IR) and the IR, or the errno of
+  // failing to read the input's file.
+  struct Result {
+    int status;
+    int error_number;
+    std::string ir;
+  };
+
+  // Start parsing inputs (which are moved out of the vector) on up to
+  // threads worker threads, at least one.  locations is as for ParseToIr().
+  BatchParser(std::vector<Input>* inputs, int threads, bool locations);
+
+  // Stops and joins the workers.  Must not hold the GIL, which a worker may
+  // need when lexer stats are enabled (see Lexer::collect_stats()).
+  ~BatchParser();
+
+  size_t size() const { return inputs_.size(); }
+  const Input& input(size_t index) const { return inputs_[index]; }
+
+  // Wait for the result for an input and move it to *result.  Each result
+  // can only be taken once.  Must not hold the GIL.
+  void Take(size_t index, Result* result);
+
+ private:
+  std::vector<Input> inputs_;
+  std::vector<Result> results_;
+  std::vector<bool> done_;
+  std::vector<std::thread> workers_;
+
+  // Guards the following, and done_ and results_.
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  // The next input to parse, the number of results taken, and how many
+  // inputs beyond those the workers may parse.
+  size_t next_;
+  size_t taken_;
+  size_t window_;
+  bool stopping_;
+
+  bool locations_;
+
+  void Work();
+
+  // Parse an input into a result.
+  void Parse(const Input& input, Result* result) const;
+
+  // Not copyable.
+  BatchParser(const BatchParser&);
+  BatchParser& operator=(const BatchParser&);
+};
+
+}  // end namespace pytype
+
+#endif  // PYTYPE_PYI_BATCH_PARSER_H_
@@ -0,0 +1,86 @@
+"""Benchmark the calls from the low level parser to its peer.
+
+Usage: python -m pytype.pyi.call_benchmark [iterations]
+
+Prints the calls per second for each peer method, calling methods that do
+nothing, thus measuring the cost of the dispatch alone.
+"""
+
+import sys
+
+from pytype.pyi import parser
+from pytype.pyi import parser_ext
+
+
+class _NullPeer(object):
+  """A peer whose methods do nothing, with the signatures of _Parser's."""
+
+  ELLIPSIS = parser._Parser.ELLIPSIS
+  PARSE_ERROR = parser._Parser.PARSE_ERROR
+  NOTHING = parser._Parser.NOTHING
+  ANYTHING = parser._Parser.ANYTHING
+
+  def set_error_location(self, location):
+    pass
+
+  def new_type(self, name, parameters=None):
+    pass
+
+  def new_union_type(self, types):
+    pass
+
+  def add_import(self, from_package, import_list):
+    pass
+
+  def add_alias_or_constant(self, name, value):
+    pass
+
+  def new_constant(self, name, value):
+    pass
+
+  def new_function(self, decorators, name, param_list, return_type, raises,
+                   body):
+    pass
+
+  def new_external_function(self, decorators, name):
+    pass
+
+  def new_named_tuple(self, base_name, fields):
+    pass
+
+  def register_class_name(self, class_name):
+    pass
+
+  def add_class(self, class_name, parent_args, defs):
+    pass
+
+  def add_type_var(self, name, param_list):
+    pass
+
+  def if_begin(self, condition):
+    pass
+
+  def if_elif(self, condition):
+    pass
+
+  def if_else(self):
+    pass
+
+  def if_end(self, clauses):
+    pass
+
+
+def run(iterations):
+  """Return a dict of peer method names to calls per second."""
+  return parser_ext.time_calls(_NullPeer(), iterations)
+
+
+def main(argv):
+  iterations = int(argv[1]) if len(argv) > 1 else 1000000
+  rates = run(iterations)
+  for name in sorted(rates):
+    print "%-24s %12.0f calls/s" % (name, rates[name])
+
+
+if __name__ == "__main__":
+  main(sys.argv)
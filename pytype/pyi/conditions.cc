@@ -0,0 +1,200 @@
+#include "conditions.h"
+
+#include <string.h>
+
+namespace pytype {
+
+namespace {
+
+// The comparison operators of conditions.
+enum CompareOp { kEq, kNe, kLt, kLe, kGt, kGe, kNoOp };
+
+CompareOp GetCompareOp(PyObject* op) {
+  static const char* const names[] = {"==", "!=", "<", "<=", ">", ">="};
+  if (PyString_Check(op)) {
+    for (int i = 0; i < kNoOp; i++) {
+      if (strcmp(PyString_AS_STRING(op), names[i]) == 0) {
+        return static_cast<CompareOp>(i);
+      }
+    }
+  }
+  return kNoOp;
+}
+
+// Return whether the result of comparing two values (negative, zero or
+// positive, like strcmp()) satisfies op.
+bool Compare(CompareOp op, int cmp) {
+  switch (op) {
+    case kEq: return cmp == 0;
+    case kNe: return cmp != 0;
+    case kLt: return cmp < 0;
+    case kLe: return cmp <= 0;
+    case kGt: return cmp > 0;
+    case kGe: return cmp >= 0;
+    default: return false;
+  }
+}
+
+bool StringEquals(PyObject* obj, const char* s) {
+  return PyString_Check(obj) && strcmp(PyString_AS_STRING(obj), s) == 0;
+}
+
+}  // end namespace
+
+bool Conditions::Init(PyObject* info) {
+  if (info == Py_None) {
+    return true;
+  }
+  PyObject* version = NULL;
+  PyObject* platform = NULL;
+  bool valid = PyTuple_Check(info) && PyTuple_GET_SIZE(info) == 2;
+  if (valid) {
+    version = PyTuple_GET_ITEM(info, 0);
+    platform = PyTuple_GET_ITEM(info, 1);
+    valid = PyTuple_Check(version) && PyTuple_GET_SIZE(version) == 3 &&
+        PyString_Check(platform);
+  }
+  for (int i = 0; valid && i < 3; i++) {
+    PyObject* item = PyTuple_GET_ITEM(version, i);
+    valid = PyInt_Check(item);
+    if (valid) {
+      version_[i] = PyInt_AS_LONG(item);
+    }
+  }
+  if (!valid) {
+    PyErr_SetString(PyExc_TypeError,
+                    "native_conditions() must return None or a tuple of a "
+                    "version (three ints) and a platform (a str)");
+    return false;
+  }
+  platform_.assign(PyString_AS_STRING(platform), PyString_GET_SIZE(platform));
+  enabled_ = true;
+  return true;
+}
+
+int Conditions::Evaluate(PyObject* condition) const {
+  if (!PyTuple_Check(condition) || PyTuple_GET_SIZE(condition) != 3) {
+    return -1;
+  }
+  PyObject* name = PyTuple_GET_ITEM(condition, 0);
+  CompareOp op = GetCompareOp(PyTuple_GET_ITEM(condition, 1));
+  PyObject* value = PyTuple_GET_ITEM(condition, 2);
+  if (op == kNoOp) {
+    return -1;
+  }
+
+  if (StringEquals(name, "sys.version_info")) {
+    if (!PyTuple_Check(value)) {
+      return -1;
+    }
+    // Compare with the value normalized to three items, see _three_tuple().
+    Py_ssize_t size = PyTuple_GET_SIZE(value);
+    int cmp = 0;
+    for (int i = 0; i < 3; i++) {
+      long item = 0;
+      if (i < size) {
+        PyObject* obj = PyTuple_GET_ITEM(value, i);
+        if (!PyInt_Check(obj)) {
+          return -1;
+        }
+        item = PyInt_AS_LONG(obj);
+      }
+      if (cmp == 0 && version_[i] != item) {
+        cmp = version_[i] < item ? -1 : 1;
+      }
+    }
+    // The items beyond the third must be ints too.
+    for (Py_ssize_t i = 3; i < size; i++) {
+      if (!PyInt_Check(PyTuple_GET_ITEM(value, i))) {
+        return -1;
+      }
+    }
+    return Compare(op, cmp);
+  }
+
+  if (StringEquals(name, "sys.platform")) {
+    if (!PyString_Check(value) || (op != kEq && op != kNe)) {
+      return -1;
+    }
+    bool equal = platform_.size() ==
+        static_cast<size_t>(PyString_GET_SIZE(value)) &&
+        memcmp(platform_.data(), PyString_AS_STRING(value),
+               platform_.size()) == 0;
+    return Compare(op, equal ? 0 : 1);
+  }
+
+  return -1;
+}
+
+void Conditions::Reset() {
+  enabled_ = false;
+  scopes_.clear();
+}
+
+PyObject* Conditions::Apply(bool value) {
+  Scope& scope = scopes_.back();
+  if (scope.can_trigger && value) {
+    scope.active = true;
+    scope.can_trigger = false;
+  } else {
+    scope.active = false;
+  }
+  return PyBool_FromLong(scope.active);
+}
+
+bool Conditions::Begin(PyObject* condition, PyObject** result) {
+  int value = Evaluate(condition);
+  if (value < 0) {
+    return false;
+  }
+  Scope scope;
+  scope.active = false;
+  scope.can_trigger = scopes_.empty() || scopes_.back().active;
+  scopes_.push_back(scope);
+  *result = Apply(value);
+  return true;
+}
+
+bool Conditions::Elif(PyObject* condition, PyObject** result) {
+  int value = Evaluate(condition);
+  if (value < 0 || scopes_.empty()) {
+    return false;
+  }
+  *result = Apply(value);
+  return true;
+}
+
+PyObject* Conditions::Else() {
+  if (scopes_.empty()) {
+    PyErr_SetString(PyExc_SystemError, "else outside of an if statement.");
+    return NULL;
+  }
+  return Apply(true);
+}
+
+PyObject* Conditions::End(PyObject* clauses) {
+  if (scopes_.empty() || !PyTuple_Check(clauses)) {
+    PyErr_SetString(PyExc_SystemError, "Invalid end of an if statement.");
+    return NULL;
+  }
+  scopes_.pop_back();
+  for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(clauses); i++) {
+    PyObject* clause = PyTuple_GET_ITEM(clauses, i);
+    if (!PyTuple_Check(clause) || PyTuple_GET_SIZE(clause) != 2) {
+      PyErr_SetString(PyExc_SystemError, "Invalid clause of an if statement.");
+      return NULL;
+    }
+    int active = PyObject_IsTrue(PyTuple_GET_ITEM(clause, 0));
+    if (active < 0) {
+      return NULL;
+    }
+    if (active) {
+      PyObject* defs = PyTuple_GET_ITEM(clause, 1);
+      Py_INCREF(defs);
+      return defs;
+    }
+  }
+  return PyTuple_New(0);
+}
+
+}  // end namespace pytype
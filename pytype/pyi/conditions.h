@@ -0,0 +1,73 @@
+#ifndef PYTYPE_PYI_CONDITIONS_H_
+#define PYTYPE_PYI_CONDITIONS_H_
+
+#include <Python.h>
+
+#include <string>
+#include <vector>
+
+namespace pytype {
+
+// Evaluates the conditions of "if" statements directly in C++, and tracks
+// the nesting of the statements like the peer's _ConditionScope does, so
+// that the peer's if_begin(), if_elif(), if_else() and if_end() needn't be
+// called.  The methods correspond to those peer methods, and return a new
+// reference to the same result, or NULL if there was an error.
+//
+// Only the conditions that the peer accepts are evaluated: comparisons of
+// sys.version_info with a tuple of ints and of sys.platform with a string.
+// Begin() and Elif() return false to decline any other condition, in which
+// case the caller must have the peer report the error.
+class Conditions {
+ public:
+  Conditions() : enabled_(false) {}
+
+  // Initialize from the (version, platform) tuple returned by the peer's
+  // native_conditions() method, where version is a tuple of three ints and
+  // platform a string.  None leaves the conditions disabled.  Returns false
+  // if there was an error.
+  bool Init(PyObject* info);
+
+  // Disable the conditions and forget the enclosing if statements, so that
+  // they can be initialized again.
+  void Reset();
+
+  // Whether Init() enabled the conditions.
+  bool enabled() const { return enabled_; }
+  void Disable() { enabled_ = false; }
+
+  bool Begin(PyObject* condition, PyObject** result);
+  bool Elif(PyObject* condition, PyObject** result);
+  PyObject* Else();
+  PyObject* End(PyObject* clauses);
+
+ private:
+  // An if statement, see _ConditionScope.
+  struct Scope {
+    bool active;
+    bool can_trigger;
+  };
+
+  bool enabled_;
+  long version_[3];
+  std::string platform_;
+  // The enclosing if statements, innermost last.  The top level is always
+  // active.
+  std::vector<Scope> scopes_;
+
+  // Return 1 if a (name, op, value) condition is true, 0 if it is false, and
+  // -1 if it isn't supported.
+  int Evaluate(PyObject* condition) const;
+
+  // Apply the value of a condition to the innermost scope, and return a new
+  // reference to whether the scope is now active.
+  PyObject* Apply(bool value);
+
+  // Not copyable.
+  Conditions(const Conditions&);
+  Conditions& operator=(const Conditions&);
+};
+
+}  // end namespace pytype
+
+#endif  // PYTYPE_PYI_CONDITIONS_H_
@@ -0,0 +1,259 @@
+#include "fastscan.h"
+
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define PYTYPE_FASTSCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace pytype {
+
+namespace {
+
+// Scalar implementations.  These also handle the tails of the vectorized
+// implementations.
+
+const char* FindTripleScalar(const char* begin, const char* end, char c) {
+  const char* p = begin;
+  while (end - p >= 3) {
+    // Only positions that leave room for three characters can match.
+    p = static_cast<const char*>(memchr(p, c, end - p - 2));
+    if (p == NULL) {
+      return NULL;
+    }
+    if (p[1] == c && p[2] == c) {
+      return p;
+    }
+    ++p;
+  }
+  return NULL;
+}
+
+const char* FindNewlineScalar(const char* begin, const char* end) {
+  const char* p = static_cast<const char*>(memchr(begin, '\n', end - begin));
+  return p ? p : end;
+}
+
+int CountNewlinesScalar(const char* begin, const char* end,
+                        const char** last) {
+  int count = 0;
+  for (const char* p = begin; p < end; ++p) {
+    if (*p == '\n') {
+      count++;
+      *last = p;
+    }
+  }
+  return count;
+}
+
+bool ScalarSupported() {
+  return true;
+}
+
+#ifdef PYTYPE_FASTSCAN_X86
+
+// The SSE2 and AVX2 implementations are identical except for the vector
+// width.  They compare 16 or 32 characters at a time and use the resulting
+// bit masks to locate (or count) matches.
+
+__attribute__((target("sse2")))
+const char* FindTripleSse2(const char* begin, const char* end, char c) {
+  const __m128i needle = _mm_set1_epi8(c);
+  const char* p = begin;
+  // Each iteration reads 2 characters past the 16 it checks.
+  while (end - p >= 16 + 2) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 1));
+    __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 2));
+    __m128i match = _mm_and_si128(
+        _mm_and_si128(_mm_cmpeq_epi8(a, needle), _mm_cmpeq_epi8(b, needle)),
+        _mm_cmpeq_epi8(d, needle));
+    unsigned mask = _mm_movemask_epi8(match);
+    if (mask) {
+      return p + __builtin_ctz(mask);
+    }
+    p += 16;
+  }
+  return FindTripleScalar(p, end, c);
+}
+
+__attribute__((target("sse2")))
+const char* FindNewlineSse2(const char* begin, const char* end) {
+  const __m128i newline = _mm_set1_epi8('\n');
+  const char* p = begin;
+  while (end - p >= 16) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(a, newline));
+    if (mask) {
+      return p + __builtin_ctz(mask);
+    }
+    p += 16;
+  }
+  return FindNewlineScalar(p, end);
+}
+
+__attribute__((target("sse2")))
+int CountNewlinesSse2(const char* begin, const char* end, const char** last) {
+  const __m128i newline = _mm_set1_epi8('\n');
+  const char* p = begin;
+  int count = 0;
+  while (end - p >= 16) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(a, newline));
+    if (mask) {
+      count += __builtin_popcount(mask);
+      *last = p + 31 - __builtin_clz(mask);
+    }
+    p += 16;
+  }
+  return count + CountNewlinesScalar(p, end, last);
+}
+
+bool Sse2Supported() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("sse2");
+}
+
+__attribute__((target("avx2")))
+const char* FindTripleAvx2(const char* begin, const char* end, char c) {
+  const __m256i needle = _mm256_set1_epi8(c);
+  const char* p = begin;
+  // Each iteration reads 2 characters past the 32 it checks.
+  while (end - p >= 32 + 2) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 1));
+    __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 2));
+    __m256i match = _mm256_and_si256(
+        _mm256_and_si256(_mm256_cmpeq_epi8(a, needle),
+                         _mm256_cmpeq_epi8(b, needle)),
+        _mm256_cmpeq_epi8(d, needle));
+    unsigned mask = _mm256_movemask_epi8(match);
+    if (mask) {
+      return p + __builtin_ctz(mask);
+    }
+    p += 32;
+  }
+  return FindTripleScalar(p, end, c);
+}
+
+__attribute__((target("avx2")))
+const char* FindNewlineAvx2(const char* begin, const char* end) {
+  const __m256i newline = _mm256_set1_epi8('\n');
+  const char* p = begin;
+  while (end - p >= 32) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    unsigned mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, newline));
+    if (mask) {
+      return p + __builtin_ctz(mask);
+    }
+    p += 32;
+  }
+  return FindNewlineScalar(p, end);
+}
+
+__attribute__((target("avx2,popcnt")))
+int CountNewlinesAvx2(const char* begin, const char* end, const char** last) {
+  const __m256i newline = _mm256_set1_epi8('\n');
+  const char* p = begin;
+  int count = 0;
+  while (end - p >= 32) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    unsigned mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, newline));
+    if (mask) {
+      count += __builtin_popcount(mask);
+      *last = p + 31 - __builtin_clz(mask);
+    }
+    p += 32;
+  }
+  return count + CountNewlinesScalar(p, end, last);
+}
+
+bool Avx2Supported() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+}
+
+#endif  // PYTYPE_FASTSCAN_X86
+
+struct Implementation {
+  const char* name;
+  bool (*supported)();
+  const char* (*find_triple)(const char* begin, const char* end, char c);
+  const char* (*find_newline)(const char* begin, const char* end);
+  int (*count_newlines)(const char* begin, const char* end,
+                        const char** last);
+};
+
+// In order of preference.
+const Implementation kImplementations[] = {
+#ifdef PYTYPE_FASTSCAN_X86
+  {"avx2", Avx2Supported, FindTripleAvx2, FindNewlineAvx2, CountNewlinesAvx2},
+  {"sse2", Sse2Supported, FindTripleSse2, FindNewlineSse2, CountNewlinesSse2},
+#endif
+  {"scalar", ScalarSupported, FindTripleScalar, FindNewlineScalar,
+   CountNewlinesScalar},
+};
+
+const Implementation* ChooseImplementation() {
+  for (const Implementation& impl : kImplementations) {
+    if (impl.supported()) {
+      return &impl;
+    }
+  }
+  return NULL;  // Not reached, the scalar implementation is always supported.
+}
+
+const Implementation* implementation = ChooseImplementation();
+
+}  // end namespace
+
+const char* FindTriple(const char* begin, const char* end, char c) {
+  return implementation->find_triple(begin, end, c);
+}
+
+const char* FindNewline(const char* begin, const char* end) {
+  return implementation->find_newline(begin, end);
+}
+
+int CountNewlines(const char* begin, const char* end, const char** last) {
+  return implementation->count_newlines(begin, end, last);
+}
+
+const char* SkipBlankLines(const char* begin, const char* end, int* lines,
+                           const char** last_line) {
+  // Blank lines are short, so there is nothing to gain from vectorizing.
+  *lines = 0;
+  const char* p = begin;
+  while (true) {
+    const char* q = p;
+    while (q < end && *q == ' ') {
+      q++;
+    }
+    if (q == end || *q != '\n') {
+      return p;
+    }
+    ++*lines;
+    *last_line = p;
+    p = q + 1;
+  }
+}
+
+const char* FastScanName() {
+  return implementation->name;
+}
+
+bool SelectFastScan(const char* name) {
+  for (const Implementation& impl : kImplementations) {
+    if (strcmp(impl.name, name) == 0) {
+      if (!impl.supported()) {
+        return false;
+      }
+      implementation = &impl;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // end namespace pytype
@@ -0,0 +1,55 @@
+#ifndef PYTYPE_PYI_FASTSCAN_H_
+#define PYTYPE_PYI_FASTSCAN_H_
+
+namespace pytype {
+
+// Vectorized helpers that let the lexers skip over text that doesn't produce
+// tokens (docstrings, comments and blank lines) without matching it rule by
+// rule.  An implementation is chosen at runtime based on the CPU: AVX2 or
+// SSE2 where available, otherwise a scalar fallback.  All implementations
+// return identical results.
+
+// Return a pointer to the first occurrence of three consecutive c characters
+// in [begin, end), or NULL if there is none.
+const char* FindTriple(const char* begin, const char* end, char c);
+
+// Return a pointer to the first newline in [begin, end), or end if there is
+// none.
+const char* FindNewline(const char* begin, const char* end);
+
+// Return the number of newlines in [begin, end).  If there are any, *last is
+// set to point to the last one.
+int CountNewlines(const char* begin, const char* end, const char** last);
+
+// Advance line and column over [begin, end) the way the lexer rules do: each
+// newline moves to column 1 of the next line, other characters advance the
+// column.
+inline void AdvanceLineAndColumn(const char* begin, const char* end,
+                                 int* line, int* column) {
+  const char* last;
+  int newlines = CountNewlines(begin, end, &last);
+  if (newlines) {
+    *line += newlines;
+    *column = end - last;
+  } else {
+    *column += end - begin;
+  }
+}
+
+// Return a pointer past the blank lines (spaces followed by a newline) at the
+// start of [begin, end).  Sets *lines to the number of lines skipped and, if
+// there were any, *last_line to the start of the last one.
+const char* SkipBlankLines(const char* begin, const char* end, int* lines,
+                           const char** last_line);
+
+// The name of the implementation in use: "avx2", "sse2" or "scalar".
+const char* FastScanName();
+
+// Select an implementation by name.  Returns false if the name is unknown or
+// the CPU doesn't support it.  This is meant for tests and benchmarks, and
+// must not be called while a lexer is running.
+bool SelectFastScan(const char* name);
+
+}  // end namespace pytype
+
+#endif  // PYTYPE_PYI_FASTSCAN_H_
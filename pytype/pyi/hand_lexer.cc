@@ -0,0 +1,538 @@
+// A handwritten implementation of the scanner in lexer.lex.
+//
+// The generated scanner matches every rule through the same table driven DFA,
+// including reserved words, which flex compiles into the NAME automaton.  This
+// scanner dispatches on the first character of a token instead and classifies
+// scanned identifiers with a perfect hash of the reserved words.
+//
+// The scanner must produce exactly the same tokens as lexer.lex, including
+// locations and quirks, which is verified by tokenize_typeshed_test.py.  The
+// comments refer to the corresponding flex rules.  Some behaviour that follows
+// from the flex rules:
+//   - Flex picks the longest match, preferring the earlier rule on ties.  For
+//     example "class" is CLASS but "classes" and "class-x" are NAMEs.
+//   - Rules whose pattern can match a newline set the column to 0 before
+//     YY_USER_ACTION runs, see AdvanceLine().
+//   - <PENDING> uses yyless(0) without adjusting the column, so the column
+//     after a dedent is off by one for each DEDENT, plus one.
+//   - At the end of input, the location of the last matched rule (even one
+//     that didn't return a token) is left in place.
+
+#include <string.h>
+
+#include "fastscan.h"
+#include "lexer.h"
+
+namespace pytype {
+
+namespace {
+
+// Character classes.  Like the flex character classes (which are expanded
+// when flex generates the scanner), these are ASCII only.
+
+inline bool IsDigit(unsigned char c) {
+  return c >= '0' && c <= '9';
+}
+
+inline bool IsAlpha(unsigned char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+// [_[:alpha:]]
+inline bool IsNameStart(unsigned char c) {
+  return IsAlpha(c) || c == '_';
+}
+
+// [-_[:alnum:]]
+inline bool IsNameChar(unsigned char c) {
+  return IsNameStart(c) || IsDigit(c) || c == '-';
+}
+
+// [_~[:alpha:]] and [-_~[:alnum:]], within backticks.
+inline bool IsQuotedNameStart(unsigned char c) {
+  return IsNameStart(c) || c == '~';
+}
+
+inline bool IsQuotedNameChar(unsigned char c) {
+  return IsNameChar(c) || c == '~';
+}
+
+// Reserved words are looked up in a table indexed by a perfect hash of the
+// first and last characters.  The table is checked at compile time, thus a
+// new reserved word that collides with an existing one fails to compile and
+// requires choosing new hash parameters.
+
+struct Keyword {
+  const char* text;
+  int length;
+  int token;
+};
+
+constexpr int kKeywordTableSize = 32;
+
+constexpr int KeywordHash(const char* text, int length) {
+  return (static_cast<unsigned char>(text[0]) +
+          6 * static_cast<unsigned char>(text[length - 1])) %
+      kKeywordTableSize;
+}
+
+// The reserved words, listed at their hash values.
+constexpr Keyword kKeywords[kKeywordTableSize] = {
+  {"TypeVar", 7, TYPEVAR},         // 0
+  {"import", 6, IMPORT},           // 1
+  {"pass", 4, PASS},               // 2
+  {"else", 4, ELSE},               // 3
+  {"raises", 6, RAISES},           // 4
+  {NULL, 0, 0},                    // 5
+  {NULL, 0, 0},                    // 6
+  {NULL, 0, 0},                    // 7
+  {"def", 3, DEF},                 // 8
+  {"elif", 4, ELIF},               // 9
+  {NULL, 0, 0},                    // 10
+  {NULL, 0, 0},                    // 11
+  {"NamedTuple", 10, NAMEDTUPLE},  // 12
+  {"if", 2, IF},                   // 13
+  {"PYTHONCODE", 10, PYTHONCODE},  // 14
+  {NULL, 0, 0},                    // 15
+  {"raise", 5, RAISE},             // 16
+  {NULL, 0, 0},                    // 17
+  {NULL, 0, 0},                    // 18
+  {"as", 2, AS},                   // 19
+  {"from", 4, FROM},               // 20
+  {"class", 5, CLASS},             // 21
+  {NULL, 0, 0},                    // 22
+  {NULL, 0, 0},                    // 23
+  {"nothing", 7, NOTHING},         // 24
+  {NULL, 0, 0},                    // 25
+  {NULL, 0, 0},                    // 26
+  {"or", 2, OR},                   // 27
+  {NULL, 0, 0},                    // 28
+  {NULL, 0, 0},                    // 29
+  {NULL, 0, 0},                    // 30
+  {NULL, 0, 0},                    // 31
+};
+
+// The number of reserved words in lexer.lex.
+constexpr int kKeywordCount = 16;
+
+// The shortest and longest reserved words.
+constexpr int kMinKeywordLength = 2;
+constexpr int kMaxKeywordLength = 10;
+
+constexpr bool KeywordsArePerfectlyHashed(int i) {
+  return i == kKeywordTableSize ||
+      ((kKeywords[i].text == NULL ||
+        (KeywordHash(kKeywords[i].text, kKeywords[i].length) == i &&
+         kKeywords[i].length >= kMinKeywordLength &&
+         kKeywords[i].length <= kMaxKeywordLength)) &&
+       KeywordsArePerfectlyHashed(i + 1));
+}
+
+constexpr int CountKeywords(int i) {
+  return i == kKeywordTableSize ?
+      0 : (kKeywords[i].text != NULL) + CountKeywords(i + 1);
+}
+
+static_assert(KeywordsArePerfectlyHashed(0),
+              "A reserved word is not at its hash value.");
+static_assert(CountKeywords(0) == kKeywordCount,
+              "Reserved words are missing from the keyword table.");
+
+// Return the token code of a reserved word, or NAME.
+inline int ClassifyName(const char* text, int length) {
+  if (length < kMinKeywordLength || length > kMaxKeywordLength) {
+    return NAME;
+  }
+  const Keyword& keyword = kKeywords[KeywordHash(text, length)];
+  if (keyword.length == length && memcmp(keyword.text, text, length) == 0) {
+    return keyword.token;
+  }
+  return NAME;
+}
+
+}  // end namespace
+
+void Lexer::Advance(int length) {
+  location_.first_line = line_;
+  location_.first_column = column_;
+  location_.last_line = line_;
+  location_.last_column = column_ + length - 1;
+  column_ += length;
+  pos_ += length;
+}
+
+void Lexer::AdvanceLine(int length) {
+  line_++;
+  column_ = 0;
+  Advance(length);
+}
+
+void Lexer::ScanTokenByHand(Token* token) {
+  const char* text = base_;
+  const int length = length_;
+  int kind;
+  int start;
+
+  value_kind_ = kNoValue;
+  // Like the generated scanner, count the bytes of each match for the state
+  // in which it started.  A match put back with yyless(0) counts nothing.
+  int match_start = pos_;
+  match_state_ = hand_state_;
+  while (true) {
+    if (stats_) {
+      stats_->state_bytes[match_state_] += pos_ - match_start;
+      match_start = pos_;
+      match_state_ = hand_state_;
+    }
+    start = pos_;
+    if (start >= length) {
+      // <<EOF>>
+      kind = ScanEndOfInput();
+      token->kind = kind;
+      token->value_kind = kNoValue;
+      token->start = token->end = length;
+      token->location = location_;
+      return;
+    }
+    unsigned char c = text[start];
+
+    switch (hand_state_) {
+      case kNewlineState: {
+        int end = start;
+        while (end < length && text[end] == ' ') {
+          end++;
+        }
+        int spaces = end - start;
+        if (end < length && text[end] == '\n') {
+          // <NEWLINE>[ ]*\n, skipping any further empty lines.
+          AdvanceLine(spaces + 1);
+          column_ = 1;
+          int lines;
+          const char* last_line;
+          const char* next = SkipBlankLines(text + pos_, text + length, &lines,
+                                            &last_line);
+          if (lines) {
+            line_ += lines;
+            location_.first_line = line_;
+            location_.first_column = 0;
+            location_.last_line = line_;
+            location_.last_column = next - last_line - 1;
+            pos_ = next - text;
+          }
+        } else if (spaces && end < length && text[end] == '#') {
+          // <NEWLINE>[ ]+/#
+          Advance(spaces);
+          hand_state_ = kInitialState;
+        } else if (spaces) {
+          // <NEWLINE>[ ]+
+          Advance(spaces);
+          if (bracket_count_) {
+            hand_state_ = kInitialState;
+          } else if (spaces < CurrentIndentation()) {
+            if (!PopIndentationTo(spaces)) {
+              value_kind_ = kBadIndentValue;
+              kind = LEXERROR;
+              goto done;
+            }
+            hand_state_ = kPendingState;
+          } else if (spaces == CurrentIndentation()) {
+            hand_state_ = kInitialState;
+          } else {
+            PushIndentation(spaces);
+            hand_state_ = kInitialState;
+            kind = INDENT;
+            goto done;
+          }
+        } else {
+          // <NEWLINE>. with yyless(0) and yycolumn--.
+          Advance(1);
+          pos_ = start;
+          column_--;
+          if (CurrentIndentation()) {
+            PopIndentationTo(0);
+            hand_state_ = kPendingState;
+          } else {
+            hand_state_ = kInitialState;
+          }
+        }
+        continue;
+      }
+
+      case kPendingState:
+        if (c == '\n') {
+          break;  // An illegal character.
+        }
+        // <PENDING>. with yyless(0).
+        Advance(1);
+        pos_ = start;
+        if (PopDedent()) {
+          kind = DEDENT;
+          goto done;
+        }
+        hand_state_ = kInitialState;
+        continue;
+
+      case kTriple1State:
+      case kTriple2State: {
+        char quote = hand_state_ == kTriple1State ? '\'' : '"';
+        if (c == '\n') {
+          // <TRIPLE1>\n
+          AdvanceLine(1);
+          column_ = 1;
+        } else if (c == quote) {
+          int quotes = 1;
+          while (quotes < 3 && start + quotes < length &&
+                 text[start + quotes] == quote) {
+            quotes++;
+          }
+          // <TRIPLE1>\'\'\' or <TRIPLE1>\'\'?
+          Advance(quotes);
+          if (quotes == 3) {
+            hand_state_ = kInitialState;
+            location_.first_line = start_line_;
+            location_.first_column = start_column_;
+            kind = TRIPLEQUOTED;
+            start = start_offset_;
+            goto done;
+          }
+        } else {
+          // <TRIPLE1>[^'\n]*
+          int end = start + 1;
+          while (end < length && text[end] != quote && text[end] != '\n') {
+            end++;
+          }
+          Advance(end - start);
+        }
+        continue;
+      }
+
+      case kCommentState:
+        if (c == '\n') {
+          // <COMMENT>\n
+          AdvanceLine(1);
+          column_ = 1;
+          hand_state_ = kNewlineState;
+        } else {
+          // <COMMENT>[^\n]+
+          Advance(FindNewline(text + start, text + length) - text - start);
+          hand_state_ = kInitialState;
+        }
+        continue;
+
+      case kInitialState:
+        break;
+    }
+
+    if (hand_state_ == kInitialState) {
+      switch (c) {
+        case '\n':
+          AdvanceLine(1);
+          hand_state_ = kNewlineState;
+          column_ = 1;
+          continue;
+
+        case ' ': {
+          int end = start + 1;
+          while (end < length && text[end] == ' ') {
+            end++;
+          }
+          Advance(end - start);
+          continue;
+        }
+
+        case '@': case '*': case ',': case '?':
+          Advance(1);
+          kind = c;
+          goto done;
+
+        case ':':
+          if (start + 1 < length && text[start + 1] == '=') {
+            Advance(2);
+            kind = COLONEQUALS;
+          } else {
+            Advance(1);
+            kind = c;
+          }
+          goto done;
+
+        case '=': case '<': case '>': case '!':
+          if (start + 1 < length && text[start + 1] == '=') {
+            Advance(2);
+            kind = c == '=' ? EQ : c == '<' ? LE : c == '>' ? GE : NE;
+            goto done;
+          } else if (c != '!') {
+            Advance(1);
+            kind = c;
+            goto done;
+          }
+          break;  // An illegal character.
+
+        case '[': case '(':
+          Advance(1);
+          ++bracket_count_;
+          kind = c;
+          goto done;
+
+        case ']': case ')':
+          Advance(1);
+          CloseBracket();
+          kind = c;
+          goto done;
+
+        case '\'': case '"':
+          if (start + 2 < length && text[start + 1] == c &&
+              text[start + 2] == c) {
+            // Start of TRIPLEQUOTED.
+            Advance(3);
+            hand_state_ = c == '\'' ? kTriple1State : kTriple2State;
+            start_line_ = line_;
+            start_column_ = column_ - 3;
+            start_offset_ = start;
+            // Skip to the closing quotes, see SKIP_TRIPLEQUOTED.
+            const char* close = FindTriple(text + pos_, text + length, c);
+            if (close) {
+              CountSkip(hand_state_, close + 3 - (text + pos_));
+              AdvanceLineAndColumn(text + pos_, close, &line_, &column_);
+              pos_ = close - text;
+              Advance(3);
+              hand_state_ = kInitialState;
+              location_.first_line = start_line_;
+              location_.first_column = start_column_;
+              kind = TRIPLEQUOTED;
+              start = start_offset_;
+              goto done;
+            }
+          } else {
+            // Ignore quotes.
+            Advance(1);
+          }
+          continue;
+
+        case '#': {
+          int end = start + 1;
+          while (end < length && text[end] == ' ') {
+            end++;
+          }
+          if (end + 5 <= length && memcmp(text + end, "type:", 5) == 0) {
+            Advance(end + 5 - start);
+            kind = TYPECOMMENT;
+            goto done;
+          }
+          // \# skips the text of the comment, as in lexer.lex.
+          Advance(1);
+          end = FindNewline(text + pos_, text + length) - text;
+          if (end > pos_) {
+            CountSkip(kCommentState, end - pos_);
+            Advance(end - pos_);
+          }
+          hand_state_ = kCommentState;
+          continue;
+        }
+
+        case '`': {
+          int end = start + 1;
+          if (end < length && IsQuotedNameStart(text[end])) {
+            end++;
+            while (end < length && IsQuotedNameChar(text[end])) {
+              end++;
+            }
+            if (end < length && text[end] == '`') {
+              Advance(end + 1 - start);
+              value_kind_ = kQuotedNameValue;
+              kind = NAME;
+              goto done;
+            }
+          }
+          break;  // An illegal character.
+        }
+
+        case '-':
+          if (start + 1 < length && text[start + 1] == '>') {
+            Advance(2);
+            kind = ARROW;
+            goto done;
+          }
+          // Fall through to numbers.
+        case '+': case '.':
+        case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9': {
+          if (c == '.' && start + 2 < length && text[start + 1] == '.' &&
+              text[start + 2] == '.') {
+            Advance(3);
+            kind = ELLIPSIS;
+            goto done;
+          }
+          // [-+]?[0-9]+ or [-+]?[0-9]*\.[0-9]+ or [-+]?[0-9]+\.[0-9]*
+          int digits = start + (c == '-' || c == '+');
+          int end = digits;
+          while (end < length && IsDigit(text[end])) {
+            end++;
+          }
+          bool integer = end > digits;
+          if (end < length && text[end] == '.') {
+            int fraction = end + 1;
+            int fraction_end = fraction;
+            while (fraction_end < length && IsDigit(text[fraction_end])) {
+              fraction_end++;
+            }
+            if (integer || fraction_end > fraction) {
+              Advance(fraction_end - start);
+              value_kind_ = kFloatValue;
+              kind = NUMBER;
+              goto done;
+            }
+          }
+          if (integer) {
+            Advance(end - start);
+            value_kind_ = kIntValue;
+            kind = NUMBER;
+            goto done;
+          }
+          if (c == '.') {
+            Advance(1);
+            kind = c;
+            goto done;
+          }
+          break;  // An illegal character.
+        }
+
+        default:
+          if (IsNameStart(c)) {
+            int end = start + 1;
+            while (end < length && IsNameChar(text[end])) {
+              end++;
+            }
+            Advance(end - start);
+            kind = ClassifyName(text + start, end - start);
+            if (kind == NAME) {
+              value_kind_ = kNameValue;
+            }
+            goto done;
+          }
+          break;  // An illegal character.
+      }
+    }
+
+    // <*>.|\n
+    if (c == '\n') {
+      AdvanceLine(1);
+    } else {
+      Advance(1);
+    }
+    value_kind_ = kIllegalCharValue;
+    kind = LEXERROR;
+    goto done;
+  }
+
+done:
+  if (stats_) {
+    stats_->state_bytes[match_state_] += pos_ - match_start;
+  }
+  token->kind = kind;
+  token->value_kind = value_kind_;
+  token->start = start;
+  token->end = pos_;
+  token->location = location_;
+}
+
+}  // end namespace pytype
@@ -0,0 +1,471 @@
+#include "header_scan.h"
+
+
+#include <errno.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "lexer.h"
+#include "mapped_file.h"
+
+namespace pytype {
+
+namespace {
+
+// Walks the tokens statement by statement, tracking the blocks and "if"
+// statements that enclose each one, and looks at the first few tokens of the
+// statements that are at the top level, skipping the rest.
+class HeaderScanner {
+ public:
+  HeaderScanner(Lexer* lexer, const ScanConditions& conditions,
+                HeaderScan* result)
+      : lexer_(lexer), conditions_(conditions), result_(result),
+        starts_line_(false), bracket_depth_(0), last_line_(0),
+        collect_dotted_(false) {}
+
+  void Run();
+
+ private:
+  // A block (the tokens between an INDENT and its DEDENT): the clause of an
+  // "if" statement, which is at the top level if its statement is, or the
+  // body of a class or function, which isn't.  A block is active if its
+  // statement is, and for a clause, its condition selects it.
+  struct Block {
+    bool clause;
+    bool active;
+  };
+
+  // An "if" statement whose clauses are blocks at depth + 1, like the
+  // peer's _ConditionScope.
+  struct Scope {
+    size_t depth;
+    bool can_trigger;
+  };
+
+  Lexer* lexer_;
+  const ScanConditions& conditions_;
+  HeaderScan* result_;
+  std::unordered_set<std::string> dependencies_;
+  std::unordered_set<std::string> names_;
+
+  // The current token, whether it starts a statement, and the state that
+  // depends on, like Context::StartsLine().
+  Token token_;
+  bool starts_line_;
+  int bracket_depth_;
+  int last_line_;
+
+  std::vector<Block> blocks_;
+  std::vector<Scope> scopes_;
+  // The block that an INDENT after the current statement starts.
+  Block pending_;
+  // Whether the dotted names in the rest of the current statement are
+  // dependencies: the statement isn't in an inactive clause, and isn't a
+  // decorator or condition.
+  bool collect_dotted_;
+
+  // Scratch space for names.
+  std::string name_;
+  std::string part_;
+
+  // Move to the next token.
+  void Advance();
+
+  // Whether the current token is part of the current statement.
+  bool InStatement() const {
+    return token_.kind != 0 && token_.kind != INDENT &&
+        token_.kind != DEDENT && !starts_line_;
+  }
+
+  // Advance past the current token if it is of the given kind and part of
+  // the current statement.
+  bool Accept(int kind) {
+    if (InStatement() && token_.kind == kind) {
+      Advance();
+      return true;
+    }
+    return false;
+  }
+
+  // Read a NAME into *name, or a dotted name, appending it.
+  bool ReadName(std::string* name);
+  bool ReadDottedName(std::string* name);
+
+  // Scan a statement, starting at its first token.
+  void Statement();
+  void Clause(int kind, bool top_level, bool active);
+  void Import();
+  void FromImport();
+
+  // Scan an "if" statement's condition, and return 1 if it is true, 0 if
+  // it is false or -1 if the peer would reject it.
+  int Condition();
+
+  void AddDependency(const std::string& module) {
+    if (dependencies_.insert(module).second) {
+      result_->dependencies.push_back(module);
+    }
+  }
+  void AddName(const std::string& name) {
+    if (names_.insert(name).second) {
+      result_->names.push_back(name);
+    }
+  }
+};
+
+void HeaderScanner::Run() {
+  pending_.clause = false;
+  pending_.active = true;
+  Advance();
+  while (token_.kind != 0) {
+    if (token_.kind == INDENT) {
+      blocks_.push_back(pending_);
+      pending_.clause = false;
+      Advance();
+    } else if (token_.kind == DEDENT) {
+      if (!blocks_.empty()) {
+        blocks_.pop_back();
+      }
+      Advance();
+    } else if (starts_line_) {
+      Statement();
+    } else if (token_.kind == NAME && collect_dotted_) {
+      // The rest of a statement, or of a definition that spans lines, in
+      // which the dotted names are types.
+      ReadDottedName(&part_);
+      size_t dot = part_.rfind('.');
+      if (dot != std::string::npos) {
+        AddDependency(part_.substr(0, dot));
+      }
+    } else {
+      Advance();
+    }
+  }
+}
+
+void HeaderScanner::Advance() {
+  lexer_->Next(&token_);
+  starts_line_ = bracket_depth_ == 0 &&
+      token_.location.first_line > last_line_ && token_.kind != INDENT &&
+      token_.kind != DEDENT && token_.kind != 0;
+  switch (token_.kind) {
+    case '(':
+    case '[':
+      bracket_depth_++;
+      break;
+    case ')':
+    case ']':
+      if (bracket_depth_ > 0) {
+        bracket_depth_--;
+      }
+      break;
+    case INDENT:
+    case DEDENT:
+    case 0:
+      return;
+  }
+  last_line_ = token_.location.last_line;
+}
+
+bool HeaderScanner::ReadName(std::string* name) {
+  const char* text;
+  int length;
+  if (!InStatement() || token_.kind != NAME ||
+      !lexer_->GetValueText(token_, &text, &length)) {
+    return false;
+  }
+  name->append(text, length);
+  Advance();
+  return true;
+}
+
+bool HeaderScanner::ReadDottedName(std::string* name) {
+  name->clear();
+  if (!ReadName(name)) {
+    return false;
+  }
+  while (Accept('.')) {
+    name->push_back('.');
+    if (!ReadName(name)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void HeaderScanner::Statement() {
+  // End the "if" statements that are nested deeper, or at the same depth
+  // unless this continues them.
+  size_t depth = blocks_.size();
+  int kind = token_.kind;
+  while (!scopes_.empty() &&
+         (scopes_.back().depth > depth ||
+          (scopes_.back().depth == depth && kind != ELIF && kind != ELSE))) {
+    scopes_.pop_back();
+  }
+
+  bool top_level = true;
+  bool active = true;
+  for (const Block& block : blocks_) {
+    top_level = top_level && block.clause;
+    active = active && block.active;
+  }
+  pending_.clause = false;
+  pending_.active = active;
+  collect_dotted_ = active;
+  if (kind == IF || kind == ELIF || kind == ELSE) {
+    collect_dotted_ = false;
+    Advance();
+    Clause(kind, top_level, active);
+    return;
+  }
+
+  // Only top level statements define names.
+  active = active && top_level;
+  switch (kind) {
+    case IMPORT:
+      Advance();
+      if (active) {
+        Import();
+      }
+      return;
+    case FROM:
+      Advance();
+      if (active) {
+        FromImport();
+      }
+      return;
+    case CLASS:
+    case DEF:
+      Advance();
+      name_.clear();
+      if (active && ReadName(&name_)) {
+        AddName(name_);
+      }
+      return;
+    case NAME: {
+      // A constant, alias or type variable.  The name starts the statement,
+      // thus ReadName() doesn't accept it.
+      const char* text;
+      int length;
+      bool named = lexer_->GetValueText(token_, &text, &length);
+      if (named) {
+        name_.assign(text, length);
+      }
+      Advance();
+      if (named && active && (Accept('=') || Accept(':'))) {
+        AddName(name_);
+      }
+      return;
+    }
+    case '@':
+      collect_dotted_ = false;
+      Advance();
+      return;
+    default:
+      // Docstrings and anything unexpected.
+      Advance();
+      return;
+  }
+}
+
+void HeaderScanner::Clause(int kind, bool top_level, bool active) {
+  int value = kind == ELSE ? 1 : Condition();
+  if (!top_level) {
+    // An "if" statement in a class, which is scanned as if all of its
+    // clauses were active.
+    return;
+  }
+  if (kind == IF || scopes_.empty() ||
+      scopes_.back().depth != blocks_.size()) {
+    // A stray ELIF or ELSE is scanned like an IF.
+    Scope scope;
+    scope.depth = blocks_.size();
+    scope.can_trigger = active;
+    scopes_.push_back(scope);
+  }
+  Scope& scope = scopes_.back();
+  pending_.clause = true;
+  if (value > 0) {
+    pending_.active = scope.can_trigger;
+    scope.can_trigger = false;
+  } else if (value == 0) {
+    pending_.active = false;
+  } else {
+    // Assume the clause is active, without ruling out the later ones.
+    pending_.active = scope.can_trigger;
+  }
+}
+
+int HeaderScanner::Condition() {
+  std::string name;
+  if (!ReadDottedName(&name)) {
+    return -1;
+  }
+  int op = InStatement() ? token_.kind : 0;
+  switch (op) {
+    case '<':
+    case '>':
+    case LE:
+    case GE:
+    case EQ:
+    case NE:
+      Advance();
+      break;
+    default:
+      return -1;
+  }
+
+  // The sign of the comparison of the actual value with the condition's.
+  int compare;
+  if (name == "sys.platform") {
+    std::string platform;
+    if ((op != EQ && op != NE) || !ReadName(&platform)) {
+      return -1;
+    }
+    compare = platform == conditions_.platform ? 0 : 1;
+  } else if (name == "sys.version_info") {
+    if (!Accept('(')) {
+      return -1;
+    }
+    // Like _three_tuple(), missing items are zeros.
+    long version[3] = {0, 0, 0};
+    int count = 0;
+    do {
+      const char* text;
+      int length;
+      if (!InStatement() || token_.kind != NUMBER ||
+          token_.value_kind != kIntValue || count == 3 ||
+          !lexer_->GetValueText(token_, &text, &length)) {
+        break;
+      }
+      part_.assign(text, length);
+      version[count++] = strtol(part_.c_str(), NULL, 10);
+      Advance();
+    } while (Accept(','));
+    if (count == 0 || !Accept(')')) {
+      return -1;
+    }
+    compare = 0;
+    for (int i = 0; compare == 0 && i < 3; i++) {
+      if (conditions_.version[i] != version[i]) {
+        compare = conditions_.version[i] < version[i] ? -1 : 1;
+      }
+    }
+  } else {
+    return -1;
+  }
+
+  switch (op) {
+    case '<': return compare < 0;
+    case '>': return compare > 0;
+    case LE: return compare <= 0;
+    case GE: return compare >= 0;
+    case EQ: return compare == 0;
+    default: return compare != 0;
+  }
+}
+
+void HeaderScanner::Import() {
+  // import a.b, c as d, ...
+  do {
+    if (!ReadDottedName(&name_)) {
+      return;
+    }
+    AddDependency(name_);
+    if (Accept(AS)) {
+      part_.clear();
+      ReadName(&part_);
+    }
+  } while (Accept(','));
+}
+
+void HeaderScanner::FromImport() {
+  // from a.b import c, d as e, ...
+  std::string module;
+  if (!ReadDottedName(&module)) {
+    return;
+  }
+  AddDependency(module);
+  if (!Accept(IMPORT)) {
+    return;
+  }
+  // Names imported from typing are resolved by the parser rather than
+  // becoming aliases.
+  bool aliases = module != "typing";
+  Accept('(');
+  do {
+    name_.clear();
+    if (Accept(NAMEDTUPLE)) {
+      name_ = "NamedTuple";
+    } else if (Accept(TYPEVAR)) {
+      name_ = "TypeVar";
+    } else if (!Accept('*') && !ReadName(&name_)) {
+      return;
+    }
+    if (Accept(AS)) {
+      name_.clear();
+      ReadName(&name_);
+    }
+    if (aliases && !name_.empty()) {
+      AddName(name_);
+    }
+  } while (Accept(','));
+}
+
+// Scan an input into a result, like BatchParser::Parse().
+void ScanInput(const BatchParser::Input& input,
+               const ScanConditions& conditions, HeaderScan* result) {
+  MappedFile file;
+  std::unique_ptr<Lexer> lexer;
+  if (input.is_path) {
+    if (!file.Open(input.text.c_str())) {
+      result->error_number = errno;
+      return;
+    }
+    lexer.reset(new Lexer(file));
+  } else {
+    lexer.reset(new Lexer(input.text.data(), input.text.size()));
+  }
+  ScanHeader(lexer.get(), conditions, result);
+}
+
+}  // end namespace
+
+void ScanHeader(Lexer* lexer, const ScanConditions& conditions,
+                HeaderScan* result) {
+  HeaderScanner(lexer, conditions, result).Run();
+}
+
+void ScanHeaders(const std::vector<BatchParser::Input>& inputs,
+                 const ScanConditions& conditions, int threads,
+                 std::vector<HeaderScan>* results) {
+  results->assign(inputs.size(), HeaderScan());
+  // The results are small, so unlike BatchParser, the threads just take
+  // the next input until there are none left.
+  std::atomic<size_t> next(0);
+  auto work = [&] {
+    for (size_t i; (i = next++) < inputs.size();) {
+      ScanInput(inputs[i], conditions, &(*results)[i]);
+    }
+  };
+  size_t count = std::min(static_cast<size_t>(std::max(1, threads)),
+                          inputs.size());
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < count; i++) {
+    workers.push_back(std::thread(work));
+  }
+  work();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+}
+
+}  // end namespace pytype
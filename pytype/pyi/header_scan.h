@@ -0,0 +1,61 @@
+#ifndef PYTYPE_PYI_HEADER_SCAN_H_
+#define PYTYPE_PYI_HEADER_SCAN_H_
+
+#include <string>
+#include <vector>
+
+#include "batch_parser.h"
+
+namespace pytype {
+
+class Lexer;
+
+// What a pyi file's dependents need to know before it is parsed: the
+// modules it depends on and the names it defines at the top level.
+struct HeaderScan {
+  // The modules, in order of first appearance, of the import statements
+  // ("import a.b" and "from a.b import c" depend on a.b) and of the dotted
+  // names in definitions (a.b.C is in a.b, like
+  // visitors.CollectDependencies() finds).
+  std::vector<std::string> dependencies;
+  // The names bound at the top level, in order of first appearance: those
+  // of classes, functions, constants, aliases and type variables, and the
+  // names imported by "from" statements (other than from typing, which
+  // don't become aliases).
+  std::vector<std::string> names;
+  // The errno of failing to read the input's file, else 0, see
+  // ScanHeaders().
+  int error_number;
+
+  HeaderScan() : error_number(0) {}
+};
+
+// The version and platform that the conditions of "if" statements are
+// evaluated for, like the peer's native_conditions().
+struct ScanConditions {
+  long version[3];
+  std::string platform;
+};
+
+// Scan the lexer's tokens for the dependencies and top level names,
+// recognizing only import statements, the first tokens of top level
+// definitions, dotted names and "if" statements, whose conditions are
+// evaluated like the parser's peer does.  Everything else is skipped, and no
+// signatures or types are built, so the scan is much cheaper than a parse.
+// Statements in the clauses of a condition that the peer would reject are
+// scanned as if the clause were active, and input that doesn't parse is
+// scanned as far as possible, thus the result holds at least what a
+// successful parse would define.  Does not require the GIL.
+void ScanHeader(Lexer* lexer, const ScanConditions& conditions,
+                HeaderScan* result);
+
+// Scan many inputs into results (one for each, in order) on up to threads
+// threads (at least one), the calling thread being one of them.  Must not
+// hold the GIL, which a thread may need when lexer stats are enabled.
+void ScanHeaders(const std::vector<BatchParser::Input>& inputs,
+                 const ScanConditions& conditions, int threads,
+                 std::vector<HeaderScan>* results);
+
+}  // end namespace pytype
+
+#endif  // PYTYPE_PYI_HEADER_SCAN_H_
@@ -0,0 +1,87 @@
+#include "input_stream.h"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+namespace pytype {
+
+int FdInputStream::Read(char* buffer, int size) {
+  if (errno_) {
+    return -1;
+  }
+  while (true) {
+    ssize_t n = read(fd_, buffer, size);
+    if (n >= 0) {
+      return n;
+    }
+    if (errno != EINTR) {
+      errno_ = errno;
+      return -1;
+    }
+  }
+}
+
+bool FdInputStream::RaiseError() {
+  if (!errno_) {
+    return false;
+  }
+  errno = errno_;
+  PyErr_SetFromErrno(PyExc_IOError);
+  return true;
+}
+
+PyFileInputStream::PyFileInputStream(PyObject* file)
+    : file_(file), type_(NULL), value_(NULL), traceback_(NULL) {
+  Py_INCREF(file_);
+}
+
+PyFileInputStream::~PyFileInputStream() {
+  Py_DECREF(file_);
+  Py_XDECREF(type_);
+  Py_XDECREF(value_);
+  Py_XDECREF(traceback_);
+}
+
+int PyFileInputStream::Read(char* buffer, int size) {
+  if (type_) {
+    return -1;
+  }
+  PyObject* data = PyObject_CallMethod(file_, const_cast<char*>("read"),
+                                       const_cast<char*>("i"), size);
+  if (data == NULL) {
+    return Fail();
+  }
+  if (!PyString_Check(data)) {
+    PyErr_Format(PyExc_TypeError, "read() should return str, not %.200s",
+                 Py_TYPE(data)->tp_name);
+    Py_DECREF(data);
+    return Fail();
+  }
+  Py_ssize_t length = PyString_GET_SIZE(data);
+  if (length > size) {
+    PyErr_Format(PyExc_ValueError, "read(%d) returned %zd bytes", size,
+                 length);
+    Py_DECREF(data);
+    return Fail();
+  }
+  memcpy(buffer, PyString_AS_STRING(data), length);
+  Py_DECREF(data);
+  return length;
+}
+
+int PyFileInputStream::Fail() {
+  PyErr_Fetch(&type_, &value_, &traceback_);
+  return -1;
+}
+
+bool PyFileInputStream::RaiseError() {
+  if (!type_) {
+    return false;
+  }
+  PyErr_Restore(type_, value_, traceback_);
+  type_ = value_ = traceback_ = NULL;
+  return true;
+}
+
+}  // end namespace pytype
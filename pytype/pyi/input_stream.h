@@ -0,0 +1,67 @@
+#ifndef PYTYPE_PYI_INPUT_STREAM_H_
+#define PYTYPE_PYI_INPUT_STREAM_H_
+
+#include <Python.h>
+
+namespace pytype {
+
+// A source of input for a streaming Lexer, which reads it in chunks rather
+// than requiring the whole text in memory.
+class InputStream {
+ public:
+  virtual ~InputStream() {}
+
+  // Read up to size bytes into buffer.  Returns the number of bytes read,
+  // 0 at the end of input or -1 if there was an error.  A stream that has
+  // failed keeps returning -1.
+  virtual int Read(char* buffer, int size) = 0;
+
+  // If a Read() failed, set a Python exception describing the failure and
+  // return true.  Requires the GIL.
+  virtual bool RaiseError() = 0;
+};
+
+// Reads from a file descriptor, which is not closed.  Does not require the
+// GIL.
+class FdInputStream : public InputStream {
+ public:
+  explicit FdInputStream(int fd) : fd_(fd), errno_(0) {}
+
+  int Read(char* buffer, int size);
+  bool RaiseError();
+
+ private:
+  int fd_;
+  int errno_;  // The errno of the failed read, 0 if there was none.
+};
+
+// Reads by calling read(size) on a Python file-like object, which must
+// return a str.  Requires the GIL.  An exception raised by read() is saved
+// and cleared, so that the parser can run to the end of input without an
+// exception pending, and RaiseError() restores it.
+class PyFileInputStream : public InputStream {
+ public:
+  explicit PyFileInputStream(PyObject* file);
+  ~PyFileInputStream();
+
+  int Read(char* buffer, int size);
+  bool RaiseError();
+
+ private:
+  PyObject* file_;
+  // The saved exception, all NULL if there was none.
+  PyObject* type_;
+  PyObject* value_;
+  PyObject* traceback_;
+
+  // Save and clear the current exception, return -1.
+  int Fail();
+
+  // Not copyable.
+  PyFileInputStream(const PyFileInputStream&);
+  PyFileInputStream& operator=(const PyFileInputStream&);
+};
+
+}  // end namespace pytype
+
+#endif  // PYTYPE_PYI_INPUT_STREAM_H_
@@ -0,0 +1,56 @@
+#include "intern_table.h"
+
+namespace pytype {
+
+long InternTable::total_hits_ = 0;
+long InternTable::total_misses_ = 0;
+
+InternTable::~InternTable() {
+  Clear();
+}
+
+void InternTable::Clear() {
+  for (Map::iterator it = map_.begin(); it != map_.end(); ++it) {
+    Py_DECREF(it->second);
+  }
+  map_.clear();
+  hits_ = 0;
+  misses_ = 0;
+}
+
+PyObject* InternTable::Intern(const char* text, int length) {
+  key_.assign(text, length);
+  Map::iterator it = map_.find(key_);
+  if (it != map_.end()) {
+    hits_++;
+    total_hits_++;
+    Py_INCREF(it->second);
+    return it->second;
+  }
+
+  PyObject* str = PyString_FromStringAndSize(text, length);
+  if (str == NULL) {
+    return NULL;
+  }
+  PyString_InternInPlace(&str);
+  misses_++;
+  total_misses_++;
+  // One reference for the table, one for the caller.
+  Py_INCREF(str);
+  map_[key_] = str;
+  return str;
+}
+
+void InternTable::ResetTotals() {
+  total_hits_ = 0;
+  total_misses_ = 0;
+}
+
+InternTable* InternTable::Global() {
+  // Intentionally leaked: destroying the table at exit could release
+  // references after the interpreter has been finalized.
+  static InternTable* global = new InternTable();
+  return global;
+}
+
+}  // end namespace pytype
@@ -0,0 +1,68 @@
+#ifndef PYTYPE_PYI_INTERN_TABLE_H_
+#define PYTYPE_PYI_INTERN_TABLE_H_
+
+#include <string>
+#include <unordered_map>
+#include <Python.h>
+
+namespace pytype {
+
+// A table of interned strings keyed by their contents.
+//
+// Identifiers such as "self", "int" and "typing" occur many times in a pyi
+// file.  Intern() returns the same string object for every occurrence of a
+// spelling, so that only the first occurrence allocates a string and Python
+// dict lookups on the strings can succeed on pointer equality.  Strings are
+// also interned with PyString_InternInPlace(), making them identical to
+// interned strings created by Python itself (e.g. attribute names).
+class InternTable {
+ public:
+  InternTable() : hits_(0), misses_(0) {}
+  ~InternTable();
+
+  // Return a new reference to the interned string with the given contents,
+  // or NULL if a string could not be created.
+  PyObject* Intern(const char* text, int length);
+
+  // Remove all strings and reset the counts of hits and misses (but not the
+  // totals).
+  void Clear();
+
+  // The number of distinct strings in the table.
+  int size() const { return map_.size(); }
+
+  // The number of Intern() calls that found (hits) or added (misses) a string.
+  long hits() const { return hits_; }
+  long misses() const { return misses_; }
+
+  // Process-wide totals of hits and misses over all tables.
+  static long total_hits() { return total_hits_; }
+  static long total_misses() { return total_misses_; }
+  static void ResetTotals();
+
+  // A process-wide table that is never destroyed.
+  static InternTable* Global();
+
+ private:
+  typedef std::unordered_map<std::string, PyObject*> Map;
+
+  // Strings and the references held on them.
+  Map map_;
+
+  // Reused for lookups so that a hit does not allocate.
+  std::string key_;
+
+  long hits_;
+  long misses_;
+
+  static long total_hits_;
+  static long total_misses_;
+
+  // Not copyable.
+  InternTable(const InternTable&);
+  InternTable& operator=(const InternTable&);
+};
+
+}  // end namespace pytype
+
+#endif  // PYTYPE_PYI_INTERN_TABLE_H_
@@ -0,0 +1,176 @@
+#include "ir.h"
+
+#include <stdint.h>
+#include <string.h>
+
+namespace pytype {
+
+namespace {
+
+// Serialized IR is a sequence of native byte order int32s (and string
+// bytes), thus it is only meant to be read on the machine that wrote it:
+//
+//   kMagic, kVersion,
+//   the number of strings, then for each its length and bytes,
+//   the number of code words, then the words,
+//   the number of locations, then for each the value id and the IrLocation.
+//
+// kVersion must be changed whenever the IR changes.
+const int32_t kMagic = 0x52495950;  // "PYIR"
+const int32_t kVersion = 3;
+
+const int kLocationFields = sizeof(IrLocation) / sizeof(int);
+
+void WriteInt(int32_t value, std::string* out) {
+  out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Reads from a buffer, failing once it runs out of data.
+class Input {
+ public:
+  Input(const char* data, size_t size) : p_(data), end_(data + size) {}
+
+  bool ReadInt(int* value) {
+    const char* start;
+    if (!Skip(sizeof(int32_t), &start)) {
+      return false;
+    }
+    int32_t v;
+    memcpy(&v, start, sizeof(v));
+    *value = v;
+    return true;
+  }
+
+  // Read a non-negative count of items of item_size bytes each.
+  bool ReadCount(size_t item_size, int* count) {
+    return ReadInt(count) && *count >= 0 &&
+        static_cast<size_t>(*count) <= (end_ - p_) / item_size;
+  }
+
+  // Skip over size bytes, setting *start to the first of them.
+  bool Skip(size_t size, const char** start) {
+    if (static_cast<size_t>(end_ - p_) < size) {
+      return false;
+    }
+    *start = p_;
+    p_ += size;
+    return true;
+  }
+
+  bool at_end() const { return p_ == end_; }
+
+ private:
+  const char* p_;
+  const char* end_;
+};
+
+}  // end namespace
+
+int IrWriter::EmitList(int op, const int* extra, int extra_count,
+                       const int* values, int count) {
+  code_.push_back(op);
+  code_.insert(code_.end(), extra, extra + extra_count);
+  code_.push_back(count);
+  code_.insert(code_.end(), values, values + count);
+  return next_id_++;
+}
+
+void IrWriter::EmitError(int message, const IrLocation& location) {
+  code_.push_back(kIrError);
+  code_.push_back(message);
+  const int* fields = &location.first_line;
+  code_.insert(code_.end(), fields, fields + kLocationFields);
+}
+
+int IrWriter::AddString(const char* text, int length) {
+  std::string key(text, length);
+  auto it = string_index_.find(key);
+  if (it != string_index_.end()) {
+    return it->second;
+  }
+  int index = strings_.size();
+  strings_.push_back(key);
+  string_index_.emplace(key, index);
+  return index;
+}
+
+void IrWriter::SetLocation(int id, const IrLocation& location) {
+  locations_.push_back(std::make_pair(id, location));
+}
+
+void IrWriter::Serialize(std::string* out) const {
+  WriteInt(kMagic, out);
+  WriteInt(kVersion, out);
+  WriteInt(strings_.size(), out);
+  for (const std::string& s : strings_) {
+    WriteInt(s.size(), out);
+    out->append(s);
+  }
+  WriteInt(code_.size(), out);
+  out->append(reinterpret_cast<const char*>(code_.data()),
+              code_.size() * sizeof(int));
+  WriteInt(locations_.size(), out);
+  for (const auto& entry : locations_) {
+    WriteInt(entry.first, out);
+    out->append(reinterpret_cast<const char*>(&entry.second),
+                sizeof(entry.second));
+  }
+}
+
+bool IrReader::Read(const char* data, size_t size) {
+  static_assert(sizeof(int) == sizeof(int32_t), "IR words must be int32");
+  Input input(data, size);
+  int magic, version, count;
+  if (!input.ReadInt(&magic) || magic != kMagic ||
+      !input.ReadInt(&version) || version != kVersion) {
+    return false;
+  }
+
+  if (!input.ReadCount(sizeof(int32_t), &count)) {
+    return false;
+  }
+  strings_.clear();
+  for (int i = 0; i < count; i++) {
+    int length;
+    const char* text;
+    if (!input.ReadCount(1, &length) || !input.Skip(length, &text)) {
+      return false;
+    }
+    strings_.push_back(std::make_pair(text, length));
+  }
+
+  const char* words;
+  if (!input.ReadCount(sizeof(int32_t), &count) ||
+      !input.Skip(count * sizeof(int32_t), &words)) {
+    return false;
+  }
+  code_.resize(count);
+  memcpy(code_.data(), words, count * sizeof(int32_t));
+
+  if (!input.ReadCount(sizeof(int32_t) + sizeof(IrLocation), &count)) {
+    return false;
+  }
+  locations_.clear();
+  for (int i = 0; i < count; i++) {
+    int id;
+    const char* fields;
+    if (!input.ReadInt(&id) || !input.Skip(sizeof(IrLocation), &fields)) {
+      return false;
+    }
+    IrLocation location;
+    memcpy(&location, fields, sizeof(location));
+    locations_[id] = location;
+  }
+  return input.at_end();
+}
+
+bool IrReader::GetLocation(int id, IrLocation* location) const {
+  auto it = locations_.find(id);
+  if (it == locations_.end()) {
+    return false;
+  }
+  *location = it->second;
+  return true;
+}
+
+}  // end namespace pytype
@@ -0,0 +1,152 @@
+#ifndef PYTYPE_PYI_IR_H_
+#define PYTYPE_PYI_IR_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace pytype {
+
+// The parser can emit an intermediate representation (IR) of the parse
+// instead of building Python objects, which lets it run without the GIL.
+// The IR records, in the order the parser performs them, the operations
+// that build the parse tree (creating strings, lists and tuples and calling
+// the peer), so that decoding it performs the same operations, and thus
+// the same peer calls, as a direct parse.
+//
+// Every operation that produces a value implicitly defines the next value
+// id, starting at 1.  Operands are value ids, and an operation consumes the
+// values it is given (like a stolen reference), except kIrDup.  Strings are
+// indexes into a string table.
+enum IrOp {
+  kIrNone = 1,  // -> None.
+  kIrName,      // string -> the interned string.
+  kIrString,    // string -> the string.
+  kIrInt,       // string -> an int parsed from the string.
+  kIrFloat,     // string -> a float parsed from the string.
+  kIrValue,     // selector -> the Context value for the ValueSelector.
+  kIrDup,       // value -> the same value, which isn't consumed.
+  kIrTuple,     // count, values... -> a tuple of the values.
+  kIrConcat,    // count, values... -> a tuple of the items of the values.
+  kIrCall,      // selector, count, values... -> the result of the call.
+  kIrDrop,      // value.  Produces nothing.
+  kIrResult,    // value: the result of the parse.  Produces nothing.
+  kIrError,     // string, location: a syntax error.  Produces nothing.
+
+  kIrOpCount,   // This must be last, it isn't an actual op.
+};
+
+// A location in the IR: the span of a token or rule (see YYLTYPE) and the
+// byte offsets of the start and end of its first line (-1 if unknown).
+struct IrLocation {
+  int first_line;
+  int first_column;
+  int last_line;
+  int last_column;
+  int line_start;
+  int line_end;
+};
+
+// Builds IR.  Does not require the GIL.
+class IrWriter {
+ public:
+  // If record_locations is false, the IR doesn't record the locations of
+  // values (see SetLocation()), which makes it smaller, but errors raised
+  // decoding it then have no location.
+  explicit IrWriter(bool record_locations = true)
+      : next_id_(1), record_locations_(record_locations) {}
+
+  bool records_locations() const { return record_locations_; }
+
+  // Append an op (with its operands) that produces a value, and return the
+  // value's id.
+  int Emit(int op, int operand) {
+    code_.push_back(op);
+    code_.push_back(operand);
+    return next_id_++;
+  }
+  int Emit(int op, int operand1, int operand2) {
+    code_.push_back(op);
+    code_.push_back(operand1);
+    code_.push_back(operand2);
+    return next_id_++;
+  }
+  int Emit(int op) {
+    code_.push_back(op);
+    return next_id_++;
+  }
+
+  // Append an op with a count of operands, preceded by extra_count other
+  // operands.  Produces a value.
+  int EmitList(int op, const int* extra, int extra_count, const int* values,
+               int count);
+
+  // Append an op that doesn't produce a value.
+  void EmitStatement(int op, int operand) {
+    code_.push_back(op);
+    code_.push_back(operand);
+  }
+
+  // Append a kIrError.
+  void EmitError(int message, const IrLocation& location);
+
+  // Return the index of a string in the string table, adding it if it isn't
+  // there yet.
+  int AddString(const char* text, int length);
+  int AddString(const std::string& text) {
+    return AddString(text.data(), text.size());
+  }
+
+  // Record the location of the op that produced a value.  Decoding reports
+  // it if the op fails.  Must only be called if records_locations().
+  void SetLocation(int id, const IrLocation& location);
+
+  // Append the serialized IR to out.
+  void Serialize(std::string* out) const;
+
+ private:
+  std::vector<int> code_;
+  std::vector<std::string> strings_;
+  std::unordered_map<std::string, int> string_index_;
+  // Value ids and their locations.
+  std::vector<std::pair<int, IrLocation>> locations_;
+  int next_id_;
+  bool record_locations_;
+};
+
+// Reads serialized IR.  Does not require the GIL.
+class IrReader {
+ public:
+  IrReader() {}
+
+  // Read the IR from data, which must outlive the reader.  Returns false if
+  // the data isn't valid IR of this version.  The code is only checked when
+  // it is decoded.
+  bool Read(const char* data, size_t size);
+
+  const std::vector<std::pair<const char*, int>>& strings() const {
+    return strings_;
+  }
+  const std::vector<int>& code() const { return code_; }
+
+  // Get the location recorded for a value id.  Returns false if there is
+  // none.
+  bool GetLocation(int id, IrLocation* location) const;
+
+  // Whether the IR records locations.  IR written without them has an empty
+  // table, and so does IR of a source without definitions.
+  bool has_locations() const { return !locations_.empty(); }
+
+ private:
+  std::vector<std::pair<const char*, int>> strings_;
+  std::vector<int> code_;
+  std::unordered_map<int, IrLocation> locations_;
+
+  // Not copyable.
+  IrReader(const IrReader&);
+  IrReader& operator=(const IrReader&);
+};
+
+}  // end namespace pytype
+
+#endif  // PYTYPE_PYI_IR_H_
@@ -1,22 +1,197 @@
 #ifndef PYTYPE_PYI_LEXER_H_
 #define PYTYPE_PYI_LEXER_H_
 
+#include <atomic>
+#include <mutex>
+#include <string>
 #include <vector>
 #include <Python.h>
 
+#include "intern_table.h"
 #include "parser.tab.h"
 #include "refholder.h"
 
 namespace pytype {
 
+class InputStream;
+class MappedFile;
+
+// The kind of value carried by a token.  Scanner actions only record the kind
+// of a token's value, the value's text is the token's span of the input.
+// Python objects for values are created by Lexer::MaterializeValue(), so the
+// scanner itself never needs the GIL.
+enum TokenValueKind {
+  kNoValue = 0,
+  kNameValue,           // NAME, the span is the name.
+  kQuotedNameValue,     // NAME, the span is the name enclosed in backticks.
+  kIntValue,            // NUMBER, the span is an integer literal.
+  kFloatValue,          // NUMBER, the span is a float literal.
+  kIllegalCharValue,    // LEXERROR, the span is the illegal character.
+  kBadIndentValue,      // LEXERROR for an invalid dedent.
+};
+
+// A scanned token.  Tokens do not reference Python objects, thus a vector of
+// them can be built without holding the GIL.
+struct Token {
+  int kind;             // The token code, 0 for end of input.
+  int value_kind;       // A TokenValueKind.
+  int start;            // Byte offset of the start of the token.
+  int end;              // Byte offset just past the end of the token.
+  YYLTYPE location;
+};
+
+// Counters describing the work done by lexers, see Lexer::collect_stats().
+struct LexerStats {
+  // The number of start states in lexer.lex, see Lexer::HandState.
+  static const int kStartStates = 6;
+
+  // Token codes are characters or bison token numbers, which start at 258.
+  static const int kTokenKinds = 512;
+
+  // Bytes consumed in each start state.  Text skipped by an action (e.g. the
+  // body of a docstring) counts for the state whose rules it bypasses.
+  long state_bytes[kStartStates];
+  // Tokens scanned by kind, not counting the end of input.
+  long tokens[kTokenKinds];
+  // The greatest number of indentation levels.
+  int max_indent_depth;
+  // Value objects created for tokens, and how many of them were allocated
+  // (rather than found in the intern table).
+  long values;
+  long allocations;
+
+  LexerStats() { Reset(); }
+  void Reset();
+  // Add other's counts to these.
+  void Merge(const LexerStats& other);
+};
+
+// The implementations of the scanner.  Both produce identical tokens.
+enum LexerBackend {
+  kFlexBackend,          // The flex generated scanner in lexer.lex.cc.
+  kHandwrittenBackend,   // The handwritten scanner in hand_lexer.cc.
+};
+
+// The backend used unless one is requested explicitly.
+#ifdef PYTYPE_HANDWRITTEN_LEXER
+const LexerBackend kDefaultLexerBackend = kHandwrittenBackend;
+#else
+const LexerBackend kDefaultLexerBackend = kFlexBackend;
+#endif
+
 class Lexer {
  public:
-  Lexer(const char* bytes, int length);
+  // Scan a copy of length bytes of data.
+  Lexer(const char* bytes, int length,
+        LexerBackend backend = kDefaultLexerBackend);
+
+  // Scan a mapped file in place.  The file must outlive the Lexer.
+  explicit Lexer(const MappedFile& file,
+                 LexerBackend backend = kDefaultLexerBackend);
+
+  // Scan input read from a stream in chunks of up to chunk_size bytes, so
+  // that only about two chunks (or the longest line, if that is longer) are
+  // held in memory.  The stream must outlive the Lexer.  A streaming lexer
+  // always uses the flex backend, and the text of a token is only available
+  // until the next one is scanned, so it must not be used with Tokenize(),
+  // LineStarts() or checkpoints.  A read error ends the input.
+  Lexer(InputStream* stream, int chunk_size);
+
   ~Lexer();
 
+  // Start scanning a copy of length bytes of data, or a mapped file (which
+  // must outlive the scan), as a new Lexer would, but reusing this one's
+  // scanner and storage.  Must not be used on a streaming lexer.
+  void Reset(const char* bytes, int length);
+  void Reset(const MappedFile& file);
+
   // The generated scanner associated with this lexer.
   void* scanner() const { return scanner_; }
 
+  // Get the next token, whose kind is 0 at the end of input.  Does not
+  // require the GIL.
+  void Next(Token* token);
+
+  // Scan the entire input into tokens(), after which Next() returns the
+  // stored tokens rather than scanning.  Does not require the GIL.
+  void Tokenize();
+
+  // The tokens stored by Tokenize().  The final token has kind 0.
+  const std::vector<Token>& tokens() const { return tokens_; }
+
+  // The indexes of the tokens stored by Tokenize() that are checkpoints.
+  const std::vector<int>& checkpoints() const { return checkpoints_; }
+
+  // Scan the next token without storing it or creating its value, and set
+  // *checkpoint to whether it is a checkpoint: the first token on a line
+  // (not preceded by a DEDENT) at the start of which there is no
+  // indentation, pending dedent or open bracket.  A lexer started at the
+  // token's line produces the same tokens from there on as this one.  Does
+  // not require the GIL.
+  void ScanToken(Token* token, bool* checkpoint);
+
+  // Number lines starting at line rather than 1.  Must be called before
+  // scanning starts.
+  void SetStartLine(int line);
+
+  // Return a new reference to the value of token, or NULL if it has no value
+  // or there was an error.  Sets error_message_ for LEXERROR tokens.
+  PyObject* MaterializeValue(const Token& token);
+
+  // Return a new reference to the interned string for the text of a name
+  // (e.g. a NAME token's value), or NULL if there was an error.  The string
+  // is counted like the values MaterializeValue() creates.
+  PyObject* MaterializeName(const char* text, int length);
+
+  // Get the text of a NAME or NUMBER token's value.  Returns false if the
+  // token has no such value.
+  bool GetValueText(const Token& token, const char** text, int* length) const;
+
+  // Whether the text of the tokens stays where GetValueText() found it for
+  // the lifetime of the lexer, which is the case unless streaming.
+  bool stable_text() const { return stream_ == NULL; }
+
+  // Get the error message of a LEXERROR token.  Returns false if the token
+  // has no message.
+  bool GetErrorMessage(const Token& token, std::string* message) const;
+
+  // Return the byte offset of a pointer into the scanned text.
+  int Offset(const char* p) const { return base_offset_ + (p - base_); }
+
+  // Called by the scanner at the start of a match (in the given start state)
+  // and with the end of the match once its action is done.  Offsets are
+  // computed relative to the current match, since flex moves the text in its
+  // buffer when it refills it from a stream.  Each match starts where the
+  // previous one ended.
+  void StartMatch(const char* text, int state) {
+    base_ = text;
+    base_offset_ = match_end_;
+    match_state_ = state;
+  }
+  void EndMatch(const char* end) { FinishMatch(Offset(end)); }
+
+  // Called by an action that consumes length bytes which the rules of the
+  // given start state would otherwise have matched.
+  void CountSkip(int state, int length) {
+    if (stats_) {
+      stats_->state_bytes[state] += length;
+      stats_->state_bytes[match_state_] -= length;
+    }
+  }
+
+  // Implement YY_INPUT for a streaming lexer: read up to max_size bytes into
+  // buffer.  Returns the number of bytes read, 0 at the end of input.
+  int ReadInput(char* buffer, size_t max_size);
+
+  // The byte offsets at which the lines of the input start, thus line n
+  // (counting from 1, like token locations) starts at LineStarts()[n - 1].
+  // The index is built on first use.  Does not require the GIL.
+  const std::vector<int>& LineStarts();
+
+  // Get the byte offsets of the start and end (excluding the newline) of a
+  // line.  Returns false if the input has no such line.
+  bool GetLineSpan(int line, int* start, int* end);
+
   // Return the current indentation.
   int CurrentIndentation() const { return indents_.back(); }
 
@@ -29,12 +204,57 @@ class Lexer {
   // Pop one dedent, return true iff there was one to pop.
   bool PopDedent();
 
+  // Implement the <<EOF>> rule of the scanner, returning the token code.
+  int ScanEndOfInput();
+
+  // Return a new reference to a string for a NAME token.  Repeated spellings
+  // return the same object, see InternTable.
+  PyObject* Intern(const char* text, int length) {
+    return names_->Intern(text, length);
+  }
+
+  // Whether lexers share the process-wide intern table rather than creating
+  // a table per parse.  This only affects lexers created afterwards.
+  static bool global_interning() { return global_interning_; }
+  static void set_global_interning(bool enabled) {
+    global_interning_ = enabled;
+  }
+
+  // Whether lexers count what they scan.  This only affects lexers created
+  // afterwards.  A lexer adds its counts to the totals when it is
+  // destroyed, which doesn't require the GIL.
+  static bool collect_stats() { return collect_stats_; }
+  static void set_collect_stats(bool enabled) { collect_stats_ = enabled; }
+
+  // Copy the totals to stats, and reset them if reset is true.
+  static void TotalStats(LexerStats* stats, bool reset);
+
+  // Add this lexer's counts to the totals now rather than when it is
+  // destroyed, and restart them from zero.
+  void MergeStats();
+
   // A simple counter to track open brackets.
   int bracket_count_;
 
+  // Count a closing bracket.  One without an opening bracket (a syntax
+  // error) is ignored, so that the indentation of the lines that follow is
+  // still tracked when the parser recovers from the error.
+  void CloseBracket() {
+    if (bracket_count_ > 0) {
+      --bracket_count_;
+    }
+  }
+
   // Saved location for start of triplequoted.
   int start_line_;
   int start_column_;
+  int start_offset_;
+
+  // The value kind of the token being scanned, set by scanner actions.
+  TokenValueKind value_kind_;
+
+  // Set by the <<EOF>> action.
+  bool at_eof_;
 
   // The last error message (NULL if there hasn't been an error).
   RefHolder error_message_;
@@ -46,11 +266,127 @@ class Lexer {
   // actions within the scanner can access the Lexer.
   void* scanner_;
 
+  // A pointer into the text being scanned and its byte offset in the
+  // input, see StartMatch(), the offset at which the last match ended, the
+  // start state of the current match and the length of the input.  When
+  // streaming, length_ counts the bytes read so far.
+  const char* base_;
+  int base_offset_;
+  int match_end_;
+  int match_state_;
+  int length_;
+
   // A stack of indents.  There is always a first element of value 0.
   std::vector<int> indents_;
 
   // A count of dedents that have not yet been returned.
   int pending_dedents_;
+
+  // The intern table for names, either local_names_ or the global table.
+  InternTable* names_;
+  InternTable local_names_;
+
+  // The location of the last token scanned.  The scanner leaves this
+  // unchanged at the end of input.
+  YYLTYPE location_;
+
+  // Tokens stored by Tokenize() and the index of the next one to return.
+  std::vector<Token> tokens_;
+  std::vector<int> checkpoints_;
+  size_t next_token_;
+  bool tokenized_;
+
+  // See LineStarts(), empty until it is built.
+  std::vector<int> line_starts_;
+
+  // Scratch space for converting numbers.
+  std::string number_text_;
+
+  // The stream a streaming lexer reads (NULL otherwise), the size of the
+  // chunks it reads and whether it has reached the end of the stream.
+  InputStream* stream_;
+  int chunk_size_;
+  bool stream_done_;
+
+  // This lexer's counts, NULL unless collect_stats() was enabled.
+  LexerStats* stats_;
+
+  LexerBackend backend_;
+
+  // Scan the next token with the selected backend.
+  void ScanToken(Token* token);
+
+  // Scan the next token with the generated scanner.
+  void ScanTokenWithFlex(Token* token);
+
+  // Count a value created by MaterializeValue() or MaterializeName().
+  void CountValue(bool allocated) {
+    if (stats_) {
+      stats_->values++;
+      stats_->allocations += allocated;
+    }
+  }
+
+  // Record the end offset of the current match.
+  void FinishMatch(int end) {
+    if (stats_) {
+      stats_->state_bytes[match_state_] += end - base_offset_;
+    }
+    match_end_ = end;
+  }
+
+  // Return a pointer to the text at a byte offset.  When streaming, only the
+  // text of the last token scanned is available.
+  const char* Text(int offset) const {
+    return base_ + (offset - base_offset_);
+  }
+
+  // The start states of the handwritten scanner, which correspond to the
+  // start states in lexer.lex.
+  enum HandState {
+    kInitialState,
+    kNewlineState,
+    kPendingState,
+    kTriple1State,
+    kTriple2State,
+    kCommentState,
+  };
+
+  // The state of the handwritten scanner: the offset of the next character,
+  // the current line and column (yylineno and yycolumn in the generated
+  // scanner) and the start state.
+  int pos_;
+  int line_;
+  int column_;
+  HandState hand_state_;
+
+  static bool global_interning_;
+  static std::atomic<bool> collect_stats_;
+  // The counts of the lexers that have finished, which may be merged from
+  // several threads.
+  static LexerStats total_stats_;
+  static std::mutex total_stats_mutex_;
+
+  // Create the scanner, must be called before installing an input buffer.
+  void InitScanner();
+
+  // Discard the state of the last scan, including its input buffer, before
+  // installing a new one.
+  void Restart();
+
+  // Initialize the scanner state after an input buffer has been installed.
+  void StartScanning(const char* base, int length);
+
+  // Scan the next token with the handwritten scanner.
+  void ScanTokenByHand(Token* token);
+
+
+  // Advance the handwritten scanner over length characters of a match,
+  // updating the location the same way as YY_USER_ACTION in lexer.lex.
+  void Advance(int length);
+
+  // Advance over a match that contains a single newline at its end.
+  void AdvanceLine(int length);
 };
 
 
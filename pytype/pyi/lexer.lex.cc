@@ -425,20 +425,81 @@ static yyconst flex_int32_t yy_rule_can_match_eol[58] =
 /* Exclusive start states. */
 
 #line 17 "lexer.lex"
+#include <algorithm>
+
+#include "fastscan.h"
+#include "input_stream.h"
 #include "lexer.h"
+#include "mapped_file.h"
 
 #define YY_EXTRA_TYPE pytype::Lexer*
 
 #define YY_USER_INIT BEGIN(NEWLINE);
 
 #define YY_USER_ACTION \
+  yyextra->StartMatch(yytext, YY_START); \
   yylval->obj=NULL; \
   yylloc->first_line = yylineno; \
   yylloc->first_column = yycolumn; \
   yylloc->last_line = yylineno; \
   yylloc->last_column = yycolumn + yyleng - 1; \
   yycolumn += yyleng;
-#line 456 "pyi/lexer.lex.cc"
+
+// The end of the text in the buffer.  This is the end of the input unless
+// the lexer is streaming.
+#define YY_TEXT_END (YY_CURRENT_BUFFER_LVALUE->yy_ch_buf + yyg->yy_n_chars)
+
+// Record where each action leaves the end of the match, see StartMatch().
+// Actions that return a token are handled by ScanToken().
+#define YY_BREAK \
+  yyextra->EndMatch(yytext + yyleng); \
+  break;
+
+// Only a streaming lexer reads input, buffers scanned in memory are never
+// refilled.
+#define YY_INPUT(buf, result, max_size) \
+  result = yyextra->ReadInput(buf, max_size);
+
+// Flex terminates yytext by replacing the character after the match with a
+// NUL.  UNTERMINATE_MATCH() puts the character back, so that an action can
+// look at the text that follows, and EXTEND_MATCH(p) then ends the match at
+// p (which must not be before the end of the match).  This lets an action
+// consume text without matching it rule by rule.  The location and line
+// number are not updated.
+#define UNTERMINATE_MATCH() (yytext[yyleng] = yyg->yy_hold_char)
+#define EXTEND_MATCH(p) \
+  do { \
+    yyg->yy_c_buf_p = const_cast<char*>(p); \
+    yyg->yy_hold_char = *yyg->yy_c_buf_p; \
+    *yyg->yy_c_buf_p = '\0'; \
+    yyleng = yyg->yy_c_buf_p - yytext; \
+  } while (0)
+
+// Skip a docstring opened by the current match.  If the closing quotes are
+// found, this consumes the docstring and returns TRIPLEQUOTED with the
+// location the state (TRIPLE1 or TRIPLE2) rules would have produced.
+// Otherwise the docstring is left to those rules, which handle the end of
+// input.
+#define SKIP_TRIPLEQUOTED(quote, state) \
+  do { \
+    UNTERMINATE_MATCH(); \
+    const char* close = pytype::FindTriple(yytext + yyleng, YY_TEXT_END, \
+                                           quote); \
+    if (close) { \
+      pytype::AdvanceLineAndColumn(yytext + yyleng, close, &yylineno, \
+                                   &yycolumn); \
+      yyextra->CountSkip(state, close + 3 - (yytext + yyleng)); \
+      EXTEND_MATCH(close + 3); \
+      yylloc->first_line = yyextra->start_line_; \
+      yylloc->first_column = yyextra->start_column_; \
+      yylloc->last_line = yylineno; \
+      yylloc->last_column = yycolumn + 2; \
+      yycolumn += 3; \
+      return TRIPLEQUOTED; \
+    } \
+    EXTEND_MATCH(yytext + yyleng); \
+  } while (0)
+#line 517 "pyi/lexer.lex.cc"
 
 #define INITIAL 0
 #define NEWLINE 1
@@ -682,10 +743,10 @@ YY_DECL
 	register int yy_act;
     struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
 
-#line 32 "lexer.lex"
+#line 93 "lexer.lex"
 
 
-#line 703 "pyi/lexer.lex.cc"
+#line 764 "pyi/lexer.lex.cc"
 
     yylval = yylval_param;
 
@@ -783,233 +844,235 @@ do_action:	/* This label is used only to access EOF actions. */
 case 1:
 /* rule 1 can match eol */
 YY_RULE_SETUP
-#line 34 "lexer.lex"
+#line 95 "lexer.lex"
 { BEGIN(NEWLINE); yycolumn=1; }  /* Determine indentation. */
 	YY_BREAK
 case 2:
 YY_RULE_SETUP
-#line 35 "lexer.lex"
+#line 96 "lexer.lex"
 { }  /* Ignore whitespace */
 	YY_BREAK
 /* Punctuation */
 case 3:
 YY_RULE_SETUP
-#line 38 "lexer.lex"
+#line 99 "lexer.lex"
 { return yytext[0]; }
 	YY_BREAK
 case 4:
 YY_RULE_SETUP
-#line 39 "lexer.lex"
+#line 100 "lexer.lex"
 { ++yyextra->bracket_count_; return yytext[0]; }
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
-#line 40 "lexer.lex"
-{ --yyextra->bracket_count_; return yytext[0]; }
+#line 101 "lexer.lex"
+{ yyextra->CloseBracket(); return yytext[0]; }
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 41 "lexer.lex"
+#line 102 "lexer.lex"
 { ++yyextra->bracket_count_; return yytext[0]; }
 	YY_BREAK
 case 7:
 YY_RULE_SETUP
-#line 42 "lexer.lex"
-{ --yyextra->bracket_count_; return yytext[0]; }
+#line 103 "lexer.lex"
+{ yyextra->CloseBracket(); return yytext[0]; }
 	YY_BREAK
 /* Ignore quotes. */
 case 8:
 YY_RULE_SETUP
-#line 45 "lexer.lex"
+#line 106 "lexer.lex"
 { }
 	YY_BREAK
 /* Multi-character punctuation. */
 case 9:
 YY_RULE_SETUP
-#line 48 "lexer.lex"
+#line 109 "lexer.lex"
 { return ARROW; }
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
-#line 49 "lexer.lex"
+#line 110 "lexer.lex"
 { return COLONEQUALS; }
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 50 "lexer.lex"
+#line 111 "lexer.lex"
 { return ELLIPSIS; }
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
-#line 51 "lexer.lex"
+#line 112 "lexer.lex"
 { return EQ; }
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 52 "lexer.lex"
+#line 113 "lexer.lex"
 { return NE; }
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
-#line 53 "lexer.lex"
+#line 114 "lexer.lex"
 { return LE; }
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 54 "lexer.lex"
+#line 115 "lexer.lex"
 { return GE; }
 	YY_BREAK
-/* Reserved words (must also be added to parse_ext.cc and match
-  * parser_constant.py).
+/* Reserved words (must also be added to parse_ext.cc and hand_lexer.cc and
+  * match parser_constant.py).
   */
 case 16:
 YY_RULE_SETUP
-#line 60 "lexer.lex"
+#line 121 "lexer.lex"
 { return CLASS; }
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
-#line 61 "lexer.lex"
+#line 122 "lexer.lex"
 { return DEF; }
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
-#line 62 "lexer.lex"
+#line 123 "lexer.lex"
 { return ELSE; }
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
-#line 63 "lexer.lex"
+#line 124 "lexer.lex"
 { return ELIF; }
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
-#line 64 "lexer.lex"
+#line 125 "lexer.lex"
 { return IF; }
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
-#line 65 "lexer.lex"
+#line 126 "lexer.lex"
 { return OR; }
 	YY_BREAK
 case 22:
 YY_RULE_SETUP
-#line 66 "lexer.lex"
+#line 127 "lexer.lex"
 { return PASS; }
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
-#line 67 "lexer.lex"
+#line 128 "lexer.lex"
 { return IMPORT; }
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
-#line 68 "lexer.lex"
+#line 129 "lexer.lex"
 { return FROM; }
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
-#line 69 "lexer.lex"
+#line 130 "lexer.lex"
 { return AS; }
 	YY_BREAK
 case 26:
 YY_RULE_SETUP
-#line 70 "lexer.lex"
+#line 131 "lexer.lex"
 { return RAISE; }
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
-#line 71 "lexer.lex"
+#line 132 "lexer.lex"
 { return PYTHONCODE; }
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
-#line 72 "lexer.lex"
+#line 133 "lexer.lex"
 { return NOTHING; }
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
-#line 73 "lexer.lex"
+#line 134 "lexer.lex"
 { return RAISES; }
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
-#line 74 "lexer.lex"
+#line 135 "lexer.lex"
 { return NAMEDTUPLE; }
 	YY_BREAK
 case 31:
 YY_RULE_SETUP
-#line 75 "lexer.lex"
+#line 136 "lexer.lex"
 { return TYPEVAR; }
 	YY_BREAK
 /* NAME */
 case 32:
 YY_RULE_SETUP
-#line 78 "lexer.lex"
+#line 139 "lexer.lex"
 {
-  yylval->obj=PyString_FromString(yytext);
+  yyextra->value_kind_ = pytype::kNameValue;
   return NAME;
 }
 	YY_BREAK
 case 33:
 YY_RULE_SETUP
-#line 82 "lexer.lex"
+#line 143 "lexer.lex"
 {
-  yylval->obj=PyString_FromStringAndSize(yytext+1, yyleng-2);
+  yyextra->value_kind_ = pytype::kQuotedNameValue;
   return NAME;
 }
 	YY_BREAK
 /* NUMBER */
 case 34:
 YY_RULE_SETUP
-#line 88 "lexer.lex"
-{ yylval->obj=PyInt_FromString(yytext, NULL, 10); return NUMBER; }
+#line 149 "lexer.lex"
+{ yyextra->value_kind_ = pytype::kIntValue; return NUMBER; }
 	YY_BREAK
 case 35:
 YY_RULE_SETUP
-#line 89 "lexer.lex"
+#line 150 "lexer.lex"
 {
-  yylval->obj=PyFloat_FromDouble(atof(yytext));
+  yyextra->value_kind_ = pytype::kFloatValue;
   return NUMBER;
 }
 	YY_BREAK
 case 36:
 YY_RULE_SETUP
-#line 93 "lexer.lex"
+#line 154 "lexer.lex"
 {
-  yylval->obj=PyFloat_FromDouble(atof(yytext));
+  yyextra->value_kind_ = pytype::kFloatValue;
   return NUMBER;
 }
 	YY_BREAK
 /* TRIPLEQUOTED */
 case 37:
 YY_RULE_SETUP
-#line 99 "lexer.lex"
+#line 160 "lexer.lex"
 {
-  BEGIN(TRIPLE1);
   yyextra->start_line_ = yylineno;
   yyextra->start_column_ = yycolumn - yyleng;
+  yyextra->start_offset_ = yyextra->Offset(yytext);
+  SKIP_TRIPLEQUOTED('\'', TRIPLE1);
+  BEGIN(TRIPLE1);
 }
 	YY_BREAK
 case 38:
 YY_RULE_SETUP
-#line 104 "lexer.lex"
+#line 167 "lexer.lex"
 { }
 	YY_BREAK
 case 39:
 /* rule 39 can match eol */
 YY_RULE_SETUP
-#line 105 "lexer.lex"
+#line 168 "lexer.lex"
 { yycolumn = 1; }
 	YY_BREAK
 case 40:
 YY_RULE_SETUP
-#line 106 "lexer.lex"
+#line 169 "lexer.lex"
 { }
 	YY_BREAK
 case 41:
 YY_RULE_SETUP
-#line 107 "lexer.lex"
+#line 170 "lexer.lex"
 {
   BEGIN(INITIAL);
   yylloc->first_line = yyextra->start_line_;
@@ -1019,32 +1082,34 @@ YY_RULE_SETUP
 	YY_BREAK
 case 42:
 YY_RULE_SETUP
-#line 114 "lexer.lex"
+#line 177 "lexer.lex"
 {
-  BEGIN(TRIPLE2);
   yyextra->start_line_ = yylineno;
   yyextra->start_column_ = yycolumn - yyleng;
+  yyextra->start_offset_ = yyextra->Offset(yytext);
+  SKIP_TRIPLEQUOTED('"', TRIPLE2);
+  BEGIN(TRIPLE2);
 }
 	YY_BREAK
 case 43:
 YY_RULE_SETUP
-#line 119 "lexer.lex"
+#line 184 "lexer.lex"
 { }
 	YY_BREAK
 case 44:
 /* rule 44 can match eol */
 YY_RULE_SETUP
-#line 120 "lexer.lex"
+#line 185 "lexer.lex"
 { yycolumn = 1; }
 	YY_BREAK
 case 45:
 YY_RULE_SETUP
-#line 121 "lexer.lex"
+#line 186 "lexer.lex"
 { }
 	YY_BREAK
 case 46:
 YY_RULE_SETUP
-#line 122 "lexer.lex"
+#line 187 "lexer.lex"
 {
   BEGIN(INITIAL);
   yylloc->first_line = yyextra->start_line_;
@@ -1054,30 +1119,51 @@ YY_RULE_SETUP
 	YY_BREAK
 case 47:
 YY_RULE_SETUP
-#line 129 "lexer.lex"
+#line 194 "lexer.lex"
 { return TYPECOMMENT; }
 	YY_BREAK
 case 48:
 YY_RULE_SETUP
-#line 130 "lexer.lex"
-{ BEGIN(COMMENT); }
+#line 195 "lexer.lex"
+{
+  // Skip the text of the comment in one go, as if <COMMENT>[^\n]+ had
+  // matched it.  This leaves the COMMENT state at the newline.  A comment
+  // that runs to the end of the buffer is left to that rule, since a
+  // streaming lexer may not have read all of it yet.
+  UNTERMINATE_MATCH();
+  const char* newline = pytype::FindNewline(yytext + yyleng, YY_TEXT_END);
+  if (newline == YY_TEXT_END) {
+    newline = yytext + yyleng;
+  }
+  int length = newline - (yytext + yyleng);
+  yyextra->CountSkip(COMMENT, length);
+  EXTEND_MATCH(newline);
+  if (length) {
+    yylloc->first_column = yycolumn;
+    yylloc->last_column = yycolumn + length - 1;
+    yycolumn += length;
+  }
+  BEGIN(COMMENT);
+}
 	YY_BREAK
 /* Due to a quirk of the flex state machine, matching an empty string
   * does not trigger an action, thus <COMMENT>[^\n]* would not by itself
   * trigger a switch to the INITIAL state if the comment were empty.  In
   * order to deal with this, we have two rules for the COMMENT state: the
   * first consumes any non-empty comment and switchtes to INITIAL.  The second
-  * consumes a lone newline and moves to the NEWLINE state.
+  * consumes a lone newline and moves to the NEWLINE state.  (The \# rule
+  * skips the comment text itself, so the first rule is only reached for a
+  * comment at the end of the buffer.)
   */
 case 49:
 YY_RULE_SETUP
-#line 138 "lexer.lex"
+#line 224 "lexer.lex"
 { BEGIN(INITIAL); }
 	YY_BREAK
 case 50:
 /* rule 50 can match eol */
 YY_RULE_SETUP
-#line 139 "lexer.lex"
+#line 225 "lexer.lex"
 { BEGIN(NEWLINE); yycolumn=1; }
 	YY_BREAK
 /* NEWLINE state is responsible for processing the whitespace at the start
@@ -1088,8 +1174,24 @@ YY_RULE_SETUP
 case 51:
 /* rule 51 can match eol */
 YY_RULE_SETUP
-#line 148 "lexer.lex"
-{ yycolumn = 1; }
+#line 234 "lexer.lex"
+{
+  // Skip any further empty lines in one go, with the location of the last.
+  int lines;
+  const char* last_line;
+  UNTERMINATE_MATCH();
+  const char* next = pytype::SkipBlankLines(yytext + yyleng, YY_TEXT_END,
+                                            &lines, &last_line);
+  EXTEND_MATCH(next);
+  if (lines) {
+    yylineno += lines;
+    yylloc->first_line = yylineno;
+    yylloc->first_column = 0;
+    yylloc->last_line = yylineno;
+    yylloc->last_column = next - last_line - 1;
+  }
+  yycolumn = 1;
+}
 	YY_BREAK
 /* Ignore comment indentation. */
 case 52:
@@ -1097,13 +1199,13 @@ case 52:
 yyg->yy_c_buf_p = yy_cp -= 1;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
-#line 151 "lexer.lex"
+#line 253 "lexer.lex"
 { BEGIN(INITIAL); }
 	YY_BREAK
 /* White space at start of line. */
 case 53:
 YY_RULE_SETUP
-#line 154 "lexer.lex"
+#line 256 "lexer.lex"
 {
   if (yyextra->bracket_count_) {
     // Ignore indentation within brackets.
@@ -1111,8 +1213,7 @@ YY_RULE_SETUP
   } else if (yyleng < yyextra->CurrentIndentation()) {
     // Dedent.
     if (!yyextra->PopIndentationTo(yyleng)) {
-      yylval->obj=PyString_FromString("Invalid indentation");
-      yyextra->error_message_ = yylval->obj;
+      yyextra->value_kind_ = pytype::kBadIndentValue;
       return LEXERROR;
     }
     BEGIN(PENDING);
@@ -1130,7 +1231,7 @@ YY_RULE_SETUP
 /* Anything else - put it back and transition to PENDING or INITIAL. */
 case 54:
 YY_RULE_SETUP
-#line 178 "lexer.lex"
+#line 279 "lexer.lex"
 {
   yyless(0); yycolumn--;
   if (yyextra->CurrentIndentation()) {
@@ -1146,7 +1247,7 @@ YY_RULE_SETUP
   */
 case 55:
 YY_RULE_SETUP
-#line 191 "lexer.lex"
+#line 292 "lexer.lex"
 {
   yyless(0);
   if (yyextra->PopDedent()) {
@@ -1162,37 +1263,29 @@ case YY_STATE_EOF(PENDING):
 case YY_STATE_EOF(TRIPLE1):
 case YY_STATE_EOF(TRIPLE2):
 case YY_STATE_EOF(COMMENT):
-#line 200 "lexer.lex"
+#line 301 "lexer.lex"
 {
-  if (yyextra->CurrentIndentation()) {
-    yyextra->PopIndentationTo(0);
-  }
   // Ensure a yylval of NULL, even when returning EOF.
   yylval->obj=NULL;
-  if (yyextra->PopDedent()) {
-    return DEDENT;
-  } else {
-    yyterminate();
-  }
+  return yyextra->ScanEndOfInput();
 }
 	YY_BREAK
 /* Anything we don't understand is an error. */
 case 56:
 /* rule 56 can match eol */
 YY_RULE_SETUP
-#line 214 "lexer.lex"
+#line 308 "lexer.lex"
 {
-  yylval->obj=PyString_FromFormat("Illegal character '%c'", yytext[0]);
-  yyextra->error_message_ = yylval->obj;
+  yyextra->value_kind_ = pytype::kIllegalCharValue;
   return LEXERROR;
 }
 	YY_BREAK
 case 57:
 YY_RULE_SETUP
-#line 220 "lexer.lex"
+#line 313 "lexer.lex"
 YY_FATAL_ERROR( "flex scanner jammed" );
 	YY_BREAK
-#line 1210 "pyi/lexer.lex.cc"
+#line 1303 "pyi/lexer.lex.cc"
 
 	case YY_END_OF_BUFFER:
 		{
@@ -2377,31 +2470,176 @@ void pytypefree (void * ptr , yyscan_t yyscanner)
 
 #define YYTABLES_NAME "yytables"
 
-#line 220 "lexer.lex"
+#line 313 "lexer.lex"
 
 
 
 namespace pytype {
 
-Lexer::Lexer(const char* data, int len)
-    : bracket_count_(0), pending_dedents_(0) {
+bool Lexer::global_interning_ = false;
+std::atomic<bool> Lexer::collect_stats_(false);
+LexerStats Lexer::total_stats_;
+std::mutex Lexer::total_stats_mutex_;
+
+void LexerStats::Reset() {
+  std::fill(state_bytes, state_bytes + kStartStates, 0);
+  std::fill(tokens, tokens + kTokenKinds, 0);
+  max_indent_depth = 0;
+  values = 0;
+  allocations = 0;
+}
+
+void LexerStats::Merge(const LexerStats& other) {
+  for (int i = 0; i < kStartStates; ++i) {
+    state_bytes[i] += other.state_bytes[i];
+  }
+  for (int i = 0; i < kTokenKinds; ++i) {
+    tokens[i] += other.tokens[i];
+  }
+  max_indent_depth = std::max(max_indent_depth, other.max_indent_depth);
+  values += other.values;
+  allocations += other.allocations;
+}
+
+Lexer::Lexer(const char* data, int len, LexerBackend backend)
+    : bracket_count_(0), pending_dedents_(0), stream_(NULL),
+      backend_(backend) {
+  InitScanner();
+  YY_BUFFER_STATE buffer = pytype_scan_bytes(data,len,scanner_);
+  StartScanning(buffer->yy_ch_buf, len);
+}
+
+Lexer::Lexer(const MappedFile& file, LexerBackend backend)
+    : bracket_count_(0), pending_dedents_(0), stream_(NULL),
+      backend_(backend) {
+  InitScanner();
+  // The mapping is followed by the NUL sentinels that pytype_scan_buffer()
+  // requires, so it is scanned in place rather than copied.
+  pytype_scan_buffer(file.data(),file.length() + MappedFile::kSentinelBytes,
+                 scanner_);
+  StartScanning(file.data(), file.length());
+}
+
+Lexer::Lexer(InputStream* stream, int chunk_size)
+    : bracket_count_(0), pending_dedents_(0), stream_(stream),
+      backend_(kFlexBackend) {
+  InitScanner();
+  // Flex never reads more than YY_READ_BUF_SIZE at a time.  The buffer holds
+  // a chunk plus the partial match that flex keeps when refilling it, and
+  // flex grows it if a match doesn't fit.
+  chunk_size_ = std::min(std::max(chunk_size, 1), YY_READ_BUF_SIZE);
+  YY_BUFFER_STATE buffer = pytype_create_buffer(NULL,2 * chunk_size_,scanner_);
+  pytype_switch_to_buffer(buffer,scanner_);
+  StartScanning(buffer->yy_ch_buf, 0);
+}
+
+void Lexer::Reset(const char* data, int len) {
+  Restart();
+  YY_BUFFER_STATE buffer = pytype_scan_bytes(data,len,scanner_);
+  StartScanning(buffer->yy_ch_buf, len);
+}
+
+void Lexer::Reset(const MappedFile& file) {
+  Restart();
+  pytype_scan_buffer(file.data(),file.length() + MappedFile::kSentinelBytes,
+                 scanner_);
+  StartScanning(file.data(), file.length());
+}
+
+void Lexer::TotalStats(LexerStats* stats, bool reset) {
+  std::lock_guard<std::mutex> lock(total_stats_mutex_);
+  *stats = total_stats_;
+  if (reset) {
+    total_stats_.Reset();
+  }
+}
+
+void Lexer::MergeStats() {
+  if (stats_) {
+    std::lock_guard<std::mutex> lock(total_stats_mutex_);
+    total_stats_.Merge(*stats_);
+    stats_->Reset();
+  }
+}
+
+void Lexer::Restart() {
+  // Finish the last scan like ~Lexer(), then set up like InitScanner().
+  MergeStats();
+  if (collect_stats_ != (stats_ != NULL)) {
+    delete stats_;
+    stats_ = collect_stats_ ? new LexerStats : NULL;
+  }
+  names_ = global_interning_ ? InternTable::Global() : &local_names_;
+  local_names_.Clear();
+  pytypepop_buffer_state(scanner_);
+  // YY_USER_INIT only sets the start state for the first scan.
+  struct yyguts_t* yyg = static_cast<struct yyguts_t*>(scanner_);
+  BEGIN(NEWLINE);
+
+  bracket_count_ = 0;
+  pending_dedents_ = 0;
+  indents_.clear();
+  tokens_.clear();
+  checkpoints_.clear();
+  line_starts_.clear();
+  value_kind_ = kNoValue;
+  error_message_ = NULL;
+}
+
+void Lexer::InitScanner() {
+  names_ = global_interning_ ? InternTable::Global() : &local_names_;
+  stats_ = collect_stats_ ? new LexerStats : NULL;
   pytypelex_init(&scanner_);
   pytypeset_extra(this,scanner_);
-  pytype_scan_bytes(data,len,scanner_);
-  // When using scan_bytes() a new buffer is installed without intializing
-  // yylineno, thus it must be explicitly initialized.
+}
+
+void Lexer::StartScanning(const char* base, int length) {
+  // When using scan_bytes() or scan_buffer() a new buffer is installed
+  // without intializing yylineno, thus it must be explicitly initialized.
   pytypeset_lineno(1,scanner_);
   pytypeset_column(1,scanner_);
 
+  base_ = base;
+  base_offset_ = 0;
+  match_end_ = 0;
+  match_state_ = INITIAL;
+  length_ = length;
+  stream_done_ = false;
   indents_.push_back(0);
+  at_eof_ = false;
+  location_.first_line = location_.last_line = 1;
+  location_.first_column = location_.last_column = 1;
+  next_token_ = 0;
+  tokenized_ = false;
+
+  // Stats are indexed by start state, for which both scanners use the same
+  // numbers.
+  static_assert(INITIAL == kInitialState && NEWLINE == kNewlineState &&
+                PENDING == kPendingState && TRIPLE1 == kTriple1State &&
+                TRIPLE2 == kTriple2State && COMMENT == kCommentState &&
+                LexerStats::kStartStates == kCommentState + 1,
+                "The start states do not match HandState.");
+
+  // Mirror the generated scanner, which starts in the NEWLINE state.
+  pos_ = 0;
+  line_ = 1;
+  column_ = 1;
+  hand_state_ = kNewlineState;
 }
 
 Lexer::~Lexer() {
   pytypelex_destroy(scanner_);
+  MergeStats();
+  delete stats_;
 }
 
 void Lexer::PushIndentation(int width) {
   indents_.push_back(width);
+  if (stats_) {
+    // The first element is not an indentation level.
+    stats_->max_indent_depth = std::max(
+        stats_->max_indent_depth, static_cast<int>(indents_.size()) - 1);
+  }
 }
 
 bool Lexer::PopIndentationTo(int width) {
@@ -2416,6 +2654,220 @@ bool Lexer::PopIndentationTo(int width) {
   return indents_.back() == width;
 }
 
+int Lexer::ReadInput(char* buffer, size_t max_size) {
+  if (stream_ == NULL || stream_done_) {
+    return 0;
+  }
+  int n = stream_->Read(buffer, std::min(max_size,
+                                         static_cast<size_t>(chunk_size_)));
+  if (n <= 0) {
+    // Flex may ask again after the end of input.
+    stream_done_ = true;
+    return 0;
+  }
+  length_ += n;
+  return n;
+}
+
+void Lexer::SetStartLine(int line) {
+  pytypeset_lineno(line,scanner_);
+  line_ = line;
+  location_.first_line = location_.last_line = line;
+}
+
+void Lexer::ScanToken(Token* token) {
+  if (backend_ == kHandwrittenBackend) {
+    ScanTokenByHand(token);
+  } else {
+    ScanTokenWithFlex(token);
+  }
+  if (stats_ && token->kind) {
+    stats_->tokens[token->kind]++;
+  }
+}
+
+void Lexer::ScanTokenWithFlex(Token* token) {
+  YYSTYPE lval;
+  value_kind_ = kNoValue;
+  token->kind = pytypelex(&lval, &location_, scanner_);
+  token->value_kind = value_kind_;
+  token->location = location_;
+  if (at_eof_) {
+    token->start = token->end = length_;
+  } else {
+    // yytext and yyleng reflect any yyless() done by the action.
+    int offset = Offset(pytypeget_text(scanner_));
+    token->start = token->kind == TRIPLEQUOTED ? start_offset_ : offset;
+    token->end = offset + pytypeget_leng(scanner_);
+    FinishMatch(token->end);
+  }
+}
+
+void Lexer::Next(Token* token) {
+  if (tokenized_) {
+    *token = tokens_[next_token_];
+    // Stay on the final token once it is reached.
+    if (token->kind) {
+      next_token_++;
+    }
+  } else {
+    ScanToken(token);
+  }
+}
+
+const std::vector<int>& Lexer::LineStarts() {
+  // A streaming lexer no longer has the text, the index stays empty.
+  if (line_starts_.empty() && stream_ == NULL) {
+    // The generated scanner terminates yytext by replacing the following
+    // character with a NUL, which must be put back while indexing.
+    struct yyguts_t* yyg = static_cast<struct yyguts_t*>(scanner_);
+    char terminator = *yyg->yy_c_buf_p;
+    *yyg->yy_c_buf_p = yyg->yy_hold_char;
+
+    // Lines end at a newline, as for yylineno.
+    const char* end = Text(length_);
+    const char* p = Text(0);
+    line_starts_.push_back(0);
+    while ((p = FindNewline(p, end)) != end) {
+      ++p;
+      line_starts_.push_back(Offset(p));
+    }
+
+    *yyg->yy_c_buf_p = terminator;
+  }
+  return line_starts_;
+}
+
+bool Lexer::GetLineSpan(int line, int* start, int* end) {
+  const std::vector<int>& starts = LineStarts();
+  if (line < 1 || line > static_cast<int>(starts.size())) {
+    return false;
+  }
+  *start = starts[line - 1];
+  *end = line < static_cast<int>(starts.size()) ? starts[line] - 1 : length_;
+  return true;
+}
+
+void Lexer::ScanToken(Token* token, bool* checkpoint) {
+  // Scanning the newline before a token doesn't change this state, thus it
+  // is the state at the start of the token's line.
+  bool top_level = stream_ == NULL && indents_.size() == 1 &&
+      pending_dedents_ == 0 && bracket_count_ == 0;
+  ScanToken(token);
+  // A token that follows a DEDENT on the same line is at a later column, see
+  // the PENDING rule.
+  *checkpoint = top_level && token->kind != 0 && token->kind != INDENT &&
+      token->location.first_column == 1 &&
+      (token->start == 0 || *Text(token->start - 1) == '\n');
+}
+
+void Lexer::Tokenize() {
+  // Regrowing the vector dominates the cost of scanning, so reserve enough
+  // for dense stubs (roughly one token per 8 bytes).  Pages that aren't
+  // used are never touched.
+  tokens_.reserve(length_ / 8 + 1);
+  Token token;
+  bool checkpoint;
+  do {
+    ScanToken(&token, &checkpoint);
+    if (checkpoint) {
+      checkpoints_.push_back(tokens_.size());
+    }
+    tokens_.push_back(token);
+  } while (token.kind);
+  next_token_ = 0;
+  tokenized_ = true;
+}
+
+bool Lexer::GetValueText(const Token& token, const char** text,
+                         int* length) const {
+  switch (token.value_kind) {
+    case kNameValue:
+    case kIntValue:
+    case kFloatValue:
+      *text = Text(token.start);
+      *length = token.end - token.start;
+      return true;
+    case kQuotedNameValue:
+      *text = Text(token.start) + 1;
+      *length = token.end - token.start - 2;
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool Lexer::GetErrorMessage(const Token& token, std::string* message) const {
+  switch (token.value_kind) {
+    case kIllegalCharValue:
+      message->assign("Illegal character '");
+      message->push_back(*Text(token.start));
+      message->push_back('\'');
+      return true;
+    case kBadIndentValue:
+      message->assign("Invalid indentation");
+      return true;
+    default:
+      return false;
+  }
+}
+
+PyObject* Lexer::MaterializeName(const char* text, int length) {
+  if (stats_) {
+    long misses = names_->misses();
+    PyObject* name = Intern(text, length);
+    CountValue(names_->misses() != misses);
+    return name;
+  }
+  return Intern(text, length);
+}
+
+PyObject* Lexer::MaterializeValue(const Token& token) {
+  const char* text = Text(token.start);
+  int length = token.end - token.start;
+  PyObject* message;
+  std::string message_text;
+  switch (token.value_kind) {
+    case kNoValue:
+      return NULL;
+    case kNameValue:
+    case kQuotedNameValue:
+      GetValueText(token, &text, &length);
+      return MaterializeName(text, length);
+    case kIntValue:
+      // The text is not NUL terminated once scanning has moved on.
+      number_text_.assign(text, length);
+      CountValue(true);
+      return PyInt_FromString(const_cast<char*>(number_text_.c_str()), NULL,
+                              10);
+    case kFloatValue:
+      number_text_.assign(text, length);
+      CountValue(true);
+      return PyFloat_FromDouble(atof(number_text_.c_str()));
+    case kIllegalCharValue:
+    case kBadIndentValue:
+      GetErrorMessage(token, &message_text);
+      message = PyString_FromStringAndSize(message_text.data(),
+                                           message_text.size());
+      break;
+    default:
+      PyErr_Format(PyExc_AssertionError, "Unknown token value kind %d.",
+                   token.value_kind);
+      return NULL;
+  }
+  CountValue(true);
+  error_message_ = message;
+  return message;
+}
+
+int Lexer::ScanEndOfInput() {
+  at_eof_ = true;
+  if (CurrentIndentation()) {
+    PopIndentationTo(0);
+  }
+  return PopDedent() ? DEDENT : 0;
+}
+
 bool Lexer::PopDedent() {
   if (pending_dedents_) {
     pending_dedents_--;
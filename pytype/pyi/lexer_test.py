@@ -1,4 +1,6 @@
+import array
 import os
+import random
 import textwrap
 
 from pytype.pyi import parser_ext
@@ -73,9 +75,13 @@ def convert_token(t):
 
 class LexerTest(unittest.TestCase):
 
+  # Passed to tokenize() to select the scanner, None for the default.
+  HANDWRITTEN = None
+
   def check(self, expected, text):
     text = textwrap.dedent(text)
-    actual = map(convert_token, parser_ext.tokenize(text))
+    actual = map(convert_token,
+                 parser_ext.tokenize(text, handwritten=self.HANDWRITTEN))
     if expected is not None:
       self.assertEquals(map(convert_expected, expected), actual)
 
@@ -128,6 +134,24 @@ class LexerTest(unittest.TestCase):
     self.check([0.5], "+.5")
     self.check([-0.5], "-.5")
 
+  def test_longest_match(self):
+    self.check([("NAME", "classes"), ("NAME", "class-x"), "CLASS"],
+               "classes class-x class")
+    self.check([("NAME", "a-"), ">", ("NAME", "b")], "a->b")
+    self.check(["ELLIPSIS", 5], "...5")
+    self.check([1.2, 0.3], "1.2.3")
+    self.check([("LEXERROR", "Illegal character '-'"), "."], "-.")
+    self.check([("LEXERROR", "Illegal character '`'"), ("NAME", "a")], "`a")
+
+  def test_column_after_dedent(self):
+    # The columns of tokens after a dedent are off by one for each DEDENT,
+    # plus one.
+    self.check([("NAME", "a", 1, 1), "INDENT", ("NAME", "b", 2, 3),
+                ("DEDENT", None, 3, 1), ("NAME", "c", 3, 3)], """\
+      a
+        b
+      c""")
+
   def test_line_numbers(self):
     self.check([("NAME", "a", 1), ("NAME", "b", 2)], "a\nb")
 
@@ -267,5 +291,388 @@ class LexerTest(unittest.TestCase):
     self.check(None, text)
 
 
+class HandwrittenLexerTest(LexerTest):
+  """Run the lexer tests with the handwritten scanner."""
+
+  HANDWRITTEN = True
+
+  def test_matches_flex(self):
+    text = textwrap.dedent("""\
+      class A(B[`~c~`]):  # comment
+        \'\'\'doc\'\'\'
+        def f(self, x: int = -1.5, ...) -> ?: ...
+          # type: 1 % 2
+      if sys.version_info >= (3, 0):
+          x = ...  # type: int
+         y
+      """)
+    self.assertEquals(parser_ext.tokenize(text, handwritten=False),
+                      parser_ext.tokenize(text, handwritten=True))
+
+
+class TokenizeColumnsTest(unittest.TestCase):
+
+  def check(self, text):
+    """Check that tokenize_columns() and tokenize() agree on text."""
+    columns = parser_ext.tokenize_columns(text)
+    tokens = parser_ext.tokenize(text)
+    for name in ("kind", "start", "end", "line", "column", "value"):
+      self.assertIsInstance(columns[name], array.array)
+      self.assertEquals("i", columns[name].typecode)
+      self.assertEquals(len(tokens), len(columns[name]))
+    strings = columns["strings"]
+    for i, token in enumerate(tokens):
+      self.assertEquals(token[0], columns["kind"][i])
+      self.assertEquals(token[2:4], (columns["line"][i], columns["column"][i]))
+      value = columns["value"][i]
+      if token[1] is None:
+        self.assertEquals(-1, value)
+      else:
+        self.assertEquals(str(token[1]), strings[value])
+    return columns
+
+  def test_simple(self):
+    text = "def foo(x: int) -> int: ...\n"
+    columns = self.check(text)
+    self.assertEquals(["def", "foo", "(", "x", ":", "int", ")", "->", "int",
+                       ":", "..."],
+                      [text[start:end] for start, end in
+                       zip(columns["start"], columns["end"])])
+
+  def test_strings_are_deduplicated(self):
+    columns = self.check("x y 1 `x` 1 y 2.5 % %")
+    self.assertEquals(["x", "y", "1", "2.5", "Illegal character '%'"],
+                      columns["strings"])
+    self.assertEquals([0, 1, 2, 0, 2, 1, 3, 4, 4], list(columns["value"]))
+
+  def test_indentation_and_triplequoted(self):
+    columns = self.check(textwrap.dedent("""\
+      class A:
+        \'\'\'doc
+        \'\'\'
+        x = 1
+      """))
+    kinds = [TOKEN_NAMES.get(k) for k in columns["kind"]]
+    self.assertEquals(["CLASS", "NAME", None, "INDENT", "TRIPLEQUOTED",
+                       "NAME", None, "NUMBER", "DEDENT"], kinds)
+    # The TRIPLEQUOTED span includes the quotes.
+    self.assertEquals((11, 23), (columns["start"][4], columns["end"][4]))
+
+  def test_line_starts(self):
+    columns = self.check("a\n\n  b\n\"\"\"\nc\n\"\"\" # d\n")
+    self.assertEquals([0, 2, 3, 7, 11, 13, 21], list(columns["line_starts"]))
+    # The starts of the lines agree with the locations of the names.
+    for i, line in enumerate(columns["line"]):
+      if columns["value"][i] != -1:
+        self.assertEquals(
+            columns["line_starts"][line - 1] + columns["column"][i] - 1,
+            columns["start"][i])
+
+  def test_tokenize_line_starts(self):
+    text = "x\ny\n"
+    tokens, line_starts = parser_ext.tokenize(text, line_starts=True)
+    self.assertEquals(parser_ext.tokenize(text), tokens)
+    self.assertEquals(array.array("i", [0, 2, 4]), line_starts)
+
+  def test_buffer_protocol(self):
+    columns = self.check("a b c")
+    kinds = columns["kind"]
+    self.assertEquals(3 * kinds.itemsize, len(buffer(kinds)))
+
+  def test_empty(self):
+    columns = self.check("")
+    self.assertEquals(0, len(columns["kind"]))
+    self.assertEquals([], columns["strings"])
+
+  def test_builtins(self):
+    pytd_dir = os.path.dirname(os.path.dirname(parser_constants.__file__))
+    with open(os.path.join(pytd_dir, "builtins/__builtin__.pytd")) as f:
+      self.check(f.read())
+
+
+class RelexTest(unittest.TestCase):
+
+  def resolve(self, columns):
+    """Return the columns as lists, with values instead of value indexes."""
+    result = {key: list(columns[key]) for key in
+              ("kind", "start", "end", "line", "column", "line_starts",
+               "checkpoints")}
+    result["value"] = [columns["strings"][i] if i >= 0 else None
+                       for i in columns["value"]]
+    return result
+
+  def check(self, old, start, old_end, replacement):
+    """Check relexing an edit to old, and return the number of new tokens."""
+    new = old[:start] + replacement + old[old_end:]
+    columns = parser_ext.relex_columns(
+        new, parser_ext.tokenize_columns(old), start, old_end,
+        start + len(replacement))
+    self.assertEquals(self.resolve(parser_ext.tokenize_columns(new)),
+                      self.resolve(columns))
+    return columns["relexed"]
+
+  def test_edit_is_local(self):
+    src = "".join("def f%d(x: int) -> str: ...\n" % i for i in range(100))
+    start = src.index("f50")
+    # Only the edited line is relexed.
+    self.assertEquals(11, self.check(src, start, start + 3, "g"))
+    # An unclosed bracket is relexed to the end.
+    self.assertGreater(self.check(src, start, start + 3, "g["), 50 * 11)
+
+  def test_edit_beyond_window(self):
+    lines = ["def f%d(x: int) -> str: ...\n" % i for i in range(1000)]
+    lines[600] = "x = 1  # '''\n"
+    src = "".join(lines)
+    start = src.index("def f50(")
+    # The only new token is a string that ends in the comment 550 lines later.
+    self.assertEquals(1, self.check(src, start, start, "'''"))
+    self.assertGreater(self.check(src, start, start, "("), 949 * 11)
+
+  def test_edit_in_class(self):
+    src = textwrap.dedent("""\
+      x = ...  # type: int
+      class A:
+        def f(self) -> int: ...
+        def g(self) -> int: ...
+      y = ...  # type: int
+      z = ...  # type: int
+      """)
+    start = src.index("g(")
+    # The lexer restarts at the class, and rejoins at z (y follows a DEDENT).
+    self.assertEquals(28, self.check(src, start, start + 1, "h"))
+
+  def test_indentation_changes(self):
+    src = "class A:\n  x = ...  # type: int\ny = ...  # type: int\n"
+    self.check(src, src.index("y"), src.index("y"), "  ")
+    self.check(src, src.index("x") - 2, src.index("x"), "")
+
+  def test_brackets(self):
+    src = "x = ...  # type: int\ny = ...  # type: int\nz = 1\n"
+    self.check(src, src.index("int"), src.index("int"), "(\n")
+    self.check(src, src.index("int"), src.index("int"), "[")
+
+  def test_docstring(self):
+    src = "x = 1\ny = 2\nz = 3\n"
+    self.check(src, src.index("y"), src.index("y"), "'''")
+    self.check(src, src.index("y"), src.index("y"), "'''\n'''")
+
+  def test_bad_dedent(self):
+    src = "class A:\n    x = 1\n  y = 2\nz = 3\nw = 4\n"
+    self.check(src, src.index("z"), src.index("z") + 1, "v")
+
+  def test_whole_text(self):
+    src = "x = 1\ny = 2\n"
+    self.check(src, 0, len(src), "")
+    self.check("", 0, 0, src)
+    self.check(src, len(src), len(src), "z = 3\n")
+
+  def test_random_edits(self):
+    pytd_dir = os.path.dirname(os.path.dirname(parser_constants.__file__))
+    with open(os.path.join(pytd_dir, "builtins/__builtin__.pytd")) as f:
+      src = f.read()
+    fragments = ["\n", "  ", "(", ")", "[", "]", "'''", "#", "x", "class A:",
+                 "  pass\n", "$"]
+    rand = random.Random(0)
+    for _ in range(100):
+      start = rand.randrange(len(src))
+      old_end = min(len(src), start + rand.choice([0, 1, 5]))
+      self.check(src, start, old_end, "".join(
+          rand.choice(fragments) for _ in range(rand.randrange(4))))
+
+  def test_invalid_edit(self):
+    columns = parser_ext.tokenize_columns("x = 1\n")
+    self.assertRaises(ValueError, parser_ext.relex_columns, "x = 1\n",
+                      columns, 3, 2, 3)
+    self.assertRaises(ValueError, parser_ext.relex_columns, "x = 1\n",
+                      columns, 0, 0, 10)
+    del columns["checkpoints"]
+    self.assertRaises(KeyError, parser_ext.relex_columns, "x = 1\n",
+                      columns, 0, 0, 0)
+
+
+class InternTest(unittest.TestCase):
+
+  def tearDown(self):
+    parser_ext.set_global_interning(False)
+
+  def names(self, text):
+    return [value for _, value, _, _, _, _ in parser_ext.tokenize(text)]
+
+  def test_repeated_names_are_identical(self):
+    a1, b, a2, a3 = self.names("abc b abc `abc`")
+    self.assertEquals("abc", a1)
+    self.assertIs(a1, a2)
+    self.assertIs(a1, a3)
+    self.assertIs(intern("abc"), a1)
+
+  def test_stats(self):
+    parser_ext.intern_stats(True)
+    self.names("x y x x")
+    stats = parser_ext.intern_stats()
+    self.assertEquals(2, stats["hits"])
+    self.assertEquals(2, stats["misses"])
+    self.assertFalse(stats["global"])
+    # Reset returns the stats before resetting them.
+    self.assertEquals(stats, parser_ext.intern_stats(True))
+    self.assertEquals(0, parser_ext.intern_stats()["hits"])
+
+  def test_per_parse_table(self):
+    parser_ext.intern_stats(True)
+    self.names("unique_name_1")
+    self.names("unique_name_1")
+    self.assertEquals(0, parser_ext.intern_stats()["hits"])
+
+  def test_global_table(self):
+    parser_ext.set_global_interning(True)
+    parser_ext.intern_stats(True)
+    x1, = self.names("unique_name_2")
+    x2, = self.names("unique_name_2")
+    self.assertIs(x1, x2)
+    stats = parser_ext.intern_stats()
+    self.assertEquals(1, stats["hits"])
+    self.assertTrue(stats["global"])
+    self.assertGreaterEqual(stats["global_size"], 1)
+
+  def test_columns_intern_only_names(self):
+    parser_ext.set_global_interning(True)
+    parser_ext.intern_stats(True)
+    columns = parser_ext.tokenize_columns("x = 12345\ny = 12345\n$ $\n")
+    self.assertEquals(["x", "12345", "y", "Illegal character '$'"],
+                      columns["strings"])
+    # Only x and y are looked up.
+    stats = parser_ext.intern_stats()
+    self.assertEquals(0, stats["hits"])
+    self.assertEquals(2, stats["misses"])
+
+
+class LexerStatsTest(unittest.TestCase):
+
+  def setUp(self):
+    parser_ext.set_lexer_stats(True)
+    parser_ext.lexer_stats(True)
+
+  def tearDown(self):
+    parser_ext.set_lexer_stats(False)
+    parser_ext.lexer_stats(True)
+
+  def stats(self, text, handwritten=None):
+    parser_ext.tokenize(text, handwritten=handwritten)
+    return parser_ext.lexer_stats(True)
+
+  def test_stats(self):
+    stats = self.stats(textwrap.dedent("""\
+      class A:
+        \'\'\'doc\'\'\'
+        x = 1  # c
+
+      def f(): ...
+      """))
+    self.assertTrue(stats["enabled"])
+    self.assertEquals({"INITIAL": 34, "NEWLINE": 5, "TRIPLE1": 6,
+                       "COMMENT": 3}, stats["state_bytes"])
+    self.assertEquals({"CLASS": 1, "NAME": 3, ":": 2, "INDENT": 1,
+                       "TRIPLEQUOTED": 1, "=": 1, "NUMBER": 1, "DEDENT": 1,
+                       "DEF": 1, "(": 1, ")": 1, "ELLIPSIS": 1},
+                      stats["tokens"])
+    self.assertEquals(1, stats["indents"])
+    self.assertEquals(1, stats["dedents"])
+    self.assertEquals(1, stats["max_indent_depth"])
+    self.assertEquals(4, stats["values"])
+    self.assertEquals(4, stats["allocations"])
+
+  def test_skipped_text(self):
+    # Text skipped by an action counts as if the rules had matched it.
+    self.assertEquals({"INITIAL": 3, "TRIPLE2": 5},
+                      self.stats('"""ab"""')["state_bytes"])
+    self.assertEquals({"INITIAL": 3, "TRIPLE2": 2},
+                      self.stats('"""ab')["state_bytes"])
+    self.assertEquals({"INITIAL": 3, "COMMENT": 2},
+                      self.stats("a # b")["state_bytes"])
+
+  def test_values(self):
+    stats = self.stats("x x x 1.5 $")
+    self.assertEquals(5, stats["values"])
+    self.assertEquals(3, stats["allocations"])
+
+  def test_indent_depth(self):
+    stats = self.stats("a\n b\n  c\n   d\n e\n")
+    self.assertEquals(3, stats["indents"])
+    self.assertEquals(3, stats["dedents"])
+    self.assertEquals(3, stats["max_indent_depth"])
+
+  def test_backends_agree(self):
+    texts = ["a\n\"\"\"xx\"\"\"\nb", "a\n\'\'\'x\n\'\'\n\'\'\'\'\n  b",
+             "a # x\n#\n  # x\nb #", "def f():\n  x\n\n  \n",
+             "class A:\n  def f(self, x: int) -> str: ...\n    y\n z\n$"]
+    for handwritten in (False, True):
+      for text in texts:
+        parser_ext.tokenize(text, handwritten=handwritten)
+      stats = parser_ext.lexer_stats(True)
+      self.assertEquals(sum(len(text) for text in texts),
+                        sum(stats["state_bytes"].values()))
+      if handwritten:
+        self.assertEquals(expected, stats)
+      expected = stats
+
+  def test_disabled(self):
+    parser_ext.set_lexer_stats(False)
+    stats = self.stats("x = 1")
+    self.assertFalse(stats["enabled"])
+    self.assertEquals({}, stats["state_bytes"])
+    self.assertEquals({}, stats["tokens"])
+    self.assertEquals(0, stats["values"])
+
+
+class FastScanTest(unittest.TestCase):
+  """Test the skipping of docstrings, comments and empty lines."""
+
+  IMPLEMENTATIONS = ("avx2", "sse2", "scalar")
+
+  def setUp(self):
+    self.default = parser_ext.fastscan()
+
+  def tearDown(self):
+    parser_ext.set_fastscan(self.default)
+
+  def texts(self):
+    # Put the interesting characters at every offset relative to the vector
+    # widths, and leave some unterminated.
+    for n in range(70):
+      pad = "x" * n
+      yield "a\n\"\"\"%s\"\"\"\nb" % pad
+      yield "a\n\'\'\'%s\n\'\'\n\'\'\'\'\n  b" % pad
+      yield "\"\"\"%s\n%s\"\"\"\" c" % (pad, pad)
+      yield "\'\'\'%s\'\'" % pad
+      yield "a # %s\n#\n  # %s\nb #" % (pad, pad)
+      yield "a\n%s\nb" % ("\n".join(" " * i for i in range(n)))
+      yield "def f():\n  x\n%s\n  \n" % ("\n" * n)
+
+  def test_default(self):
+    self.assertIn(parser_ext.fastscan(), self.IMPLEMENTATIONS)
+
+  def test_unknown(self):
+    self.assertRaises(ValueError, parser_ext.set_fastscan, "mmx")
+    self.assertEquals(self.default, parser_ext.fastscan())
+
+  def test_docstring_location(self):
+    tokens = parser_ext.tokenize("x\n\"\"\"a\n\nbc\"\"\" y\n")
+    self.assertEquals([(1, 1, 1, 1), (2, 1, 4, 5), (4, 7, 4, 7)],
+                      [token[2:] for token in tokens])
+
+  def test_implementations_agree(self):
+    parser_ext.set_fastscan("scalar")
+    expected = [parser_ext.tokenize(text) for text in self.texts()]
+    for name in self.IMPLEMENTATIONS:
+      try:
+        parser_ext.set_fastscan(name)
+      except ValueError:
+        continue  # Not supported by this CPU.
+      self.assertEquals(name, parser_ext.fastscan())
+      for handwritten in (False, True):
+        self.assertEquals(
+            expected, [parser_ext.tokenize(text, handwritten=handwritten)
+                       for text in self.texts()])
+
+
 if __name__ == "__main__":
   unittest.main()
@@ -0,0 +1,26 @@
+#!/bin/sh
+# Generate the parsers from parser.y with bison (3.x):
+#
+#   parser.tab.cc, parser.tab.h: pytypeparse(), without the lines of
+#       parser.y that end with "// recovering" (the "error" rules).
+#   recovering_parser.tab.cc: pytyperecoverparse(), from all of parser.y,
+#       which includes parser.tab.h rather than a header of its own.
+#
+# The lines are blanked rather than deleted, so that the #line directives
+# of both parsers refer to parser.y.
+
+set -e
+
+cd "$(dirname "$0")/.."
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT
+
+mkdir "$tmp/pyi"
+sed 's|^.*// recovering$||' pyi/parser.y > "$tmp/pyi/parser.y"
+(cd "$tmp" &&
+ bison -p pytype --defines=pyi/parser.tab.h -o pyi/parser.tab.cc pyi/parser.y)
+cp "$tmp/pyi/parser.tab.cc" "$tmp/pyi/parser.tab.h" pyi/
+
+bison -p pytyperecover -Dapi.header.include='{"parser.tab.h"}' \
+    --defines="$tmp/recovering_parser.tab.h" \
+    -o pyi/recovering_parser.tab.cc pyi/parser.y
@@ -0,0 +1,80 @@
+#include "mapped_file.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace pytype {
+
+MappedFile::~MappedFile() {
+  if (data_) {
+    munmap(data_, mapped_size_);
+  }
+}
+
+bool MappedFile::Open(const char* path) {
+  if (data_) {
+    errno = EBUSY;
+    return false;
+  }
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) < 0) {
+    int saved_errno = errno;
+    close(fd);
+    errno = saved_errno;
+    return false;
+  }
+  // The lexer works with int sizes.
+  if (info.st_size > INT_MAX - kSentinelBytes) {
+    close(fd);
+    errno = EFBIG;
+    return false;
+  }
+
+  // Reserve zero filled memory for the file plus the sentinels, then map the
+  // file over the start of it.  The tail of the file's last page is zero
+  // filled by mmap, and if the sentinels spill onto the next page they land
+  // in the reserved anonymous memory.  Either way they read as NUL.
+  size_t length = info.st_size;
+  size_t page_size = sysconf(_SC_PAGESIZE);
+  size_t mapped_size =
+      (length + kSentinelBytes + page_size - 1) / page_size * page_size;
+  void* base = mmap(NULL, mapped_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (base == MAP_FAILED) {
+    int saved_errno = errno;
+    close(fd);
+    errno = saved_errno;
+    return false;
+  }
+  if (length) {
+    void* file_base = mmap(base, length, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_FIXED, fd, 0);
+    if (file_base == MAP_FAILED) {
+      int saved_errno = errno;
+      munmap(base, mapped_size);
+      close(fd);
+      errno = saved_errno;
+      return false;
+    }
+    // The lexer reads the file exactly once from start to end.
+    madvise(base, length, MADV_SEQUENTIAL);
+  }
+  // The mapping holds its own reference to the file.
+  close(fd);
+
+  data_ = static_cast<char*>(base);
+  length_ = static_cast<int>(length);
+  mapped_size_ = mapped_size;
+  return true;
+}
+
+}  // end namespace pytype
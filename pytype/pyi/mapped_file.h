@@ -0,0 +1,46 @@
+#ifndef PYTYPE_PYI_MAPPED_FILE_H_
+#define PYTYPE_PYI_MAPPED_FILE_H_
+
+#include <stddef.h>
+
+namespace pytype {
+
+// A file mapped into memory so that it can be scanned in place.
+//
+// The mapping is private (copy-on-write) and writable, since flex temporarily
+// writes NUL characters into the buffer it is scanning.  The file contents are
+// followed by kSentinelBytes NUL bytes, which flex requires as end-of-buffer
+// markers.  Only pages that are actually written to are copied, thus scanning
+// a mapped file avoids the full copies made when reading a file into a
+// string and then handing it to yy_scan_bytes().
+class MappedFile {
+ public:
+  // The number of NUL bytes following the file contents.
+  static const int kSentinelBytes = 2;
+
+  MappedFile() : data_(NULL), length_(0), mapped_size_(0) {}
+  ~MappedFile();
+
+  // Map the specified file.  Returns true iff successful, otherwise returns
+  // false with errno set.
+  bool Open(const char* path);
+
+  // The start of the mapped file contents (NULL if not open).
+  char* data() const { return data_; }
+
+  // The length of the file, not including the sentinel bytes.
+  int length() const { return length_; }
+
+ private:
+  char* data_;
+  int length_;
+  size_t mapped_size_;
+
+  // Not copyable.
+  MappedFile(const MappedFile&);
+  MappedFile& operator=(const MappedFile&);
+};
+
+}  // end namespace pytype
+
+#endif  // PYTYPE_PYI_MAPPED_FILE_H_
@@ -0,0 +1,402 @@
+#include "node_factory.h"
+
+#include <stdarg.h>
+#include <string.h>
+
+#include <vector>
+
+namespace pytype {
+
+namespace {
+
+// A key of the dict returned by the peer's native_nodes(), the number of
+// fields of the node class it maps to (-1 for other values) and the member
+// that holds the value.
+struct InfoEntry {
+  const char* key;
+  int fields;
+  RefHolder NodeFactory::* member;
+};
+
+PyTypeObject* AsType(PyObject* cls) {
+  return reinterpret_cast<PyTypeObject*>(cls);
+}
+
+// Return a new reference to a node of class cls whose fields are the count
+// objects after count (borrowed references), or NULL if there was an error.
+PyObject* MakeNode(PyObject* cls, int count, ...) {
+  PyObject* node = AsType(cls)->tp_alloc(AsType(cls), count);
+  if (node == NULL) {
+    return NULL;
+  }
+  va_list va;
+  va_start(va, count);
+  for (int i = 0; i < count; i++) {
+    PyObject* field = va_arg(va, PyObject*);
+    Py_INCREF(field);
+    PyTuple_SET_ITEM(node, i, field);
+  }
+  va_end(va);
+  return node;
+}
+
+// Return true if obj is a str equal to s.
+bool StringEquals(PyObject* obj, const char* s) {
+  return PyString_Check(obj) && strcmp(PyString_AS_STRING(obj), s) == 0;
+}
+
+// Return true if obj is a str equal to one of the strings in names, which
+// ends with NULL.
+bool StringIn(PyObject* obj, const char* const* names) {
+  for (; *names; names++) {
+    if (StringEquals(obj, *names)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Names that new_type() rejects without parameters.
+const char* const kNeedParameters[] = {
+  "typing.Union", "typing.Optional", NULL,
+};
+
+// Base types that new_type() doesn't turn into a plain GenericType.
+const char* const kSpecialBases[] = {
+  "typing.Callable", "tuple", "__builtin__.tuple", "Tuple", "typing.Tuple",
+  NULL,
+};
+
+}  // end namespace
+
+bool NodeFactory::Init(PyObject* info, PyObject* ellipsis) {
+  if (info == Py_None) {
+    return true;
+  }
+  if (!PyDict_Check(info)) {
+    PyErr_SetString(PyExc_TypeError, "native_nodes() must return a dict");
+    return false;
+  }
+  static const InfoEntry entries[] = {
+    {"type_map", -1, &NodeFactory::type_map_},
+    {"types", -1, &NodeFactory::type_classes_},
+    {"NamedType", 1, &NodeFactory::named_type_},
+    {"GenericType", 2, &NodeFactory::generic_type_},
+    {"UnionType", 1, &NodeFactory::union_type_},
+    {"AnythingType", 0, &NodeFactory::anything_type_},
+    {"Constant", 2, &NodeFactory::constant_},
+    {"Parameter", 5, &NodeFactory::parameter_},
+    {"Signature", 6, &NodeFactory::signature_},
+    {"NameAndSig", 4, &NodeFactory::name_and_sig_},
+  };
+  for (const InfoEntry& entry : entries) {
+    PyObject* value = PyDict_GetItemString(info, entry.key);
+    if (value == NULL) {
+      PyErr_Format(PyExc_KeyError, "native_nodes() is missing %s", entry.key);
+      return false;
+    }
+    if (entry.fields >= 0) {
+      // The class must be a namedtuple with the expected fields, which
+      // tp_alloc() creates the same way as tuple.__new__() does.
+      PyObject* fields = PyType_Check(value) &&
+          PyType_IsSubtype(AsType(value), &PyTuple_Type) ?
+          PyObject_GetAttrString(value, "_fields") : NULL;
+      bool ok = fields != NULL && PyTuple_Check(fields) &&
+          PyTuple_GET_SIZE(fields) == entry.fields;
+      Py_XDECREF(fields);
+      if (!ok) {
+        PyErr_Format(PyExc_TypeError,
+                     "native_nodes() %s is not a node class with %d fields",
+                     entry.key, entry.fields);
+        return false;
+      }
+    }
+    this->*entry.member = value;
+  }
+  if (!PyDict_Check(type_map_)) {
+    PyErr_SetString(PyExc_TypeError, "native_nodes() type_map is not a dict");
+    return false;
+  }
+  ellipsis_ = ellipsis;
+  PyObject* named_types = PyDict_New();
+  if (named_types == NULL) {
+    return false;
+  }
+  named_types_ = named_types;
+  Py_DECREF(named_types);
+  enabled_ = true;
+  return true;
+}
+
+void NodeFactory::Reset() {
+  enabled_ = false;
+  type_map_ = NULL;
+  ellipsis_ = NULL;
+  named_types_ = NULL;
+}
+
+PyObject* NodeFactory::NamedType(PyObject* name) {
+  PyObject* node = PyDict_GetItem(named_types_, name);
+  if (node != NULL) {
+    Py_INCREF(node);
+    return node;
+  }
+  node = MakeNode(named_type_, 1, name);
+  if (node != NULL && PyDict_SetItem(named_types_, name, node) < 0) {
+    Py_DECREF(node);
+    return NULL;
+  }
+  return node;
+}
+
+PyObject* NodeFactory::NamedType(const char* name) {
+  PyObject* str = PyString_FromString(name);
+  if (str == NULL) {
+    return NULL;
+  }
+  PyObject* node = NamedType(str);
+  Py_DECREF(str);
+  return node;
+}
+
+PyObject* NodeFactory::LookupType(PyObject* name, RefHolder* owned) {
+  PyObject* type = PyDict_GetItem(type_map_, name);
+  if (type != NULL) {
+    return type;
+  }
+  type = NamedType(name);
+  *owned = type;
+  Py_XDECREF(type);
+  return type;
+}
+
+bool NodeFactory::NewType(PyObject* name, PyObject* parameters,
+                          PyObject** result) {
+  if (!enabled_ || !PyString_Check(name)) {
+    return false;
+  }
+  RefHolder owned;
+  PyObject* base = LookupType(name, &owned);
+  if (base == NULL) {
+    *result = NULL;
+    return true;
+  }
+  bool named = PyObject_TypeCheck(base, AsType(named_type_));
+  if (parameters == NULL) {
+    if (named && StringIn(PyTuple_GET_ITEM(base, 0), kNeedParameters)) {
+      return false;
+    }
+    Py_INCREF(base);
+    *result = base;
+    return true;
+  }
+
+  // Only plain generic types, anything else depends on the parameters or
+  // on the module being parsed.
+  if (Py_TYPE(base) != AsType(named_type_) ||
+      StringIn(PyTuple_GET_ITEM(base, 0), kSpecialBases) ||
+      !PyTuple_CheckExact(parameters) || PyTuple_GET_SIZE(parameters) == 0) {
+    return false;
+  }
+  for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(parameters); i++) {
+    if (PyTuple_GET_ITEM(parameters, i) == ellipsis_) {
+      return false;
+    }
+  }
+  // The parser's tuple becomes the node's.
+  *result = MakeNode(generic_type_, 2, base, parameters);
+  return true;
+}
+
+PyObject* NodeFactory::UnionType(PyObject* const* types, int count) {
+  // Flatten, then remove duplicates preserving order.  Unions are small,
+  // thus a linear search is cheaper than the dict pytd uses.
+  std::vector<PyObject*> flattened;
+  for (int i = 0; i < count; i++) {
+    if (PyObject_TypeCheck(types[i], AsType(union_type_))) {
+      PyObject* type_list = PyTuple_GET_ITEM(types[i], 0);
+      for (Py_ssize_t j = 0; j < PyTuple_GET_SIZE(type_list); j++) {
+        flattened.push_back(PyTuple_GET_ITEM(type_list, j));
+      }
+    } else {
+      flattened.push_back(types[i]);
+    }
+  }
+  std::vector<PyObject*> unique;
+  for (PyObject* type : flattened) {
+    bool found = false;
+    for (PyObject* other : unique) {
+      int equal = PyObject_RichCompareBool(other, type, Py_EQ);
+      if (equal < 0) {
+        return NULL;
+      }
+      if (equal) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      unique.push_back(type);
+    }
+  }
+  PyObject* type_list = PyTuple_New(unique.size());
+  if (type_list == NULL) {
+    return NULL;
+  }
+  for (size_t i = 0; i < unique.size(); i++) {
+    Py_INCREF(unique[i]);
+    PyTuple_SET_ITEM(type_list, i, unique[i]);
+  }
+  PyObject* node = MakeNode(union_type_, 1, type_list);
+  Py_DECREF(type_list);
+  return node;
+}
+
+bool NodeFactory::NewUnionType(PyObject* left, PyObject* right,
+                               PyObject** result) {
+  if (!enabled_) {
+    return false;
+  }
+  PyObject* types[] = {left, right};
+  *result = UnionType(types, 2);
+  return true;
+}
+
+bool NodeFactory::NewConstant(PyObject* name, PyObject* value,
+                              PyObject** result) {
+  if (!enabled_) {
+    return false;
+  }
+  RefHolder type;
+  if (PyInt_CheckExact(value) && PyInt_AS_LONG(value) == 0) {
+    PyObject* int_type = NamedType("int");
+    type = int_type;
+    Py_XDECREF(int_type);
+  } else {
+    // Other numbers are errors, leave those to the peer.
+    int is_type = PyObject_IsInstance(value, type_classes_);
+    if (is_type < 0) {
+      *result = NULL;
+      return true;
+    }
+    if (!is_type) {
+      return false;
+    }
+    type = value;
+  }
+  *result = type == NULL ? NULL : MakeNode(constant_, 2, name,
+                                           static_cast<PyObject*>(type));
+  return true;
+}
+
+PyObject* NodeFactory::TypeForDefault(PyObject* value) {
+  if (StringEquals(value, "None")) {
+    return NamedType("NoneType");
+  } else if (PyFloat_Check(value)) {
+    return NamedType("float");
+  } else if (PyInt_Check(value)) {
+    return NamedType("int");
+  } else {
+    // ELLIPSIS or NAMEs other than None are treated as object.
+    return NamedType("object");
+  }
+}
+
+PyObject* NodeFactory::Parameter(PyObject* param) {
+  PyObject* name = PyTuple_GET_ITEM(param, 0);
+  PyObject* type = PyTuple_GET_ITEM(param, 1);
+  PyObject* default_value = PyTuple_GET_ITEM(param, 2);
+  RefHolder param_type;
+  if (default_value != Py_None) {
+    PyObject* default_type = TypeForDefault(default_value);
+    if (default_type == NULL) {
+      return NULL;
+    }
+    if (type == Py_None) {
+      param_type = default_type;
+    } else if (StringEquals(PyTuple_GET_ITEM(default_type, 0), "NoneType")) {
+      PyObject* types[] = {type, default_type};
+      PyObject* union_type = UnionType(types, 2);
+      param_type = union_type;
+      Py_XDECREF(union_type);
+    } else {
+      param_type = type;
+    }
+    Py_DECREF(default_type);
+  } else if (type == Py_None) {
+    PyObject* object_type = NamedType("object");
+    param_type = object_type;
+    Py_XDECREF(object_type);
+  } else {
+    param_type = type;
+  }
+  if (param_type == NULL) {
+    return NULL;
+  }
+  PyObject* optional = default_value == Py_None ? Py_False : Py_True;
+  return MakeNode(parameter_, 5, name, static_cast<PyObject*>(param_type),
+                  Py_False, optional, Py_None);
+}
+
+bool NodeFactory::NewFunction(PyObject* decorators, PyObject* name,
+                              PyObject* params, PyObject* return_type,
+                              PyObject* raises, PyObject* body,
+                              PyObject** result) {
+  if (!enabled_ || !PyTuple_Check(decorators) ||
+      PyTuple_GET_SIZE(decorators) || !PyTuple_Check(body) ||
+      PyTuple_GET_SIZE(body) || !PyTuple_Check(params) ||
+      !PyTuple_CheckExact(raises)) {
+    return false;
+  }
+  // Special parameters are validated by the peer.
+  Py_ssize_t count = PyTuple_GET_SIZE(params);
+  for (Py_ssize_t i = 0; i < count; i++) {
+    PyObject* param = PyTuple_GET_ITEM(params, i);
+    if (!PyTuple_CheckExact(param) || PyTuple_GET_SIZE(param) != 3 ||
+        !PyString_Check(PyTuple_GET_ITEM(param, 0)) ||
+        PyString_AS_STRING(PyTuple_GET_ITEM(param, 0))[0] == '*') {
+      return false;
+    }
+  }
+
+  *result = NULL;
+  RefHolder param_nodes;
+  {
+    PyObject* tuple = PyTuple_New(count);
+    if (tuple == NULL) {
+      return true;
+    }
+    param_nodes = tuple;
+    Py_DECREF(tuple);
+  }
+  for (Py_ssize_t i = 0; i < count; i++) {
+    PyObject* param = Parameter(PyTuple_GET_ITEM(params, i));
+    if (param == NULL) {
+      return true;
+    }
+    PyTuple_SET_ITEM(static_cast<PyObject*>(param_nodes), i, param);
+  }
+
+  RefHolder ret = return_type;
+  if (StringEquals(name, "__init__") &&
+      PyObject_TypeCheck(return_type, AsType(anything_type_))) {
+    PyObject* none_type = NamedType("NoneType");
+    if (none_type == NULL) {
+      return true;
+    }
+    ret = none_type;
+    Py_DECREF(none_type);
+  }
+  PyObject* empty = PyTuple_New(0);
+  PyObject* signature = empty == NULL ? NULL : MakeNode(
+      signature_, 6, static_cast<PyObject*>(param_nodes), Py_None, Py_None,
+      static_cast<PyObject*>(ret), raises, empty);
+  if (signature != NULL) {
+    *result = MakeNode(name_and_sig_, 4, name, signature, empty, Py_False);
+    Py_DECREF(signature);
+  }
+  Py_XDECREF(empty);
+  return true;
+}
+
+}  // end namespace pytype
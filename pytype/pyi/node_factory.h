@@ -0,0 +1,108 @@
+#ifndef PYTYPE_PYI_NODE_FACTORY_H_
+#define PYTYPE_PYI_NODE_FACTORY_H_
+
+#include <Python.h>
+
+#include "refholder.h"
+
+namespace pytype {
+
+// Builds common pytd nodes directly in C++ rather than by calling the
+// peer's methods.  The nodes are instances of the pytd classes, which are
+// tuple subclasses without instance dicts, so they are allocated and filled
+// in the same way tuple.__new__ does (but without running the precondition
+// checks in pytd's node.Node.__init__).
+//
+// Only the cases that need no state beyond the peer's type map are handled.
+// A New* method returns false to decline a node, in which case the caller
+// must have the peer build it: e.g. for types that need special handling
+// (typing.Union, tuples, Callable, ...), functions with decorators, bodies
+// or special parameters, and anything that the peer would reject with an
+// error.  If it returns true, *result is a new reference to the node, or
+// NULL if there was an error.
+class NodeFactory {
+ public:
+  NodeFactory() : enabled_(false) {}
+
+  // Initialize from the dict returned by the peer's native_nodes() method.
+  // A dict of None leaves the factory disabled.  Returns false if there was
+  // an error.
+  bool Init(PyObject* info, PyObject* ellipsis);
+
+  // Disable the factory, releasing what Init() was given, so that it can be
+  // initialized again.
+  void Reset();
+
+  // Whether Init() enabled the factory.  A disabled factory declines all
+  // nodes.
+  bool enabled() const { return enabled_; }
+
+  // See the peer's new_type().  parameters is a tuple, or NULL if there are
+  // none.
+  bool NewType(PyObject* name, PyObject* parameters, PyObject** result);
+
+  // See the peer's new_union_type(), for a union of two types.
+  bool NewUnionType(PyObject* left, PyObject* right, PyObject** result);
+
+  // See the peer's new_constant().
+  bool NewConstant(PyObject* name, PyObject* value, PyObject** result);
+
+  // See the peer's new_function().
+  bool NewFunction(PyObject* decorators, PyObject* name, PyObject* params,
+                   PyObject* return_type, PyObject* raises, PyObject* body,
+                   PyObject** result);
+
+ private:
+  bool enabled_;
+
+  // The peer's map of names to the types they stand for and its ELLIPSIS
+  // value.
+  RefHolder type_map_;
+  RefHolder ellipsis_;
+
+  // The tuple of pytd type classes, for isinstance() checks.
+  RefHolder type_classes_;
+
+  // The node classes.
+  RefHolder named_type_;
+  RefHolder generic_type_;
+  RefHolder union_type_;
+  RefHolder anything_type_;
+  RefHolder constant_;
+  RefHolder parameter_;
+  RefHolder signature_;
+  RefHolder name_and_sig_;
+
+  // NamedType nodes by name.  The nodes are immutable, so one is shared by
+  // all occurrences of a name.
+  RefHolder named_types_;
+
+  // Return a new reference to the NamedType for name, or NULL if there was
+  // an error.
+  PyObject* NamedType(PyObject* name);
+  PyObject* NamedType(const char* name);
+
+  // Return a borrowed reference to the type name stands for (a new
+  // reference in *owned if it had to be created), or NULL if there was an
+  // error.
+  PyObject* LookupType(PyObject* name, RefHolder* owned);
+
+  // Return a new reference to a UnionType of the types in the first count
+  // items of types, flattening nested unions and dropping duplicates.
+  PyObject* UnionType(PyObject* const* types, int count);
+
+  // Return a new reference to the type for a parameter's default value.
+  PyObject* TypeForDefault(PyObject* value);
+
+  // Return a new reference to a Parameter for a (name, type, default) tuple
+  // without a "*" or "**" name, or NULL if there was an error.
+  PyObject* Parameter(PyObject* param);
+
+  // Not copyable.
+  NodeFactory(const NodeFactory&);
+  NodeFactory& operator=(const NodeFactory&);
+};
+
+}  // end namespace pytype
+
+#endif  // PYTYPE_PYI_NODE_FACTORY_H_
@@ -0,0 +1,179 @@
+"""A cache of parsed ASTs, keyed by the source and the parse options.
+
+The cache holds the most recently used ASTs in memory, and can also store
+every AST it is given in a directory, so that later processes find them
+there instead of parsing the source again.  The ASTs are shared by everyone
+who looks them up, which is safe since pytd nodes are immutable.
+"""
+
+import collections
+import cPickle
+import errno
+import hashlib
+import os
+import sys
+import tempfile
+
+from pytype import metrics
+
+
+_counts = metrics.MapCounter("parse_cache")
+
+# The number of bytes of a source file that make_file_key() reads at a time.
+_CHUNK_SIZE = 1 << 16
+
+
+class ParseCache(object):
+  """A least recently used cache of ASTs, optionally backed by a directory."""
+
+  def __init__(self, max_entries=256, directory=None):
+    """Initialize the cache.
+
+    Args:
+      max_entries: The number of ASTs to keep in memory.
+      directory: A directory to store ASTs in (created if need be), or None
+        to only keep them in memory.
+    """
+    self._max_entries = max_entries
+    self._directory = directory
+    self._entries = collections.OrderedDict()
+    self._counts = collections.Counter()
+
+  @staticmethod
+  def make_key(src, version, options):
+    """Return the key for a source.
+
+    Args:
+      src: The source text.
+      version: A string that changes whenever the parser (or anything else
+        that shapes the AST) does.
+      options: A tuple of the other inputs of the parse, e.g. the python
+        version, which must have stable reprs.
+
+    Returns:
+      The key, a hex str.
+    """
+    h = ParseCache._start_key(version, options)
+    h.update(src)
+    return h.hexdigest()
+
+  @staticmethod
+  def make_file_key(filename, version, options):
+    """Return the key for a source file.
+
+    This is make_key() of the file's contents, but the file is hashed in
+    chunks rather than read into a string.
+
+    Args:
+      filename: The path of the source file.
+      version: As for make_key().
+      options: As for make_key().
+
+    Returns:
+      The key, a hex str.
+
+    Raises:
+      IOError: If the file can't be read.
+    """
+    h = ParseCache._start_key(version, options)
+    with open(filename, "rb") as f:
+      for chunk in iter(lambda: f.read(_CHUNK_SIZE), ""):
+        h.update(chunk)
+    return h.hexdigest()
+
+  @staticmethod
+  def _start_key(version, options):
+    """Return a hash of the parts of a key other than the source."""
+    h = hashlib.md5()
+    h.update("%s\0%r\0" % (version, options))
+    return h
+
+  def get(self, key):
+    """Return the AST for a key, or None if there is none."""
+    ast = self._entries.pop(key, None)
+    if ast is not None:
+      self._entries[key] = ast
+      self._inc("hits")
+      return ast
+    if self._directory:
+      ast = self._load(key)
+      if ast is not None:
+        self._inc("disk_hits")
+        self._add(key, ast)
+        return ast
+    self._inc("misses")
+    return None
+
+  def put(self, key, ast):
+    """Add the AST for a key."""
+    self._add(key, ast)
+    if self._directory:
+      self._store(key, ast)
+
+  def clear(self):
+    """Drop the ASTs held in memory (but not those in the directory)."""
+    self._entries.clear()
+
+  def stats(self):
+    """Return a dict of the counts of lookups and evictions.
+
+    The keys are "hits" (found in memory), "disk_hits", "misses",
+    "evictions" (from memory) and "disk_writes".
+    """
+    return {key: self._counts[key] for key in
+            ("hits", "disk_hits", "misses", "evictions", "disk_writes")}
+
+  def __len__(self):
+    return len(self._entries)
+
+  def _inc(self, key):
+    self._counts[key] += 1
+    _counts.inc(key)
+
+  def _add(self, key, ast):
+    self._entries.pop(key, None)
+    self._entries[key] = ast
+    while len(self._entries) > self._max_entries:
+      self._entries.popitem(last=False)
+      self._inc("evictions")
+
+  def _path(self, key):
+    return os.path.join(self._directory, key + ".pickle")
+
+  def _load(self, key):
+    """Return the AST stored for a key, or None."""
+    try:
+      with open(self._path(key), "rb") as f:
+        return cPickle.load(f)
+    except Exception:  # pylint: disable=broad-except
+      # A missing file, or a corrupt one (files are never seen while they are
+      # being written, see _store()), which will be overwritten.
+      return None
+
+  def _store(self, key, ast):
+    """Write an AST to the directory.  Failures are ignored."""
+    try:
+      os.makedirs(self._directory)
+    except OSError as e:
+      if e.errno != errno.EEXIST:
+        return
+    # Write to a temporary file, then rename it, so that other processes
+    # never see a partial file.
+    try:
+      fd, tmp_path = tempfile.mkstemp(dir=self._directory, suffix=".tmp")
+    except OSError:
+      return
+    # See pytype.pytd.parse.builtins.Precompile().
+    old_limit = sys.getrecursionlimit()
+    sys.setrecursionlimit(20000)
+    try:
+      with os.fdopen(fd, "wb") as f:
+        cPickle.dump(ast, f, protocol=2)
+      os.rename(tmp_path, self._path(key))
+    except (IOError, OSError, cPickle.PicklingError):
+      if os.path.exists(tmp_path):
+        os.unlink(tmp_path)
+      return
+    finally:
+      sys.setrecursionlimit(old_limit)
+    self._inc("disk_writes")
@@ -0,0 +1,126 @@
+import os
+
+from pytype import utils
+from pytype.pyi import parse_cache
+from pytype.pyi import parser
+
+import unittest
+
+
+class ParseCacheTest(unittest.TestCase):
+
+  def test_key(self):
+    key = parse_cache.ParseCache.make_key("x = ...  # type: int", "1", ())
+    self.assertEqual(key, parse_cache.ParseCache.make_key(
+        "x = ...  # type: int", "1", ()))
+    self.assertNotEqual(key, parse_cache.ParseCache.make_key(
+        "x = ...  # type: str", "1", ()))
+    self.assertNotEqual(key, parse_cache.ParseCache.make_key(
+        "x = ...  # type: int", "2", ()))
+    self.assertNotEqual(key, parse_cache.ParseCache.make_key(
+        "x = ...  # type: int", "1", ("foo",)))
+
+  def test_file_key(self):
+    with utils.Tempdir() as d:
+      filename = d.create_file("foo.pyi", "x = ...  # type: int")
+      self.assertEqual(
+          parse_cache.ParseCache.make_key("x = ...  # type: int", "1", ()),
+          parse_cache.ParseCache.make_file_key(filename, "1", ()))
+
+  def test_eviction(self):
+    cache = parse_cache.ParseCache(max_entries=2)
+    cache.put("a", 1)
+    cache.put("b", 2)
+    self.assertEqual(1, cache.get("a"))
+    cache.put("c", 3)  # Evicts "b", the least recently used.
+    self.assertEqual(2, len(cache))
+    self.assertIsNone(cache.get("b"))
+    self.assertEqual(1, cache.get("a"))
+    self.assertEqual(3, cache.get("c"))
+    self.assertEqual({"hits": 3, "disk_hits": 0, "misses": 1,
+                      "evictions": 1, "disk_writes": 0}, cache.stats())
+    cache.clear()
+    self.assertEqual(0, len(cache))
+    self.assertIsNone(cache.get("a"))
+
+  def test_directory(self):
+    with utils.Tempdir() as d:
+      directory = os.path.join(d.path, "cache")
+      cache = parse_cache.ParseCache(directory=directory)
+      cache.put("a", ("foo", 42))
+      self.assertEqual(["a.pickle"], os.listdir(directory))
+      cache = parse_cache.ParseCache(directory=directory)
+      self.assertEqual(("foo", 42), cache.get("a"))
+      self.assertEqual(("foo", 42), cache.get("a"))
+      self.assertIsNone(cache.get("b"))
+      self.assertEqual({"hits": 1, "disk_hits": 1, "misses": 1,
+                        "evictions": 0, "disk_writes": 0}, cache.stats())
+
+  def test_corrupt_file(self):
+    with utils.Tempdir() as d:
+      d.create_file("a.pickle", "not a pickle")
+      cache = parse_cache.ParseCache(directory=d.path)
+      self.assertIsNone(cache.get("a"))
+      cache.put("a", 42)
+      self.assertEqual(42, parse_cache.ParseCache(directory=d.path).get("a"))
+
+
+class ParserCacheTest(unittest.TestCase):
+  """Test parsing through a cache."""
+
+  def setUp(self):
+    self.cache = parse_cache.ParseCache()
+    self.old_cache = parser.set_parse_cache(self.cache)
+
+  def tearDown(self):
+    parser.set_parse_cache(self.old_cache)
+
+  def test_hit(self):
+    src = "def f(x: int) -> str: ..."
+    ast = parser.parse_string(src, name="foo")
+    self.assertIs(ast, parser.parse_string(src, name="foo"))
+    self.assertEqual(1, self.cache.stats()["hits"])
+    parser.set_parse_cache(None)
+    self.assertTrue(ast.ASTeq(parser.parse_string(src, name="foo")))
+
+  def test_options(self):
+    src = "x = ...  # type: int"
+    ast = parser.parse_string(src, name="foo")
+    self.assertIsNot(ast, parser.parse_string(src, name="bar"))
+    self.assertIsNot(ast, parser.parse_string(src, name="foo",
+                                              python_version=(3, 6)))
+    self.assertIsNot(ast, parser.parse_string(src, name="foo",
+                                              platform="win32"))
+    # The default version and platform are the same as no version.
+    self.assertIs(ast, parser.parse_string(src, name="foo",
+                                           python_version=(2, 7, 6),
+                                           platform="linux"))
+
+  def test_file(self):
+    with utils.Tempdir() as d:
+      filename = d.create_file("foo.pyi", "x = ...  # type: int")
+      ast = parser.parse_file(filename, name="foo")
+      self.assertIs(ast, parser.parse_string("x = ...  # type: int",
+                                             name="foo"))
+
+  def test_file_parsed_in_place(self):
+    with utils.Tempdir() as d:
+      filename = d.create_file("foo.pyi", "x = ...  # type: int")
+      # A miss parses the file rather than its contents as a string.
+      parse = parser._Parser.parse
+      parser._Parser.parse = None
+      try:
+        ast = parser.parse_file(filename, name="foo")
+      finally:
+        parser._Parser.parse = parse
+      self.assertIs(ast, parser.parse_file(filename, name="foo"))
+      self.assertEqual(1, self.cache.stats()["hits"])
+
+  def test_errors_not_cached(self):
+    for _ in range(2):
+      self.assertRaises(parser.ParseError, parser.parse_string, "x = (")
+    self.assertEqual(0, len(self.cache))
+
+
+if __name__ == "__main__":
+  unittest.main()
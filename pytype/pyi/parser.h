@@ -1,11 +1,22 @@
 #ifndef PYTYPE_PYI_PARSER_H_
 #define PYTYPE_PYI_PARSER_H_
 
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <Python.h>
 
+#include "conditions.h"
+#include "ir.h"
 #include "lexer.h"
+#include "node_factory.h"
 #include "refholder.h"
+#include "type_memo.h"
 
 namespace pytype {
 
@@ -45,41 +56,447 @@ enum CallSelector {
 };
 
 
+// Counts of what the parser did while Context::collect_stats() was enabled:
+// the reductions of each grammar rule, and the calls of each peer method
+// with the wall time spent in them (which includes any Python code that the
+// method calls, e.g. the _merge_signatures() of add_class()).
+struct ParseStats {
+  // Reductions by the name of the nonterminal that the rule reduces to.
+  // The names are those in a parser's tables, thus each parser has its
+  // own pointers.
+  std::unordered_map<const char*, long> reductions;
+  // Calls of the peer's methods and their seconds, by CallSelector.  Nodes
+  // and conditions built natively aren't calls.
+  long calls[kCallSelectorCount];
+  double call_seconds[kCallSelectorCount];
+
+  ParseStats() { Reset(); }
+  void Reset();
+  // Add other's counts to these.
+  void Merge(const ParseStats& other);
+};
+
+
+// A list of values being built by the parser's actions, see
+// Context::List().  A spread item stands for the items of a sequence value
+// rather than for the value itself.
+struct HandleList {
+  std::vector<Handle> items;
+  // The indexes of the spread items, in increasing order.
+  std::vector<int> spreads;
+};
+
+
 // A context manages interaction with the python side of the parser (referred
 // to as the "peer").
+//
+// The parser's actions build values through the Context, which either
+// builds Python objects directly (the default), or emits IR (see ir.h) that
+// Decode() later turns into the same objects.  Emitting IR does not require
+// the GIL, so it doesn't require a peer either.
 class Context {
  public:
-  Context() : initialized_(false), result_(Py_None) {}
+  Context() : initialized_(false), result_(Py_None), ir_(NULL),
+              lex_error_(-1), skip_state_(kNotSkipping), skip_depth_(0),
+              resyncing_(false), resync_depth_(0), last_kind_(-1),
+              last_starts_line_(false), last_line_(0), bracket_depth_(0),
+              stats_(collect_stats_ ? new ParseStats : NULL) {}
+
+  // A Context that emits IR to ir, which must outlive it.  It can be created
+  // and used without the GIL.
+  explicit Context(IrWriter* ir) : initialized_(false), ir_(ir),
+                                   lex_error_(-1), skip_state_(kNotSkipping),
+                                   skip_depth_(0), resyncing_(false),
+                                   resync_depth_(0), last_kind_(-1),
+                                   last_starts_line_(false), last_line_(0),
+                                   bracket_depth_(0),
+                                   stats_(collect_stats_ ? new ParseStats
+                                          : NULL) {}
+
+  ~Context() { MergeStats(); }
 
   // Returns true iff initialization was successful.
   bool Init(PyObject* peer);
 
-  // Returns a new reference to the selected value.
-  PyObject* Value(ValueSelector selector) const;
+  // Initialize a Context for reuse by parses with different peers, which
+  // are all instances of peer_class (a new-style class): the selector tables
+  // are looked up on the class, once, and Bind() then supplies the peer for
+  // each parse.  The peers may override the class's methods in their
+  // instance dicts, but not its values.  Returns true iff initialization was
+  // successful.
+  bool InitClass(PyObject* peer_class);
+
+  // Prepare a Context initialized by InitClass() for parsing with peer,
+  // whose type must be the class.  Returns false if there was an error.
+  bool Bind(PyObject* peer);
+
+  // Release the state of the last parse, including the peer, keeping the
+  // selector tables and the storage of lists for the next one.
+  void Reset();
 
-  // Call the corresponding method in the peer building the arguments from
-  // the specified format and additional args.
-  PyObject* Call(CallSelector selector, const char* fmt, ...) const;
+  // Recover from errors instead of failing the parse: append each syntax
+  // error, and each PARSE_ERROR raised by the peer, to errors (a list) as a
+  // (location, message) tuple, where location is as passed to the peer's
+  // set_error_location(), then skip to the next statement.  The result is
+  // the definitions that could be parsed.  Conditions are evaluated by the
+  // peer, so that the clauses of inactive conditions are checked too.  Must
+  // be called after Init().  Returns false if there was an error.
+  bool EnableRecovery(PyObject* errors);
+  bool recovering() const { return errors_ != NULL; }
+
+  // Whether Contexts count reductions and peer calls.  This only affects
+  // Contexts created, and parses bound by Bind(), afterwards.  A Context
+  // adds its counts to the totals when it is destroyed or reset, which
+  // doesn't require the GIL.
+  static bool collect_stats() { return collect_stats_; }
+  static void set_collect_stats(bool enabled) { collect_stats_ = enabled; }
+
+  // Copy the totals to stats, and reset them if reset is true.
+  static void TotalStats(ParseStats* stats, bool reset);
+
+  // Called by the parser for each reduction of a rule, with the name of
+  // its nonterminal.
+  void CountReduction(const char* symbol) {
+    if (stats_) {
+      stats_->reductions[symbol]++;
+    }
+  }
+
+  // Call the corresponding method in the peer with count arguments,
+  // consuming the references to them.  Arguments may be NULL if creating
+  // them failed, in which case the method isn't called and NULL is returned.
+  PyObject* Call(CallSelector selector, int count, PyObject** args);
+
+  // Perform the operations recorded in IR, calling the peer.  Returns a new
+  // reference to the result of the parse, or NULL if there was an error.
+  PyObject* Decode(const IrReader& ir);
 
   // Call the peer's kSetErrorLocation method.
-  void SetErrorLocation(YYLTYPE* loc) const;
+  void SetErrorLocation(const IrLocation& location);
 
   // Get the result object (a borrowed reference).
   PyObject* GetResult() const { return result_; }
 
-  // Set the result object, consuming the reference.
-  void SetAndDelResult(PyObject* result) {
-    result_ = result;
-    Py_XDECREF(result);
+  // The following are called by the parser, and work in either mode.  They
+  // consume the values they are passed, and return a new value, or NULL if
+  // there was an error.
+
+  // Get the next token from the lexer, setting its value and location.
+  // Returns the token code.
+  int NextToken(Lexer* lexer, YYSTYPE* lval, YYLTYPE* lloc);
+
+  // Return whether a value is not NULL, setting the error location to loc
+  // if it is.  The location is recorded in the IR, in case the operation
+  // that produced the value fails when the IR is decoded.
+  bool Check(Handle value, YYLTYPE* loc, Lexer* lexer);
+
+  // Report a syntax error at loc.  The message of the last LEXERROR token,
+  // if any, takes precedence over the parser's.
+  void SyntaxError(YYLTYPE* loc, Lexer* lexer, const char* message);
+
+  // Called by the parser's error rules: returns whether to continue after
+  // an error, which is only the case when recovering from errors, and the
+  // error was one that is recovered from.
+  bool Recover();
+
+  // Release the value of an "if" statement's nonterminal that the parser
+  // discards, ending the peer's condition scope for the statement when
+  // recovering from errors.
+  void DropCondition(Handle value);
+  void DropCondition(HandleList* clauses);
+
+  // Set the result of the parse.
+  void SetResult(Handle result);
+
+  // Return the selected value.
+  Handle Value(ValueSelector selector);
+  Handle None();
+  Handle String(const char* text);
+
+  // Return a second reference to a value, which isn't consumed.
+  Handle Dup(Handle value);
+
+  // Release a value, which may be NULL.
+  void Drop(Handle value);
+
+  // Return a new empty list, or a list of one item.  Lists are built in
+  // storage owned by the Context, which is reused, and only become a value
+  // (a tuple) once they are complete, see Sequence().
+  HandleList* List();
+  HandleList* StartList(Handle item);
+  // Return list with item appended.
+  HandleList* AppendList(HandleList* list, Handle item);
+  // Return list extended by the items of a sequence value.
+  HandleList* ExtendList(HandleList* list, Handle items);
+
+  // Return a tuple of the items of list, which is consumed.
+  Handle Sequence(HandleList* list);
+
+  // Release a list, which may be NULL, and its items.
+  void DropList(HandleList* list);
+
+  template <typename... Args>
+  Handle Tuple(Args... items) {
+    Handle array[] = {items...};
+    return Build(kIrTuple, sizeof...(items), array);
+  }
+
+  // Return the string for a name, interned by the lexer's table.
+  Handle Name(const NameSpan& name, Lexer* lexer);
+
+  // Return the names joined by a dot.  That is usually the text of the
+  // input from the start of left to the end of right, in which case nothing
+  // is copied.
+  NameSpan JoinDotted(const NameSpan& left, const NameSpan& right);
+
+  // Return name with a prefix.
+  NameSpan Prefix(const char* prefix, const NameSpan& name);
+
+  // Typed entry points for calling the peer's methods.
+  Handle AddImport(Handle from_package, Handle import_list) {
+    return CallPeer(kAddImport, from_package, import_list);
+  }
+  Handle AddAliasOrConstant(Handle name, Handle value) {
+    return CallPeer(kAddAliasOrConstant, name, value);
+  }
+  Handle NewExternalFunction(Handle decorators, Handle name) {
+    return CallPeer(kNewExternalFunction, decorators, name);
+  }
+  Handle NewNamedTuple(Handle base_name, Handle fields) {
+    return CallPeer(kNewNamedTuple, base_name, fields);
+  }
+  Handle RegisterClassName(Handle class_name) {
+    return CallPeer(kRegisterClassName, class_name);
+  }
+  Handle AddClass(Handle class_name, Handle parent_args, Handle defs) {
+    return CallPeer(kAddClass, class_name, parent_args, defs);
+  }
+  Handle AddTypeVar(Handle name, Handle param_list) {
+    return CallPeer(kAddTypeVar, name, param_list);
+  }
+  Handle IfBegin(Handle condition) { return CallPeer(kIfBegin, condition); }
+  Handle IfElif(Handle condition) { return CallPeer(kIfElif, condition); }
+  Handle IfElse() { return CallHandles(kIfElse, 0, NULL); }
+  Handle IfEnd(Handle clauses) { return CallPeer(kIfEnd, clauses); }
+
+  // Build nodes like the corresponding peer methods.  The nodes are built
+  // natively if the peer enabled that (see NodeFactory), otherwise by
+  // calling the peer.  parameters may be NULL if the type has none.
+  Handle NewType(Handle name, Handle parameters) {
+    return CallHandles(kNewType, parameters ? 2 : 1, name, parameters);
+  }
+  Handle NewUnionType(Handle left, Handle right) {
+    return CallPeer(kNewUnionType, left, right);
+  }
+  Handle NewConstant(Handle name, Handle value) {
+    return CallPeer(kNewConstant, name, value);
+  }
+  Handle NewFunction(Handle decorators, Handle name, Handle params,
+                     Handle return_type, Handle raises, Handle body) {
+    return CallPeer(kNewFunction, decorators, name, params, return_type,
+                    raises, body);
   }
 
  private:
+  // A peer method.  Bound methods are split into their function and self,
+  // so that calls pass a single argument tuple (starting with self) straight
+  // to the function instead of having the method copy it into a new one.
+  // The tuple is kept for the next call, unless the function kept a
+  // reference to it.  Between calls its items are NULL, thus it is hidden
+  // from the garbage collector.
+  struct Method {
+    RefHolder function;
+    RefHolder self;  // NULL if the method isn't bound.
+    RefHolder args;  // NULL until the first call.
+    // Whether self is the peer supplied by Bind() (see InitClass()).
+    bool bind_peer;
+    // Whether Bind() found the method in the peer's instance dict.
+    bool overridden;
+    // The method's name, set by InitClass().
+    RefHolder name;
+
+    Method() : bind_peer(false), overridden(false) {}
+  };
+
   bool initialized_;
+  // The class passed to InitClass(), else NULL.
+  RefHolder peer_class_;
   RefHolder values_[kValueSelectorCount];
   RefHolder callables_[kCallSelectorCount];
+  Method methods_[kCallSelectorCount];
   RefHolder result_;
+  NodeFactory nodes_;
+  Conditions conditions_;
+  TypeMemo types_;
+
+  // The IR being emitted, NULL when building objects.
+  IrWriter* ir_;
+  // The string index of the message of the last LEXERROR token, -1 if
+  // there wasn't one.
+  int lex_error_;
+
+  // The text of the NameSpans that aren't in the lexer's input: names
+  // built by JoinDotted() and Prefix(), and the names read by a streaming
+  // lexer.  Each spelling is stored once, so this is bounded by the number
+  // of distinct names.
+  std::unordered_set<std::string> names_;
+  // Reused for lookups in names_.
+  std::string name_key_;
+
+  // Skipping the clause of an inactive condition: pending until the
+  // clause's INDENT is read, then skipping tokens until the matching
+  // DEDENT, with skip_depth_ counting the nested INDENTs.
+  enum SkipState { kNotSkipping, kSkipPending, kSkipping };
+  SkipState skip_state_;
+  int skip_depth_;
+
+  // The list errors are appended to when recovering from them, else NULL.
+  RefHolder errors_;
+  // Skipping tokens after an error, with resync_depth_ counting the INDENTs
+  // of the blocks being skipped.
+  bool resyncing_;
+  int resync_depth_;
+  // When recovering from errors: the kind and location of the last token
+  // returned and whether it started a line, the last line of the last token
+  // other than an INDENT or DEDENT, and the bracket nesting depth (tracked
+  // like Lexer::bracket_count_, which is the final count if the input was
+  // tokenized beforehand).
+  int last_kind_;
+  YYLTYPE last_location_;
+  bool last_starts_line_;
+  int last_line_;
+  int bracket_depth_;
+
+  // The counts of this Context if it collects them, else NULL.
+  std::unique_ptr<ParseStats> stats_;
+  static std::atomic<bool> collect_stats_;
+  // The counts of the Contexts that have finished, which may be merged
+  // from several threads.
+  static ParseStats total_stats_;
+  static std::mutex total_stats_mutex_;
+
+  // Add stats_ to the totals and restart them from zero.
+  void MergeStats();
+
+  // Look up the selector tables on owner, the peer or its class.
+  bool InitTables(PyObject* owner);
+
+  // Set a method from the callable found for it on the peer or its class.
+  void SetMethod(Method* method, PyObject* callable);
+
+  // Initialize the native construction of nodes and evaluation of
+  // conditions for peer.
+  bool InitNative(PyObject* peer);
+
+  // Return a NameSpan for the text in name_key_, stored in names_.
+  NameSpan StoreName();
+
+  // The storage of lists, which lasts until the end of the parse, and the
+  // lists that are free for reuse.
+  std::deque<HandleList> lists_;
+  std::vector<HandleList*> free_lists_;
+
+  // Scratch space for Build() and Sequence().
+  std::vector<int> ids_;
+  std::vector<PyObject*> objects_;
+  std::vector<Handle> parts_;
+
+  // Clear a list, whose items have been consumed, for reuse.
+  void FreeList(HandleList* list);
+
+  // Build a tuple (op is kIrTuple) of count items, or a tuple of the items
+  // of count sequences (op is kIrConcat).
+  Handle Build(IrOp op, int count, Handle* items);
+
+  // Call a peer method, or build the node it would build.  See CallObjects()
+  // for the arguments, which includes the special cases.
+  Handle CallHandles(CallSelector selector, int count, Handle* args);
+  Handle CallHandles(CallSelector selector, int count, Handle arg1,
+                     Handle arg2) {
+    Handle array[] = {arg1, arg2};
+    return CallHandles(selector, count, array);
+  }
+
+  template <typename... Args>
+  Handle CallPeer(CallSelector selector, Args... args) {
+    Handle array[] = {args...};
+    return CallHandles(selector, sizeof...(args), array);
+  }
+
+  // Call a peer method, or build the node it would build, with Python
+  // objects.  The arguments are those of the peer method, except that
+  // kNewType takes the parameters only if there are any, and
+  // kNewUnionType takes two types rather than a list of them.
+  PyObject* CallObjects(CallSelector selector, int count, PyObject** args);
+
+  // Return the type memoized for a call of kNewType or kNewUnionType (see
+  // TypeMemo), else build it like CallObjects() and memoize it.
+  PyObject* MemoizedTypeObject(CallSelector selector, int count,
+                               PyObject** args);
+
+  PyObject* NewTypeObject(PyObject* name, PyObject* parameters);
+  PyObject* NewUnionTypeObject(PyObject* left, PyObject* right);
+  PyObject* NewConstantObject(PyObject* name, PyObject* value);
+  PyObject* NewFunctionObject(PyObject** args);
+
+  // Call one of the peer's if_*() methods, or evaluate the condition
+  // natively if the peer enabled that (see Conditions).
+  PyObject* ConditionObject(CallSelector selector, int count,
+                            PyObject** args);
+
+  // Update token for skip_state_, skipping tokens if need be.
+  void SkipTokens(Lexer* lexer, Token* token);
+
+  // Record an error that is recovered from.  message is consumed.
+  void AddError(const IrLocation& location, PyObject* message);
+
+  // Start skipping tokens after an error.  lookahead is whether the last
+  // token returned is the one after the construct that failed, rather than
+  // part of it.
+  void StartResync(bool lookahead);
+
+  // Skip tokens after an error, up to the first token that starts a line (a
+  // statement), the DEDENT that ends the current block or the end of the
+  // input, which is left in token.  Blocks and the clauses of "if"
+  // statements that start while skipping are skipped as a whole.
+  void Resync(Lexer* lexer, Token* token);
+
+  // Whether token is the first on its line, outside of brackets.
+  bool StartsLine(const Token& token) const {
+    return bracket_depth_ == 0 && token.location.first_line > last_line_ &&
+        token.kind != INDENT && token.kind != DEDENT && token.kind != 0;
+  }
+
+  // Update the state that StartsLine() depends on with a token.
+  void NoteToken(const Token& token);
+
+  // Return the location of loc, with the span of its line from the lexer.
+  static IrLocation GetLocation(YYLTYPE* loc, Lexer* lexer);
+
+  template <typename... Args>
+  PyObject* CallPeerObjects(CallSelector selector, Args... args) {
+    PyObject* array[] = {args...};
+    return Call(selector, sizeof...(args), array);
+  }
 };
 
+// Parse the lexer's input into IR, which is appended to data.  locations is
+// whether the IR records the locations of values, see IrWriter.  Returns the
+// status returned by the parser: 0, 1 for a syntax error (which is recorded
+// in the IR, with its location), or another value if parsing failed
+// otherwise.  Does not require the GIL.
+int ParseToIr(Lexer* lexer, bool locations, std::string* data);
+
 }  // end namespace pytype
 
+// The lexer functions called by the parsers, see parser.y.
+inline int pytypelex(YYSTYPE* lvalp, YYLTYPE* llocp, pytype::Lexer* lexer,
+                     pytype::Context* ctx) {
+  return ctx->NextToken(lexer, lvalp, llocp);
+}
+inline int pytyperecoverlex(YYSTYPE* lvalp, YYLTYPE* llocp,
+                            pytype::Lexer* lexer, pytype::Context* ctx) {
+  return ctx->NextToken(lexer, lvalp, llocp);
+}
+
 #endif  // PYTYPE_PYI_PARSER_H_
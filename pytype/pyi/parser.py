@@ -2,7 +2,10 @@
 
 import collections
 import hashlib
+import os
+import sys
 
+from pytype import metrics
 from pytype.pyi import parser_ext
 from pytype.pytd import pep484
 from pytype.pytd import pytd
@@ -20,6 +23,18 @@ from pytype.pytd.parse import visitors
 _DEFAULT_VERSION = (2, 7, 6)
 _DEFAULT_PLATFORM = "linux"
 
+# Lexer counters, see record_lexer_stats().
+_lexer_state_bytes = metrics.MapCounter("lexer_state_bytes")
+_lexer_tokens = metrics.MapCounter("lexer_tokens")
+_lexer_values = metrics.MapCounter("lexer_values")
+_lexer_indent_depth = metrics.Distribution("lexer_max_indent_depth")
+
+# Parser counters, see record_parse_stats().
+_parse_reductions = metrics.MapCounter("parse_reductions")
+_parse_peer_calls = metrics.MapCounter("parse_peer_calls")
+_parse_peer_usecs = metrics.MapCounter("parse_peer_usecs")
+_parse_peer_seconds = metrics.Distribution("parse_peer_seconds")
+
 
 _Params = collections.namedtuple("_", ["required",
                                        "starargs", "starstarargs",
@@ -29,6 +44,22 @@ _NameAndSig = collections.namedtuple("_", ["name", "signature",
                                            "decorators", "external_code"])
 
 
+# An entry for parse_many() that names a file to read the source from.
+SourceFile = collections.namedtuple("SourceFile", ["path"])
+
+# The result of scan_dependencies() for a source: tuples of the modules it
+# depends on and of the names it defines at the top level.
+HeaderScan = collections.namedtuple("HeaderScan", ["dependencies", "names"])
+
+# The parser_ext.Parser for each peer class, see _Parser._native_parser().
+_native_parsers = {}
+
+# The ParseCache that parse_string() and parse_file() use, see
+# set_parse_cache(), and the version of the parser for its keys.
+_parse_cache = None
+_parser_version = None
+
+
 _COMPARES = {
     "==": lambda x, y: x == y,
     "!=": lambda x, y: x != y,
@@ -199,6 +230,24 @@ class _Parser(object):
   Other methods:
     set_error_location()
 
+  Optional methods:
+    native_nodes(): Called once before parsing.  Returns None, or a dict of
+        the node classes and the type map that the low level parser needs to
+        build nodes for the simple cases of new_type(), new_union_type(),
+        new_constant() and new_function() itself rather than calling those
+        methods.
+    native_conditions(): Called once before parsing.  Returns None, or a
+        (version, platform) tuple against which the low level parser
+        evaluates conditions itself, instead of calling if_begin(),
+        if_elif(), if_else() and if_end() (see below).  It then skips the
+        definitions under inactive conditions without parsing them, only
+        checking for lexer errors.
+    memoize_types(): Called once before parsing.  Returns whether the low
+        level parser may reuse the result of a new_type() or
+        new_union_type() call for later calls with the same arguments (the
+        same objects) instead of calling the method again, until it calls
+        add_import(), add_alias_or_constant() or register_class_name().
+
 
   Error handling is a bit tricky because it is important to associate
   location information with errors, but undesireable to move location
@@ -210,6 +259,8 @@ class _Parser(object):
   the peer in the first place).  The high level parser can thus save location
   information from set_error_location(), catch the exception raised by
   parse_ext.parse(), and raise a new exception that includes a location.
+  When the low level parser recovers from errors (see check()), it collects
+  them with their locations instead.
 
   Conditional pyi code (under an "if" statement) is handled similar to a
   preprocessor, discarding any statements under False conditions rather than
@@ -234,11 +285,11 @@ class _Parser(object):
       if the scope will now be active.
 
   if_end(self, clauses): This should be called at the end of the entire if
-      statement where clauses is a list of (active, defs) pairs.  Active is
-      the return value of the corresponding if_begin/if_elif/if_else call, and
-      defs is a list of definitions within that block.  The function returns
-      the list of defs that should be processed (i.e. the defs in the tuple
-      where active was True, or [] if no such tuple is present).
+      statement where clauses is a sequence of (active, defs) pairs.  Active
+      is the return value of the corresponding if_begin/if_elif/if_else call,
+      and defs is a sequence of definitions within that block.  The function
+      returns the sequence of defs that should be processed (i.e. the defs in
+      the pair where active was True, or [] if no such pair is present).
 
   Conditions are represented by tuples (name, op, value), where name is a
   dotted name string, op is one of six comparisson strings ("==", "!=", "<",
@@ -251,14 +302,22 @@ class _Parser(object):
   NOTHING = pytd.NothingType()
   ANYTHING = pytd.AnythingType()
 
-  def __init__(self, version, platform):
+  def __init__(self, version, platform, pretokenize=False, native_nodes=False):
     """Initialize the parser.
 
     Args:
       version: A version tuple.
       platform: A platform string.
+      pretokenize: If True, the source is tokenized without holding the GIL
+        before parsing starts, so other threads can run while it is lexed.
+      native_nodes: If True, the low level parser builds common nodes
+        directly, only calling the peer methods for cases that need their
+        checks.  The AST is the same, but node preconditions aren't checked
+        for the nodes it builds.
     """
     self._used = False
+    self._pretokenize = pretokenize
+    self._native_nodes = native_nodes
     self._error_location = None
     self._version = _three_tuple(version or _DEFAULT_VERSION)
     self._platform = platform or _DEFAULT_PLATFORM
@@ -292,6 +351,136 @@ class _Parser(object):
     Raises:
       ParseError: If the PYI source could not be parsed.
     """
+    return self._parse(
+        lambda: self._native_parser().parse(
+            self, src, pretokenize=self._pretokenize),
+        src, name, filename)
+
+  def parse_file(self, filename, name):
+    """Parse the PYI file at filename and return the corresponding AST.
+
+    This is equivalent to parse() on the contents of the file, but the low
+    level parser memory-maps the file and lexes it in place rather than
+    having it read into a string first.  The same single use restriction
+    applies.
+
+    Args:
+      filename: The path of the file to parse.
+      name: The name of the module to be created.
+
+    Returns:
+      A pytd.TypeDeclUnit() representing the parsed pyi.
+
+    Raises:
+      ParseError: If the PYI source could not be parsed.
+      IOError: If the file could not be read.
+    """
+    return self._parse(
+        lambda: self._native_parser().parse_file(
+            self, filename, pretokenize=self._pretokenize),
+        None, name, filename)
+
+  def parse_stream(self, stream, name, filename=None):
+    """Parse PYI source read from stream and return the corresponding AST.
+
+    The source is read in chunks while it is parsed, so it is never held in
+    memory as a whole.  The AST is the same as parse() returns for the source
+    (pretokenizing doesn't apply), but a ParseError doesn't include the text
+    of the line.  The same single use restriction applies.
+
+    Args:
+      stream: A file descriptor, or a file-like object whose read() method
+        returns str.
+      name: The name of the module to be created.  Unlike for parse(), this
+        is required, since there is no source to derive a name from.
+      filename: The name of the source file.
+
+    Returns:
+      A pytd.TypeDeclUnit() representing the parsed pyi.
+
+    Raises:
+      ParseError: If the PYI source could not be parsed.
+      ValueError: If name is empty.
+    """
+    if not name:
+      raise ValueError("parse_stream() requires a module name")
+    return self._parse(lambda: parser_ext.parse_stream(self, stream),
+                       None, name, filename)
+
+  def parse_ir(self, ir, src, name, filename):
+    """Build the AST from IR returned by parse_to_ir().
+
+    The AST (or ParseError) is the same as parse() returns for the source the
+    IR was made from.  The same single use restriction applies.
+
+    Args:
+      ir: The IR, a str.
+      src: The source text, used for the text of errors and to name the
+        module if name is None.  May be None if filename can be read instead.
+      name: The name of the module to be created.
+      filename: The name of the source file.
+
+    Returns:
+      A pytd.TypeDeclUnit() representing the parsed pyi.
+
+    Raises:
+      ParseError: If the PYI source could not be parsed.
+      ValueError: If the IR is invalid.
+    """
+    return self._parse(lambda: parser_ext.decode_ir(self, ir),
+                       src, name, filename)
+
+  def check(self, src, name, filename):
+    """Parse a PYI file, recovering from errors, and return the errors.
+
+    Unlike parse(), which stops at the first error, this reports every error
+    in one pass: the low level parser skips to the next statement after an
+    error.  Definitions under inactive conditions are checked too.  The same
+    single use restriction applies.
+
+    Args:
+      src: The source text to parse, or None to parse the file at filename
+        (which the low level parser then reads in place, see parse_file()).
+      name: The name of the module to be created.
+      filename: The name of the source file.
+
+    Returns:
+      A list of ParseErrors, in the order they were found, which is empty if
+      the source is valid.
+
+    Raises:
+      IOError: If src is None and the file could not be read.
+    """
+    diagnostics = []
+    if src is None:
+      parse_ext = lambda: parser_ext.parse_file(self, filename,
+                                                errors=diagnostics)
+    else:
+      parse_ext = lambda: parser_ext.parse(self, src, errors=diagnostics)
+    try:
+      self._parse(parse_ext, src, name, filename)
+      error = None
+    except ParseError as e:
+      # An error found after parsing, while building the AST.
+      error = e
+    errors = [_located_error(message, location, src, filename)
+              for location, message in diagnostics]
+    if error:
+      errors.append(error)
+    return errors
+
+  def _parse(self, parse_ext, src, name, filename):
+    """Run parse_ext() and build the AST, see parse() for details.
+
+    Args:
+      parse_ext: A function that invokes the low level parser.
+      src: The source text, or None if it is being read from filename.
+      name: The name of the module to be created.
+      filename: The name of the source file.
+
+    Returns:
+      A pytd.TypeDeclUnit() representing the parsed pyi.
+    """
     # Ensure instances do not get reused.
     assert not self._used
     self._used = True
@@ -301,17 +490,11 @@ class _Parser(object):
     self._type_map = {}
 
     try:
-      defs = parser_ext.parse(self, src)
+      defs = parse_ext()
       ast = self._build_type_decl_unit(defs)
     except ParseError as e:
       if self._error_location:
-        line = self._error_location[0]
-        try:
-          text = src.splitlines()[line-1]
-        except IndexError:
-          text = None
-        raise ParseError(e.message, line=line, filename=self._filename,
-                         column=self._error_location[1], text=text)
+        raise _located_error(e.message, self._error_location, src, filename)
       else:
         raise e
 
@@ -325,6 +508,9 @@ class _Parser(object):
       ast = ast.Visit(visitors.AddNamePrefix())
     else:
       # If there's no unique name, hash the sourcecode.
+      if src is None:
+        with open(filename, "rb") as f:
+          src = f.read()
       ast = ast.Replace(name=hashlib.md5(src).hexdigest())
 
     return ast
@@ -365,11 +551,47 @@ class _Parser(object):
                              classes=tuple(classes),
                              aliases=tuple(self._aliases))
 
+  def _native_parser(self):
+    """Return the parser_ext.Parser for peers of this class."""
+    native = _native_parsers.get(type(self))
+    if native is None:
+      native = _native_parsers[type(self)] = parser_ext.Parser(type(self))
+    return native
+
+  def native_nodes(self):
+    """Return what the low level parser needs to build nodes, or None."""
+    if not self._native_nodes:
+      return None
+    return {
+        "type_map": self._type_map,
+        "types": pytd.TYPE,
+        "NamedType": pytd.NamedType,
+        "GenericType": pytd.GenericType,
+        "UnionType": pytd.UnionType,
+        "AnythingType": pytd.AnythingType,
+        "Constant": pytd.Constant,
+        "Parameter": pytd.Parameter,
+        "Signature": pytd.Signature,
+        "NameAndSig": _NameAndSig,
+    }
+
+  def native_conditions(self):
+    """Return the version and platform that conditions are evaluated for."""
+    return self._version, self._platform
+
+  def memoize_types(self):
+    """Return whether the results of new_type() can be reused."""
+    # They only depend on the arguments, and on _type_map, which only
+    # changes as described in the class docstring.
+    return True
+
   def set_error_location(self, location):
     """Record the location of the current error.
 
     Args:
-      location: A tuple (first_line, first_column, last_line, last_column).
+      location: A tuple (first_line, first_column, last_line, last_column,
+        line_start, line_end).  The last two are the byte offsets of the text
+        of first_line (excluding the newline), or -1 if there is no such line.
     """
     self._error_location = location
 
@@ -395,8 +617,11 @@ class _Parser(object):
 
   def if_begin(self, condition):
     """Begin an "if" statement using the specified condition."""
+    # Evaluate the condition first, so that there is no scope to end if it
+    # fails.
+    value = self._eval_condition(condition)
     self._current_condition = _ConditionScope(self._current_condition)
-    self._current_condition.apply_condition(self._eval_condition(condition))
+    self._current_condition.apply_condition(value)
     return self._current_condition.active
 
   def if_elif(self, condition):
@@ -410,7 +635,7 @@ class _Parser(object):
     return self._current_condition.active
 
   def if_end(self, clauses):
-    """Finish an "if" statement given a list of (active, defs) clauses."""
+    """Finish an "if" statement given a sequence of (active, defs) clauses."""
     self._current_condition = self._current_condition.parent
     for cond_value, stmts in clauses:
       if cond_value:
@@ -464,9 +689,9 @@ class _Parser(object):
     Args:
       from_package: A dotted package name if this is a "from" statement, or None
           if it is an "import" statement.
-      import_list: A list of imported items, which are either strings or pairs
-          of strings.  Pairs are used when items are renamed during import
-          using "as".
+      import_list: A sequence of imported items, which are either strings or
+          pairs of strings.  Pairs are used when items are renamed during
+          import using "as".
 
     Raises:
       ParseError: If an import statement uses a rename.
@@ -501,7 +726,7 @@ class _Parser(object):
 
     Args:
       name: The name of the type.
-      parameters: List of type parameters.
+      parameters: Sequence of type parameters.
 
     Returns:
       A pytd type node.
@@ -564,9 +789,9 @@ class _Parser(object):
     """Return a _NameAndSig object for the function.
 
     Args:
-      decorators: List of decorator names.
+      decorators: Sequence of decorator names.
       name: Name of funciton.
-      param_list: List of parameters, where a paremeter is either a tuple
+      param_list: Sequence of parameters, where a paremeter is either a tuple
         (name, type, default) or the ELLIPSIS special object.  See
         _validate_params for a more detailed description of allowed parameters.
       return_type: A pytd type object.
@@ -630,7 +855,7 @@ class _Parser(object):
 
     Args:
       base_name: The named tuple's name.
-      fields: A list of (name, type) tuples.
+      fields: A sequence of (name, type) tuples.
 
     Returns:
       A NamedType() for the generated class that describes the named tuple.
@@ -663,11 +888,11 @@ class _Parser(object):
 
     Args:
       class_name: The name of the class (a string).
-      parent_args: A list of parent types and (keyword, value) tuples.
+      parent_args: A sequence of parent types and (keyword, value) tuples.
           Parent types must be instances of pytd.Type.  Keyword tuples must
-          appear at the end of the list.  Currently the only supported keyword
-          is 'metaclass'.
-      defs: A list of constant (pytd.Constant) and function (_NameAndSig)
+          appear at the end of the sequence.  Currently the only supported
+          keyword is 'metaclass'.
+      defs: A sequence of constant (pytd.Constant) and function (_NameAndSig)
           definitions.
 
     Raises:
@@ -738,9 +963,311 @@ class _Parser(object):
 
 
 def parse_string(src, name=None, filename=None, python_version=None,
+                 platform=None, pretokenize=False, native_nodes=False):
+  def parse():
+    return _Parser(version=python_version, platform=platform,
+                   pretokenize=pretokenize,
+                   native_nodes=native_nodes).parse(src, name, filename)
+  if _parse_cache is None:
+    return parse()
+  return _cached_parse(
+      _parse_cache.make_key(src, _get_parser_version(),
+                            _cache_options(name, python_version, platform)),
+      parse)
+
+
+def parse_file(filename, name=None, python_version=None, platform=None,
+               pretokenize=False, native_nodes=False):
+  def parse():
+    return _Parser(version=python_version, platform=platform,
+                   pretokenize=pretokenize,
+                   native_nodes=native_nodes).parse_file(filename, name)
+  if _parse_cache is None:
+    return parse()
+  # The file is hashed without reading it into a string, and on a miss still
+  # parsed in place.
+  return _cached_parse(
+      _parse_cache.make_file_key(filename, _get_parser_version(),
+                                 _cache_options(name, python_version,
+                                                platform)),
+      parse)
+
+
+def set_parse_cache(cache):
+  """Make parse_string() and parse_file() use a cache.
+
+  The ASTs of sources parsed with the same name, python version and platform
+  (and the same version of the parser) are then looked up in the cache, and
+  only parsed if they aren't found.  Errors aren't cached.
+
+  Args:
+    cache: A parse_cache.ParseCache, or None to parse every source.
+
+  Returns:
+    The cache that was in use before.
+  """
+  global _parse_cache
+  old_cache = _parse_cache
+  _parse_cache = cache
+  return old_cache
+
+
+def _cache_options(name, python_version, platform):
+  """Return the options of a parse that are part of its cache key."""
+  version = _three_tuple(python_version or _DEFAULT_VERSION)
+  return (name, version, platform or _DEFAULT_PLATFORM)
+
+
+def _cached_parse(key, parse):
+  """Look up the AST for key in _parse_cache, calling parse() on a miss."""
+  ast = _parse_cache.get(key)
+  if ast is None:
+    ast = parse()
+    _parse_cache.put(key, ast)
+  return ast
+
+
+def _get_parser_version():
+  """Return a hash of the code of the modules that shape or define the AST."""
+  global _parser_version
+  if _parser_version is None:
+    h = hashlib.md5()
+    # The parser and the modules it builds the AST with, and those that
+    # define the classes of the nodes, which a cache pickles.
+    for module in (sys.modules[__name__], parser_ext, pep484, pytd, visitors,
+                   visitors.parser_constants, pytd.node, pytd.preconditions):
+      path = module.__file__
+      if path.endswith(".pyc") and os.path.exists(path[:-1]):
+        path = path[:-1]
+      with open(path, "rb") as f:
+        h.update(f.read())
+    _parser_version = h.hexdigest()
+  return _parser_version
+
+
+def parse_stream(stream, name, filename=None, python_version=None,
+                 platform=None, native_nodes=False):
+  return _Parser(version=python_version, platform=platform,
+                 native_nodes=native_nodes).parse_stream(stream, name,
+                                                         filename)
+
+
+def check_string(src, name=None, filename=None, python_version=None,
                  platform=None):
-  return _Parser(version=python_version, platform=platform).parse(
-      src, name, filename)
+  return _Parser(version=python_version,
+                 platform=platform).check(src, name, filename)
+
+
+def check_file(filename, name=None, python_version=None, platform=None):
+  return _Parser(version=python_version,
+                 platform=platform).check(None, name, filename)
+
+
+def parse_to_ir(src, locations=True):
+  """Parse src without holding the GIL, and return the parse as IR.
+
+  The IR is a str, which parse_ir() turns into the AST, so the parsing can
+  run on other threads or be cached (only for use by the same build of the
+  parser, though).  Syntax errors are recorded in the IR and raised by
+  parse_ir().  Conditions are evaluated by parse_ir(), thus the IR doesn't
+  depend on the version and platform, but the definitions under inactive
+  conditions are parsed rather than skipped, so errors in them are reported.
+
+  Args:
+    src: The source text to parse.
+    locations: Whether the IR records the locations of the definitions.
+      Without them the IR is about a third smaller, but a ParseError raised
+      by parse_ir() has no location, unless it is a syntax error.
+
+  Returns:
+    The IR, a str.
+  """
+  return parser_ext.parse_ir(src, locations=locations)
+
+
+def parse_ir(ir, name=None, filename=None, src=None, python_version=None,
+             platform=None, native_nodes=False):
+  return _Parser(version=python_version, platform=platform,
+                 native_nodes=native_nodes).parse_ir(ir, src, name, filename)
+
+
+def parse_many(entries, threads=0, native_nodes=False):
+  """Parse many sources, lexing and parsing them on a pool of threads.
+
+  The sources are parsed into IR (see parse_to_ir()) on native threads that
+  don't hold the GIL, while the calling thread builds the ASTs from the IR in
+  order, so only the lexing and parsing run in parallel.  As with
+  parse_to_ir(), definitions under inactive conditions are parsed rather than
+  skipped.  The IR doesn't record locations, which makes it cheaper to
+  build; a source whose IR fails to build with an error that lacks a location
+  is parsed again with locations, so the errors are the same as
+  parse_string() would raise.
+
+  Args:
+    entries: A sequence of (name, source, python_version, platform) tuples,
+      where source is the source text or a SourceFile, and the other items
+      are as for parse_string().
+    threads: The number of threads, or 0 for the number of CPUs.
+    native_nodes: As for parse_string().
+
+  Returns:
+    A list with an item for each entry, in order: the pytd.TypeDeclUnit for
+    the source, or the ParseError or IOError raised parsing or reading it.
+  """
+  entries = list(entries)
+  inputs = [(source.path,) if isinstance(source, SourceFile) else source
+            for _, source, _, _ in entries]
+  results = [None] * len(entries)
+
+  def decode(index, ir, error):
+    if ir is None:
+      results[index] = error
+      return
+    name, source, python_version, platform = entries[index]
+    if isinstance(source, SourceFile):
+      src, filename = None, source.path
+    else:
+      src, filename = source, None
+    try:
+      results[index] = parse_ir(ir, name, filename, src, python_version,
+                                platform, native_nodes)
+    except ParseError as e:
+      if e.line is None:
+        e = _locate_error(e, name, filename, src, python_version, platform)
+      results[index] = e
+
+  parser_ext.parse_ir_many(inputs, decode, threads, locations=False)
+  return results
+
+
+def scan_dependencies(sources, python_version=None, platform=None,
+                      threads=0):
+  """Find the dependencies and top level names of sources without parsing.
+
+  Only import statements, the names of top level definitions, dotted names
+  and "if" statements (whose conditions are evaluated for python_version and
+  platform) are recognized, on a pool of threads that don't hold the GIL,
+  which is far cheaper than parsing the sources and running
+  visitors.CollectDependencies() over the ASTs, e.g. to order the sources by
+  their dependencies before parsing them.  Errors aren't reported: a source that
+  doesn't parse, or has conditions that the parser rejects, is scanned as far
+  as possible, so that the result covers at least what a parse would find.
+
+  Args:
+    sources: A sequence of source texts or SourceFiles.
+    python_version: As for parse_string().
+    platform: As for parse_string().
+    threads: The number of threads, or 0 for the number of CPUs.
+
+  Returns:
+    A list with an item for each source, in order: a HeaderScan, where the
+    dependencies are the modules of the import statements ("import a.b" and
+    "from a.b import c" depend on "a.b") and of dotted names ("a.b.C" depends
+    on "a.b"), and the names are those of the
+    classes, functions, constants, aliases and type variables, and the names
+    imported by "from" statements (except from typing), or the IOError raised
+    reading the source.
+  """
+  inputs = [(source.path,) if isinstance(source, SourceFile) else source
+            for source in sources]
+  results = parser_ext.scan_headers(
+      inputs, _three_tuple(python_version or _DEFAULT_VERSION),
+      platform or _DEFAULT_PLATFORM, threads)
+  return [result if isinstance(result, IOError) else HeaderScan(*result)
+          for result in results]
+
+
+def record_lexer_stats():
+  """Move the counts of the lexers into the lexer_* metrics.
+
+  The lexers only count after parser_ext.set_lexer_stats(True).  Bytes per
+  start state, tokens per kind and the value counts ("values" and
+  "allocations") are added to MapCounters, and the maximum indentation depth
+  to a Distribution.  The lexer counts are then reset.
+  """
+  stats = parser_ext.lexer_stats(True)
+  for state, count in stats["state_bytes"].items():
+    _lexer_state_bytes.inc(state, count)
+  for kind, count in stats["tokens"].items():
+    _lexer_tokens.inc(kind, count)
+  for key in ("values", "allocations"):
+    _lexer_values.inc(key, stats[key])
+  if stats["tokens"]:
+    _lexer_indent_depth.add(stats["max_indent_depth"])
+
+
+def record_parse_stats():
+  """Move the counts of the parses into the parse_* metrics.
+
+  The parses only count after parser_ext.set_parse_stats(True).  Reductions
+  per nonterminal of the grammar and calls per peer method are added to
+  MapCounters, as is the time spent in each peer method, in microseconds.
+  The total time spent in the peer is added to a Distribution, so that it
+  can be compared with the time of the parses.  The parse counts are then
+  reset.
+  """
+  stats = parser_ext.parse_stats(True)
+  for symbol, count in stats["reductions"].items():
+    _parse_reductions.inc(symbol, count)
+  for method, count in stats["calls"].items():
+    _parse_peer_calls.inc(method, count)
+  for method, seconds in stats["call_seconds"].items():
+    _parse_peer_usecs.inc(method, int(round(seconds * 1e6)))
+  if stats["calls"]:
+    _parse_peer_seconds.add(sum(stats["call_seconds"].values()))
+
+
+def _locate_error(error, name, filename, src, python_version, platform):
+  """Parse a source again with locations, to locate an error from parse_ir().
+
+  Args:
+    error: The ParseError from building the AST from IR without locations.
+    name: The name of the module.
+    filename: The name of the source file.
+    src: The source text, or None to read it from filename.
+    python_version: As for parse_string().
+    platform: As for parse_string().
+
+  Returns:
+    The error found by the new parse, or error if there was none (e.g. if the
+    file changed), or an IOError if the file could not be read.
+  """
+  if src is None:
+    try:
+      with open(filename, "rb") as f:
+        src = f.read()
+    except IOError as e:
+      return e
+  try:
+    parse_ir(parse_to_ir(src), name, filename, src, python_version, platform)
+  except ParseError as e:
+    return e
+  return error
+
+
+def _located_error(message, location, src, filename):
+  """Return a ParseError for message at a low level parser location."""
+  line, column, _, _, line_start, line_end = location
+  text = _source_text(src, filename, line_start, line_end)
+  return ParseError(message, line=line, filename=filename, column=column,
+                    text=text)
+
+
+def _source_text(src, filename, start, end):
+  """Return the text of a line given its offsets, or None if unavailable."""
+  if start < 0:
+    return None
+  if src is None:
+    # The file was parsed in place, so only read the line.
+    try:
+      with open(filename, "rb") as f:
+        f.seek(start)
+        text = f.read(end - start)
+    except IOError:
+      return None
+  else:
+    text = src[start:end]
+  return text.rstrip("\r")
 
 
 def _keep_decorator(decorator):
@@ -784,7 +1311,7 @@ def _validate_params(param_list):
   ELLIPSIS: Syntactic sugar that adds both *args and *kwargs parameters.
 
   Args:
-    param_list: list of (name, type, default) tuples and ELLIPSIS objects.
+    param_list: sequence of (name, type, default) tuples and ELLIPSIS objects.
 
   Returns:
     A _Params instance.
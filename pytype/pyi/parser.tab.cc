@@ -1,22 +1,22 @@
-/* A Bison parser, made by GNU Bison 2.4.2.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-/* Skeleton implementation for Bison's Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989-1990, 2000-2006, 2009-2010 Free Software
-   Foundation, Inc.
-   
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -27,13 +27,17 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -41,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.4.2"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -59,23 +63,16 @@
 /* Pull parsers.  */
 #define YYPULL 1
 
-/* Using locations.  */
-#define YYLSP_NEEDED 1
 
 /* Substitute the variable and function names.  */
 #define yyparse         pytypeparse
 #define yylex           pytypelex
 #define yyerror         pytypeerror
-#define yylval          pytypelval
-#define yychar          pytypechar
 #define yydebug         pytypedebug
 #define yynerrs         pytypenerrs
-#define yylloc          pytypelloc
 
-/* Copy the first part of user declarations.  */
-
-/* Line 189 of yacc.c  */
-#line 26 "parser.y"
+/* First part of user prologue.  */
+#line 56 "pyi/parser.y"
 
 #include "lexer.h"
 #include "parser.h"
@@ -85,173 +82,272 @@ namespace pytype {
 // code after the parser skeleton is emitted.  Thus the entire parser (except
 // for a few #defines) is in the pytype namespace.
 
+// yyerror is renamed with the prefix of the parser, like yyparse.
 namespace {
-PyObject* DOT_STRING = PyString_FromString(".");
-
-int pytypeerror(YYLTYPE* llocp, void* scanner, pytype::Context* ctx,
+int yyerror(YYLTYPE* llocp, Lexer* lexer, pytype::Context* ctx,
     const char *p);
-
-/* Helper functions for building up lists. */
-PyObject* StartList(PyObject* item);
-PyObject* AppendList(PyObject* list, PyObject* item);
-PyObject* ExtendList(PyObject* dst, PyObject* src);
-
 }  // end namespace
 
 
-// Check that a python value is not NULL.  The must be a macro because it
-// calls YYERROR (which is a goto).
-#define CHECK(x, loc) do { if (x == NULL) {\
-    ctx->SetErrorLocation(&loc); \
+// Check that a value is not NULL, see Context::Check().  This must be a
+// macro because it calls YYERROR (which is a goto).
+#define CHECK(x, loc) do { if (!ctx->Check(x, &loc, lexer)) {\
     YYERROR; \
   }} while(0)
 
+// Continue after an error if the Context recovers from it, otherwise abort
+// the parse, releasing the list of the rule's other symbol (which the parser
+// leaves to the action).  See Context::Recover().
+#define RECOVER(list) do { if (!ctx->Recover()) {\
+    ctx->DropList(list); \
+    YYABORT; \
+  }} while(0)
 
+// The default location of a rule's value, as bison computes it, which also
+// counts the reduction of the rule (yyn) by its nonterminal for
+// Context::collect_stats().  The parser computes the location of every
+// reduction into yyloc, and only that of the error token elsewhere.
+#define YYLLOC_DEFAULT(Current, Rhs, N) do { \
+    if (N) { \
+      (Current).first_line = YYRHSLOC(Rhs, 1).first_line; \
+      (Current).first_column = YYRHSLOC(Rhs, 1).first_column; \
+      (Current).last_line = YYRHSLOC(Rhs, N).last_line; \
+      (Current).last_column = YYRHSLOC(Rhs, N).last_column; \
+    } else { \
+      (Current).first_line = (Current).last_line = \
+          YYRHSLOC(Rhs, 0).last_line; \
+      (Current).first_column = (Current).last_column = \
+          YYRHSLOC(Rhs, 0).last_column; \
+    } \
+    if (&(Current) == &yyloc) { \
+      ctx->CountReduction(yytname[yyr1[yyn]]); \
+    } \
+  } while (0)
+
+
+#line 129 "pyi/parser.tab.cc"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
 
-/* Line 189 of yacc.c  */
-#line 113 "pyi/parser.tab.cc"
+#include "parser.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_NAME = 3,                       /* NAME  */
+  YYSYMBOL_NUMBER = 4,                     /* NUMBER  */
+  YYSYMBOL_LEXERROR = 5,                   /* LEXERROR  */
+  YYSYMBOL_CLASS = 6,                      /* CLASS  */
+  YYSYMBOL_DEF = 7,                        /* DEF  */
+  YYSYMBOL_ELSE = 8,                       /* ELSE  */
+  YYSYMBOL_ELIF = 9,                       /* ELIF  */
+  YYSYMBOL_IF = 10,                        /* IF  */
+  YYSYMBOL_OR = 11,                        /* OR  */
+  YYSYMBOL_PASS = 12,                      /* PASS  */
+  YYSYMBOL_IMPORT = 13,                    /* IMPORT  */
+  YYSYMBOL_FROM = 14,                      /* FROM  */
+  YYSYMBOL_AS = 15,                        /* AS  */
+  YYSYMBOL_RAISE = 16,                     /* RAISE  */
+  YYSYMBOL_PYTHONCODE = 17,                /* PYTHONCODE  */
+  YYSYMBOL_NOTHING = 18,                   /* NOTHING  */
+  YYSYMBOL_RAISES = 19,                    /* RAISES  */
+  YYSYMBOL_NAMEDTUPLE = 20,                /* NAMEDTUPLE  */
+  YYSYMBOL_TYPEVAR = 21,                   /* TYPEVAR  */
+  YYSYMBOL_ARROW = 22,                     /* ARROW  */
+  YYSYMBOL_COLONEQUALS = 23,               /* COLONEQUALS  */
+  YYSYMBOL_ELLIPSIS = 24,                  /* ELLIPSIS  */
+  YYSYMBOL_EQ = 25,                        /* EQ  */
+  YYSYMBOL_NE = 26,                        /* NE  */
+  YYSYMBOL_LE = 27,                        /* LE  */
+  YYSYMBOL_GE = 28,                        /* GE  */
+  YYSYMBOL_INDENT = 29,                    /* INDENT  */
+  YYSYMBOL_DEDENT = 30,                    /* DEDENT  */
+  YYSYMBOL_TRIPLEQUOTED = 31,              /* TRIPLEQUOTED  */
+  YYSYMBOL_TYPECOMMENT = 32,               /* TYPECOMMENT  */
+  YYSYMBOL_33_ = 33,                       /* ':'  */
+  YYSYMBOL_34_ = 34,                       /* '('  */
+  YYSYMBOL_35_ = 35,                       /* ')'  */
+  YYSYMBOL_36_ = 36,                       /* ','  */
+  YYSYMBOL_37_ = 37,                       /* '='  */
+  YYSYMBOL_38_ = 38,                       /* '<'  */
+  YYSYMBOL_39_ = 39,                       /* '>'  */
+  YYSYMBOL_40_ = 40,                       /* '*'  */
+  YYSYMBOL_41_ = 41,                       /* '@'  */
+  YYSYMBOL_42_ = 42,                       /* '['  */
+  YYSYMBOL_43_ = 43,                       /* ']'  */
+  YYSYMBOL_44_ = 44,                       /* '?'  */
+  YYSYMBOL_45_ = 45,                       /* '.'  */
+  YYSYMBOL_YYACCEPT = 46,                  /* $accept  */
+  YYSYMBOL_start = 47,                     /* start  */
+  YYSYMBOL_unit = 48,                      /* unit  */
+  YYSYMBOL_alldefs = 49,                   /* alldefs  */
+  YYSYMBOL_classdef = 50,                  /* classdef  */
+  YYSYMBOL_class_name = 51,                /* class_name  */
+  YYSYMBOL_parents = 52,                   /* parents  */
+  YYSYMBOL_parent_list = 53,               /* parent_list  */
+  YYSYMBOL_parent = 54,                    /* parent  */
+  YYSYMBOL_maybe_class_funcs = 55,         /* maybe_class_funcs  */
+  YYSYMBOL_class_funcs = 56,               /* class_funcs  */
+  YYSYMBOL_funcdefs = 57,                  /* funcdefs  */
+  YYSYMBOL_if_stmt = 58,                   /* if_stmt  */
+  YYSYMBOL_if_and_elifs = 59,              /* if_and_elifs  */
+  YYSYMBOL_class_if_stmt = 60,             /* class_if_stmt  */
+  YYSYMBOL_class_if_and_elifs = 61,        /* class_if_and_elifs  */
+  YYSYMBOL_if_cond = 62,                   /* if_cond  */
+  YYSYMBOL_elif_cond = 63,                 /* elif_cond  */
+  YYSYMBOL_else_cond = 64,                 /* else_cond  */
+  YYSYMBOL_condition = 65,                 /* condition  */
+  YYSYMBOL_version_tuple = 66,             /* version_tuple  */
+  YYSYMBOL_condition_op = 67,              /* condition_op  */
+  YYSYMBOL_constantdef = 68,               /* constantdef  */
+  YYSYMBOL_importdef = 69,                 /* importdef  */
+  YYSYMBOL_import_items = 70,              /* import_items  */
+  YYSYMBOL_import_item = 71,               /* import_item  */
+  YYSYMBOL_from_list = 72,                 /* from_list  */
+  YYSYMBOL_from_items = 73,                /* from_items  */
+  YYSYMBOL_from_item = 74,                 /* from_item  */
+  YYSYMBOL_alias_or_constant = 75,         /* alias_or_constant  */
+  YYSYMBOL_typevardef = 76,                /* typevardef  */
+  YYSYMBOL_funcdef = 77,                   /* funcdef  */
+  YYSYMBOL_decorators = 78,                /* decorators  */
+  YYSYMBOL_decorator = 79,                 /* decorator  */
+  YYSYMBOL_params = 80,                    /* params  */
+  YYSYMBOL_param_list = 81,                /* param_list  */
+  YYSYMBOL_param = 82,                     /* param  */
+  YYSYMBOL_param_type = 83,                /* param_type  */
+  YYSYMBOL_param_default = 84,             /* param_default  */
+  YYSYMBOL_param_star_name = 85,           /* param_star_name  */
+  YYSYMBOL_return = 86,                    /* return  */
+  YYSYMBOL_raises = 87,                    /* raises  */
+  YYSYMBOL_exceptions = 88,                /* exceptions  */
+  YYSYMBOL_maybe_body = 89,                /* maybe_body  */
+  YYSYMBOL_empty_body = 90,                /* empty_body  */
+  YYSYMBOL_body = 91,                      /* body  */
+  YYSYMBOL_body_stmt = 92,                 /* body_stmt  */
+  YYSYMBOL_type_parameters = 93,           /* type_parameters  */
+  YYSYMBOL_type_parameter = 94,            /* type_parameter  */
+  YYSYMBOL_type = 95,                      /* type  */
+  YYSYMBOL_named_tuple_fields = 96,        /* named_tuple_fields  */
+  YYSYMBOL_named_tuple_field_list = 97,    /* named_tuple_field_list  */
+  YYSYMBOL_named_tuple_field = 98,         /* named_tuple_field  */
+  YYSYMBOL_maybe_comma = 99,               /* maybe_comma  */
+  YYSYMBOL_maybe_type_list = 100,          /* maybe_type_list  */
+  YYSYMBOL_type_list = 101,                /* type_list  */
+  YYSYMBOL_dotted_name = 102,              /* dotted_name  */
+  YYSYMBOL_pass_or_ellipsis = 103          /* pass_or_ellipsis  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-/* Enabling traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 1
-#endif
 
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-# define YYTOKEN_TABLE 0
-#endif
 
-/* "%code requires" blocks.  */
-
-/* Line 209 of yacc.c  */
-#line 18 "parser.y"
-
-#include <Python.h>
-
-
-
-/* Line 209 of yacc.c  */
-#line 143 "pyi/parser.tab.cc"
-
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     END = 0,
-     NAME = 258,
-     NUMBER = 259,
-     LEXERROR = 260,
-     CLASS = 261,
-     DEF = 262,
-     ELSE = 263,
-     ELIF = 264,
-     IF = 265,
-     OR = 266,
-     PASS = 267,
-     IMPORT = 268,
-     FROM = 269,
-     AS = 270,
-     RAISE = 271,
-     PYTHONCODE = 272,
-     NOTHING = 273,
-     RAISES = 274,
-     NAMEDTUPLE = 275,
-     TYPEVAR = 276,
-     ARROW = 277,
-     COLONEQUALS = 278,
-     ELLIPSIS = 279,
-     EQ = 280,
-     NE = 281,
-     LE = 282,
-     GE = 283,
-     INDENT = 284,
-     DEDENT = 285,
-     TRIPLEQUOTED = 286,
-     TYPECOMMENT = 287
-   };
+#ifdef short
+# undef short
 #endif
 
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
 
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
-{
-
-/* Line 214 of yacc.c  */
-#line 58 "parser.y"
-
-  PyObject* obj;
-  const char* str;
-
-
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-/* Line 214 of yacc.c  */
-#line 200 "pyi/parser.tab.cc"
-} YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
 #endif
 
-#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE
-{
-  int first_line;
-  int first_column;
-  int last_line;
-  int last_column;
-} YYLTYPE;
-# define yyltype YYLTYPE /* obsolescent; will be withdrawn */
-# define YYLTYPE_IS_DECLARED 1
-# define YYLTYPE_IS_TRIVIAL 1
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
 #endif
 
-
-/* Copy the second part of user declarations.  */
-
-
-/* Line 264 of yacc.c  */
-#line 225 "pyi/parser.tab.cc"
-
-#ifdef short
-# undef short
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
 typedef unsigned char yytype_uint8;
-#endif
-
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-typedef signed char yytype_int8;
 #else
-typedef short int yytype_int8;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef unsigned short int yytype_uint16;
+typedef int yytype_uint16;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
-#else
-typedef short int yytype_int16;
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -259,55 +355,106 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
 #  if ENABLE_NLS
 #   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(msgid) dgettext ("bison-runtime", msgid)
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
 #  endif
 # endif
 # ifndef YY_
-#  define YY_(msgid) msgid
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(e) ((void) (e))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(e) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(n) (n)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int yyi)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (yyi)
-    int yyi;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return yyi;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -324,11 +471,11 @@ YYID (yyi)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#     ifndef _STDLIB_H
-#      define _STDLIB_H 1
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
 #     endif
 #    endif
 #   endif
@@ -336,8 +483,8 @@ YYID (yyi)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -351,90 +498,92 @@ YYID (yyi)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
 #   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
 #  endif
-#  if (defined __cplusplus && ! defined _STDLIB_H \
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#   ifndef _STDLIB_H
-#    define _STDLIB_H 1
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
 #   endif
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL \
-	     && defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL \
+             && defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
   YYLTYPE yyls_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE) + sizeof (YYLTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
       + 2 * YYSTACK_GAP_MAXIMUM)
 
-/* Copy COUNT objects from FROM to TO.  The source and destination do
-   not overlap.  */
-# ifndef YYCOPY
-#  if defined __GNUC__ && 1 < __GNUC__
-#   define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
-#  else
-#   define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (YYID (0))
-#  endif
-# endif
+# define YYCOPY_NEEDED 1
 
 /* Relocate STACK from its old location to the new one.  The
    local variables YYSIZE and YYSTACKSIZE give the old and new number of
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack_alloc, Stack)				\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack_alloc, Stack, yysize);			\
-	Stack = &yyptr->Stack_alloc;					\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  6
 /* YYLAST -- Last index in YYTABLE.  */
@@ -446,18 +595,23 @@ union yyalloc
 #define YYNNTS  58
 /* YYNRULES -- Number of rules.  */
 #define YYNRULES  140
-/* YYNRULES -- Number of states.  */
+/* YYNSTATES -- Number of states.  */
 #define YYNSTATES  253
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   287
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -491,107 +645,42 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint16 yyprhs[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,     0,     3,     6,    10,    12,    15,    18,    21,    24,
-      27,    30,    33,    34,    40,    42,    46,    49,    50,    54,
-      56,    58,    62,    64,    68,    73,    75,    77,    80,    83,
-      86,    87,    94,    96,   102,   109,   116,   118,   124,   131,
-     134,   137,   139,   143,   147,   152,   158,   166,   168,   170,
-     172,   174,   176,   178,   182,   186,   192,   196,   202,   205,
-     210,   214,   216,   218,   222,   224,   228,   233,   237,   239,
-     241,   243,   245,   247,   251,   255,   262,   272,   277,   280,
-     281,   284,   286,   287,   291,   293,   297,   299,   302,   304,
-     307,   308,   311,   314,   317,   318,   321,   325,   328,   329,
-     332,   333,   337,   339,   344,   346,   349,   354,   359,   360,
-     363,   365,   369,   372,   377,   381,   383,   385,   387,   389,
-     394,   398,   405,   409,   413,   415,   417,   422,   425,   429,
-     431,   438,   440,   441,   443,   444,   448,   450,   452,   456,
-     458
+       0,   204,   204,   205,   209,   213,   214,   215,   216,   217,
+     218,   219,   225,   229,   236,   246,   247,   248,   252,   253,
+     257,   258,   262,   263,   264,   268,   269,   273,   274,   275,
+     281,   286,   289,   294,   298,   317,   320,   325,   329,   341,
+     345,   349,   353,   357,   364,   365,   366,   372,   373,   374,
+     375,   376,   377,   381,   385,   389,   393,   397,   404,   408,
+     415,   416,   419,   420,   426,   427,   428,   432,   433,   437,
+     438,   439,   440,   441,   447,   454,   461,   478,   489,   490,
+     494,   499,   500,   504,   505,   509,   512,   513,   514,   518,
+     519,   523,   524,   525,   526,   530,   531,   535,   536,   540,
+     541,   545,   546,   550,   551,   555,   556,   557,   558,   562,
+     563,   569,   570,   571,   575,   576,   580,   581,   585,   589,
+     593,   603,   607,   608,   609,   610,   614,   615,   619,   622,
+     626,   632,   633,   637,   638,   642,   643,   648,   649,   653,
+     654
 };
+#endif
 
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      47,     0,    -1,    48,     0,    -1,    31,    48,     0,    -1,
-      49,    -1,    49,    68,    -1,    49,    77,    -1,    49,    69,
-      -1,    49,    75,    -1,    49,    50,    -1,    49,    76,    -1,
-      49,    58,    -1,    -1,     6,    51,    52,    33,    55,    -1,
-       3,    -1,    34,    53,    35,    -1,    34,    35,    -1,    -1,
-      53,    36,    54,    -1,    54,    -1,    95,    -1,     3,    37,
-      95,    -1,   103,    -1,    29,    56,    30,    -1,    29,    31,
-      56,    30,    -1,   103,    -1,    57,    -1,    57,    68,    -1,
-      57,    77,    -1,    57,    60,    -1,    -1,    59,    64,    33,
-      29,    49,    30,    -1,    59,    -1,    62,    33,    29,    49,
-      30,    -1,    59,    63,    33,    29,    49,    30,    -1,    61,
-      64,    33,    29,    57,    30,    -1,    61,    -1,    62,    33,
-      29,    57,    30,    -1,    61,    63,    33,    29,    57,    30,
-      -1,    10,    65,    -1,     9,    65,    -1,     8,    -1,   102,
-      67,     3,    -1,   102,    67,    66,    -1,    34,     4,    36,
-      35,    -1,    34,     4,    36,     4,    35,    -1,    34,     4,
-      36,     4,    36,     4,    35,    -1,    38,    -1,    39,    -1,
-      27,    -1,    28,    -1,    25,    -1,    26,    -1,     3,    37,
-       4,    -1,     3,    37,    24,    -1,     3,    37,    24,    32,
-      95,    -1,     3,    33,    95,    -1,     3,    33,    95,    37,
-      24,    -1,    13,    70,    -1,    14,   102,    13,    72,    -1,
-      70,    36,    71,    -1,    71,    -1,   102,    -1,   102,    15,
-       3,    -1,    73,    -1,    34,    73,    35,    -1,    34,    73,
-      36,    35,    -1,    73,    36,    74,    -1,    74,    -1,     3,
-      -1,    20,    -1,    21,    -1,    40,    -1,     3,    15,     3,
-      -1,     3,    37,    95,    -1,     3,    37,    21,    34,    80,
-      35,    -1,    78,     7,     3,    34,    80,    35,    86,    87,
-      89,    -1,    78,     7,     3,    17,    -1,    78,    79,    -1,
-      -1,    41,   102,    -1,    81,    -1,    -1,    81,    36,    82,
-      -1,    82,    -1,     3,    83,    84,    -1,    40,    -1,    85,
-      83,    -1,    24,    -1,    33,    95,    -1,    -1,    37,     3,
-      -1,    37,     4,    -1,    37,    24,    -1,    -1,    40,     3,
-      -1,    40,    40,     3,    -1,    22,    95,    -1,    -1,    19,
-      88,    -1,    -1,    88,    36,    95,    -1,    95,    -1,    33,
-      29,    91,    30,    -1,    90,    -1,    33,   103,    -1,    33,
-      29,   103,    30,    -1,    33,    29,    31,    30,    -1,    -1,
-      91,    92,    -1,    92,    -1,     3,    23,    95,    -1,    16,
-       3,    -1,    16,     3,    34,    35,    -1,    93,    36,    94,
-      -1,    94,    -1,    95,    -1,    24,    -1,   102,    -1,   102,
-      42,    93,    43,    -1,    42,   100,    43,    -1,    20,    34,
-       3,    36,    96,    35,    -1,    34,    95,    35,    -1,    95,
-      11,    95,    -1,    44,    -1,    18,    -1,    42,    97,    99,
-      43,    -1,    42,    43,    -1,    97,    36,    98,    -1,    98,
-      -1,    34,     3,    36,    95,    99,    35,    -1,    36,    -1,
-      -1,   101,    -1,    -1,   101,    36,    95,    -1,    95,    -1,
-       3,    -1,   102,    45,     3,    -1,    12,    -1,    24,    -1
-};
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
 
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
-{
-       0,   127,   127,   128,   132,   136,   137,   138,   139,   140,
-     141,   142,   147,   151,   158,   169,   170,   171,   175,   176,
-     180,   181,   185,   186,   187,   191,   192,   196,   197,   198,
-     203,   208,   211,   216,   220,   239,   242,   247,   251,   263,
-     267,   271,   275,   278,   285,   286,   287,   293,   294,   295,
-     296,   297,   298,   302,   306,   310,   314,   318,   325,   329,
-     336,   337,   340,   341,   345,   346,   347,   351,   352,   356,
-     357,   358,   359,   360,   364,   371,   378,   393,   404,   405,
-     409,   414,   415,   419,   420,   424,   425,   426,   427,   431,
-     432,   436,   437,   438,   439,   443,   444,   448,   449,   453,
-     454,   458,   459,   463,   464,   468,   469,   470,   471,   475,
-     476,   480,   481,   482,   486,   487,   491,   492,   496,   500,
-     504,   514,   518,   519,   520,   521,   525,   526,   530,   531,
-     535,   539,   540,   544,   545,   549,   550,   555,   556,   564,
-     565
-};
-#endif
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
 
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "\"end of file\"", "error", "$undefined", "NAME", "NUMBER", "LEXERROR",
-  "CLASS", "DEF", "ELSE", "ELIF", "IF", "OR", "PASS", "IMPORT", "FROM",
-  "AS", "RAISE", "PYTHONCODE", "NOTHING", "RAISES", "NAMEDTUPLE",
+  "\"end of file\"", "error", "\"invalid token\"", "NAME", "NUMBER",
+  "LEXERROR", "CLASS", "DEF", "ELSE", "ELIF", "IF", "OR", "PASS", "IMPORT",
+  "FROM", "AS", "RAISE", "PYTHONCODE", "NOTHING", "RAISES", "NAMEDTUPLE",
   "TYPEVAR", "ARROW", "COLONEQUALS", "ELLIPSIS", "EQ", "NE", "LE", "GE",
   "INDENT", "DEDENT", "TRIPLEQUOTED", "TYPECOMMENT", "':'", "'('", "')'",
   "','", "'='", "'<'", "'>'", "'*'", "'@'", "'['", "']'", "'?'", "'.'",
@@ -607,110 +696,28 @@ static const char *const yytname[] =
   "empty_body", "body", "body_stmt", "type_parameters", "type_parameter",
   "type", "named_tuple_fields", "named_tuple_field_list",
   "named_tuple_field", "maybe_comma", "maybe_type_list", "type_list",
-  "dotted_name", "pass_or_ellipsis", 0
+  "dotted_name", "pass_or_ellipsis", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,    58,    40,    41,    44,    61,    60,    62,
-      42,    64,    91,    93,    63,    46
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
-{
-       0,    46,    47,    47,    48,    49,    49,    49,    49,    49,
-      49,    49,    49,    50,    51,    52,    52,    52,    53,    53,
-      54,    54,    55,    55,    55,    56,    56,    57,    57,    57,
-      57,    58,    58,    59,    59,    60,    60,    61,    61,    62,
-      63,    64,    65,    65,    66,    66,    66,    67,    67,    67,
-      67,    67,    67,    68,    68,    68,    68,    68,    69,    69,
-      70,    70,    71,    71,    72,    72,    72,    73,    73,    74,
-      74,    74,    74,    74,    75,    76,    77,    77,    78,    78,
-      79,    80,    80,    81,    81,    82,    82,    82,    82,    83,
-      83,    84,    84,    84,    84,    85,    85,    86,    86,    87,
-      87,    88,    88,    89,    89,    90,    90,    90,    90,    91,
-      91,    92,    92,    92,    93,    93,    94,    94,    95,    95,
-      95,    95,    95,    95,    95,    95,    96,    96,    97,    97,
-      98,    99,    99,   100,   100,   101,   101,   102,   102,   103,
-     103
-};
+#define YYPACT_NINF (-155)
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
-{
-       0,     2,     2,     3,     1,     2,     2,     2,     2,     2,
-       2,     2,     0,     5,     1,     3,     2,     0,     3,     1,
-       1,     3,     1,     3,     4,     1,     1,     2,     2,     2,
-       0,     6,     1,     5,     6,     6,     1,     5,     6,     2,
-       2,     1,     3,     3,     4,     5,     7,     1,     1,     1,
-       1,     1,     1,     3,     3,     5,     3,     5,     2,     4,
-       3,     1,     1,     3,     1,     3,     4,     3,     1,     1,
-       1,     1,     1,     3,     3,     6,     9,     4,     2,     0,
-       2,     1,     0,     3,     1,     3,     1,     2,     1,     2,
-       0,     2,     2,     2,     0,     2,     3,     2,     0,     2,
-       0,     3,     1,     4,     1,     2,     4,     4,     0,     2,
-       1,     3,     2,     4,     3,     1,     1,     1,     1,     4,
-       3,     6,     3,     3,     1,     1,     4,     2,     3,     1,
-       6,     1,     0,     1,     0,     3,     1,     1,     3,     1,
-       1
-};
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-/* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
-   STATE-NUM when YYTABLE doesn't specify something else to do.  Zero
-   means the default is an error.  */
-static const yytype_uint8 yydefact[] =
-{
-      12,    12,     0,     0,    79,     0,     1,     2,     0,     0,
-       0,     0,     0,     9,    11,    32,     0,     5,     7,     8,
-      10,     6,     0,     3,     0,     0,    14,    17,   137,    39,
-       0,    58,    61,    62,     0,    41,     0,     0,     0,     0,
-       0,     0,    78,   125,     0,     0,   134,   124,    56,   118,
-      53,     0,    54,    74,     0,     0,    51,    52,    49,    50,
-      47,    48,     0,     0,     0,     0,     0,    40,     0,     0,
-      12,     0,    80,     0,     0,   136,     0,   133,     0,     0,
-       0,    82,     0,   137,    16,     0,    19,    20,     0,   138,
-      42,     0,    43,    60,    63,    69,    70,    71,     0,    72,
-      59,    64,    68,    12,    12,    79,    77,    82,     0,   122,
-     120,     0,   123,    57,   117,     0,   115,   116,    90,    88,
-      86,     0,    81,    84,    90,    55,     0,    15,     0,   139,
-     140,    30,    13,    22,     0,     0,     0,     0,    79,    79,
-      33,     0,     0,   135,     0,   119,     0,    94,    95,     0,
-      75,     0,    87,    21,    18,    30,     0,    79,    25,     0,
-      73,    65,     0,    67,    34,    31,    98,     0,     0,   114,
-      89,     0,    85,    96,    83,     0,    23,     0,    29,    36,
-       0,    27,    28,     0,    44,    66,     0,   100,     0,   127,
-     132,   129,   121,    91,    92,    93,    24,     0,     0,     0,
-       0,    45,     0,    97,     0,   108,     0,   131,     0,     0,
-       0,    30,     0,    99,   102,     0,    76,   104,     0,   128,
-     126,    30,    30,    79,    46,     0,     0,   105,   132,    79,
-      79,    37,   101,     0,     0,     0,     0,   110,     0,   131,
-       0,    38,    35,     0,   112,   107,   103,   109,   106,   130,
-     111,     0,   113
-};
+#define YYTABLE_NINF (-27)
 
-/* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int16 yydefgoto[] =
-{
-      -1,     2,     3,     4,    13,    27,    55,    85,    86,   132,
-     156,   157,    14,    15,   178,   179,    16,    37,    38,    29,
-      92,    63,    17,    18,    31,    32,   100,   101,   102,    19,
-      20,    21,    22,    42,   121,   122,   123,   147,   172,   124,
-     187,   205,   213,   216,   217,   236,   237,   115,   116,    87,
-     168,   190,   191,   208,    76,    77,    49,   158
-};
+#define yytable_value_is_error(Yyn) \
+  0
 
 /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
    STATE-NUM.  */
-#define YYPACT_NINF -155
 static const yytype_int16 yypact[] =
 {
      -14,  -155,    19,    95,   182,   100,  -155,  -155,   -19,   129,
@@ -741,6 +748,39 @@ static const yytype_int16 yypact[] =
      206,   241,  -155
 };
 
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_uint8 yydefact[] =
+{
+      12,    12,     0,     0,    79,     0,     1,     2,     0,     0,
+       0,     0,     0,     9,    11,    32,     0,     5,     7,     8,
+      10,     6,     0,     3,     0,     0,    14,    17,   137,    39,
+       0,    58,    61,    62,     0,    41,     0,     0,     0,     0,
+       0,     0,    78,   125,     0,     0,   134,   124,    56,   118,
+      53,     0,    54,    74,     0,     0,    51,    52,    49,    50,
+      47,    48,     0,     0,     0,     0,     0,    40,     0,     0,
+      12,     0,    80,     0,     0,   136,     0,   133,     0,     0,
+       0,    82,     0,   137,    16,     0,    19,    20,     0,   138,
+      42,     0,    43,    60,    63,    69,    70,    71,     0,    72,
+      59,    64,    68,    12,    12,    79,    77,    82,     0,   122,
+     120,     0,   123,    57,   117,     0,   115,   116,    90,    88,
+      86,     0,    81,    84,    90,    55,     0,    15,     0,   139,
+     140,    30,    13,    22,     0,     0,     0,     0,    79,    79,
+      33,     0,     0,   135,     0,   119,     0,    94,    95,     0,
+      75,     0,    87,    21,    18,    30,     0,    79,    25,     0,
+      73,    65,     0,    67,    34,    31,    98,     0,     0,   114,
+      89,     0,    85,    96,    83,     0,    23,     0,    29,    36,
+       0,    27,    28,     0,    44,    66,     0,   100,     0,   127,
+     132,   129,   121,    91,    92,    93,    24,     0,     0,     0,
+       0,    45,     0,    97,     0,   108,     0,   131,     0,     0,
+       0,    30,     0,    99,   102,     0,    76,   104,     0,   128,
+     126,    30,    30,    79,    46,     0,     0,   105,   132,    79,
+      79,    37,   101,     0,     0,     0,     0,   110,     0,   131,
+       0,    38,    35,     0,   112,   107,   103,   109,   106,   130,
+     111,     0,   113
+};
+
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
@@ -752,11 +792,20 @@ static const yytype_int16 yypgoto[] =
     -155,  -155,    76,    54,  -155,  -155,    -2,   -86
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If zero, do what YYDEFACT says.
-   If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -27
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
+{
+       0,     2,     3,     4,    13,    27,    55,    85,    86,   132,
+     156,   157,    14,    15,   178,   179,    16,    37,    38,    29,
+      92,    63,    17,    18,    31,    32,   100,   101,   102,    19,
+      20,    21,    22,    42,   121,   122,   123,   147,   172,   124,
+     187,   205,   213,   216,   217,   236,   237,   115,   116,    87,
+     168,   190,   191,   208,    76,    77,    49,   158
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
       48,    53,   133,   180,    66,   181,    95,   182,    30,    33,
@@ -823,9 +872,9 @@ static const yytype_uint8 yycheck[] =
      124,   236,   228,   207,   144
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,    31,    47,    48,    49,    48,     0,     0,     3,     6,
       10,    13,    14,    50,    58,    59,    62,    68,    69,    75,
@@ -855,104 +904,107 @@ static const yytype_uint8 yystos[] =
       95,    34,    35
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
-
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
-
-
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  However,
-   YYFAIL appears to be in use.  Nevertheless, it is formally deprecated
-   in Bison 2.4.2's NEWS entry, where a plan to phase it out is
-   discussed.  */
-
-#define YYFAIL		goto yyerrlab
-#if defined YYFAIL
-  /* This is here to suppress warnings from the GCC cpp's
-     -Wunused-macros.  Normally we don't worry about that warning, but
-     some users do, and we want to make it easy for users to remove
-     YYFAIL uses, which will produce warnings from Bison 2.5.  */
-#endif
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    46,    47,    47,    48,    49,    49,    49,    49,    49,
+      49,    49,    49,    50,    51,    52,    52,    52,    53,    53,
+      54,    54,    55,    55,    55,    56,    56,    57,    57,    57,
+      57,    58,    58,    59,    59,    60,    60,    61,    61,    62,
+      63,    64,    65,    65,    66,    66,    66,    67,    67,    67,
+      67,    67,    67,    68,    68,    68,    68,    68,    69,    69,
+      70,    70,    71,    71,    72,    72,    72,    73,    73,    74,
+      74,    74,    74,    74,    75,    76,    77,    77,    78,    78,
+      79,    80,    80,    81,    81,    82,    82,    82,    82,    83,
+      83,    84,    84,    84,    84,    85,    85,    86,    86,    87,
+      87,    88,    88,    89,    89,    90,    90,    90,    90,    91,
+      91,    92,    92,    92,    93,    93,    94,    94,    95,    95,
+      95,    95,    95,    95,    95,    95,    96,    96,    97,    97,
+      98,    99,    99,   100,   100,   101,   101,   102,   102,   103,
+     103
+};
 
-#define YYRECOVERING()  (!!yyerrstatus)
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     2,     3,     1,     2,     2,     2,     2,     2,
+       2,     2,     0,     5,     1,     3,     2,     0,     3,     1,
+       1,     3,     1,     3,     4,     1,     1,     2,     2,     2,
+       0,     6,     1,     5,     6,     6,     1,     5,     6,     2,
+       2,     1,     3,     3,     4,     5,     7,     1,     1,     1,
+       1,     1,     1,     3,     3,     5,     3,     5,     2,     4,
+       3,     1,     1,     3,     1,     3,     4,     3,     1,     1,
+       1,     1,     1,     3,     3,     6,     9,     4,     2,     0,
+       2,     1,     0,     3,     1,     3,     1,     2,     1,     2,
+       0,     2,     2,     2,     0,     2,     3,     2,     0,     2,
+       0,     3,     1,     4,     1,     2,     4,     4,     0,     2,
+       1,     3,     2,     4,     3,     1,     1,     1,     1,     4,
+       3,     6,     3,     3,     1,     1,     4,     2,     3,     1,
+       6,     1,     0,     1,     0,     3,     1,     1,     3,     1,
+       1
+};
+
+
+enum { YYENOMEM = -2 };
 
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      yytoken = YYTRANSLATE (yychar);				\
-      YYPOPSTACK (1);						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (&yylloc, scanner, ctx, YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
-#define YYTERROR	1
-#define YYERRCODE	256
 
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (&yylloc, lexer, ctx, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
    the previous symbol: RHS[0] (always defined).  */
 
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
 #ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (YYID (N))                                                    \
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (YYID (0))
+# define YYLLOC_DEFAULT(Current, Rhs, N)                                \
+    do                                                                  \
+      if (N)                                                            \
+        {                                                               \
+          (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;        \
+          (Current).first_column = YYRHSLOC (Rhs, 1).first_column;      \
+          (Current).last_line    = YYRHSLOC (Rhs, N).last_line;         \
+          (Current).last_column  = YYRHSLOC (Rhs, N).last_column;       \
+        }                                                               \
+      else                                                              \
+        {                                                               \
+          (Current).first_line   = (Current).last_line   =              \
+            YYRHSLOC (Rhs, 0).last_line;                                \
+          (Current).first_column = (Current).last_column =              \
+            YYRHSLOC (Rhs, 0).last_column;                              \
+        }                                                               \
+    while (0)
 #endif
 
+#define YYRHSLOC(Rhs, K) ((Rhs)[K])
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
-   This macro was not mandated originally: define only if we know
-   we won't break user code: when these are the locations we know.  */
-
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
-#  define YY_LOCATION_PRINT(File, Loc)			\
-     fprintf (File, "%d.%d-%d.%d",			\
-	      (Loc).first_line, (Loc).first_column,	\
-	      (Loc).last_line,  (Loc).last_column)
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
-
-
-/* YYLEX -- calling `yylex' with the right arguments.  */
-
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (&yylval, &yylloc, YYLEX_PARAM)
-#else
-# define YYLEX yylex (&yylval, &yylloc, scanner)
-#endif
 
 /* Enable debugging if requested.  */
 #if YYDEBUG
@@ -962,91 +1014,120 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value, Location, scanner, ctx); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, void* scanner, pytype::Context* ctx)
-#else
-static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep, yylocationp, scanner, ctx)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-    YYLTYPE const * const yylocationp;
-    void* scanner;
-    pytype::Context* ctx;
-#endif
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+/* YYLOCATION_PRINT -- Print the location on the stream.
+   This macro was not mandated originally: define only if we know
+   we won't break user code: when these are the locations we know.  */
+
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+
+/* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
+
+YY_ATTRIBUTE_UNUSED
+static int
+yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
 {
-  if (!yyvaluep)
-    return;
-  YYUSE (yylocationp);
-  YYUSE (scanner);
-  YYUSE (ctx);
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
+  int res = 0;
+  int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
+  if (0 <= yylocp->first_line)
     {
-      default:
-	break;
+      res += YYFPRINTF (yyo, "%d", yylocp->first_line);
+      if (0 <= yylocp->first_column)
+        res += YYFPRINTF (yyo, ".%d", yylocp->first_column);
     }
+  if (0 <= yylocp->last_line)
+    {
+      if (yylocp->first_line < yylocp->last_line)
+        {
+          res += YYFPRINTF (yyo, "-%d", yylocp->last_line);
+          if (0 <= end_col)
+            res += YYFPRINTF (yyo, ".%d", end_col);
+        }
+      else if (0 <= end_col && yylocp->first_column < end_col)
+        res += YYFPRINTF (yyo, "-%d", end_col);
+    }
+  return res;
 }
 
+#   define YYLOCATION_PRINT  yy_location_print_
+
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, Location, lexer, ctx); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, void* scanner, pytype::Context* ctx)
-#else
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, pytype::Lexer* lexer, pytype::Context* ctx)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (lexer);
+  YY_USE (ctx);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
 static void
-yy_symbol_print (yyoutput, yytype, yyvaluep, yylocationp, scanner, ctx)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-    YYLTYPE const * const yylocationp;
-    void* scanner;
-    pytype::Context* ctx;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, pytype::Lexer* lexer, pytype::Context* ctx)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyoutput, *yylocationp);
-  YYFPRINTF (yyoutput, ": ");
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep, yylocationp, scanner, ctx);
-  YYFPRINTF (yyoutput, ")");
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, lexer, ctx);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1054,16 +1135,8 @@ yy_symbol_print (yyoutput, yytype, yyvaluep, yylocationp, scanner, ctx)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
-#else
-static void
-yy_stack_print (yybottom, yytop)
-    yytype_int16 *yybottom;
-    yytype_int16 *yytop;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -1074,66 +1147,57 @@ yy_stack_print (yybottom, yytop)
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_reduce_print (YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule, void* scanner, pytype::Context* ctx)
-#else
-static void
-yy_reduce_print (yyvsp, yylsp, yyrule, scanner, ctx)
-    YYSTYPE *yyvsp;
-    YYLTYPE *yylsp;
-    int yyrule;
-    void* scanner;
-    pytype::Context* ctx;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, pytype::Lexer* lexer, pytype::Context* ctx)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       , &(yylsp[(yyi + 1) - (yynrhs)])		       , scanner, ctx);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), lexer, ctx);
       YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, yylsp, Rule, scanner, ctx); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule, lexer, ctx); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -1148,49 +1212,82 @@ int yydebug;
 # define YYMAXDEPTH 10000
 #endif
 
-
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
+static YYPTRDIFF_T
 yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
 {
-  YYSIZE_T yylen;
+  YYPTRDIFF_T yylen;
   for (yylen = 0; yystr[yylen]; yylen++)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static char *
 yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
 {
   char *yyd = yydest;
   const char *yys = yysrc;
@@ -1200,10 +1297,10 @@ yystpcpy (yydest, yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -1211,811 +1308,607 @@ yystpcpy (yydest, yysrc)
    backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
    null, do not copy; instead, return the length of what the result
    would have been.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yytnamerr (char *yyres, const char *yystr)
 {
   if (*yystr == '"')
     {
-      YYSIZE_T yyn = 0;
+      YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
+        switch (*++yyp)
+          {
+          case '\'':
+          case ',':
+            goto do_not_strip_quotes;
+
+          case '\\':
+            if (*++yyp != '\\')
+              goto do_not_strip_quotes;
+            else
+              goto append;
+
+          append:
+          default:
+            if (yyres)
+              yyres[yyn] = *yyp;
+            yyn++;
+            break;
+
+          case '"':
+            if (yyres)
+              yyres[yyn] = '\0';
+            return yyn;
+          }
     do_not_strip_quotes: ;
     }
 
-  if (! yyres)
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
     return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
 }
-# endif
+#endif
 
-/* Copy into YYRESULT an error message about the unexpected token
-   YYCHAR while in state YYSTATE.  Return the number of bytes copied,
-   including the terminating null byte.  If YYRESULT is null, do not
-   copy anything; just return the number of bytes that would be
-   copied.  As a special case, return 0 if an ordinary "syntax error"
-   message will do.  Return YYSIZE_MAXIMUM if overflow occurs during
-   size calculation.  */
-static YYSIZE_T
-yysyntax_error (char *yyresult, int yystate, int yychar)
-{
-  int yyn = yypact[yystate];
 
-  if (! (YYPACT_NINF < yyn && yyn <= YYLAST))
-    return 0;
-  else
+static int
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  /* There are many possibilities here to consider:
+     - If this state is a consistent state with a default action, then
+       the only way this function was invoked is if the default action
+       is an error action.  In that case, don't check for expected
+       tokens because there are none.
+     - The only way there can be no lookahead present (in yychar) is if
+       this state is a consistent state with a default action.  Thus,
+       detecting the absence of a lookahead is sufficient to determine
+       that there is no unexpected or expected token to report.  In that
+       case, just report a simple "syntax error".
+     - Don't assume there isn't a lookahead just because this state is a
+       consistent state with a default action.  There might have been a
+       previous inconsistent state, consistent state with a non-default
+       action, or user semantic action that manipulated yychar.
+     - Of course, the expected token list depends on states to have
+       correct lookahead information, and it depends on the parser not
+       to perform extra reductions after fetching a lookahead from the
+       scanner and before detecting a syntax error.  Thus, state merging
+       (from LALR or IELR) and default reductions corrupt the expected
+       token list.  However, the list is correct for canonical LR with
+       one exception: it will still contain any token that will not be
+       accepted due to an error action in a later state.
+  */
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
     {
-      int yytype = YYTRANSLATE (yychar);
-      YYSIZE_T yysize0 = yytnamerr (0, yytname[yytype]);
-      YYSIZE_T yysize = yysize0;
-      YYSIZE_T yysize1;
-      int yysize_overflow = 0;
-      enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-      char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-      int yyx;
-
-# if 0
-      /* This is so xgettext sees the translatable formats that are
-	 constructed on the fly.  */
-      YY_("syntax error, unexpected %s");
-      YY_("syntax error, unexpected %s, expecting %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s");
-# endif
-      char *yyfmt;
-      char const *yyf;
-      static char const yyunexpected[] = "syntax error, unexpected %s";
-      static char const yyexpecting[] = ", expecting %s";
-      static char const yyor[] = " or %s";
-      char yyformat[sizeof yyunexpected
-		    + sizeof yyexpecting - 1
-		    + ((YYERROR_VERBOSE_ARGS_MAXIMUM - 2)
-		       * (sizeof yyor - 1))];
-      char const *yyprefix = yyexpecting;
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
+    }
+  return yycount;
+}
 
-      /* Start YYX at -YYN if negative to avoid negative indexes in
-	 YYCHECK.  */
-      int yyxbegin = yyn < 0 ? -yyn : 0;
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
 
-      /* Stay within bounds of both yycheck and yytname.  */
-      int yychecklim = YYLAST - yyn + 1;
-      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-      int yycount = 1;
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
+
+  switch (yycount)
+    {
+#define YYCASE_(N, S)                       \
+      case N:                               \
+        yyformat = S;                       \
+        break
+    default: /* Avoid compiler warnings. */
+      YYCASE_(0, YY_("syntax error"));
+      YYCASE_(1, YY_("syntax error, unexpected %s"));
+      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
+      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
+      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
+      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
+#undef YYCASE_
+    }
 
-      yyarg[0] = yytname[yytype];
-      yyfmt = yystpcpy (yyformat, yyunexpected);
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
+  {
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
+  }
 
-      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-	if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR)
-	  {
-	    if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-	      {
-		yycount = 1;
-		yysize = yysize0;
-		yyformat[sizeof yyunexpected - 1] = '\0';
-		break;
-	      }
-	    yyarg[yycount++] = yytname[yyx];
-	    yysize1 = yysize + yytnamerr (0, yytname[yyx]);
-	    yysize_overflow |= (yysize1 < yysize);
-	    yysize = yysize1;
-	    yyfmt = yystpcpy (yyfmt, yyprefix);
-	    yyprefix = yyor;
-	  }
-
-      yyf = YY_(yyformat);
-      yysize1 = yysize + yystrlen (yyf);
-      yysize_overflow |= (yysize1 < yysize);
-      yysize = yysize1;
-
-      if (yysize_overflow)
-	return YYSIZE_MAXIMUM;
-
-      if (yyresult)
-	{
-	  /* Avoid sprintf, as that infringes on the user's name space.
-	     Don't have undefined behavior even if the translation
-	     produced a string with the wrong number of "%s"s.  */
-	  char *yyp = yyresult;
-	  int yyi = 0;
-	  while ((*yyp = *yyf) != '\0')
-	    {
-	      if (*yyp == '%' && yyf[1] == 's' && yyi < yycount)
-		{
-		  yyp += yytnamerr (yyp, yyarg[yyi++]);
-		  yyf += 2;
-		}
-	      else
-		{
-		  yyp++;
-		  yyf++;
-		}
-	    }
-	}
-      return yysize;
+  if (*yymsg_alloc < yysize)
+    {
+      *yymsg_alloc = 2 * yysize;
+      if (! (yysize <= *yymsg_alloc
+             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
+        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
+      return -1;
     }
+
+  /* Avoid sprintf, as that infringes on the user's name space.
+     Don't have undefined behavior even if the translation
+     produced a string with the wrong number of "%s"s.  */
+  {
+    char *yyp = *yymsg;
+    int yyi = 0;
+    while ((*yyp = *yyformat) != '\0')
+      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
+        {
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
+          yyformat += 2;
+        }
+      else
+        {
+          ++yyp;
+          ++yyformat;
+        }
+  }
+  return 0;
 }
-#endif /* YYERROR_VERBOSE */
-
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, void* scanner, pytype::Context* ctx)
-#else
-static void
-yydestruct (yymsg, yytype, yyvaluep, yylocationp, scanner, ctx)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-    YYLTYPE *yylocationp;
-    void* scanner;
-    pytype::Context* ctx;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, pytype::Lexer* lexer, pytype::Context* ctx)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
-  YYUSE (scanner);
-  YYUSE (ctx);
-
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (lexer);
+  YY_USE (ctx);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-  switch (yytype)
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  switch (yykind)
     {
-      case 3: /* "NAME" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1403 "pyi/parser.tab.cc"
-	break;
-      case 4: /* "NUMBER" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1412 "pyi/parser.tab.cc"
-	break;
-      case 5: /* "LEXERROR" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1421 "pyi/parser.tab.cc"
-	break;
-      case 47: /* "start" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1430 "pyi/parser.tab.cc"
-	break;
-      case 48: /* "unit" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1439 "pyi/parser.tab.cc"
-	break;
-      case 49: /* "alldefs" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1448 "pyi/parser.tab.cc"
-	break;
-      case 50: /* "classdef" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1457 "pyi/parser.tab.cc"
-	break;
-      case 51: /* "class_name" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1466 "pyi/parser.tab.cc"
-	break;
-      case 52: /* "parents" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1475 "pyi/parser.tab.cc"
-	break;
-      case 53: /* "parent_list" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1484 "pyi/parser.tab.cc"
-	break;
-      case 54: /* "parent" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1493 "pyi/parser.tab.cc"
-	break;
-      case 55: /* "maybe_class_funcs" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1502 "pyi/parser.tab.cc"
-	break;
-      case 56: /* "class_funcs" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
+    case YYSYMBOL_NUMBER: /* NUMBER  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
 #line 1511 "pyi/parser.tab.cc"
-	break;
-      case 57: /* "funcdefs" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1520 "pyi/parser.tab.cc"
-	break;
-      case 58: /* "if_stmt" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
+        break;
+
+    case YYSYMBOL_LEXERROR: /* LEXERROR  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1517 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_start: /* start  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1523 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_unit: /* unit  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
 #line 1529 "pyi/parser.tab.cc"
-	break;
-      case 59: /* "if_and_elifs" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1538 "pyi/parser.tab.cc"
-	break;
-      case 60: /* "class_if_stmt" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
+        break;
+
+    case YYSYMBOL_alldefs: /* alldefs  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1535 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_classdef: /* classdef  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1541 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_class_name: /* class_name  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
 #line 1547 "pyi/parser.tab.cc"
-	break;
-      case 61: /* "class_if_and_elifs" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1556 "pyi/parser.tab.cc"
-	break;
-      case 62: /* "if_cond" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
+        break;
+
+    case YYSYMBOL_parents: /* parents  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1553 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_parent_list: /* parent_list  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1559 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_parent: /* parent  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
 #line 1565 "pyi/parser.tab.cc"
-	break;
-      case 63: /* "elif_cond" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1574 "pyi/parser.tab.cc"
-	break;
-      case 64: /* "else_cond" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
+        break;
+
+    case YYSYMBOL_maybe_class_funcs: /* maybe_class_funcs  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1571 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_class_funcs: /* class_funcs  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1577 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_funcdefs: /* funcdefs  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
 #line 1583 "pyi/parser.tab.cc"
-	break;
-      case 65: /* "condition" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1592 "pyi/parser.tab.cc"
-	break;
-      case 66: /* "version_tuple" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
+        break;
+
+    case YYSYMBOL_if_stmt: /* if_stmt  */
+#line 161 "pyi/parser.y"
+            { ctx->DropCondition(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1589 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_if_and_elifs: /* if_and_elifs  */
+#line 160 "pyi/parser.y"
+            { ctx->DropCondition(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1595 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_class_if_stmt: /* class_if_stmt  */
+#line 163 "pyi/parser.y"
+            { ctx->DropCondition(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
 #line 1601 "pyi/parser.tab.cc"
-	break;
-      case 67: /* "condition_op" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->str)); };
-
-/* Line 1009 of yacc.c  */
-#line 1610 "pyi/parser.tab.cc"
-	break;
-      case 68: /* "constantdef" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
+        break;
+
+    case YYSYMBOL_class_if_and_elifs: /* class_if_and_elifs  */
+#line 162 "pyi/parser.y"
+            { ctx->DropCondition(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1607 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_if_cond: /* if_cond  */
+#line 160 "pyi/parser.y"
+            { ctx->DropCondition(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1613 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_elif_cond: /* elif_cond  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
 #line 1619 "pyi/parser.tab.cc"
-	break;
-      case 69: /* "importdef" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1628 "pyi/parser.tab.cc"
-	break;
-      case 70: /* "import_items" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
+        break;
+
+    case YYSYMBOL_else_cond: /* else_cond  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1625 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_condition: /* condition  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1631 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_version_tuple: /* version_tuple  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
 #line 1637 "pyi/parser.tab.cc"
-	break;
-      case 71: /* "import_item" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1646 "pyi/parser.tab.cc"
-	break;
-      case 72: /* "from_list" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
+        break;
+
+    case YYSYMBOL_constantdef: /* constantdef  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1643 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_importdef: /* importdef  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1649 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_import_items: /* import_items  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
 #line 1655 "pyi/parser.tab.cc"
-	break;
-      case 73: /* "from_items" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1664 "pyi/parser.tab.cc"
-	break;
-      case 74: /* "from_item" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
+        break;
+
+    case YYSYMBOL_import_item: /* import_item  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1661 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_from_list: /* from_list  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1667 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_from_items: /* from_items  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
 #line 1673 "pyi/parser.tab.cc"
-	break;
-      case 75: /* "alias_or_constant" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1682 "pyi/parser.tab.cc"
-	break;
-      case 76: /* "typevardef" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
+        break;
+
+    case YYSYMBOL_from_item: /* from_item  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1679 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_alias_or_constant: /* alias_or_constant  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1685 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_typevardef: /* typevardef  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
 #line 1691 "pyi/parser.tab.cc"
-	break;
-      case 77: /* "funcdef" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1700 "pyi/parser.tab.cc"
-	break;
-      case 78: /* "decorators" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
+        break;
+
+    case YYSYMBOL_funcdef: /* funcdef  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1697 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_decorators: /* decorators  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1703 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_decorator: /* decorator  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
 #line 1709 "pyi/parser.tab.cc"
-	break;
-      case 79: /* "decorator" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1718 "pyi/parser.tab.cc"
-	break;
-      case 80: /* "params" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
+        break;
+
+    case YYSYMBOL_params: /* params  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1715 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_param_list: /* param_list  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1721 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_param: /* param  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
 #line 1727 "pyi/parser.tab.cc"
-	break;
-      case 81: /* "param_list" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1736 "pyi/parser.tab.cc"
-	break;
-      case 82: /* "param" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
+        break;
+
+    case YYSYMBOL_param_type: /* param_type  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1733 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_param_default: /* param_default  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1739 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_param_star_name: /* param_star_name  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
 #line 1745 "pyi/parser.tab.cc"
-	break;
-      case 83: /* "param_type" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1754 "pyi/parser.tab.cc"
-	break;
-      case 84: /* "param_default" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
+        break;
+
+    case YYSYMBOL_return: /* return  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1751 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_raises: /* raises  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1757 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_exceptions: /* exceptions  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
 #line 1763 "pyi/parser.tab.cc"
-	break;
-      case 85: /* "param_star_name" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1772 "pyi/parser.tab.cc"
-	break;
-      case 86: /* "return" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
+        break;
+
+    case YYSYMBOL_maybe_body: /* maybe_body  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1769 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_body: /* body  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1775 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_body_stmt: /* body_stmt  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
 #line 1781 "pyi/parser.tab.cc"
-	break;
-      case 87: /* "raises" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1790 "pyi/parser.tab.cc"
-	break;
-      case 88: /* "exceptions" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
+        break;
+
+    case YYSYMBOL_type_parameters: /* type_parameters  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1787 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_type_parameter: /* type_parameter  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1793 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_type: /* type  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
 #line 1799 "pyi/parser.tab.cc"
-	break;
-      case 89: /* "maybe_body" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1808 "pyi/parser.tab.cc"
-	break;
-      case 91: /* "body" */
+        break;
+
+    case YYSYMBOL_named_tuple_fields: /* named_tuple_fields  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1805 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_named_tuple_field_list: /* named_tuple_field_list  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1811 "pyi/parser.tab.cc"
+        break;
+
+    case YYSYMBOL_named_tuple_field: /* named_tuple_field  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1817 "pyi/parser.tab.cc"
+        break;
 
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
+    case YYSYMBOL_maybe_type_list: /* maybe_type_list  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1823 "pyi/parser.tab.cc"
+        break;
 
-/* Line 1009 of yacc.c  */
-#line 1817 "pyi/parser.tab.cc"
-	break;
-      case 92: /* "body_stmt" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1826 "pyi/parser.tab.cc"
-	break;
-      case 93: /* "type_parameters" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1835 "pyi/parser.tab.cc"
-	break;
-      case 94: /* "type_parameter" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1844 "pyi/parser.tab.cc"
-	break;
-      case 95: /* "type" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1853 "pyi/parser.tab.cc"
-	break;
-      case 96: /* "named_tuple_fields" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1862 "pyi/parser.tab.cc"
-	break;
-      case 97: /* "named_tuple_field_list" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1871 "pyi/parser.tab.cc"
-	break;
-      case 98: /* "named_tuple_field" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1880 "pyi/parser.tab.cc"
-	break;
-      case 100: /* "maybe_type_list" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1889 "pyi/parser.tab.cc"
-	break;
-      case 101: /* "type_list" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1898 "pyi/parser.tab.cc"
-	break;
-      case 102: /* "dotted_name" */
-
-/* Line 1009 of yacc.c  */
-#line 94 "parser.y"
-	{ Py_CLEAR((yyvaluep->obj)); };
-
-/* Line 1009 of yacc.c  */
-#line 1907 "pyi/parser.tab.cc"
-	break;
+    case YYSYMBOL_type_list: /* type_list  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1829 "pyi/parser.tab.cc"
+        break;
 
       default:
-	break;
+        break;
     }
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
-/* Prevent warnings from -Wmissing-prototypes.  */
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void* scanner, pytype::Context* ctx);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
-
-
-
-
 
-/*-------------------------.
-| yyparse or yypush_parse.  |
-`-------------------------*/
-
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void* scanner, pytype::Context* ctx)
-#else
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
 int
-yyparse (scanner, ctx)
-    void* scanner;
-    pytype::Context* ctx;
-#endif
-#endif
+yyparse (pytype::Lexer* lexer, pytype::Context* ctx)
 {
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
+
 /* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
 
 /* Location data for the lookahead symbol.  */
-YYLTYPE yylloc;
+static YYLTYPE yyloc_default
+# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+YYLTYPE yylloc = yyloc_default;
 
     /* Number of syntax errors so far.  */
-    int yynerrs;
+    int yynerrs = 0;
 
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+    int yyerrstatus = 0;
 
-    /* The stacks and their tools:
-       `yyss': related to states.
-       `yyvs': related to semantic values.
-       `yyls': related to locations.
-
-       Refer to the stacks thru separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    /* The semantic value stack.  */
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-    /* The location stack.  */
+    /* The location stack: array, bottom, top.  */
     YYLTYPE yylsa[YYINITDEPTH];
-    YYLTYPE *yyls;
-    YYLTYPE *yylsp;
-
-    /* The locations where the error started and ended.  */
-    YYLTYPE yyerror_range[2];
-
-    YYSIZE_T yystacksize;
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
-#if YYERROR_VERBOSE
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
 
@@ -2023,146 +1916,147 @@ YYLTYPE yylloc;
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yytoken = 0;
-  yyss = yyssa;
-  yyvs = yyvsa;
-  yyls = yylsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
 
-  /* Initialize stack pointers.
-     Waste one element of value and location stack
-     so that they stay on the same level as the state stack.
-     The wasted elements are never initialized.  */
-  yyssp = yyss;
-  yyvsp = yyvs;
-  yylsp = yyls;
-
-#if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
-  /* Initialize the default location before parsing starts.  */
-  yylloc.first_line   = yylloc.last_line   = 1;
-  yylloc.first_column = yylloc.last_column = 1;
-#endif
-
+  yylsp[0] = yylloc;
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-	YYLTYPE *yyls1 = yyls;
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-		    &yyls1, yysize * sizeof (*yylsp),
-		    &yystacksize);
-
-	yyls = yyls1;
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+        YYLTYPE *yyls1 = yyls;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+        yyls = yyls1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss_alloc, yyss);
-	YYSTACK_RELOCATE (yyvs_alloc, yyvs);
-	YYSTACK_RELOCATE (yyls_alloc, yyls);
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        YYSTACK_RELOCATE (yyls_alloc, yyls);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
       yylsp = yyls + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
   /* First try to decide what to do without reference to lookahead token.  */
   yyn = yypact[yystate];
-  if (yyn == YYPACT_NINF)
+  if (yypact_value_is_default (yyn))
     goto yydefault;
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, &yylloc, lexer, ctx);
     }
 
-  if (yychar <= YYEOF)
+  if (yychar <= END)
     {
-      yychar = yytoken = YYEOF;
+      yychar = END;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -2177,8 +2071,8 @@ yybackup:
   yyn = yytable[yyn];
   if (yyn <= 0)
     {
-      if (yyn == 0 || yyn == YYTABLE_NINF)
-	goto yyerrlab;
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
       yyn = -yyn;
       goto yyreduce;
     }
@@ -2190,13 +2084,14 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
   *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -2211,14 +2106,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -2227,549 +2122,505 @@ yyreduce:
      GCC warning that YYVAL may be used uninitialized.  */
   yyval = yyvsp[1-yylen];
 
-  /* Default location.  */
+  /* Default location. */
   YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-
-/* Line 1464 of yacc.c  */
-#line 127 "parser.y"
-    { ctx->SetAndDelResult((yyvsp[(1) - (2)].obj)); (yyval.obj) = NULL; ;}
+  case 2: /* start: unit "end of file"  */
+#line 204 "pyi/parser.y"
+             { ctx->SetResult((yyvsp[-1].obj)); (yyval.obj) = NULL; }
+#line 2135 "pyi/parser.tab.cc"
     break;
 
-  case 3:
-
-/* Line 1464 of yacc.c  */
-#line 128 "parser.y"
-    { ctx->SetAndDelResult((yyvsp[(2) - (3)].obj)); (yyval.obj) = NULL; ;}
+  case 3: /* start: TRIPLEQUOTED unit "end of file"  */
+#line 205 "pyi/parser.y"
+                          { ctx->SetResult((yyvsp[-1].obj)); (yyval.obj) = NULL; }
+#line 2141 "pyi/parser.tab.cc"
     break;
 
-  case 5:
-
-/* Line 1464 of yacc.c  */
-#line 136 "parser.y"
-    { (yyval.obj) = AppendList((yyvsp[(1) - (2)].obj), (yyvsp[(2) - (2)].obj)); ;}
+  case 4: /* unit: alldefs  */
+#line 209 "pyi/parser.y"
+            { (yyval.obj) = ctx->Sequence((yyvsp[0].list)); }
+#line 2147 "pyi/parser.tab.cc"
     break;
 
-  case 6:
-
-/* Line 1464 of yacc.c  */
-#line 137 "parser.y"
-    { (yyval.obj) = AppendList((yyvsp[(1) - (2)].obj), (yyvsp[(2) - (2)].obj)); ;}
+  case 5: /* alldefs: alldefs constantdef  */
+#line 213 "pyi/parser.y"
+                        { (yyval.list) = ctx->AppendList((yyvsp[-1].list), (yyvsp[0].obj)); }
+#line 2153 "pyi/parser.tab.cc"
     break;
 
-  case 7:
-
-/* Line 1464 of yacc.c  */
-#line 138 "parser.y"
-    { (yyval.obj) = (yyvsp[(1) - (2)].obj); Py_DECREF((yyvsp[(2) - (2)].obj)); ;}
+  case 6: /* alldefs: alldefs funcdef  */
+#line 214 "pyi/parser.y"
+                    { (yyval.list) = ctx->AppendList((yyvsp[-1].list), (yyvsp[0].obj)); }
+#line 2159 "pyi/parser.tab.cc"
     break;
 
-  case 8:
-
-/* Line 1464 of yacc.c  */
-#line 139 "parser.y"
-    { (yyval.obj) = (yyvsp[(1) - (2)].obj); Py_DECREF((yyvsp[(2) - (2)].obj)); ;}
+  case 7: /* alldefs: alldefs importdef  */
+#line 215 "pyi/parser.y"
+                      { (yyval.list) = (yyvsp[-1].list); ctx->Drop((yyvsp[0].obj)); }
+#line 2165 "pyi/parser.tab.cc"
     break;
 
-  case 9:
-
-/* Line 1464 of yacc.c  */
-#line 140 "parser.y"
-    { (yyval.obj) = (yyvsp[(1) - (2)].obj); Py_DECREF((yyvsp[(2) - (2)].obj)); ;}
+  case 8: /* alldefs: alldefs alias_or_constant  */
+#line 216 "pyi/parser.y"
+                              { (yyval.list) = (yyvsp[-1].list); ctx->Drop((yyvsp[0].obj)); }
+#line 2171 "pyi/parser.tab.cc"
     break;
 
-  case 10:
-
-/* Line 1464 of yacc.c  */
-#line 141 "parser.y"
-    { (yyval.obj) = (yyvsp[(1) - (2)].obj); Py_DECREF((yyvsp[(2) - (2)].obj)); ;}
+  case 9: /* alldefs: alldefs classdef  */
+#line 217 "pyi/parser.y"
+                     { (yyval.list) = (yyvsp[-1].list); ctx->Drop((yyvsp[0].obj)); }
+#line 2177 "pyi/parser.tab.cc"
     break;
 
-  case 11:
-
-/* Line 1464 of yacc.c  */
-#line 142 "parser.y"
-    {
-      PyObject* tmp = ctx->Call(kIfEnd, "(N)", (yyvsp[(2) - (2)].obj));
-      CHECK(tmp, (yylsp[(2) - (2)]));
-      (yyval.obj) = ExtendList((yyvsp[(1) - (2)].obj), tmp);
-    ;}
+  case 10: /* alldefs: alldefs typevardef  */
+#line 218 "pyi/parser.y"
+                       { (yyval.list) = (yyvsp[-1].list); ctx->Drop((yyvsp[0].obj)); }
+#line 2183 "pyi/parser.tab.cc"
     break;
 
-  case 12:
-
-/* Line 1464 of yacc.c  */
-#line 147 "parser.y"
-    { (yyval.obj) = PyList_New(0); ;}
+  case 11: /* alldefs: alldefs if_stmt  */
+#line 219 "pyi/parser.y"
+                    {
+      Handle tmp = ctx->IfEnd(ctx->Sequence((yyvsp[0].list)));
+      CHECK(tmp, (yylsp[0]));
+      (yyval.list) = ctx->ExtendList((yyvsp[-1].list), tmp);
+    }
+#line 2193 "pyi/parser.tab.cc"
     break;
 
-  case 13:
+  case 12: /* alldefs: %empty  */
+#line 225 "pyi/parser.y"
+    { (yyval.list) = ctx->List(); }
+#line 2199 "pyi/parser.tab.cc"
+    break;
 
-/* Line 1464 of yacc.c  */
-#line 151 "parser.y"
-    {
-      (yyval.obj) = ctx->Call(kAddClass, "(NNN)", (yyvsp[(2) - (5)].obj), (yyvsp[(3) - (5)].obj), (yyvsp[(5) - (5)].obj));
+  case 13: /* classdef: CLASS class_name parents ':' maybe_class_funcs  */
+#line 229 "pyi/parser.y"
+                                                   {
+      (yyval.obj) = ctx->AddClass((yyvsp[-3].obj), ctx->Sequence((yyvsp[-2].list)), ctx->Sequence((yyvsp[0].list)));
       CHECK((yyval.obj), (yyloc));
-    ;}
+    }
+#line 2208 "pyi/parser.tab.cc"
     break;
 
-  case 14:
-
-/* Line 1464 of yacc.c  */
-#line 158 "parser.y"
-    {
-      // Do not borrow the $1 reference since it is also returned later
-      // in $$.  Use O instead of N in the format string.
-      PyObject* tmp = ctx->Call(kRegisterClassName, "(O)", (yyvsp[(1) - (1)].obj));
+  case 14: /* class_name: NAME  */
+#line 236 "pyi/parser.y"
+         {
+      // Do not give away $$ since it is also the value of the rule.
+      (yyval.obj) = ctx->Name((yyvsp[0].name), lexer);
+      Handle tmp = ctx->RegisterClassName(ctx->Dup((yyval.obj)));
       CHECK(tmp, (yyloc));
-      Py_DECREF(tmp);
-      (yyval.obj) = (yyvsp[(1) - (1)].obj);
-    ;}
+      ctx->Drop(tmp);
+    }
+#line 2220 "pyi/parser.tab.cc"
     break;
 
-  case 15:
-
-/* Line 1464 of yacc.c  */
-#line 169 "parser.y"
-    { (yyval.obj) = (yyvsp[(2) - (3)].obj); ;}
+  case 15: /* parents: '(' parent_list ')'  */
+#line 246 "pyi/parser.y"
+                        { (yyval.list) = (yyvsp[-1].list); }
+#line 2226 "pyi/parser.tab.cc"
     break;
 
-  case 16:
-
-/* Line 1464 of yacc.c  */
-#line 170 "parser.y"
-    { (yyval.obj) = PyList_New(0); ;}
+  case 16: /* parents: '(' ')'  */
+#line 247 "pyi/parser.y"
+            { (yyval.list) = ctx->List(); }
+#line 2232 "pyi/parser.tab.cc"
     break;
 
-  case 17:
-
-/* Line 1464 of yacc.c  */
-#line 171 "parser.y"
-    { (yyval.obj) = PyList_New(0); ;}
+  case 17: /* parents: %empty  */
+#line 248 "pyi/parser.y"
+                 { (yyval.list) = ctx->List(); }
+#line 2238 "pyi/parser.tab.cc"
     break;
 
-  case 18:
-
-/* Line 1464 of yacc.c  */
-#line 175 "parser.y"
-    { (yyval.obj) = AppendList((yyvsp[(1) - (3)].obj), (yyvsp[(3) - (3)].obj)); ;}
+  case 18: /* parent_list: parent_list ',' parent  */
+#line 252 "pyi/parser.y"
+                           { (yyval.list) = ctx->AppendList((yyvsp[-2].list), (yyvsp[0].obj)); }
+#line 2244 "pyi/parser.tab.cc"
     break;
 
-  case 19:
-
-/* Line 1464 of yacc.c  */
-#line 176 "parser.y"
-    { (yyval.obj) = StartList((yyvsp[(1) - (1)].obj)); ;}
+  case 19: /* parent_list: parent  */
+#line 253 "pyi/parser.y"
+           { (yyval.list) = ctx->StartList((yyvsp[0].obj)); }
+#line 2250 "pyi/parser.tab.cc"
     break;
 
-  case 20:
-
-/* Line 1464 of yacc.c  */
-#line 180 "parser.y"
-    { (yyval.obj) = (yyvsp[(1) - (1)].obj); ;}
+  case 20: /* parent: type  */
+#line 257 "pyi/parser.y"
+         { (yyval.obj) = (yyvsp[0].obj); }
+#line 2256 "pyi/parser.tab.cc"
     break;
 
-  case 21:
-
-/* Line 1464 of yacc.c  */
-#line 181 "parser.y"
-    { (yyval.obj) = Py_BuildValue("(NN)", (yyvsp[(1) - (3)].obj), (yyvsp[(3) - (3)].obj)); ;}
+  case 21: /* parent: NAME '=' type  */
+#line 258 "pyi/parser.y"
+                  { (yyval.obj) = ctx->Tuple(ctx->Name((yyvsp[-2].name), lexer), (yyvsp[0].obj)); }
+#line 2262 "pyi/parser.tab.cc"
     break;
 
-  case 22:
-
-/* Line 1464 of yacc.c  */
-#line 185 "parser.y"
-    { (yyval.obj) = PyList_New(0); ;}
+  case 22: /* maybe_class_funcs: pass_or_ellipsis  */
+#line 262 "pyi/parser.y"
+                     { (yyval.list) = ctx->List(); }
+#line 2268 "pyi/parser.tab.cc"
     break;
 
-  case 23:
-
-/* Line 1464 of yacc.c  */
-#line 186 "parser.y"
-    { (yyval.obj) = (yyvsp[(2) - (3)].obj); ;}
+  case 23: /* maybe_class_funcs: INDENT class_funcs DEDENT  */
+#line 263 "pyi/parser.y"
+                              { (yyval.list) = (yyvsp[-1].list); }
+#line 2274 "pyi/parser.tab.cc"
     break;
 
-  case 24:
-
-/* Line 1464 of yacc.c  */
-#line 187 "parser.y"
-    { (yyval.obj) = (yyvsp[(3) - (4)].obj); ;}
+  case 24: /* maybe_class_funcs: INDENT TRIPLEQUOTED class_funcs DEDENT  */
+#line 264 "pyi/parser.y"
+                                           { (yyval.list) = (yyvsp[-1].list); }
+#line 2280 "pyi/parser.tab.cc"
     break;
 
-  case 25:
-
-/* Line 1464 of yacc.c  */
-#line 191 "parser.y"
-    { (yyval.obj) = PyList_New(0); ;}
+  case 25: /* class_funcs: pass_or_ellipsis  */
+#line 268 "pyi/parser.y"
+                     { (yyval.list) = ctx->List(); }
+#line 2286 "pyi/parser.tab.cc"
     break;
 
-  case 27:
-
-/* Line 1464 of yacc.c  */
-#line 196 "parser.y"
-    { (yyval.obj) = AppendList((yyvsp[(1) - (2)].obj), (yyvsp[(2) - (2)].obj)); ;}
+  case 27: /* funcdefs: funcdefs constantdef  */
+#line 273 "pyi/parser.y"
+                         { (yyval.list) = ctx->AppendList((yyvsp[-1].list), (yyvsp[0].obj)); }
+#line 2292 "pyi/parser.tab.cc"
     break;
 
-  case 28:
-
-/* Line 1464 of yacc.c  */
-#line 197 "parser.y"
-    { (yyval.obj) = AppendList((yyvsp[(1) - (2)].obj), (yyvsp[(2) - (2)].obj)); ;}
+  case 28: /* funcdefs: funcdefs funcdef  */
+#line 274 "pyi/parser.y"
+                     { (yyval.list) = ctx->AppendList((yyvsp[-1].list), (yyvsp[0].obj)); }
+#line 2298 "pyi/parser.tab.cc"
     break;
 
-  case 29:
-
-/* Line 1464 of yacc.c  */
-#line 198 "parser.y"
-    {
-      PyObject* tmp = ctx->Call(kIfEnd, "(N)", (yyvsp[(2) - (2)].obj));
-      CHECK(tmp, (yylsp[(2) - (2)]));
-      (yyval.obj) = ExtendList((yyvsp[(1) - (2)].obj), tmp);
-    ;}
+  case 29: /* funcdefs: funcdefs class_if_stmt  */
+#line 275 "pyi/parser.y"
+                           {
+      Handle tmp = ctx->IfEnd(ctx->Sequence((yyvsp[0].list)));
+      CHECK(tmp, (yylsp[0]));
+      (yyval.list) = ctx->ExtendList((yyvsp[-1].list), tmp);
+    }
+#line 2308 "pyi/parser.tab.cc"
     break;
 
-  case 30:
-
-/* Line 1464 of yacc.c  */
-#line 203 "parser.y"
-    { (yyval.obj) = PyList_New(0); ;}
+  case 30: /* funcdefs: %empty  */
+#line 281 "pyi/parser.y"
+                { (yyval.list) = ctx->List(); }
+#line 2314 "pyi/parser.tab.cc"
     break;
 
-  case 31:
-
-/* Line 1464 of yacc.c  */
-#line 208 "parser.y"
-    {
-      (yyval.obj) = AppendList((yyvsp[(1) - (6)].obj), Py_BuildValue("(NN)", (yyvsp[(2) - (6)].obj), (yyvsp[(5) - (6)].obj)));
-    ;}
+  case 31: /* if_stmt: if_and_elifs else_cond ':' INDENT alldefs DEDENT  */
+#line 286 "pyi/parser.y"
+                                                     {
+      (yyval.list) = ctx->AppendList((yyvsp[-5].list), ctx->Tuple((yyvsp[-4].obj), ctx->Sequence((yyvsp[-1].list))));
+    }
+#line 2322 "pyi/parser.tab.cc"
     break;
 
-  case 33:
-
-/* Line 1464 of yacc.c  */
-#line 216 "parser.y"
-    {
-      (yyval.obj) = Py_BuildValue("[(NN)]", (yyvsp[(1) - (5)].obj), (yyvsp[(4) - (5)].obj));
-    ;}
+  case 33: /* if_and_elifs: if_cond ':' INDENT alldefs DEDENT  */
+#line 294 "pyi/parser.y"
+                                      {
+      (yyval.list) = ctx->StartList(ctx->Tuple((yyvsp[-4].obj), ctx->Sequence((yyvsp[-1].list))));
+    }
+#line 2330 "pyi/parser.tab.cc"
     break;
 
-  case 34:
-
-/* Line 1464 of yacc.c  */
-#line 220 "parser.y"
-    {
-      (yyval.obj) = AppendList((yyvsp[(1) - (6)].obj), Py_BuildValue("(NN)", (yyvsp[(2) - (6)].obj), (yyvsp[(5) - (6)].obj)));
-    ;}
+  case 34: /* if_and_elifs: if_and_elifs elif_cond ':' INDENT alldefs DEDENT  */
+#line 298 "pyi/parser.y"
+                                                     {
+      (yyval.list) = ctx->AppendList((yyvsp[-5].list), ctx->Tuple((yyvsp[-4].obj), ctx->Sequence((yyvsp[-1].list))));
+    }
+#line 2338 "pyi/parser.tab.cc"
     break;
 
-  case 35:
-
-/* Line 1464 of yacc.c  */
-#line 239 "parser.y"
-    {
-      (yyval.obj) = AppendList((yyvsp[(1) - (6)].obj), Py_BuildValue("(NN)", (yyvsp[(2) - (6)].obj), (yyvsp[(5) - (6)].obj)));
-    ;}
+  case 35: /* class_if_stmt: class_if_and_elifs else_cond ':' INDENT funcdefs DEDENT  */
+#line 317 "pyi/parser.y"
+                                                            {
+      (yyval.list) = ctx->AppendList((yyvsp[-5].list), ctx->Tuple((yyvsp[-4].obj), ctx->Sequence((yyvsp[-1].list))));
+    }
+#line 2346 "pyi/parser.tab.cc"
     break;
 
-  case 37:
-
-/* Line 1464 of yacc.c  */
-#line 247 "parser.y"
-    {
-      (yyval.obj) = Py_BuildValue("[(NN)]", (yyvsp[(1) - (5)].obj), (yyvsp[(4) - (5)].obj));
-    ;}
+  case 37: /* class_if_and_elifs: if_cond ':' INDENT funcdefs DEDENT  */
+#line 325 "pyi/parser.y"
+                                       {
+      (yyval.list) = ctx->StartList(ctx->Tuple((yyvsp[-4].obj), ctx->Sequence((yyvsp[-1].list))));
+    }
+#line 2354 "pyi/parser.tab.cc"
     break;
 
-  case 38:
-
-/* Line 1464 of yacc.c  */
-#line 251 "parser.y"
-    {
-      (yyval.obj) = AppendList((yyvsp[(1) - (6)].obj), Py_BuildValue("(NN)", (yyvsp[(2) - (6)].obj), (yyvsp[(5) - (6)].obj)));
-    ;}
+  case 38: /* class_if_and_elifs: class_if_and_elifs elif_cond ':' INDENT funcdefs DEDENT  */
+#line 329 "pyi/parser.y"
+                                                            {
+      (yyval.list) = ctx->AppendList((yyvsp[-5].list), ctx->Tuple((yyvsp[-4].obj), ctx->Sequence((yyvsp[-1].list))));
+    }
+#line 2362 "pyi/parser.tab.cc"
     break;
 
-  case 39:
-
-/* Line 1464 of yacc.c  */
-#line 263 "parser.y"
-    { (yyval.obj) = ctx->Call(kIfBegin, "(N)", (yyvsp[(2) - (2)].obj)); CHECK((yyval.obj), (yyloc)); ;}
+  case 39: /* if_cond: IF condition  */
+#line 341 "pyi/parser.y"
+                 { (yyval.obj) = ctx->IfBegin((yyvsp[0].obj)); CHECK((yyval.obj), (yyloc)); }
+#line 2368 "pyi/parser.tab.cc"
     break;
 
-  case 40:
-
-/* Line 1464 of yacc.c  */
-#line 267 "parser.y"
-    { (yyval.obj) = ctx->Call(kIfElif, "(N)", (yyvsp[(2) - (2)].obj)); CHECK((yyval.obj), (yyloc)); ;}
+  case 40: /* elif_cond: ELIF condition  */
+#line 345 "pyi/parser.y"
+                   { (yyval.obj) = ctx->IfElif((yyvsp[0].obj)); CHECK((yyval.obj), (yyloc)); }
+#line 2374 "pyi/parser.tab.cc"
     break;
 
-  case 41:
-
-/* Line 1464 of yacc.c  */
-#line 271 "parser.y"
-    { (yyval.obj) = ctx->Call(kIfElse, "()"); CHECK((yyval.obj), (yyloc)); ;}
+  case 41: /* else_cond: ELSE  */
+#line 349 "pyi/parser.y"
+         { (yyval.obj) = ctx->IfElse(); CHECK((yyval.obj), (yyloc)); }
+#line 2380 "pyi/parser.tab.cc"
     break;
 
-  case 42:
-
-/* Line 1464 of yacc.c  */
-#line 275 "parser.y"
-    {
-      (yyval.obj) = Py_BuildValue("(NsN)", (yyvsp[(1) - (3)].obj), (yyvsp[(2) - (3)].str), (yyvsp[(3) - (3)].obj));
-    ;}
+  case 42: /* condition: dotted_name condition_op NAME  */
+#line 353 "pyi/parser.y"
+                                  {
+      (yyval.obj) = ctx->Tuple(ctx->Name((yyvsp[-2].name), lexer), ctx->String((yyvsp[-1].str)),
+                      ctx->Name((yyvsp[0].name), lexer));
+    }
+#line 2389 "pyi/parser.tab.cc"
     break;
 
-  case 43:
-
-/* Line 1464 of yacc.c  */
-#line 278 "parser.y"
-    {
-      (yyval.obj) = Py_BuildValue("(NsN)", (yyvsp[(1) - (3)].obj), (yyvsp[(2) - (3)].str), (yyvsp[(3) - (3)].obj));
-    ;}
+  case 43: /* condition: dotted_name condition_op version_tuple  */
+#line 357 "pyi/parser.y"
+                                           {
+      (yyval.obj) = ctx->Tuple(ctx->Name((yyvsp[-2].name), lexer), ctx->String((yyvsp[-1].str)), (yyvsp[0].obj));
+    }
+#line 2397 "pyi/parser.tab.cc"
     break;
 
-  case 44:
-
-/* Line 1464 of yacc.c  */
-#line 285 "parser.y"
-    { (yyval.obj) = Py_BuildValue("(N)", (yyvsp[(2) - (4)].obj)); ;}
+  case 44: /* version_tuple: '(' NUMBER ',' ')'  */
+#line 364 "pyi/parser.y"
+                       { (yyval.obj) = ctx->Tuple((yyvsp[-2].obj)); }
+#line 2403 "pyi/parser.tab.cc"
     break;
 
-  case 45:
-
-/* Line 1464 of yacc.c  */
-#line 286 "parser.y"
-    { (yyval.obj) = Py_BuildValue("(NN)", (yyvsp[(2) - (5)].obj), (yyvsp[(4) - (5)].obj)); ;}
+  case 45: /* version_tuple: '(' NUMBER ',' NUMBER ')'  */
+#line 365 "pyi/parser.y"
+                              { (yyval.obj) = ctx->Tuple((yyvsp[-3].obj), (yyvsp[-1].obj)); }
+#line 2409 "pyi/parser.tab.cc"
     break;
 
-  case 46:
-
-/* Line 1464 of yacc.c  */
-#line 287 "parser.y"
-    {
-      (yyval.obj) = Py_BuildValue("(NNN)", (yyvsp[(2) - (7)].obj), (yyvsp[(4) - (7)].obj), (yyvsp[(6) - (7)].obj));
-    ;}
+  case 46: /* version_tuple: '(' NUMBER ',' NUMBER ',' NUMBER ')'  */
+#line 366 "pyi/parser.y"
+                                         {
+      (yyval.obj) = ctx->Tuple((yyvsp[-5].obj), (yyvsp[-3].obj), (yyvsp[-1].obj));
+    }
+#line 2417 "pyi/parser.tab.cc"
     break;
 
-  case 47:
-
-/* Line 1464 of yacc.c  */
-#line 293 "parser.y"
-    { (yyval.str) = "<"; ;}
+  case 47: /* condition_op: '<'  */
+#line 372 "pyi/parser.y"
+        { (yyval.str) = "<"; }
+#line 2423 "pyi/parser.tab.cc"
     break;
 
-  case 48:
-
-/* Line 1464 of yacc.c  */
-#line 294 "parser.y"
-    { (yyval.str) = ">"; ;}
+  case 48: /* condition_op: '>'  */
+#line 373 "pyi/parser.y"
+        { (yyval.str) = ">"; }
+#line 2429 "pyi/parser.tab.cc"
     break;
 
-  case 49:
-
-/* Line 1464 of yacc.c  */
-#line 295 "parser.y"
-    { (yyval.str) = "<="; ;}
+  case 49: /* condition_op: LE  */
+#line 374 "pyi/parser.y"
+        { (yyval.str) = "<="; }
+#line 2435 "pyi/parser.tab.cc"
     break;
 
-  case 50:
-
-/* Line 1464 of yacc.c  */
-#line 296 "parser.y"
-    { (yyval.str) = ">="; ;}
+  case 50: /* condition_op: GE  */
+#line 375 "pyi/parser.y"
+        { (yyval.str) = ">="; }
+#line 2441 "pyi/parser.tab.cc"
     break;
 
-  case 51:
-
-/* Line 1464 of yacc.c  */
-#line 297 "parser.y"
-    { (yyval.str) = "=="; ;}
+  case 51: /* condition_op: EQ  */
+#line 376 "pyi/parser.y"
+        { (yyval.str) = "=="; }
+#line 2447 "pyi/parser.tab.cc"
     break;
 
-  case 52:
-
-/* Line 1464 of yacc.c  */
-#line 298 "parser.y"
-    { (yyval.str) = "!="; ;}
+  case 52: /* condition_op: NE  */
+#line 377 "pyi/parser.y"
+        { (yyval.str) = "!="; }
+#line 2453 "pyi/parser.tab.cc"
     break;
 
-  case 53:
-
-/* Line 1464 of yacc.c  */
-#line 302 "parser.y"
-    {
-      (yyval.obj) = ctx->Call(kNewConstant, "(NN)", (yyvsp[(1) - (3)].obj), (yyvsp[(3) - (3)].obj));
+  case 53: /* constantdef: NAME '=' NUMBER  */
+#line 381 "pyi/parser.y"
+                    {
+      (yyval.obj) = ctx->NewConstant(ctx->Name((yyvsp[-2].name), lexer), (yyvsp[0].obj));
       CHECK((yyval.obj), (yyloc));
-    ;}
+    }
+#line 2462 "pyi/parser.tab.cc"
     break;
 
-  case 54:
-
-/* Line 1464 of yacc.c  */
-#line 306 "parser.y"
-    {
-      (yyval.obj) = ctx->Call(kNewConstant, "(NN)", (yyvsp[(1) - (3)].obj), ctx->Value(kAnything));
+  case 54: /* constantdef: NAME '=' ELLIPSIS  */
+#line 385 "pyi/parser.y"
+                      {
+      (yyval.obj) = ctx->NewConstant(ctx->Name((yyvsp[-2].name), lexer), ctx->Value(kAnything));
       CHECK((yyval.obj), (yyloc));
-    ;}
+    }
+#line 2471 "pyi/parser.tab.cc"
     break;
 
-  case 55:
-
-/* Line 1464 of yacc.c  */
-#line 310 "parser.y"
-    {
-      (yyval.obj) = ctx->Call(kNewConstant, "(NN)", (yyvsp[(1) - (5)].obj), (yyvsp[(5) - (5)].obj));
+  case 55: /* constantdef: NAME '=' ELLIPSIS TYPECOMMENT type  */
+#line 389 "pyi/parser.y"
+                                       {
+      (yyval.obj) = ctx->NewConstant(ctx->Name((yyvsp[-4].name), lexer), (yyvsp[0].obj));
       CHECK((yyval.obj), (yyloc));
-    ;}
+    }
+#line 2480 "pyi/parser.tab.cc"
     break;
 
-  case 56:
-
-/* Line 1464 of yacc.c  */
-#line 314 "parser.y"
-    {
-      (yyval.obj) = ctx->Call(kNewConstant, "(NN)", (yyvsp[(1) - (3)].obj), (yyvsp[(3) - (3)].obj));
+  case 56: /* constantdef: NAME ':' type  */
+#line 393 "pyi/parser.y"
+                  {
+      (yyval.obj) = ctx->NewConstant(ctx->Name((yyvsp[-2].name), lexer), (yyvsp[0].obj));
       CHECK((yyval.obj), (yyloc));
-    ;}
+    }
+#line 2489 "pyi/parser.tab.cc"
     break;
 
-  case 57:
-
-/* Line 1464 of yacc.c  */
-#line 318 "parser.y"
-    {
-      (yyval.obj) = ctx->Call(kNewConstant, "(NN)", (yyvsp[(1) - (5)].obj), (yyvsp[(3) - (5)].obj));
+  case 57: /* constantdef: NAME ':' type '=' ELLIPSIS  */
+#line 397 "pyi/parser.y"
+                               {
+      (yyval.obj) = ctx->NewConstant(ctx->Name((yyvsp[-4].name), lexer), (yyvsp[-2].obj));
       CHECK((yyval.obj), (yyloc));
-    ;}
+    }
+#line 2498 "pyi/parser.tab.cc"
     break;
 
-  case 58:
-
-/* Line 1464 of yacc.c  */
-#line 325 "parser.y"
-    {
-      (yyval.obj) = ctx->Call(kAddImport, "(ON)", Py_None, (yyvsp[(2) - (2)].obj));
+  case 58: /* importdef: IMPORT import_items  */
+#line 404 "pyi/parser.y"
+                        {
+      (yyval.obj) = ctx->AddImport(ctx->None(), ctx->Sequence((yyvsp[0].list)));
       CHECK((yyval.obj), (yyloc));
-    ;}
+    }
+#line 2507 "pyi/parser.tab.cc"
     break;
 
-  case 59:
-
-/* Line 1464 of yacc.c  */
-#line 329 "parser.y"
-    {
-      (yyval.obj) = ctx->Call(kAddImport, "(NN)", (yyvsp[(2) - (4)].obj), (yyvsp[(4) - (4)].obj));
+  case 59: /* importdef: FROM dotted_name IMPORT from_list  */
+#line 408 "pyi/parser.y"
+                                      {
+      (yyval.obj) = ctx->AddImport(ctx->Name((yyvsp[-2].name), lexer), ctx->Sequence((yyvsp[0].list)));
       CHECK((yyval.obj), (yyloc));
-    ;}
+    }
+#line 2516 "pyi/parser.tab.cc"
     break;
 
-  case 60:
-
-/* Line 1464 of yacc.c  */
-#line 336 "parser.y"
-    { (yyval.obj) = AppendList((yyvsp[(1) - (3)].obj), (yyvsp[(3) - (3)].obj)); ;}
+  case 60: /* import_items: import_items ',' import_item  */
+#line 415 "pyi/parser.y"
+                                 { (yyval.list) = ctx->AppendList((yyvsp[-2].list), (yyvsp[0].obj)); }
+#line 2522 "pyi/parser.tab.cc"
     break;
 
-  case 61:
-
-/* Line 1464 of yacc.c  */
-#line 337 "parser.y"
-    { (yyval.obj) = StartList((yyvsp[(1) - (1)].obj)); ;}
+  case 61: /* import_items: import_item  */
+#line 416 "pyi/parser.y"
+                { (yyval.list) = ctx->StartList((yyvsp[0].obj)); }
+#line 2528 "pyi/parser.tab.cc"
     break;
 
-  case 63:
-
-/* Line 1464 of yacc.c  */
-#line 341 "parser.y"
-    { (yyval.obj) = Py_BuildValue("(NN)", (yyvsp[(1) - (3)].obj), (yyvsp[(3) - (3)].obj)); ;}
+  case 62: /* import_item: dotted_name  */
+#line 419 "pyi/parser.y"
+                { (yyval.obj) = ctx->Name((yyvsp[0].name), lexer); }
+#line 2534 "pyi/parser.tab.cc"
     break;
 
-  case 65:
-
-/* Line 1464 of yacc.c  */
-#line 346 "parser.y"
-    { (yyval.obj) = (yyvsp[(2) - (3)].obj); ;}
+  case 63: /* import_item: dotted_name AS NAME  */
+#line 420 "pyi/parser.y"
+                        {
+      (yyval.obj) = ctx->Tuple(ctx->Name((yyvsp[-2].name), lexer), ctx->Name((yyvsp[0].name), lexer));
+    }
+#line 2542 "pyi/parser.tab.cc"
     break;
 
-  case 66:
-
-/* Line 1464 of yacc.c  */
-#line 347 "parser.y"
-    { (yyval.obj) = (yyvsp[(2) - (4)].obj); ;}
+  case 65: /* from_list: '(' from_items ')'  */
+#line 427 "pyi/parser.y"
+                       { (yyval.list) = (yyvsp[-1].list); }
+#line 2548 "pyi/parser.tab.cc"
     break;
 
-  case 67:
-
-/* Line 1464 of yacc.c  */
-#line 351 "parser.y"
-    { (yyval.obj) = AppendList((yyvsp[(1) - (3)].obj), (yyvsp[(3) - (3)].obj)); ;}
+  case 66: /* from_list: '(' from_items ',' ')'  */
+#line 428 "pyi/parser.y"
+                           { (yyval.list) = (yyvsp[-2].list); }
+#line 2554 "pyi/parser.tab.cc"
     break;
 
-  case 68:
-
-/* Line 1464 of yacc.c  */
-#line 352 "parser.y"
-    { (yyval.obj) = StartList((yyvsp[(1) - (1)].obj)); ;}
+  case 67: /* from_items: from_items ',' from_item  */
+#line 432 "pyi/parser.y"
+                             { (yyval.list) = ctx->AppendList((yyvsp[-2].list), (yyvsp[0].obj)); }
+#line 2560 "pyi/parser.tab.cc"
     break;
 
-  case 70:
-
-/* Line 1464 of yacc.c  */
-#line 357 "parser.y"
-    { (yyval.obj) = PyString_FromString("NamedTuple"); ;}
+  case 68: /* from_items: from_item  */
+#line 433 "pyi/parser.y"
+              { (yyval.list) = ctx->StartList((yyvsp[0].obj)); }
+#line 2566 "pyi/parser.tab.cc"
     break;
 
-  case 71:
-
-/* Line 1464 of yacc.c  */
-#line 358 "parser.y"
-    { (yyval.obj) = PyString_FromString("TypeVar"); ;}
+  case 69: /* from_item: NAME  */
+#line 437 "pyi/parser.y"
+         { (yyval.obj) = ctx->Name((yyvsp[0].name), lexer); }
+#line 2572 "pyi/parser.tab.cc"
     break;
 
-  case 72:
-
-/* Line 1464 of yacc.c  */
-#line 359 "parser.y"
-    { (yyval.obj) = PyString_FromString("*"); ;}
+  case 70: /* from_item: NAMEDTUPLE  */
+#line 438 "pyi/parser.y"
+               { (yyval.obj) = ctx->String("NamedTuple"); }
+#line 2578 "pyi/parser.tab.cc"
     break;
 
-  case 73:
+  case 71: /* from_item: TYPEVAR  */
+#line 439 "pyi/parser.y"
+            { (yyval.obj) = ctx->String("TypeVar"); }
+#line 2584 "pyi/parser.tab.cc"
+    break;
 
-/* Line 1464 of yacc.c  */
-#line 360 "parser.y"
-    { (yyval.obj) = Py_BuildValue("(NN)", (yyvsp[(1) - (3)].obj), (yyvsp[(3) - (3)].obj)); ;}
+  case 72: /* from_item: '*'  */
+#line 440 "pyi/parser.y"
+        { (yyval.obj) = ctx->String("*"); }
+#line 2590 "pyi/parser.tab.cc"
     break;
 
-  case 74:
+  case 73: /* from_item: NAME AS NAME  */
+#line 441 "pyi/parser.y"
+                 {
+      (yyval.obj) = ctx->Tuple(ctx->Name((yyvsp[-2].name), lexer), ctx->Name((yyvsp[0].name), lexer));
+    }
+#line 2598 "pyi/parser.tab.cc"
+    break;
 
-/* Line 1464 of yacc.c  */
-#line 364 "parser.y"
-    {
-      (yyval.obj) = ctx->Call(kAddAliasOrConstant, "(NN)", (yyvsp[(1) - (3)].obj), (yyvsp[(3) - (3)].obj));
+  case 74: /* alias_or_constant: NAME '=' type  */
+#line 447 "pyi/parser.y"
+                  {
+      (yyval.obj) = ctx->AddAliasOrConstant(ctx->Name((yyvsp[-2].name), lexer), (yyvsp[0].obj));
       CHECK((yyval.obj), (yyloc));
-    ;}
+    }
+#line 2607 "pyi/parser.tab.cc"
     break;
 
-  case 75:
-
-/* Line 1464 of yacc.c  */
-#line 371 "parser.y"
-    {
-      (yyval.obj) = ctx->Call(kAddTypeVar, "(NN)", (yyvsp[(1) - (6)].obj), (yyvsp[(5) - (6)].obj));
+  case 75: /* typevardef: NAME '=' TYPEVAR '(' params ')'  */
+#line 454 "pyi/parser.y"
+                                    {
+      (yyval.obj) = ctx->AddTypeVar(ctx->Name((yyvsp[-5].name), lexer), ctx->Sequence((yyvsp[-1].list)));
       CHECK((yyval.obj), (yyloc));
-    ;}
+    }
+#line 2616 "pyi/parser.tab.cc"
     break;
 
-  case 76:
-
-/* Line 1464 of yacc.c  */
-#line 378 "parser.y"
-    {
-      (yyval.obj) = ctx->Call(kNewFunction, "(NNNNNN)", (yyvsp[(1) - (9)].obj), (yyvsp[(3) - (9)].obj), (yyvsp[(5) - (9)].obj), (yyvsp[(7) - (9)].obj), (yyvsp[(8) - (9)].obj), (yyvsp[(9) - (9)].obj));
+  case 76: /* funcdef: decorators DEF NAME '(' params ')' return raises maybe_body  */
+#line 461 "pyi/parser.y"
+                                                                {
+      (yyval.obj) = ctx->NewFunction(ctx->Sequence((yyvsp[-8].list)), ctx->Name((yyvsp[-6].name), lexer),
+                            ctx->Sequence((yyvsp[-4].list)), (yyvsp[-2].obj), ctx->Sequence((yyvsp[-1].list)),
+                            ctx->Sequence((yyvsp[0].list)));
       // Decorators is nullable and messes up the location tracking by
       // using the previous symbol as the start location for this production,
       // which is very misleading.  It is better to ignore decorators and
@@ -2779,527 +2630,480 @@ yyreduce:
       // TODO(dbaum): Consider making this smarter and only ignoring decorators
       // when they are empty.  Making decorators non-nullable and having two
       // productions for funcdef would be a reasonable solution.
-      (yyloc).first_line = (yylsp[(2) - (9)]).first_line;
-      (yyloc).first_column = (yylsp[(2) - (9)]).first_column;
+      (yyloc).first_line = (yylsp[-7]).first_line;
+      (yyloc).first_column = (yylsp[-7]).first_column;
       CHECK((yyval.obj), (yyloc));
-    ;}
+    }
+#line 2638 "pyi/parser.tab.cc"
     break;
 
-  case 77:
-
-/* Line 1464 of yacc.c  */
-#line 393 "parser.y"
-    {
+  case 77: /* funcdef: decorators DEF NAME PYTHONCODE  */
+#line 478 "pyi/parser.y"
+                                   {
       // TODO(dbaum): Is PYTHONCODE necessary?
-      (yyval.obj) = ctx->Call(kNewExternalFunction, "(NN)", (yyvsp[(1) - (4)].obj), (yyvsp[(3) - (4)].obj));
+      (yyval.obj) = ctx->NewExternalFunction(ctx->Sequence((yyvsp[-3].list)), ctx->Name((yyvsp[-1].name), lexer));
       // See comment above about why @2 is used as the start.
-      (yyloc).first_line = (yylsp[(2) - (4)]).first_line;
-      (yyloc).first_column = (yylsp[(2) - (4)]).first_column;
+      (yyloc).first_line = (yylsp[-2]).first_line;
+      (yyloc).first_column = (yylsp[-2]).first_column;
       CHECK((yyval.obj), (yyloc));
-    ;}
+    }
+#line 2651 "pyi/parser.tab.cc"
     break;
 
-  case 78:
-
-/* Line 1464 of yacc.c  */
-#line 404 "parser.y"
-    { (yyval.obj) = AppendList((yyvsp[(1) - (2)].obj), (yyvsp[(2) - (2)].obj)); ;}
+  case 78: /* decorators: decorators decorator  */
+#line 489 "pyi/parser.y"
+                         { (yyval.list) = ctx->AppendList((yyvsp[-1].list), (yyvsp[0].obj)); }
+#line 2657 "pyi/parser.tab.cc"
     break;
 
-  case 79:
-
-/* Line 1464 of yacc.c  */
-#line 405 "parser.y"
-    { (yyval.obj) = PyList_New(0); ;}
+  case 79: /* decorators: %empty  */
+#line 490 "pyi/parser.y"
+                { (yyval.list) = ctx->List(); }
+#line 2663 "pyi/parser.tab.cc"
     break;
 
-  case 80:
-
-/* Line 1464 of yacc.c  */
-#line 409 "parser.y"
-    { (yyval.obj) = (yyvsp[(2) - (2)].obj); ;}
+  case 80: /* decorator: '@' dotted_name  */
+#line 494 "pyi/parser.y"
+                    { (yyval.obj) = ctx->Name((yyvsp[0].name), lexer); }
+#line 2669 "pyi/parser.tab.cc"
     break;
 
-  case 81:
-
-/* Line 1464 of yacc.c  */
-#line 414 "parser.y"
-    { (yyval.obj) = (yyvsp[(1) - (1)].obj); ;}
+  case 81: /* params: param_list  */
+#line 499 "pyi/parser.y"
+               { (yyval.list) = (yyvsp[0].list); }
+#line 2675 "pyi/parser.tab.cc"
     break;
 
-  case 82:
-
-/* Line 1464 of yacc.c  */
-#line 415 "parser.y"
-    { (yyval.obj) = PyList_New(0); ;}
+  case 82: /* params: %empty  */
+#line 500 "pyi/parser.y"
+                { (yyval.list) = ctx->List(); }
+#line 2681 "pyi/parser.tab.cc"
     break;
 
-  case 83:
-
-/* Line 1464 of yacc.c  */
-#line 419 "parser.y"
-    { (yyval.obj) = AppendList((yyvsp[(1) - (3)].obj), (yyvsp[(3) - (3)].obj)); ;}
+  case 83: /* param_list: param_list ',' param  */
+#line 504 "pyi/parser.y"
+                         { (yyval.list) = ctx->AppendList((yyvsp[-2].list), (yyvsp[0].obj)); }
+#line 2687 "pyi/parser.tab.cc"
     break;
 
-  case 84:
-
-/* Line 1464 of yacc.c  */
-#line 420 "parser.y"
-    { (yyval.obj) = StartList((yyvsp[(1) - (1)].obj)); ;}
+  case 84: /* param_list: param  */
+#line 505 "pyi/parser.y"
+          { (yyval.list) = ctx->StartList((yyvsp[0].obj)); }
+#line 2693 "pyi/parser.tab.cc"
     break;
 
-  case 85:
-
-/* Line 1464 of yacc.c  */
-#line 424 "parser.y"
-    { (yyval.obj) = Py_BuildValue("(NNN)", (yyvsp[(1) - (3)].obj), (yyvsp[(2) - (3)].obj), (yyvsp[(3) - (3)].obj)); ;}
+  case 85: /* param: NAME param_type param_default  */
+#line 509 "pyi/parser.y"
+                                  {
+      (yyval.obj) = ctx->Tuple(ctx->Name((yyvsp[-2].name), lexer), (yyvsp[-1].obj), (yyvsp[0].obj));
+    }
+#line 2701 "pyi/parser.tab.cc"
     break;
 
-  case 86:
-
-/* Line 1464 of yacc.c  */
-#line 425 "parser.y"
-    { (yyval.obj) = Py_BuildValue("(sOO)", "*", Py_None, Py_None); ;}
+  case 86: /* param: '*'  */
+#line 512 "pyi/parser.y"
+        { (yyval.obj) = ctx->Tuple(ctx->String("*"), ctx->None(), ctx->None()); }
+#line 2707 "pyi/parser.tab.cc"
     break;
 
-  case 87:
-
-/* Line 1464 of yacc.c  */
-#line 426 "parser.y"
-    { (yyval.obj) = Py_BuildValue("(NNO)", (yyvsp[(1) - (2)].obj), (yyvsp[(2) - (2)].obj), Py_None); ;}
+  case 87: /* param: param_star_name param_type  */
+#line 513 "pyi/parser.y"
+                               { (yyval.obj) = ctx->Tuple((yyvsp[-1].obj), (yyvsp[0].obj), ctx->None()); }
+#line 2713 "pyi/parser.tab.cc"
     break;
 
-  case 88:
-
-/* Line 1464 of yacc.c  */
-#line 427 "parser.y"
-    { (yyval.obj) = ctx->Value(kEllipsis) ;}
+  case 88: /* param: ELLIPSIS  */
+#line 514 "pyi/parser.y"
+             { (yyval.obj) = ctx->Value(kEllipsis); }
+#line 2719 "pyi/parser.tab.cc"
     break;
 
-  case 89:
-
-/* Line 1464 of yacc.c  */
-#line 431 "parser.y"
-    { (yyval.obj) = (yyvsp[(2) - (2)].obj); ;}
+  case 89: /* param_type: ':' type  */
+#line 518 "pyi/parser.y"
+             { (yyval.obj) = (yyvsp[0].obj); }
+#line 2725 "pyi/parser.tab.cc"
     break;
 
-  case 90:
-
-/* Line 1464 of yacc.c  */
-#line 432 "parser.y"
-    { Py_INCREF(Py_None); (yyval.obj) = Py_None; ;}
+  case 90: /* param_type: %empty  */
+#line 519 "pyi/parser.y"
+                { (yyval.obj) = ctx->None(); }
+#line 2731 "pyi/parser.tab.cc"
     break;
 
-  case 91:
-
-/* Line 1464 of yacc.c  */
-#line 436 "parser.y"
-    { (yyval.obj) = (yyvsp[(2) - (2)].obj); ;}
+  case 91: /* param_default: '=' NAME  */
+#line 523 "pyi/parser.y"
+             { (yyval.obj) = ctx->Name((yyvsp[0].name), lexer); }
+#line 2737 "pyi/parser.tab.cc"
     break;
 
-  case 92:
-
-/* Line 1464 of yacc.c  */
-#line 437 "parser.y"
-    { (yyval.obj) = (yyvsp[(2) - (2)].obj); ;}
+  case 92: /* param_default: '=' NUMBER  */
+#line 524 "pyi/parser.y"
+               { (yyval.obj) = (yyvsp[0].obj); }
+#line 2743 "pyi/parser.tab.cc"
     break;
 
-  case 93:
-
-/* Line 1464 of yacc.c  */
-#line 438 "parser.y"
-    { (yyval.obj) = ctx->Value(kEllipsis); ;}
+  case 93: /* param_default: '=' ELLIPSIS  */
+#line 525 "pyi/parser.y"
+                 { (yyval.obj) = ctx->Value(kEllipsis); }
+#line 2749 "pyi/parser.tab.cc"
     break;
 
-  case 94:
-
-/* Line 1464 of yacc.c  */
-#line 439 "parser.y"
-    { Py_INCREF(Py_None); (yyval.obj) = Py_None; ;}
+  case 94: /* param_default: %empty  */
+#line 526 "pyi/parser.y"
+    { (yyval.obj) = ctx->None(); }
+#line 2755 "pyi/parser.tab.cc"
     break;
 
-  case 95:
-
-/* Line 1464 of yacc.c  */
-#line 443 "parser.y"
-    { (yyval.obj) = PyString_FromFormat("*%s", PyString_AsString((yyvsp[(2) - (2)].obj))); ;}
+  case 95: /* param_star_name: '*' NAME  */
+#line 530 "pyi/parser.y"
+             { (yyval.obj) = ctx->Name(ctx->Prefix("*", (yyvsp[0].name)), lexer); }
+#line 2761 "pyi/parser.tab.cc"
     break;
 
-  case 96:
-
-/* Line 1464 of yacc.c  */
-#line 444 "parser.y"
-    { (yyval.obj) = PyString_FromFormat("**%s", PyString_AsString((yyvsp[(3) - (3)].obj))); ;}
+  case 96: /* param_star_name: '*' '*' NAME  */
+#line 531 "pyi/parser.y"
+                 { (yyval.obj) = ctx->Name(ctx->Prefix("**", (yyvsp[0].name)), lexer); }
+#line 2767 "pyi/parser.tab.cc"
     break;
 
-  case 97:
-
-/* Line 1464 of yacc.c  */
-#line 448 "parser.y"
-    { (yyval.obj) = (yyvsp[(2) - (2)].obj); ;}
+  case 97: /* return: ARROW type  */
+#line 535 "pyi/parser.y"
+               { (yyval.obj) = (yyvsp[0].obj); }
+#line 2773 "pyi/parser.tab.cc"
     break;
 
-  case 98:
-
-/* Line 1464 of yacc.c  */
-#line 449 "parser.y"
-    { (yyval.obj) = ctx->Value(kAnything); ;}
+  case 98: /* return: %empty  */
+#line 536 "pyi/parser.y"
+                { (yyval.obj) = ctx->Value(kAnything); }
+#line 2779 "pyi/parser.tab.cc"
     break;
 
-  case 99:
-
-/* Line 1464 of yacc.c  */
-#line 453 "parser.y"
-    { (yyval.obj) = (yyvsp[(2) - (2)].obj); ;}
+  case 99: /* raises: RAISES exceptions  */
+#line 540 "pyi/parser.y"
+                      { (yyval.list) = (yyvsp[0].list); }
+#line 2785 "pyi/parser.tab.cc"
     break;
 
-  case 100:
-
-/* Line 1464 of yacc.c  */
-#line 454 "parser.y"
-    { (yyval.obj) = PyList_New(0); ;}
+  case 100: /* raises: %empty  */
+#line 541 "pyi/parser.y"
+                { (yyval.list) = ctx->List(); }
+#line 2791 "pyi/parser.tab.cc"
     break;
 
-  case 101:
-
-/* Line 1464 of yacc.c  */
-#line 458 "parser.y"
-    { (yyval.obj) = AppendList((yyvsp[(1) - (3)].obj), (yyvsp[(3) - (3)].obj)); ;}
+  case 101: /* exceptions: exceptions ',' type  */
+#line 545 "pyi/parser.y"
+                        { (yyval.list) = ctx->AppendList((yyvsp[-2].list), (yyvsp[0].obj)); }
+#line 2797 "pyi/parser.tab.cc"
     break;
 
-  case 102:
-
-/* Line 1464 of yacc.c  */
-#line 459 "parser.y"
-    { (yyval.obj) = StartList((yyvsp[(1) - (1)].obj)); ;}
+  case 102: /* exceptions: type  */
+#line 546 "pyi/parser.y"
+         { (yyval.list) = ctx->StartList((yyvsp[0].obj)); }
+#line 2803 "pyi/parser.tab.cc"
     break;
 
-  case 103:
-
-/* Line 1464 of yacc.c  */
-#line 463 "parser.y"
-    { (yyval.obj) = (yyvsp[(3) - (4)].obj); ;}
+  case 103: /* maybe_body: ':' INDENT body DEDENT  */
+#line 550 "pyi/parser.y"
+                           { (yyval.list) = (yyvsp[-1].list); }
+#line 2809 "pyi/parser.tab.cc"
     break;
 
-  case 104:
-
-/* Line 1464 of yacc.c  */
-#line 464 "parser.y"
-    { (yyval.obj) = PyList_New(0); ;}
+  case 104: /* maybe_body: empty_body  */
+#line 551 "pyi/parser.y"
+               { (yyval.list) = ctx->List(); }
+#line 2815 "pyi/parser.tab.cc"
     break;
 
-  case 109:
-
-/* Line 1464 of yacc.c  */
-#line 475 "parser.y"
-    { (yyval.obj) = AppendList((yyvsp[(1) - (2)].obj), (yyvsp[(2) - (2)].obj)); ;}
+  case 109: /* body: body body_stmt  */
+#line 562 "pyi/parser.y"
+                   { (yyval.list) = ctx->AppendList((yyvsp[-1].list), (yyvsp[0].obj)); }
+#line 2821 "pyi/parser.tab.cc"
     break;
 
-  case 110:
-
-/* Line 1464 of yacc.c  */
-#line 476 "parser.y"
-    { (yyval.obj) = StartList((yyvsp[(1) - (1)].obj)); ;}
+  case 110: /* body: body_stmt  */
+#line 563 "pyi/parser.y"
+              { (yyval.list) = ctx->StartList((yyvsp[0].obj)); }
+#line 2827 "pyi/parser.tab.cc"
     break;
 
-  case 111:
-
-/* Line 1464 of yacc.c  */
-#line 480 "parser.y"
-    { (yyval.obj) = Py_BuildValue("(NN)", (yyvsp[(1) - (3)].obj), (yyvsp[(3) - (3)].obj)); ;}
+  case 111: /* body_stmt: NAME COLONEQUALS type  */
+#line 569 "pyi/parser.y"
+                          { (yyval.obj) = ctx->Tuple(ctx->Name((yyvsp[-2].name), lexer), (yyvsp[0].obj)); }
+#line 2833 "pyi/parser.tab.cc"
     break;
 
-  case 112:
-
-/* Line 1464 of yacc.c  */
-#line 481 "parser.y"
-    { Py_DECREF((yyvsp[(2) - (2)].obj)); Py_INCREF(Py_None); (yyval.obj) = Py_None; ;}
+  case 112: /* body_stmt: RAISE NAME  */
+#line 570 "pyi/parser.y"
+               { (yyval.obj) = ctx->None(); }
+#line 2839 "pyi/parser.tab.cc"
     break;
 
-  case 113:
-
-/* Line 1464 of yacc.c  */
-#line 482 "parser.y"
-    { Py_DECREF((yyvsp[(2) - (4)].obj)); Py_INCREF(Py_None); (yyval.obj) = Py_None; ;}
+  case 113: /* body_stmt: RAISE NAME '(' ')'  */
+#line 571 "pyi/parser.y"
+                       { (yyval.obj) = ctx->None(); }
+#line 2845 "pyi/parser.tab.cc"
     break;
 
-  case 114:
-
-/* Line 1464 of yacc.c  */
-#line 486 "parser.y"
-    { (yyval.obj) = AppendList((yyvsp[(1) - (3)].obj), (yyvsp[(3) - (3)].obj)); ;}
+  case 114: /* type_parameters: type_parameters ',' type_parameter  */
+#line 575 "pyi/parser.y"
+                                       { (yyval.list) = ctx->AppendList((yyvsp[-2].list), (yyvsp[0].obj)); }
+#line 2851 "pyi/parser.tab.cc"
     break;
 
-  case 115:
-
-/* Line 1464 of yacc.c  */
-#line 487 "parser.y"
-    { (yyval.obj) = StartList((yyvsp[(1) - (1)].obj)); ;}
+  case 115: /* type_parameters: type_parameter  */
+#line 576 "pyi/parser.y"
+                   { (yyval.list) = ctx->StartList((yyvsp[0].obj)); }
+#line 2857 "pyi/parser.tab.cc"
     break;
 
-  case 116:
-
-/* Line 1464 of yacc.c  */
-#line 491 "parser.y"
-    { (yyval.obj) = (yyvsp[(1) - (1)].obj); ;}
+  case 116: /* type_parameter: type  */
+#line 580 "pyi/parser.y"
+         { (yyval.obj) = (yyvsp[0].obj); }
+#line 2863 "pyi/parser.tab.cc"
     break;
 
-  case 117:
-
-/* Line 1464 of yacc.c  */
-#line 492 "parser.y"
-    { (yyval.obj) = ctx->Value(kEllipsis); ;}
+  case 117: /* type_parameter: ELLIPSIS  */
+#line 581 "pyi/parser.y"
+             { (yyval.obj) = ctx->Value(kEllipsis); }
+#line 2869 "pyi/parser.tab.cc"
     break;
 
-  case 118:
-
-/* Line 1464 of yacc.c  */
-#line 496 "parser.y"
-    {
-      (yyval.obj) = ctx->Call(kNewType, "(N)", (yyvsp[(1) - (1)].obj));
+  case 118: /* type: dotted_name  */
+#line 585 "pyi/parser.y"
+                {
+      (yyval.obj) = ctx->NewType(ctx->Name((yyvsp[0].name), lexer), NULL);
       CHECK((yyval.obj), (yyloc));
-    ;}
+    }
+#line 2878 "pyi/parser.tab.cc"
     break;
 
-  case 119:
-
-/* Line 1464 of yacc.c  */
-#line 500 "parser.y"
-    {
-      (yyval.obj) = ctx->Call(kNewType, "(NN)", (yyvsp[(1) - (4)].obj), (yyvsp[(3) - (4)].obj));
+  case 119: /* type: dotted_name '[' type_parameters ']'  */
+#line 589 "pyi/parser.y"
+                                        {
+      (yyval.obj) = ctx->NewType(ctx->Name((yyvsp[-3].name), lexer), ctx->Sequence((yyvsp[-1].list)));
       CHECK((yyval.obj), (yyloc));
-    ;}
+    }
+#line 2887 "pyi/parser.tab.cc"
     break;
 
-  case 120:
-
-/* Line 1464 of yacc.c  */
-#line 504 "parser.y"
-    {
+  case 120: /* type: '[' maybe_type_list ']'  */
+#line 593 "pyi/parser.y"
+                            {
       // TODO(dbaum): Is this rule necessary?  Seems like it may be old cruft.
       //
       // TODO(dbaum): This assumes kNewType will make this a GenericType and
       // not try to convert it to HomogeneousContainerType (like it does with
       // typing.Tuple).  This feels inconsistent and should be revisited once
       // the parser is complete.
-      (yyval.obj) = ctx->Call(kNewType, "(sN)", "tuple", (yyvsp[(2) - (3)].obj));
+      (yyval.obj) = ctx->NewType(ctx->String("tuple"), ctx->Sequence((yyvsp[-1].list)));
       CHECK((yyval.obj), (yyloc));
-    ;}
+    }
+#line 2902 "pyi/parser.tab.cc"
     break;
 
-  case 121:
-
-/* Line 1464 of yacc.c  */
-#line 514 "parser.y"
-    {
-      (yyval.obj) = ctx->Call(kNewNamedTuple, "(NN)", (yyvsp[(3) - (6)].obj), (yyvsp[(5) - (6)].obj));
+  case 121: /* type: NAMEDTUPLE '(' NAME ',' named_tuple_fields ')'  */
+#line 603 "pyi/parser.y"
+                                                   {
+      (yyval.obj) = ctx->NewNamedTuple(ctx->Name((yyvsp[-3].name), lexer), ctx->Sequence((yyvsp[-1].list)));
       CHECK((yyval.obj), (yyloc));
-    ;}
+    }
+#line 2911 "pyi/parser.tab.cc"
     break;
 
-  case 122:
-
-/* Line 1464 of yacc.c  */
-#line 518 "parser.y"
-    { (yyval.obj) = (yyvsp[(2) - (3)].obj); ;}
+  case 122: /* type: '(' type ')'  */
+#line 607 "pyi/parser.y"
+                 { (yyval.obj) = (yyvsp[-1].obj); }
+#line 2917 "pyi/parser.tab.cc"
     break;
 
-  case 123:
-
-/* Line 1464 of yacc.c  */
-#line 519 "parser.y"
-    { (yyval.obj) = ctx->Call(kNewUnionType, "([NN])", (yyvsp[(1) - (3)].obj), (yyvsp[(3) - (3)].obj)); ;}
+  case 123: /* type: type OR type  */
+#line 608 "pyi/parser.y"
+                 { (yyval.obj) = ctx->NewUnionType((yyvsp[-2].obj), (yyvsp[0].obj)); }
+#line 2923 "pyi/parser.tab.cc"
     break;
 
-  case 124:
-
-/* Line 1464 of yacc.c  */
-#line 520 "parser.y"
-    { (yyval.obj) = ctx->Value(kAnything); ;}
+  case 124: /* type: '?'  */
+#line 609 "pyi/parser.y"
+        { (yyval.obj) = ctx->Value(kAnything); }
+#line 2929 "pyi/parser.tab.cc"
     break;
 
-  case 125:
-
-/* Line 1464 of yacc.c  */
-#line 521 "parser.y"
-    { (yyval.obj) = ctx->Value(kNothing); ;}
+  case 125: /* type: NOTHING  */
+#line 610 "pyi/parser.y"
+            { (yyval.obj) = ctx->Value(kNothing); }
+#line 2935 "pyi/parser.tab.cc"
     break;
 
-  case 126:
-
-/* Line 1464 of yacc.c  */
-#line 525 "parser.y"
-    { (yyval.obj) = (yyvsp[(2) - (4)].obj); ;}
+  case 126: /* named_tuple_fields: '[' named_tuple_field_list maybe_comma ']'  */
+#line 614 "pyi/parser.y"
+                                               { (yyval.list) = (yyvsp[-2].list); }
+#line 2941 "pyi/parser.tab.cc"
     break;
 
-  case 127:
-
-/* Line 1464 of yacc.c  */
-#line 526 "parser.y"
-    { (yyval.obj) = PyList_New(0); ;}
+  case 127: /* named_tuple_fields: '[' ']'  */
+#line 615 "pyi/parser.y"
+            { (yyval.list) = ctx->List(); }
+#line 2947 "pyi/parser.tab.cc"
     break;
 
-  case 128:
-
-/* Line 1464 of yacc.c  */
-#line 530 "parser.y"
-    { (yyval.obj) = AppendList((yyvsp[(1) - (3)].obj), (yyvsp[(3) - (3)].obj)); ;}
+  case 128: /* named_tuple_field_list: named_tuple_field_list ',' named_tuple_field  */
+#line 619 "pyi/parser.y"
+                                                 {
+      (yyval.list) = ctx->AppendList((yyvsp[-2].list), (yyvsp[0].obj));
+    }
+#line 2955 "pyi/parser.tab.cc"
     break;
 
-  case 129:
-
-/* Line 1464 of yacc.c  */
-#line 531 "parser.y"
-    { (yyval.obj) = StartList((yyvsp[(1) - (1)].obj)); ;}
+  case 129: /* named_tuple_field_list: named_tuple_field  */
+#line 622 "pyi/parser.y"
+                      { (yyval.list) = ctx->StartList((yyvsp[0].obj)); }
+#line 2961 "pyi/parser.tab.cc"
     break;
 
-  case 130:
-
-/* Line 1464 of yacc.c  */
-#line 535 "parser.y"
-    { (yyval.obj) = Py_BuildValue("(NN)", (yyvsp[(2) - (6)].obj), (yyvsp[(4) - (6)].obj)); ;}
+  case 130: /* named_tuple_field: '(' NAME ',' type maybe_comma ')'  */
+#line 626 "pyi/parser.y"
+                                       {
+      (yyval.obj) = ctx->Tuple(ctx->Name((yyvsp[-4].name), lexer), (yyvsp[-2].obj));
+    }
+#line 2969 "pyi/parser.tab.cc"
     break;
 
-  case 133:
-
-/* Line 1464 of yacc.c  */
-#line 544 "parser.y"
-    { (yyval.obj) = (yyvsp[(1) - (1)].obj); ;}
+  case 133: /* maybe_type_list: type_list  */
+#line 637 "pyi/parser.y"
+              { (yyval.list) = (yyvsp[0].list); }
+#line 2975 "pyi/parser.tab.cc"
     break;
 
-  case 134:
-
-/* Line 1464 of yacc.c  */
-#line 545 "parser.y"
-    { (yyval.obj) = PyList_New(0); ;}
+  case 134: /* maybe_type_list: %empty  */
+#line 638 "pyi/parser.y"
+                { (yyval.list) = ctx->List(); }
+#line 2981 "pyi/parser.tab.cc"
     break;
 
-  case 135:
-
-/* Line 1464 of yacc.c  */
-#line 549 "parser.y"
-    { (yyval.obj) = AppendList((yyvsp[(1) - (3)].obj), (yyvsp[(3) - (3)].obj)); ;}
+  case 135: /* type_list: type_list ',' type  */
+#line 642 "pyi/parser.y"
+                       { (yyval.list) = ctx->AppendList((yyvsp[-2].list), (yyvsp[0].obj)); }
+#line 2987 "pyi/parser.tab.cc"
     break;
 
-  case 136:
-
-/* Line 1464 of yacc.c  */
-#line 550 "parser.y"
-    { (yyval.obj) = StartList((yyvsp[(1) - (1)].obj)); ;}
+  case 136: /* type_list: type  */
+#line 643 "pyi/parser.y"
+         { (yyval.list) = ctx->StartList((yyvsp[0].obj)); }
+#line 2993 "pyi/parser.tab.cc"
     break;
 
-  case 137:
-
-/* Line 1464 of yacc.c  */
-#line 555 "parser.y"
-    { (yyval.obj) = (yyvsp[(1) - (1)].obj); ;}
+  case 137: /* dotted_name: NAME  */
+#line 648 "pyi/parser.y"
+         { (yyval.name) = (yyvsp[0].name); }
+#line 2999 "pyi/parser.tab.cc"
     break;
 
-  case 138:
-
-/* Line 1464 of yacc.c  */
-#line 556 "parser.y"
-    {
-      PyString_Concat(&(yyvsp[(1) - (3)].obj), DOT_STRING);
-      PyString_ConcatAndDel(&(yyvsp[(1) - (3)].obj), (yyvsp[(3) - (3)].obj));
-      (yyval.obj) = (yyvsp[(1) - (3)].obj);
-    ;}
+  case 138: /* dotted_name: dotted_name '.' NAME  */
+#line 649 "pyi/parser.y"
+                         { (yyval.name) = ctx->JoinDotted((yyvsp[-2].name), (yyvsp[0].name)); }
+#line 3005 "pyi/parser.tab.cc"
     break;
 
 
+#line 3009 "pyi/parser.tab.cc"
 
-/* Line 1464 of yacc.c  */
-#line 3213 "pyi/parser.tab.cc"
       default: break;
     }
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
 
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (&yylloc, scanner, ctx, YY_("syntax error"));
-#else
       {
-	YYSIZE_T yysize = yysyntax_error (0, yystate, yychar);
-	if (yymsg_alloc < yysize && yymsg_alloc < YYSTACK_ALLOC_MAXIMUM)
-	  {
-	    YYSIZE_T yyalloc = 2 * yysize;
-	    if (! (yysize <= yyalloc && yyalloc <= YYSTACK_ALLOC_MAXIMUM))
-	      yyalloc = YYSTACK_ALLOC_MAXIMUM;
-	    if (yymsg != yymsgbuf)
-	      YYSTACK_FREE (yymsg);
-	    yymsg = (char *) YYSTACK_ALLOC (yyalloc);
-	    if (yymsg)
-	      yymsg_alloc = yyalloc;
-	    else
-	      {
-		yymsg = yymsgbuf;
-		yymsg_alloc = sizeof yymsgbuf;
-	      }
-	  }
-
-	if (0 < yysize && yysize <= yymsg_alloc)
-	  {
-	    (void) yysyntax_error (yymsg, yystate, yychar);
-	    yyerror (&yylloc, scanner, ctx, yymsg);
-	  }
-	else
-	  {
-	    yyerror (&yylloc, scanner, ctx, YY_("syntax error"));
-	    if (yysize != 0)
-	      goto yyexhaustedlab;
-	  }
+        yypcontext_t yyctx
+          = {yyssp, yytoken, &yylloc};
+        char const *yymsgp = YY_("syntax error");
+        int yysyntax_error_status;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+        if (yysyntax_error_status == 0)
+          yymsgp = yymsg;
+        else if (yysyntax_error_status == -1)
+          {
+            if (yymsg != yymsgbuf)
+              YYSTACK_FREE (yymsg);
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
+              {
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
+              }
+            else
+              {
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
+              }
+          }
+        yyerror (&yylloc, lexer, ctx, yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-#endif
     }
 
-  yyerror_range[0] = yylloc;
-
+  yyerror_range[1] = yylloc;
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
-	 error, discard it.  */
-
-      if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+         error, discard it.  */
+
+      if (yychar <= END)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == END)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval, &yylloc, scanner, ctx);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, &yylloc, lexer, ctx);
+          yychar = YYEMPTY;
+        }
     }
 
   /* Else will try to reuse lookahead token after shifting the error
@@ -3311,15 +3115,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  yyerror_range[0] = yylsp[1-yylen];
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -3332,44 +3134,45 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
-      if (yyn != YYPACT_NINF)
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
-      yyerror_range[0] = *yylsp;
+      yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp, yylsp, scanner, ctx);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, lexer, ctx);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
     }
 
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
-  yyerror_range[1] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the lookahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, (yyerror_range - 1), 2);
-  *++yylsp = yyloc;
+  yyerror_range[2] = yylloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -3380,92 +3183,67 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#if !defined(yyoverflow) || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (&yylloc, scanner, ctx, YY_("memory exhausted"));
+  yyerror (&yylloc, lexer, ctx, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
-yyreturn:
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
-     yydestruct ("Cleanup: discarding lookahead",
-		 yytoken, &yylval, &yylloc, scanner, ctx);
-  /* Do not reclaim the symbols of the rule which action triggered
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, &yylloc, lexer, ctx);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp, yylsp, scanner, ctx);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, lexer, ctx);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
+  return yyresult;
 }
 
-
-
-/* Line 1684 of yacc.c  */
-#line 568 "parser.y"
+#line 657 "pyi/parser.y"
 
 
 namespace {
 
-int pytypeerror(
-    YYLTYPE* llocp, void* scanner, pytype::Context* ctx, const char *p) {
-  ctx->SetErrorLocation(llocp);
-  Lexer* lexer = pytypeget_extra(scanner);
-  if (lexer->error_message_) {
-    PyErr_SetObject(ctx->Value(kParseError), lexer->error_message_);
-  } else {
-    PyErr_SetString(ctx->Value(kParseError), p);
-  }
+int yyerror(
+    YYLTYPE* llocp, Lexer* lexer, pytype::Context* ctx, const char *p) {
+  ctx->SyntaxError(llocp, lexer, p);
   return 0;
 }
 
-PyObject* StartList(PyObject* item) {
-  return Py_BuildValue("[N]", item);
-}
-
-PyObject* AppendList(PyObject* list, PyObject* item) {
-  PyList_Append(list, item);
-  Py_DECREF(item);
-  return list;
-}
-
-PyObject* ExtendList(PyObject* dst, PyObject* src) {
-  // Add items from src to dst (both of which must be lists) and return src.
-  // Borrows the reference to src.
-  Py_ssize_t count = PyList_Size(src);
-  for (Py_ssize_t i=0; i < count; ++i) {
-    PyList_Append(dst, PyList_GetItem(src, i));
-  }
-  Py_DECREF(src);
-  return dst;
-}
-
 }  // end namespace
 }  // end namespace pytype
-
@@ -1,22 +1,22 @@
-/* A Bison parser, made by GNU Bison 2.4.2.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-/* Skeleton interface for Bison's Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989-1990, 2000-2006, 2009-2010 Free Software
-   Foundation, Inc.
-   
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -27,98 +27,133 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
-/* "%code requires" blocks.  */
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
 
-/* Line 1685 of yacc.c  */
-#line 18 "parser.y"
+#ifndef YY_PYTYPE_PYI_PARSER_TAB_H_INCLUDED
+# define YY_PYTYPE_PYI_PARSER_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int pytypedebug;
+#endif
+/* "%code requires" blocks.  */
+#line 25 "pyi/parser.y"
 
 #include <Python.h>
 
+namespace pytype {
+class Context;
+class Lexer;
+
+// A semantic value, which actions only handle through the Context: a new
+// reference to a Python object, or the id of a value in the IR when the
+// Context emits IR.  NULL if there was an error.
+typedef struct HandleTag* Handle;
 
+// The text of a name: a NAME token's value, or a dotted name.  Actions turn
+// it into a string value with Context::Name() once it is complete, so
+// building a dotted name creates no intermediate strings.  The text is in
+// the lexer's input or owned by the Context, and lasts until the end of the
+// parse.
+struct NameSpan {
+  const char* text;
+  int length;
+};
 
-/* Line 1685 of yacc.c  */
-#line 45 "pyi/parser.tab.h"
+// A list of values, see Context::List().
+struct HandleList;
+}
 
-/* Tokens.  */
+#line 76 "pyi/parser.tab.h"
+
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     END = 0,
-     NAME = 258,
-     NUMBER = 259,
-     LEXERROR = 260,
-     CLASS = 261,
-     DEF = 262,
-     ELSE = 263,
-     ELIF = 264,
-     IF = 265,
-     OR = 266,
-     PASS = 267,
-     IMPORT = 268,
-     FROM = 269,
-     AS = 270,
-     RAISE = 271,
-     PYTHONCODE = 272,
-     NOTHING = 273,
-     RAISES = 274,
-     NAMEDTUPLE = 275,
-     TYPEVAR = 276,
-     ARROW = 277,
-     COLONEQUALS = 278,
-     ELLIPSIS = 279,
-     EQ = 280,
-     NE = 281,
-     LE = 282,
-     GE = 283,
-     INDENT = 284,
-     DEDENT = 285,
-     TRIPLEQUOTED = 286,
-     TYPECOMMENT = 287
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    END = 0,                       /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    NAME = 258,                    /* NAME  */
+    NUMBER = 259,                  /* NUMBER  */
+    LEXERROR = 260,                /* LEXERROR  */
+    CLASS = 261,                   /* CLASS  */
+    DEF = 262,                     /* DEF  */
+    ELSE = 263,                    /* ELSE  */
+    ELIF = 264,                    /* ELIF  */
+    IF = 265,                      /* IF  */
+    OR = 266,                      /* OR  */
+    PASS = 267,                    /* PASS  */
+    IMPORT = 268,                  /* IMPORT  */
+    FROM = 269,                    /* FROM  */
+    AS = 270,                      /* AS  */
+    RAISE = 271,                   /* RAISE  */
+    PYTHONCODE = 272,              /* PYTHONCODE  */
+    NOTHING = 273,                 /* NOTHING  */
+    RAISES = 274,                  /* RAISES  */
+    NAMEDTUPLE = 275,              /* NAMEDTUPLE  */
+    TYPEVAR = 276,                 /* TYPEVAR  */
+    ARROW = 277,                   /* ARROW  */
+    COLONEQUALS = 278,             /* COLONEQUALS  */
+    ELLIPSIS = 279,                /* ELLIPSIS  */
+    EQ = 280,                      /* EQ  */
+    NE = 281,                      /* NE  */
+    LE = 282,                      /* LE  */
+    GE = 283,                      /* GE  */
+    INDENT = 284,                  /* INDENT  */
+    DEDENT = 285,                  /* DEDENT  */
+    TRIPLEQUOTED = 286,            /* TRIPLEQUOTED  */
+    TYPECOMMENT = 287              /* TYPECOMMENT  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
-
-
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
+union YYSTYPE
 {
+#line 109 "pyi/parser.y"
 
-/* Line 1685 of yacc.c  */
-#line 58 "parser.y"
-
-  PyObject* obj;
+  pytype::Handle obj;
+  pytype::HandleList* list;
+  pytype::NameSpan name;
   const char* str;
 
+#line 132 "pyi/parser.tab.h"
 
-
-/* Line 1685 of yacc.c  */
-#line 102 "pyi/parser.tab.h"
-} YYSTYPE;
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
-
-
+/* Location type.  */
 #if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE
+typedef struct YYLTYPE YYLTYPE;
+struct YYLTYPE
 {
   int first_line;
   int first_column;
   int last_line;
   int last_column;
-} YYLTYPE;
-# define yyltype YYLTYPE /* obsolescent; will be withdrawn */
+};
 # define YYLTYPE_IS_DECLARED 1
 # define YYLTYPE_IS_TRIVIAL 1
 #endif
 
 
 
+
+int pytypeparse (pytype::Lexer* lexer, pytype::Context* ctx);
+
+
+#endif /* !YY_PYTYPE_PYI_PARSER_TAB_H_INCLUDED  */
@@ -1,15 +1,22 @@
-%defines  // Creates a .h file.
+// Two parsers are generated from this grammar by make_parsers.sh, which
+// also gives them their prefixes: pytypeparse() in parser.tab.cc, without
+// the "error" rules (the lines marked "// recovering"), and
+// pytyperecoverparse() in recovering_parser.tab.cc, with them, which is
+// only used when recovering from errors.  The "error" rules change the
+// parser's tables, and with them the tokens that the messages of syntax
+// errors list as expected, so the normal parse doesn't have them.  Both
+// parsers share parser.tab.h.  Prefixes are not needed since we are
+// including the whole parser within a namespace, but they tell the parsers
+// apart.
 
-// Prefix is not needed since we are including the whole parser within a
-// namespace.  But use it anyway because using a prefix is a recommended
-// practice.
-%name-prefix = "pytype"
+%defines  // Creates a .h file.
 %locations
 
 // Use a reentrant parser, wire it up to a reentrant lexer.
 %pure-parser
-%lex-param {void* scanner}
-%parse-param {void* scanner}
+%lex-param {pytype::Lexer* lexer}
+%lex-param {pytype::Context* ctx}
+%parse-param {pytype::Lexer* lexer}
 // Plumb our Context object through the parser.
 %parse-param {pytype::Context* ctx}
 
@@ -17,6 +24,29 @@
 
 %code requires {
 #include <Python.h>
+
+namespace pytype {
+class Context;
+class Lexer;
+
+// A semantic value, which actions only handle through the Context: a new
+// reference to a Python object, or the id of a value in the IR when the
+// Context emits IR.  NULL if there was an error.
+typedef struct HandleTag* Handle;
+
+// The text of a name: a NAME token's value, or a dotted name.  Actions turn
+// it into a string value with Context::Name() once it is complete, so
+// building a dotted name creates no intermediate strings.  The text is in
+// the lexer's input or owned by the Context, and lasts until the end of the
+// parse.
+struct NameSpan {
+  const char* text;
+  int length;
+};
+
+// A list of values, see Context::List().
+struct HandleList;
+}
 }
 
 /* We cannot use %code here because we are intentionally leaving the
@@ -32,39 +62,63 @@ namespace pytype {
 // code after the parser skeleton is emitted.  Thus the entire parser (except
 // for a few #defines) is in the pytype namespace.
 
+// yyerror is renamed with the prefix of the parser, like yyparse.
 namespace {
-PyObject* DOT_STRING = PyString_FromString(".");
-
-int pytypeerror(YYLTYPE* llocp, void* scanner, pytype::Context* ctx,
+int yyerror(YYLTYPE* llocp, Lexer* lexer, pytype::Context* ctx,
     const char *p);
-
-/* Helper functions for building up lists. */
-PyObject* StartList(PyObject* item);
-PyObject* AppendList(PyObject* list, PyObject* item);
-PyObject* ExtendList(PyObject* dst, PyObject* src);
-
 }  // end namespace
 
 
-// Check that a python value is not NULL.  The must be a macro because it
-// calls YYERROR (which is a goto).
-#define CHECK(x, loc) do { if (x == NULL) {\
-    ctx->SetErrorLocation(&loc); \
+// Check that a value is not NULL, see Context::Check().  This must be a
+// macro because it calls YYERROR (which is a goto).
+#define CHECK(x, loc) do { if (!ctx->Check(x, &loc, lexer)) {\
     YYERROR; \
   }} while(0)
 
+// Continue after an error if the Context recovers from it, otherwise abort
+// the parse, releasing the list of the rule's other symbol (which the parser
+// leaves to the action).  See Context::Recover().
+#define RECOVER(list) do { if (!ctx->Recover()) {\
+    ctx->DropList(list); \
+    YYABORT; \
+  }} while(0)
+
+// The default location of a rule's value, as bison computes it, which also
+// counts the reduction of the rule (yyn) by its nonterminal for
+// Context::collect_stats().  The parser computes the location of every
+// reduction into yyloc, and only that of the error token elsewhere.
+#define YYLLOC_DEFAULT(Current, Rhs, N) do { \
+    if (N) { \
+      (Current).first_line = YYRHSLOC(Rhs, 1).first_line; \
+      (Current).first_column = YYRHSLOC(Rhs, 1).first_column; \
+      (Current).last_line = YYRHSLOC(Rhs, N).last_line; \
+      (Current).last_column = YYRHSLOC(Rhs, N).last_column; \
+    } else { \
+      (Current).first_line = (Current).last_line = \
+          YYRHSLOC(Rhs, 0).last_line; \
+      (Current).first_column = (Current).last_column = \
+          YYRHSLOC(Rhs, 0).last_column; \
+    } \
+    if (&(Current) == &yyloc) { \
+      ctx->CountReduction(yytname[yyr1[yyn]]); \
+    } \
+  } while (0)
+
 %}
 
 %union {
-  PyObject* obj;
+  pytype::Handle obj;
+  pytype::HandleList* list;
+  pytype::NameSpan name;
   const char* str;
 }
 
 /* This token value is defined by flex, give it a nice name. */
 %token END 0              "end of file"
 
-/* Tokens with PyObject values */
-%token <obj> NAME NUMBER LEXERROR
+/* Tokens with values */
+%token <name> NAME
+%token <obj> NUMBER LEXERROR
 
 /* Reserved words. */
 %token CLASS DEF ELSE ELIF IF OR PASS IMPORT FROM AS RAISE PYTHONCODE
@@ -75,29 +129,42 @@ PyObject* ExtendList(PyObject* dst, PyObject* src);
 %token INDENT DEDENT TRIPLEQUOTED TYPECOMMENT
 
 /* Most nonterminals have an obj value. */
-%type <obj> start unit alldefs if_stmt if_and_elifs
-%type <obj> class_if_stmt class_if_and_elifs
+%type <obj> start unit
 %type <obj> if_cond elif_cond else_cond condition version_tuple
 %type <obj> constantdef alias_or_constant typevardef
-%type <obj> classdef class_name parents parent_list parent maybe_class_funcs
-%type <obj> class_funcs funcdefs
-%type <obj> importdef import_items import_item from_list from_items from_item
-%type <obj> funcdef decorators decorator params param_list param param_type
-%type <obj> param_default param_star_name return raises exceptions maybe_body
-%type <obj> body body_stmt
-%type <obj> type type_parameters type_parameter
-%type <obj> named_tuple_fields named_tuple_field_list named_tuple_field
-%type <obj> maybe_type_list type_list
-%type <obj> dotted_name
-
-/* Decrement ref counts of any non-null lvals. */
-%destructor { Py_CLEAR($$); } <*>
-
-/* Nonterminals that use non-object values.  Note that these also require
- * a custom %destructor.
+%type <obj> classdef class_name parent
+%type <obj> importdef import_item from_item
+%type <obj> funcdef decorator param param_type
+%type <obj> param_default param_star_name return
+%type <obj> body_stmt
+%type <obj> type type_parameter
+%type <obj> named_tuple_field
+
+/* Nonterminals that stand for lists have a list value, which becomes an
+ * obj value (a tuple) with ctx->Sequence() once the list is complete.
  */
+%type <list> alldefs if_stmt if_and_elifs class_if_stmt class_if_and_elifs
+%type <list> parents parent_list maybe_class_funcs class_funcs funcdefs
+%type <list> import_items from_list from_items
+%type <list> decorators params param_list raises exceptions maybe_body body
+%type <list> type_parameters named_tuple_fields named_tuple_field_list
+%type <list> maybe_type_list type_list
+
+/* Release any non-null values. */
+%destructor { ctx->Drop($$); $$ = NULL; } <obj>
+%destructor { ctx->DropList($$); $$ = NULL; } <list>
+
+/* The values of an "if" statement's nonterminals stand for the peer's
+ * condition scope too, which error recovery must end when it discards them.
+ */
+%destructor { ctx->DropCondition($$); $$ = NULL; } if_cond if_and_elifs
+%destructor { ctx->DropCondition($$); $$ = NULL; } if_stmt
+%destructor { ctx->DropCondition($$); $$ = NULL; } class_if_and_elifs
+%destructor { ctx->DropCondition($$); $$ = NULL; } class_if_stmt
+
+/* Nonterminals that use non-object values, which need no %destructor. */
 %type <str> condition_op
-%destructor { } <condition_op>
+%type <name> dotted_name
 
 /* The following nonterminals do not have a value, and are not included in
  * the above %type directives.
@@ -116,97 +183,108 @@ PyObject* ExtendList(PyObject* dst, PyObject* src);
  * by the stack up until the action is called, at which point the action
  * is responsible for properly decrementing the refcount.  The action is
  * also responsible for pushing a new reference back onto the stack ($$).
- * When an action uses ctx->Call(), these references can be properly counted
- * simply by using N instead of O in the argument format string.  In fact, N
- * is almost always going to be the right choice for values that are coming
- * from the stack or ctx->Value() since those are all new references.
- * O should be used only when working with a borrowed reference (i.e. Py_None).
+ * Values are only handled through the Context (see Handle), whose methods
+ * consume the values passed to them, thus values that are coming from the
+ * stack or the Context can be passed as they are, since those are all new
+ * references.  A value that is also used afterwards must be duplicated with
+ * ctx->Dup() first, and a value that isn't used must be released with
+ * ctx->Drop().  Lists are owned the same way, and released with
+ * ctx->DropList().  Names (NAME and dotted_name) are not references but
+ * NameSpans, which need no releasing, and are passed as ctx->Name($1, lexer)
+ * where a value is needed.
+ *
+ * The "error" rules recover from errors at the level of statements, class
+ * bodies and function bodies, if the Context is recovering from errors (see
+ * Context::Recover()), otherwise they abort the parse.  The Context skips
+ * the rest of the statement that failed before the parser resumes.  They
+ * are only in the recovering parser, see above.
  */
 
 start
-  : unit END { ctx->SetAndDelResult($1); $$ = NULL; }
-  | TRIPLEQUOTED unit END { ctx->SetAndDelResult($2); $$ = NULL; }
+  : unit END { ctx->SetResult($1); $$ = NULL; }
+  | TRIPLEQUOTED unit END { ctx->SetResult($2); $$ = NULL; }
   ;
 
 unit
-  : alldefs
+  : alldefs { $$ = ctx->Sequence($1); }
   ;
 
 alldefs
-  : alldefs constantdef { $$ = AppendList($1, $2); }
-  | alldefs funcdef { $$ = AppendList($1, $2); }
-  | alldefs importdef { $$ = $1; Py_DECREF($2); }
-  | alldefs alias_or_constant { $$ = $1; Py_DECREF($2); }
-  | alldefs classdef { $$ = $1; Py_DECREF($2); }
-  | alldefs typevardef { $$ = $1; Py_DECREF($2); }
+  : alldefs constantdef { $$ = ctx->AppendList($1, $2); }
+  | alldefs funcdef { $$ = ctx->AppendList($1, $2); }
+  | alldefs importdef { $$ = $1; ctx->Drop($2); }
+  | alldefs alias_or_constant { $$ = $1; ctx->Drop($2); }
+  | alldefs classdef { $$ = $1; ctx->Drop($2); }
+  | alldefs typevardef { $$ = $1; ctx->Drop($2); }
   | alldefs if_stmt {
-      PyObject* tmp = ctx->Call(kIfEnd, "(N)", $2);
+      Handle tmp = ctx->IfEnd(ctx->Sequence($2));
       CHECK(tmp, @2);
-      $$ = ExtendList($1, tmp);
+      $$ = ctx->ExtendList($1, tmp);
     }
-  | { $$ = PyList_New(0); }
+  | alldefs error { RECOVER($1); $$ = $1; }  // recovering
+  | { $$ = ctx->List(); }
   ;
 
 classdef
   : CLASS class_name parents ':' maybe_class_funcs {
-      $$ = ctx->Call(kAddClass, "(NNN)", $2, $3, $5);
+      $$ = ctx->AddClass($2, ctx->Sequence($3), ctx->Sequence($5));
       CHECK($$, @$);
     }
   ;
 
 class_name
   : NAME {
-      // Do not borrow the $1 reference since it is also returned later
-      // in $$.  Use O instead of N in the format string.
-      PyObject* tmp = ctx->Call(kRegisterClassName, "(O)", $1);
+      // Do not give away $$ since it is also the value of the rule.
+      $$ = ctx->Name($1, lexer);
+      Handle tmp = ctx->RegisterClassName(ctx->Dup($$));
       CHECK(tmp, @$);
-      Py_DECREF(tmp);
-      $$ = $1;
+      ctx->Drop(tmp);
     }
   ;
 
 parents
   : '(' parent_list ')' { $$ = $2; }
-  | '(' ')' { $$ = PyList_New(0); }
-  |  /* EMPTY */ { $$ = PyList_New(0); }
+  | '(' ')' { $$ = ctx->List(); }
+  |  /* EMPTY */ { $$ = ctx->List(); }
   ;
 
 parent_list
-  : parent_list ',' parent { $$ = AppendList($1, $3); }
-  | parent { $$ = StartList($1); }
+  : parent_list ',' parent { $$ = ctx->AppendList($1, $3); }
+  | parent { $$ = ctx->StartList($1); }
   ;
 
 parent
   : type { $$ = $1; }
-  | NAME '=' type { $$ = Py_BuildValue("(NN)", $1, $3); }
+  | NAME '=' type { $$ = ctx->Tuple(ctx->Name($1, lexer), $3); }
   ;
 
 maybe_class_funcs
-  : pass_or_ellipsis { $$ = PyList_New(0); }
+  : pass_or_ellipsis { $$ = ctx->List(); }
   | INDENT class_funcs DEDENT { $$ = $2; }
   | INDENT TRIPLEQUOTED class_funcs DEDENT { $$ = $3; }
   ;
 
 class_funcs
-  : pass_or_ellipsis { $$ = PyList_New(0); }
+  : pass_or_ellipsis { $$ = ctx->List(); }
   | funcdefs
   ;
 
 funcdefs
-  : funcdefs constantdef { $$ = AppendList($1, $2); }
-  | funcdefs funcdef { $$ = AppendList($1, $2); }
+  : funcdefs constantdef { $$ = ctx->AppendList($1, $2); }
+  | funcdefs funcdef { $$ = ctx->AppendList($1, $2); }
   | funcdefs class_if_stmt {
-      PyObject* tmp = ctx->Call(kIfEnd, "(N)", $2);
+      Handle tmp = ctx->IfEnd(ctx->Sequence($2));
       CHECK(tmp, @2);
-      $$ = ExtendList($1, tmp);
+      $$ = ctx->ExtendList($1, tmp);
     }
-  | /* EMPTY */ { $$ = PyList_New(0); }
+  | funcdefs error { RECOVER($1); $$ = $1; }  // recovering
+  | /* EMPTY */ { $$ = ctx->List(); }
   ;
 
 if_stmt
   /* Optional ELSE clause after all IF/ELIF/... clauses. */
   : if_and_elifs else_cond ':' INDENT alldefs DEDENT {
-      $$ = AppendList($1, Py_BuildValue("(NN)", $2, $5));
+      $$ = ctx->AppendList($1, ctx->Tuple($2, ctx->Sequence($5)));
     }
   | if_and_elifs
   ;
@@ -214,11 +292,11 @@ if_stmt
 if_and_elifs
   /* Always start with IF */
   : if_cond ':' INDENT alldefs DEDENT {
-      $$ = Py_BuildValue("[(NN)]", $1, $4);
+      $$ = ctx->StartList(ctx->Tuple($1, ctx->Sequence($4)));
     }
   /* Then zero or more ELIF clauses */
   | if_and_elifs elif_cond ':' INDENT alldefs DEDENT {
-      $$ = AppendList($1, Py_BuildValue("(NN)", $2, $5));
+      $$ = ctx->AppendList($1, ctx->Tuple($2, ctx->Sequence($5)));
     }
   ;
 
@@ -237,7 +315,7 @@ if_and_elifs
 class_if_stmt
   /* Optional ELSE clause after all IF/ELIF/... clauses. */
   : class_if_and_elifs else_cond ':' INDENT funcdefs DEDENT {
-      $$ = AppendList($1, Py_BuildValue("(NN)", $2, $5));
+      $$ = ctx->AppendList($1, ctx->Tuple($2, ctx->Sequence($5)));
     }
   | class_if_and_elifs
   ;
@@ -245,11 +323,11 @@ class_if_stmt
 class_if_and_elifs
   /* Always start with IF */
   : if_cond ':' INDENT funcdefs DEDENT {
-      $$ = Py_BuildValue("[(NN)]", $1, $4);
+      $$ = ctx->StartList(ctx->Tuple($1, ctx->Sequence($4)));
     }
   /* Then zero or more ELIF clauses */
   | class_if_and_elifs elif_cond ':' INDENT funcdefs DEDENT {
-      $$ = AppendList($1, Py_BuildValue("(NN)", $2, $5));
+      $$ = ctx->AppendList($1, ctx->Tuple($2, ctx->Sequence($5)));
     }
   ;
 
@@ -260,32 +338,33 @@ class_if_and_elifs
  */
 
 if_cond
-  : IF condition { $$ = ctx->Call(kIfBegin, "(N)", $2); CHECK($$, @$); }
+  : IF condition { $$ = ctx->IfBegin($2); CHECK($$, @$); }
   ;
 
 elif_cond
-  : ELIF condition { $$ = ctx->Call(kIfElif, "(N)", $2); CHECK($$, @$); }
+  : ELIF condition { $$ = ctx->IfElif($2); CHECK($$, @$); }
   ;
 
 else_cond
-  : ELSE { $$ = ctx->Call(kIfElse, "()"); CHECK($$, @$); }
+  : ELSE { $$ = ctx->IfElse(); CHECK($$, @$); }
   ;
 
 condition
   : dotted_name condition_op NAME {
-      $$ = Py_BuildValue("(NsN)", $1, $2, $3);
+      $$ = ctx->Tuple(ctx->Name($1, lexer), ctx->String($2),
+                      ctx->Name($3, lexer));
     }
   | dotted_name condition_op version_tuple {
-      $$ = Py_BuildValue("(NsN)", $1, $2, $3);
+      $$ = ctx->Tuple(ctx->Name($1, lexer), ctx->String($2), $3);
     }
   ;
 
 /* TODO(dbaum): Consider more general rules for tuple parsing. */
 version_tuple
-  : '(' NUMBER ',' ')' { $$ = Py_BuildValue("(N)", $2); }
-  | '(' NUMBER ',' NUMBER ')' { $$ = Py_BuildValue("(NN)", $2, $4); }
+  : '(' NUMBER ',' ')' { $$ = ctx->Tuple($2); }
+  | '(' NUMBER ',' NUMBER ')' { $$ = ctx->Tuple($2, $4); }
   | '(' NUMBER ',' NUMBER ',' NUMBER ')' {
-      $$ = Py_BuildValue("(NNN)", $2, $4, $6);
+      $$ = ctx->Tuple($2, $4, $6);
     }
   ;
 
@@ -300,45 +379,47 @@ condition_op
 
 constantdef
   : NAME '=' NUMBER {
-      $$ = ctx->Call(kNewConstant, "(NN)", $1, $3);
+      $$ = ctx->NewConstant(ctx->Name($1, lexer), $3);
       CHECK($$, @$);
     }
   | NAME '=' ELLIPSIS {
-      $$ = ctx->Call(kNewConstant, "(NN)", $1, ctx->Value(kAnything));
+      $$ = ctx->NewConstant(ctx->Name($1, lexer), ctx->Value(kAnything));
       CHECK($$, @$);
     }
   | NAME '=' ELLIPSIS TYPECOMMENT type {
-      $$ = ctx->Call(kNewConstant, "(NN)", $1, $5);
+      $$ = ctx->NewConstant(ctx->Name($1, lexer), $5);
       CHECK($$, @$);
     }
   | NAME ':' type {
-      $$ = ctx->Call(kNewConstant, "(NN)", $1, $3);
+      $$ = ctx->NewConstant(ctx->Name($1, lexer), $3);
       CHECK($$, @$);
     }
   | NAME ':' type '=' ELLIPSIS {
-      $$ = ctx->Call(kNewConstant, "(NN)", $1, $3);
+      $$ = ctx->NewConstant(ctx->Name($1, lexer), $3);
       CHECK($$, @$);
     }
   ;
 
 importdef
   : IMPORT import_items {
-      $$ = ctx->Call(kAddImport, "(ON)", Py_None, $2);
+      $$ = ctx->AddImport(ctx->None(), ctx->Sequence($2));
       CHECK($$, @$);
     }
   | FROM dotted_name IMPORT from_list {
-      $$ = ctx->Call(kAddImport, "(NN)", $2, $4);
+      $$ = ctx->AddImport(ctx->Name($2, lexer), ctx->Sequence($4));
       CHECK($$, @$);
     }
   ;
 
 import_items
-  : import_items ',' import_item { $$ = AppendList($1, $3); }
-  | import_item { $$ = StartList($1); }
+  : import_items ',' import_item { $$ = ctx->AppendList($1, $3); }
+  | import_item { $$ = ctx->StartList($1); }
 
 import_item
-  : dotted_name
-  | dotted_name AS NAME { $$ = Py_BuildValue("(NN)", $1, $3); }
+  : dotted_name { $$ = ctx->Name($1, lexer); }
+  | dotted_name AS NAME {
+      $$ = ctx->Tuple(ctx->Name($1, lexer), ctx->Name($3, lexer));
+    }
   ;
 
 from_list
@@ -348,35 +429,39 @@ from_list
   ;
 
 from_items
-  : from_items ',' from_item { $$ = AppendList($1, $3); }
-  | from_item { $$ = StartList($1); }
+  : from_items ',' from_item { $$ = ctx->AppendList($1, $3); }
+  | from_item { $$ = ctx->StartList($1); }
   ;
 
 from_item
-  : NAME
-  | NAMEDTUPLE { $$ = PyString_FromString("NamedTuple"); }
-  | TYPEVAR { $$ = PyString_FromString("TypeVar"); }
-  | '*' { $$ = PyString_FromString("*"); }
-  | NAME AS NAME { $$ = Py_BuildValue("(NN)", $1, $3); }
+  : NAME { $$ = ctx->Name($1, lexer); }
+  | NAMEDTUPLE { $$ = ctx->String("NamedTuple"); }
+  | TYPEVAR { $$ = ctx->String("TypeVar"); }
+  | '*' { $$ = ctx->String("*"); }
+  | NAME AS NAME {
+      $$ = ctx->Tuple(ctx->Name($1, lexer), ctx->Name($3, lexer));
+    }
   ;
 
 alias_or_constant
   : NAME '=' type {
-      $$ = ctx->Call(kAddAliasOrConstant, "(NN)", $1, $3);
+      $$ = ctx->AddAliasOrConstant(ctx->Name($1, lexer), $3);
       CHECK($$, @$);
     }
   ;
 
 typevardef
   : NAME '=' TYPEVAR '(' params ')' {
-      $$ = ctx->Call(kAddTypeVar, "(NN)", $1, $5);
+      $$ = ctx->AddTypeVar(ctx->Name($1, lexer), ctx->Sequence($5));
       CHECK($$, @$);
     }
   ;
 
 funcdef
   : decorators DEF NAME '(' params ')' return raises maybe_body {
-      $$ = ctx->Call(kNewFunction, "(NNNNNN)", $1, $3, $5, $7, $8, $9);
+      $$ = ctx->NewFunction(ctx->Sequence($1), ctx->Name($3, lexer),
+                            ctx->Sequence($5), $7, ctx->Sequence($8),
+                            ctx->Sequence($9));
       // Decorators is nullable and messes up the location tracking by
       // using the previous symbol as the start location for this production,
       // which is very misleading.  It is better to ignore decorators and
@@ -392,7 +477,7 @@ funcdef
     }
   | decorators DEF NAME PYTHONCODE {
       // TODO(dbaum): Is PYTHONCODE necessary?
-      $$ = ctx->Call(kNewExternalFunction, "(NN)", $1, $3);
+      $$ = ctx->NewExternalFunction(ctx->Sequence($1), ctx->Name($3, lexer));
       // See comment above about why @2 is used as the start.
       @$.first_line = @2.first_line;
       @$.first_column = @2.first_column;
@@ -401,47 +486,49 @@ funcdef
   ;
 
 decorators
-  : decorators decorator { $$ = AppendList($1, $2); }
-  | /* EMPTY */ { $$ = PyList_New(0); }
+  : decorators decorator { $$ = ctx->AppendList($1, $2); }
+  | /* EMPTY */ { $$ = ctx->List(); }
   ;
 
 decorator
-  : '@' dotted_name { $$ = $2; }
+  : '@' dotted_name { $$ = ctx->Name($2, lexer); }
   ;
 
  /* TODO(dbaum): Consider allowing a trailing comma after param_list. */
 params
   : param_list { $$ = $1; }
-  | /* EMPTY */ { $$ = PyList_New(0); }
+  | /* EMPTY */ { $$ = ctx->List(); }
   ;
 
 param_list
-  : param_list ',' param { $$ = AppendList($1, $3); }
-  | param { $$ = StartList($1); }
+  : param_list ',' param { $$ = ctx->AppendList($1, $3); }
+  | param { $$ = ctx->StartList($1); }
   ;
 
 param
-  : NAME param_type param_default { $$ = Py_BuildValue("(NNN)", $1, $2, $3); }
-  | '*' { $$ = Py_BuildValue("(sOO)", "*", Py_None, Py_None); }
-  | param_star_name param_type { $$ = Py_BuildValue("(NNO)", $1, $2, Py_None); }
-  | ELLIPSIS { $$ = ctx->Value(kEllipsis) }
+  : NAME param_type param_default {
+      $$ = ctx->Tuple(ctx->Name($1, lexer), $2, $3);
+    }
+  | '*' { $$ = ctx->Tuple(ctx->String("*"), ctx->None(), ctx->None()); }
+  | param_star_name param_type { $$ = ctx->Tuple($1, $2, ctx->None()); }
+  | ELLIPSIS { $$ = ctx->Value(kEllipsis); }
   ;
 
 param_type
   : ':' type { $$ = $2; }
-  | /* EMPTY */ { Py_INCREF(Py_None); $$ = Py_None; }
+  | /* EMPTY */ { $$ = ctx->None(); }
   ;
 
 param_default
-  : '=' NAME { $$ = $2; }
+  : '=' NAME { $$ = ctx->Name($2, lexer); }
   | '=' NUMBER { $$ = $2; }
   | '=' ELLIPSIS { $$ = ctx->Value(kEllipsis); }
-  | { Py_INCREF(Py_None); $$ = Py_None; }
+  | { $$ = ctx->None(); }
   ;
 
 param_star_name
-  : '*' NAME { $$ = PyString_FromFormat("*%s", PyString_AsString($2)); }
-  | '*' '*' NAME { $$ = PyString_FromFormat("**%s", PyString_AsString($3)); }
+  : '*' NAME { $$ = ctx->Name(ctx->Prefix("*", $2), lexer); }
+  | '*' '*' NAME { $$ = ctx->Name(ctx->Prefix("**", $3), lexer); }
   ;
 
 return
@@ -451,17 +538,17 @@ return
 
 raises
   : RAISES exceptions { $$ = $2; }
-  | /* EMPTY */ { $$ = PyList_New(0); }
+  | /* EMPTY */ { $$ = ctx->List(); }
   ;
 
 exceptions
-  : exceptions ',' type { $$ = AppendList($1, $3); }
-  | type { $$ = StartList($1); }
+  : exceptions ',' type { $$ = ctx->AppendList($1, $3); }
+  | type { $$ = ctx->StartList($1); }
   ;
 
 maybe_body
   : ':' INDENT body DEDENT { $$ = $3; }
-  | empty_body { $$ = PyList_New(0); }
+  | empty_body { $$ = ctx->List(); }
   ;
 
 empty_body
@@ -472,19 +559,21 @@ empty_body
   ;
 
 body
-  : body body_stmt { $$ = AppendList($1, $2); }
-  | body_stmt { $$ = StartList($1); }
+  : body body_stmt { $$ = ctx->AppendList($1, $2); }
+  | body_stmt { $$ = ctx->StartList($1); }
+  | body error { RECOVER($1); $$ = $1; }  // recovering
+  | error { RECOVER(NULL); $$ = ctx->List(); }  // recovering
   ;
 
 body_stmt
-  : NAME COLONEQUALS type { $$ = Py_BuildValue("(NN)", $1, $3); }
-  | RAISE NAME { Py_DECREF($2); Py_INCREF(Py_None); $$ = Py_None; }
-  | RAISE NAME '(' ')' { Py_DECREF($2); Py_INCREF(Py_None); $$ = Py_None; }
+  : NAME COLONEQUALS type { $$ = ctx->Tuple(ctx->Name($1, lexer), $3); }
+  | RAISE NAME { $$ = ctx->None(); }
+  | RAISE NAME '(' ')' { $$ = ctx->None(); }
   ;
 
 type_parameters
-  : type_parameters ',' type_parameter { $$ = AppendList($1, $3); }
-  | type_parameter { $$ = StartList($1); }
+  : type_parameters ',' type_parameter { $$ = ctx->AppendList($1, $3); }
+  | type_parameter { $$ = ctx->StartList($1); }
   ;
 
 type_parameter
@@ -494,11 +583,11 @@ type_parameter
 
 type
   : dotted_name {
-      $$ = ctx->Call(kNewType, "(N)", $1);
+      $$ = ctx->NewType(ctx->Name($1, lexer), NULL);
       CHECK($$, @$);
     }
   | dotted_name '[' type_parameters ']' {
-      $$ = ctx->Call(kNewType, "(NN)", $1, $3);
+      $$ = ctx->NewType(ctx->Name($1, lexer), ctx->Sequence($3));
       CHECK($$, @$);
     }
   | '[' maybe_type_list ']' {
@@ -508,31 +597,35 @@ type
       // not try to convert it to HomogeneousContainerType (like it does with
       // typing.Tuple).  This feels inconsistent and should be revisited once
       // the parser is complete.
-      $$ = ctx->Call(kNewType, "(sN)", "tuple", $2);
+      $$ = ctx->NewType(ctx->String("tuple"), ctx->Sequence($2));
       CHECK($$, @$);
     }
   | NAMEDTUPLE '(' NAME ',' named_tuple_fields ')' {
-      $$ = ctx->Call(kNewNamedTuple, "(NN)", $3, $5);
+      $$ = ctx->NewNamedTuple(ctx->Name($3, lexer), ctx->Sequence($5));
       CHECK($$, @$);
     }
   | '(' type ')' { $$ = $2; }
-  | type OR type { $$ = ctx->Call(kNewUnionType, "([NN])", $1, $3); }
+  | type OR type { $$ = ctx->NewUnionType($1, $3); }
   | '?' { $$ = ctx->Value(kAnything); }
   | NOTHING { $$ = ctx->Value(kNothing); }
   ;
 
 named_tuple_fields
   : '[' named_tuple_field_list maybe_comma ']' { $$ = $2; }
-  | '[' ']' { $$ = PyList_New(0); }
+  | '[' ']' { $$ = ctx->List(); }
   ;
 
 named_tuple_field_list
-  : named_tuple_field_list ',' named_tuple_field { $$ = AppendList($1, $3); }
-  | named_tuple_field { $$ = StartList($1); }
+  : named_tuple_field_list ',' named_tuple_field {
+      $$ = ctx->AppendList($1, $3);
+    }
+  | named_tuple_field { $$ = ctx->StartList($1); }
   ;
 
 named_tuple_field
-  : '(' NAME ',' type maybe_comma ')'  { $$ = Py_BuildValue("(NN)", $2, $4); }
+  : '(' NAME ',' type maybe_comma ')'  {
+      $$ = ctx->Tuple(ctx->Name($2, lexer), $4);
+    }
   ;
 
 maybe_comma
@@ -542,22 +635,18 @@ maybe_comma
 
 maybe_type_list
   : type_list { $$ = $1; }
-  | /* EMPTY */ { $$ = PyList_New(0); }
+  | /* EMPTY */ { $$ = ctx->List(); }
   ;
 
 type_list
-  : type_list ',' type { $$ = AppendList($1, $3); }
-  | type { $$ = StartList($1); }
+  : type_list ',' type { $$ = ctx->AppendList($1, $3); }
+  | type { $$ = ctx->StartList($1); }
   ;
 
 
 dotted_name
   : NAME { $$ = $1; }
-  | dotted_name '.' NAME {
-      PyString_Concat(&$1, DOT_STRING);
-      PyString_ConcatAndDel(&$1, $3);
-      $$ = $1;
-    }
+  | dotted_name '.' NAME { $$ = ctx->JoinDotted($1, $3); }
   ;
 
 pass_or_ellipsis
@@ -569,38 +658,11 @@ pass_or_ellipsis
 
 namespace {
 
-int pytypeerror(
-    YYLTYPE* llocp, void* scanner, pytype::Context* ctx, const char *p) {
-  ctx->SetErrorLocation(llocp);
-  Lexer* lexer = pytypeget_extra(scanner);
-  if (lexer->error_message_) {
-    PyErr_SetObject(ctx->Value(kParseError), lexer->error_message_);
-  } else {
-    PyErr_SetString(ctx->Value(kParseError), p);
-  }
+int yyerror(
+    YYLTYPE* llocp, Lexer* lexer, pytype::Context* ctx, const char *p) {
+  ctx->SyntaxError(llocp, lexer, p);
   return 0;
 }
 
-PyObject* StartList(PyObject* item) {
-  return Py_BuildValue("[N]", item);
-}
-
-PyObject* AppendList(PyObject* list, PyObject* item) {
-  PyList_Append(list, item);
-  Py_DECREF(item);
-  return list;
-}
-
-PyObject* ExtendList(PyObject* dst, PyObject* src) {
-  // Add items from src to dst (both of which must be lists) and return src.
-  // Borrows the reference to src.
-  Py_ssize_t count = PyList_Size(src);
-  for (Py_ssize_t i=0; i < count; ++i) {
-    PyList_Append(dst, PyList_GetItem(src, i));
-  }
-  Py_DECREF(src);
-  return dst;
-}
-
 }  // end namespace
 }  // end namespace pytype
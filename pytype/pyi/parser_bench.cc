@@ -0,0 +1,185 @@
+// A standalone benchmark of the native lexer and parser.  It embeds Python
+// only because the parser is linked with it, and times the scanning and
+// parsing of files into IR directly, without the cost of building the
+// Python objects that parser_ext.tokenize() and parse() return.
+//
+// Usage: parser_bench [--iterations=N] [--handwritten] FILE...
+//
+// Prints a line of JSON for each stage ("lex", then "parse_ir") with the
+// number of files, bytes and tokens, the best time over the iterations of
+// processing all of the files, the number of calls to operator new made by
+// one iteration and the peak RSS of the process in KB, e.g.
+//
+//   {"stage": "lex", "files": 2, "bytes": 1024, "tokens": 300,
+//    "seconds": 0.000120, "operator_new_calls": 14, "peak_rss_kb": 5120}
+//
+// (on one line).  The calls don't include the scanner's buffers, which flex
+// allocates with malloc().  parser_benchmark.py runs this and merges its
+// results with its own.  See setup.py's bench command, which builds it.
+
+#include <Python.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "lexer.h"
+#include "mapped_file.h"
+#include "parser.h"
+
+namespace {
+
+std::atomic<long> operator_new_calls(0);
+
+}  // end namespace
+
+// Count the lexer's and parser's calls to operator new.
+void* operator new(size_t size) {
+  operator_new_calls++;
+  void* p = malloc(size ? size : 1);
+  if (p == NULL) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+namespace pytype {
+
+namespace {
+
+struct Options {
+  int iterations;
+  LexerBackend backend;
+  std::vector<const char*> paths;
+};
+
+// The work done for the files in one iteration of a stage.
+struct Work {
+  long bytes;
+  long tokens;
+};
+
+// Scan a file, counting its tokens.
+void Lex(const MappedFile& file, LexerBackend backend, Work* work) {
+  Lexer lexer(file, backend);
+  Token token;
+  for (lexer.Next(&token); token.kind != 0; lexer.Next(&token)) {
+    work->tokens++;
+  }
+}
+
+// Parse a file into IR.
+void ParseIr(const MappedFile& file, LexerBackend backend, Work* work) {
+  Lexer lexer(file, backend);
+  std::string ir;
+  if (ParseToIr(&lexer, false, &ir) > 1) {
+    fprintf(stderr, "parser_bench: parsing failed\n");
+    exit(1);
+  }
+}
+
+long PeakRssKb() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+// Run a stage over the files and print its line.  tokens is the number of
+// tokens in the files, or 0 to count them.
+long RunStage(const char* name,
+              void (*run)(const MappedFile&, LexerBackend, Work*),
+              const Options& options,
+              const std::vector<std::unique_ptr<MappedFile>>& files,
+              long tokens) {
+  double best = 0;
+  Work work = {0, 0};
+  long new_calls = 0;
+  for (int i = 0; i < options.iterations; i++) {
+    work.bytes = 0;
+    work.tokens = 0;
+    long start_new_calls = operator_new_calls;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& file : files) {
+      run(*file, options.backend, &work);
+      work.bytes += file->length();
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    new_calls = operator_new_calls - start_new_calls;
+    if (i == 0 || elapsed.count() < best) {
+      best = elapsed.count();
+    }
+  }
+  if (tokens == 0) {
+    tokens = work.tokens;
+  }
+  printf("{\"stage\": \"%s\", \"files\": %zu, \"bytes\": %ld, "
+         "\"tokens\": %ld, \"seconds\": %.9f, \"operator_new_calls\": %ld, "
+         "\"peak_rss_kb\": %ld}\n",
+         name, files.size(), work.bytes, tokens, best, new_calls,
+         PeakRssKb());
+  return tokens;
+}
+
+bool ParseArgs(int argc, char** argv, Options* options) {
+  options->iterations = 10;
+  options->backend = kDefaultLexerBackend;
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    if (strncmp(arg, "--iterations=", 13) == 0) {
+      options->iterations = atoi(arg + 13);
+      if (options->iterations < 1) {
+        return false;
+      }
+    } else if (strcmp(arg, "--handwritten") == 0) {
+      options->backend = kHandwrittenBackend;
+    } else if (arg[0] == '-') {
+      return false;
+    } else {
+      options->paths.push_back(arg);
+    }
+  }
+  return !options->paths.empty();
+}
+
+int Main(int argc, char** argv) {
+  Options options;
+  if (!ParseArgs(argc, argv, &options)) {
+    fprintf(stderr,
+            "usage: %s [--iterations=N] [--handwritten] FILE...\n", argv[0]);
+    return 2;
+  }
+  std::vector<std::unique_ptr<MappedFile>> files;
+  for (const char* path : options.paths) {
+    files.emplace_back(new MappedFile);
+    if (!files.back()->Open(path)) {
+      perror(path);
+      return 1;
+    }
+  }
+  long tokens = RunStage("lex", Lex, options, files, 0);
+  RunStage("parse_ir", ParseIr, options, files, tokens);
+  return 0;
+}
+
+}  // end namespace
+
+}  // end namespace pytype
+
+int main(int argc, char** argv) {
+  Py_Initialize();
+  int status = pytype::Main(argc, argv);
+  Py_Finalize();
+  return status;
+}
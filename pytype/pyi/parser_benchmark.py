@@ -0,0 +1,357 @@
+"""Benchmark the pyi parser over corpora of stubs.
+
+Usage: python -m pytype.pyi.parser_benchmark [options]
+
+Times parser_ext.tokenize(), the low level parser (parser_ext with the peer,
+but without building the AST) and parser.parse_string() over the builtins,
+the stdlib stubs and typeshed, and, with --driver, the native lexer and
+parser alone (see parser_bench.cc, which setup.py's bench command builds).
+Prints MB/s, tokens/s and peer calls/s for each corpus and stage, with the
+token values allocated by the lexers (for the Python stages), the calls to
+operator new (for the driver stages) and the peak RSS, and optionally writes
+the results as JSON, to compare later runs against with --baseline: the
+benchmark then exits with status 1 if a stage got slower by more than the
+tolerance.
+"""
+
+import collections
+import glob
+import json
+import optparse
+import os
+import resource
+import subprocess
+import sys
+import time
+
+from pytype.pyi import parser
+from pytype.pyi import parser_ext
+from pytype.pytd import typeshed
+
+_PYTD_DIR = os.path.join(
+    os.path.dirname(os.path.dirname(os.path.abspath(__file__))), "pytd")
+
+# The peer methods that the low level parser calls, see _Parser.
+_PEER_METHODS = (
+    "set_error_location", "new_type", "new_union_type", "add_import",
+    "add_alias_or_constant", "new_constant", "new_function",
+    "new_external_function", "new_named_tuple", "register_class_name",
+    "add_class", "add_type_var", "if_begin", "if_elif", "if_else", "if_end")
+
+# The version of the format of the results.
+_FORMAT = 3
+
+# A stub, where path is None for a stub that isn't a file.
+Source = collections.namedtuple("Source", ["name", "path", "text"])
+
+
+class _LowLevelParser(parser._Parser):  # pylint: disable=protected-access
+  """A peer that stops after the low level parse, before building the AST."""
+
+  def _parse(self, parse_ext, src, name, filename):
+    self._used = True
+    self._filename = filename
+    self._ast_name = name
+    self._type_map = {}
+    return parse_ext()
+
+
+def _count_calls(peer):
+  """Make peer count its calls of the peer methods, return the counts."""
+  calls = collections.Counter()
+  def counter(name, method):
+    def call(*args):
+      calls[name] += 1
+      return method(*args)
+    return call
+  for name in _PEER_METHODS:
+    setattr(peer, name, counter(name, getattr(peer, name)))
+  return calls
+
+
+def _tokenize(source):
+  return len(parser_ext.tokenize(source.text))
+
+
+def _parse(peer, source, counts):
+  calls = _count_calls(peer) if counts is not None else None
+  peer.parse(source.text, source.name, source.path)
+  if calls:
+    counts.update(calls)
+
+
+def _parse_low_level(source, counts=None):
+  _parse(_LowLevelParser(None, None), source, counts)
+
+
+def _parse_string(source, counts=None):
+  # pylint: disable=protected-access
+  _parse(parser._Parser(None, None), source, counts)
+
+
+# The stages run on each corpus, in order, by name and the function that
+# processes a source, which takes a Counter for the peer calls, if any.
+_STAGES = (
+    ("tokenize", None),
+    ("parse", _parse_low_level),
+    ("parse_string", _parse_string),
+)
+
+
+def _module_name(root, path):
+  name = os.path.splitext(os.path.relpath(path, root))[0]
+  return name.replace(os.sep, ".")
+
+
+def load_corpus(root, patterns):
+  """Return the Sources of the files under root that match the patterns.
+
+  Files that don't parse (e.g. typeshed stubs for features that the parser
+  doesn't support) are left out, so that every stage processes the same
+  sources.
+
+  Args:
+    root: A directory.
+    patterns: Glob patterns, relative to root.
+
+  Returns:
+    A tuple of a list of Sources and the number of files left out.
+  """
+  sources = []
+  skipped = 0
+  for pattern in patterns:
+    for path in sorted(glob.glob(os.path.join(root, pattern))):
+      with open(path, "rb") as f:
+        source = Source(_module_name(root, path), path, f.read())
+      try:
+        parser.parse_string(source.text, name=source.name,
+                            filename=source.path)
+      except parser.ParseError:
+        skipped += 1
+      else:
+        sources.append(source)
+  return sources, skipped
+
+
+def default_corpora(typeshed_dir=None):
+  """Return a dict of the names of the default corpora to (root, patterns).
+
+  Args:
+    typeshed_dir: A typeshed checkout, or None to use the one that pytype
+      finds.  Typeshed is left out if the directory has no stubs.
+  """
+  corpora = collections.OrderedDict([
+      ("builtins", (os.path.join(_PYTD_DIR, "builtins"), ["*.pytd"])),
+      ("stdlib", (os.path.join(_PYTD_DIR, "stdlib"), ["*.pytd", "*/*.pytd"])),
+  ])
+  if typeshed_dir is None:
+    typeshed_dir = typeshed.Typeshed().typeshed_path
+  patterns = ["stdlib/*/*.pyi", "stdlib/*/*/*.pyi", "third_party/*/*.pyi",
+              "third_party/*/*/*.pyi"]
+  if any(glob.glob(os.path.join(typeshed_dir, p)) for p in patterns):
+    corpora["typeshed"] = (typeshed_dir, patterns)
+  return corpora
+
+
+def _peak_rss_kb():
+  return resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+
+
+def _time(function, sources, repeat):
+  """Return the best time of repeat runs of function over the sources."""
+  best = None
+  for _ in range(repeat):
+    start = time.time()
+    for source in sources:
+      function(source)
+    elapsed = time.time() - start
+    if best is None or elapsed < best:
+      best = elapsed
+  return best
+
+
+def run_corpus(sources, repeat=5, driver=None):
+  """Benchmark the stages on a list of Sources.
+
+  Args:
+    sources: The Sources.
+    repeat: The number of times to time each stage, the best time counts.
+    driver: The path of the parser_bench driver, or None.
+
+  Returns:
+    A dict of stage names to dicts of the "files", "bytes", "tokens",
+    "seconds", "peer_calls", "lexer_allocations" (the token value objects
+    that the lexers allocated rather than found interned),
+    "operator_new_calls" (which leave out flex's buffers, allocated with
+    malloc()) and "peak_rss_kb" (of the process, so far).  Only the Python
+    stages count lexer allocations and only the driver stages count calls to
+    operator new, the other count is None.  The driver stages are
+    "native_lex" and "native_parse_ir".
+  """
+  size = sum(len(source.text) for source in sources)
+  tokens = sum(_tokenize(source) for source in sources)
+  results = collections.OrderedDict()
+  for stage, function in _STAGES:
+    calls = collections.Counter()
+    parser_ext.set_lexer_stats(True)
+    parser_ext.lexer_stats(True)
+    try:
+      for source in sources:
+        if function:
+          function(source, calls)
+        else:
+          _tokenize(source)
+      allocations = parser_ext.lexer_stats(True)["allocations"]
+    finally:
+      parser_ext.set_lexer_stats(False)
+    seconds = _time(function or _tokenize, sources, repeat)
+    results[stage] = {
+        "files": len(sources), "bytes": size, "tokens": tokens,
+        "seconds": seconds, "peer_calls": sum(calls.values()),
+        "lexer_allocations": allocations, "operator_new_calls": None,
+        "peak_rss_kb": _peak_rss_kb(),
+    }
+  paths = [source.path for source in sources if source.path]
+  if driver and paths:
+    output = subprocess.check_output(
+        [driver, "--iterations=%d" % repeat] + paths)
+    for line in output.splitlines():
+      result = json.loads(line)
+      result["peer_calls"] = 0
+      result["lexer_allocations"] = None
+      results["native_" + result.pop("stage")] = result
+  return results
+
+
+def run(corpora, repeat=5, driver=None):
+  """Benchmark corpora, a dict as returned by default_corpora().
+
+  Returns:
+    The results, a dict with the "format" and the "corpora", which maps the
+    corpus names to the results of run_corpus() and the "skipped" files.
+  """
+  # Parses must not be looked up in a cache.
+  old_cache = parser.set_parse_cache(None)
+  try:
+    results = collections.OrderedDict()
+    for name, (root, patterns) in corpora.items():
+      sources, skipped = load_corpus(root, patterns)
+      results[name] = {"skipped": skipped,
+                       "stages": run_corpus(sources, repeat, driver)}
+  finally:
+    parser.set_parse_cache(old_cache)
+  return {"format": _FORMAT, "corpora": results}
+
+
+def rates(result):
+  """Return the MB/s, tokens/s and peer calls/s of the result of a stage."""
+  seconds = max(result["seconds"], 1e-9)
+  return (result["bytes"] / seconds / 1e6, result["tokens"] / seconds,
+          result["peer_calls"] / seconds)
+
+
+def compare(results, baseline, tolerance=0.1):
+  """Compare results with a baseline, both as returned by run().
+
+  Only the stages that are in both are compared.
+
+  Args:
+    results: The results.
+    baseline: The baseline results.
+    tolerance: The fraction by which a stage's MB/s may drop.
+
+  Returns:
+    A dict of (corpus, stage) to the ratio of the MB/s of the results to the
+    baseline's, and a list of the (corpus, stage)s whose ratio is below
+    1 - tolerance.
+
+  Raises:
+    ValueError: If the baseline is in another format.
+  """
+  if baseline.get("format") != results["format"]:
+    raise ValueError("The baseline is in another format")
+  ratios = {}
+  regressions = []
+  for corpus, corpus_results in results["corpora"].items():
+    base_stages = baseline["corpora"].get(corpus, {}).get("stages", {})
+    for stage, result in corpus_results["stages"].items():
+      if stage not in base_stages:
+        continue
+      base_rate = rates(base_stages[stage])[0]
+      ratio = rates(result)[0] / base_rate if base_rate else 1.0
+      ratios[(corpus, stage)] = ratio
+      if ratio < 1 - tolerance:
+        regressions.append((corpus, stage))
+  return ratios, regressions
+
+
+def _count(count):
+  return "-" if count is None else str(count)
+
+
+def _report(results, ratios):
+  print "%-9s %-16s %9s %12s %12s %12s %12s %10s" % (
+      "corpus", "stage", "MB/s", "tokens/s", "calls/s", "lexer allocs",
+      "new calls", "rss KB")
+  for corpus, corpus_results in results["corpora"].items():
+    for stage, result in corpus_results["stages"].items():
+      mb, tokens, calls = rates(result)
+      line = "%-9s %-16s %9.2f %12.0f %12.0f %12s %12s %10d" % (
+          corpus, stage, mb, tokens, calls,
+          _count(result["lexer_allocations"]),
+          _count(result["operator_new_calls"]), result["peak_rss_kb"])
+      if (corpus, stage) in ratios:
+        line += "  %+6.1f%%" % ((ratios[(corpus, stage)] - 1) * 100)
+      print line
+    if corpus_results["skipped"]:
+      print "%-9s (%d files that don't parse were skipped)" % (
+          corpus, corpus_results["skipped"])
+
+
+def main(argv):
+  o = optparse.OptionParser(usage="%prog [options]")
+  o.add_option("--repeat", type="int", default=5,
+               help="The number of times to time each stage.")
+  o.add_option("--corpus", action="append", default=None,
+               help="A corpus to run (builtins, stdlib or typeshed), can be "
+               "repeated.  Defaults to all of them.")
+  o.add_option("--typeshed", default=None,
+               help="A typeshed checkout, instead of pytype's.")
+  o.add_option("--driver", default=None,
+               help="The parser_bench driver, to also time the native lexer "
+               "and parser alone.")
+  o.add_option("--output", default=None,
+               help="A file to write the results to, as JSON.")
+  o.add_option("--baseline", default=None,
+               help="Results written by --output to compare with.")
+  o.add_option("--tolerance", type="float", default=0.1,
+               help="The fraction by which MB/s may drop from the baseline.")
+  options, args = o.parse_args(argv[1:])
+  if args:
+    o.error("Unexpected arguments: %s" % " ".join(args))
+  corpora = default_corpora(options.typeshed)
+  if options.corpus:
+    unknown = set(options.corpus) - set(corpora)
+    if unknown:
+      o.error("Unknown or missing corpora: %s" % ", ".join(sorted(unknown)))
+    corpora = collections.OrderedDict(
+        (name, value) for name, value in corpora.items()
+        if name in options.corpus)
+  results = run(corpora, options.repeat, options.driver)
+  if options.output:
+    with open(options.output, "w") as f:
+      json.dump(results, f, indent=2)
+  ratios, regressions = {}, []
+  if options.baseline:
+    with open(options.baseline) as f:
+      baseline = json.load(f)
+    ratios, regressions = compare(results, baseline, options.tolerance)
+  _report(results, ratios)
+  for corpus, stage in regressions:
+    print "Regression: %s %s is %.1f%% slower than the baseline" % (
+        corpus, stage, (1 - ratios[(corpus, stage)]) * 100)
+  return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+  sys.exit(main(sys.argv))
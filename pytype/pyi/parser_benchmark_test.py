@@ -0,0 +1,60 @@
+import copy
+
+from pytype import utils
+from pytype.pyi import parser_benchmark
+from pytype.pyi import parser_ext
+
+import unittest
+
+
+class ParserBenchmarkTest(unittest.TestCase):
+
+  SOURCES = ["x = ...  # type: int\n", "def f(x: int) -> List[int]: ...\n"]
+
+  def run_benchmark(self):
+    with utils.Tempdir() as d:
+      d.create_file("foo.pyi", self.SOURCES[0])
+      d.create_file("bar.pyi", self.SOURCES[1])
+      d.create_file("baz.pyi", "this is not valid")
+      corpora = {"test": (d.path, ["*.pyi"])}
+      return parser_benchmark.run(corpora, repeat=1)
+
+  def test_run(self):
+    results = self.run_benchmark()
+    corpus = results["corpora"]["test"]
+    self.assertEquals(1, corpus["skipped"])
+    stages = corpus["stages"]
+    self.assertEquals(["tokenize", "parse", "parse_string"], list(stages))
+    tokens = sum(len(parser_ext.tokenize(src)) for src in self.SOURCES)
+    for result in stages.values():
+      self.assertEquals(2, result["files"])
+      self.assertEquals(sum(len(src) for src in self.SOURCES),
+                        result["bytes"])
+      self.assertEquals(tokens, result["tokens"])
+      self.assertGreater(result["peak_rss_kb"], 0)
+      self.assertGreaterEqual(result["lexer_allocations"], 0)
+      self.assertIsNone(result["operator_new_calls"])
+    self.assertEquals(0, stages["tokenize"]["peer_calls"])
+    # new_type() and new_constant(), then new_type() for int and List[int]
+    # and new_function().
+    self.assertEquals(5, stages["parse"]["peer_calls"])
+    self.assertEquals(5, stages["parse_string"]["peer_calls"])
+
+  def test_compare(self):
+    results = self.run_benchmark()
+    baseline = copy.deepcopy(results)
+    stages = baseline["corpora"]["test"]["stages"]
+    stages["parse"]["seconds"] = results["corpora"]["test"]["stages"][
+        "parse"]["seconds"] / 2
+    del stages["tokenize"]
+    ratios, regressions = parser_benchmark.compare(results, baseline)
+    self.assertEquals({("test", "parse"), ("test", "parse_string")},
+                      set(ratios))
+    self.assertAlmostEqual(0.5, ratios[("test", "parse")])
+    self.assertEquals([("test", "parse")], regressions)
+    baseline["format"] = None
+    self.assertRaises(ValueError, parser_benchmark.compare, results, baseline)
+
+
+if __name__ == "__main__":
+  unittest.main()
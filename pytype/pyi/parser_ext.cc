@@ -1,12 +1,32 @@
+// Use Py_ssize_t for "s#" lengths.
+#define PY_SSIZE_T_CLEAN
 #include <Python.h>
 
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "batch_parser.h"
+#include "fastscan.h"
+#include "header_scan.h"
+#include "input_stream.h"
 #include "lexer.h"
+#include "mapped_file.h"
 #include "parser.h"
 
 namespace pytype {
 
-// From parser.tab.cc.
-int pytypeparse(void* scanner, pytype::Context* ctx);
+// From parser.tab.cc, and the parser with the "error" rules from
+// recovering_parser.tab.cc, see parser.y.
+int pytypeparse(Lexer* lexer, Context* ctx);
+int pytyperecoverparse(Lexer* lexer, Context* ctx);
 
 // A pair of enum value and attribute name, parameterized by enum type.
 template <typename T> class SelectorEntry {
@@ -44,6 +64,32 @@ static const SelectorEntry<CallSelector> call_attributes[] = {
   {kIfEnd, "if_end"},
 };
 
+// The number of arguments of each peer method, indexed by CallSelector, and
+// the largest of them.
+static const int kMaxCallArity = 6;
+static const int call_arity[] = {
+  1,  // kSetErrorLocation
+  2,  // kNewType
+  1,  // kNewUnionType
+  2,  // kAddImport
+  2,  // kAddAliasOrConstant
+  2,  // kNewConstant
+  6,  // kNewFunction
+  2,  // kNewExternalFunction
+  2,  // kNewNamedTuple
+  1,  // kRegisterClassName
+  3,  // kAddClass
+  2,  // kAddTypeVar
+
+  1,  // kIfBegin
+  1,  // kIfElif
+  0,  // kIfElse
+  1,  // kIfEnd
+};
+
+static_assert(sizeof(call_arity) / sizeof(call_arity[0]) == kCallSelectorCount,
+              "call_arity must have an entry for every CallSelector");
+
 // Initialize a selector's dispatch table.
 //
 // refs: Array of RefHolders to be filled in (should contain NULLs on entry).
@@ -92,200 +138,2928 @@ template <typename T> bool InitSelectorTable(
   return true;
 }
 
+// Return a new reference to the result of calling the peer's method with
+// no arguments, None if the peer has no such method, or NULL if there was
+// an error.
+static PyObject* CallOptionalMethod(PyObject* peer, const char* name) {
+  PyObject* method = PyObject_GetAttrString(peer, name);
+  if (method == NULL) {
+    if (!PyErr_ExceptionMatches(PyExc_AttributeError)) {
+      return NULL;
+    }
+    PyErr_Clear();
+    Py_RETURN_NONE;
+  }
+  PyObject* result = PyObject_CallObject(method, NULL);
+  Py_DECREF(method);
+  return result;
+}
+
+// Return a new reference to a tuple of the fields of location, or NULL if
+// there was an error.
+static PyObject* LocationTuple(const IrLocation& location) {
+  const int* fields = &location.first_line;
+  const int field_count = sizeof(location) / sizeof(*fields);
+  PyObject* tuple = PyTuple_New(field_count);
+  for (int i = 0; tuple != NULL && i < field_count; i++) {
+    PyObject* field = PyInt_FromLong(fields[i]);
+    if (field == NULL) {
+      Py_CLEAR(tuple);
+    } else {
+      PyTuple_SET_ITEM(tuple, i, field);
+    }
+  }
+  return tuple;
+}
+
+// Return a new reference to the message of an exception: its argument if it
+// has exactly one, else its string, or NULL if there was an error.
+static PyObject* ExceptionMessage(PyObject* exception) {
+  PyObject* args = PyObject_GetAttrString(exception, "args");
+  if (args != NULL && PyTuple_Check(args) && PyTuple_GET_SIZE(args) == 1) {
+    PyObject* message = PyTuple_GET_ITEM(args, 0);
+    Py_INCREF(message);
+    Py_DECREF(args);
+    return message;
+  }
+  Py_XDECREF(args);
+  PyErr_Clear();
+  return PyObject_Str(exception);
+}
+
 bool Context::Init(PyObject* peer) {
+  if (initialized_ || !InitTables(peer) || !InitNative(peer)) {
+    return false;
+  }
+  initialized_ = true;
+  return true;
+}
+
+bool Context::InitClass(PyObject* peer_class) {
   if (initialized_) {
     return false;
   }
+  if (!PyType_Check(peer_class)) {
+    PyErr_SetString(PyExc_TypeError, "peer_class must be a new-style class");
+    return false;
+  }
+  if (!InitTables(peer_class)) {
+    return false;
+  }
+  for (const auto& entry : call_attributes) {
+    PyObject* name = PyString_InternFromString(entry.attribute_name);
+    if (name == NULL) {
+      return false;
+    }
+    methods_[entry.selector].name = name;
+    Py_DECREF(name);
+  }
+  peer_class_ = peer_class;
+  initialized_ = true;
+  return true;
+}
+
+bool Context::Bind(PyObject* peer) {
+  if (peer_class_ == NULL) {
+    PyErr_SetString(PyExc_SystemError, "Context wasn't initialized by class.");
+    return false;
+  }
+  if (reinterpret_cast<PyObject*>(Py_TYPE(peer)) != peer_class_) {
+    PyErr_Format(PyExc_TypeError, "peer must be a %s, not %s",
+                 reinterpret_cast<PyTypeObject*>(
+                     static_cast<PyObject*>(peer_class_))->tp_name,
+                 Py_TYPE(peer)->tp_name);
+    return false;
+  }
+  if (collect_stats_ != (stats_ != NULL)) {
+    stats_.reset(collect_stats_ ? new ParseStats : NULL);
+  }
+  // Methods set in the instance dict override the class's, as they do for
+  // attribute lookups.
+  PyObject** dict_ptr = _PyObject_GetDictPtr(peer);
+  PyObject* dict = dict_ptr != NULL ? *dict_ptr : NULL;
+  for (Method& method : methods_) {
+    PyObject* callable =
+        dict != NULL ? PyDict_GetItem(dict, method.name) : NULL;
+    if (callable != NULL) {
+      if (!PyCallable_Check(callable)) {
+        PyErr_Format(PyExc_TypeError, "peer's %s is not callable",
+                     PyString_AS_STRING(static_cast<PyObject*>(method.name)));
+        return false;
+      }
+      SetMethod(&method, callable);
+      method.overridden = true;
+    } else if (method.bind_peer) {
+      method.self = peer;
+    }
+  }
+  return InitNative(peer);
+}
+
+void Context::Reset() {
+  MergeStats();
+  for (int i = 0; i < kCallSelectorCount; i++) {
+    Method& method = methods_[i];
+    if (method.overridden) {
+      SetMethod(&method, callables_[i]);
+      method.overridden = false;
+    }
+    if (method.bind_peer) {
+      method.self = NULL;
+    }
+  }
+  result_ = Py_None;
+  errors_ = NULL;
+  nodes_.Reset();
+  conditions_.Reset();
+  types_.Reset();
+  lex_error_ = -1;
+  names_.clear();
+  skip_state_ = kNotSkipping;
+  skip_depth_ = 0;
+  resyncing_ = false;
+  resync_depth_ = 0;
+  last_kind_ = -1;
+  last_starts_line_ = false;
+  last_line_ = 0;
+  bracket_depth_ = 0;
+  // Lists left over from a failed parse have had their items released by
+  // the parser's destructors.
+  free_lists_.clear();
+  for (HandleList& list : lists_) {
+    list.items.clear();
+    list.spreads.clear();
+    free_lists_.push_back(&list);
+  }
+}
+
+bool Context::InitTables(PyObject* owner) {
   if (!InitSelectorTable(
       values_, kValueSelectorCount,
       value_attributes, sizeof(value_attributes) / sizeof(value_attributes[0]),
-      peer, false, "ValueSelector")) {
+      owner, false, "ValueSelector")) {
     return false;
   }
 
   if (!InitSelectorTable(
       callables_, kCallSelectorCount,
       call_attributes, sizeof(call_attributes) / sizeof(call_attributes[0]),
-      peer, true, "CallSelector")) {
+      owner, true, "CallSelector")) {
     return false;
   }
 
-  initialized_ = true;
+  for (int i = 0; i < kCallSelectorCount; i++) {
+    SetMethod(&methods_[i], callables_[i]);
+  }
   return true;
 }
 
-PyObject* Context::Value(ValueSelector selector) const {
-  if (!initialized_ || selector < 0 || selector >= kValueSelectorCount) {
-    return NULL;
+void Context::SetMethod(Method* method, PyObject* callable) {
+  // Looked up on a class, methods are unbound, and Bind() supplies their
+  // self.
+  if (PyMethod_Check(callable)) {
+    method->function = PyMethod_GET_FUNCTION(callable);
+    method->self = PyMethod_GET_SELF(callable);
+    method->bind_peer = method->self == NULL;
+  } else {
+    method->function = callable;
+    method->self = NULL;
+    method->bind_peer = false;
   }
+}
 
-  PyObject* obj = values_[selector];
-  Py_INCREF(obj);
-  return obj;
+bool Context::InitNative(PyObject* peer) {
+  // Native construction of nodes and evaluation of conditions are
+  // optional, a peer that doesn't support them lacks the methods.
+  PyObject* info = CallOptionalMethod(peer, "native_nodes");
+  bool ok = info != NULL && nodes_.Init(info, values_[kEllipsis]);
+  Py_XDECREF(info);
+  if (!ok) {
+    return false;
+  }
+  info = CallOptionalMethod(peer, "native_conditions");
+  ok = info != NULL && conditions_.Init(info);
+  Py_XDECREF(info);
+  if (!ok) {
+    return false;
+  }
+  info = CallOptionalMethod(peer, "memoize_types");
+  ok = info != NULL && types_.Init(info);
+  Py_XDECREF(info);
+  return ok;
 }
 
-PyObject* Context::Call(CallSelector selector, const char* fmt, ...) const {
-  if (!initialized_ || selector < 0 || selector >= kCallSelectorCount) {
-    return NULL;
+bool Context::EnableRecovery(PyObject* errors) {
+  if (!PyList_Check(errors)) {
+    PyErr_SetString(PyExc_TypeError, "errors must be a list");
+    return false;
+  }
+  // The result if the parser gives up, see RunParser().
+  PyObject* empty = PyList_New(0);
+  if (empty == NULL) {
+    return false;
+  }
+  result_ = empty;
+  Py_DECREF(empty);
+  errors_ = errors;
+  conditions_.Disable();
+  return true;
+}
+
+void ParseStats::Reset() {
+  reductions.clear();
+  std::fill(calls, calls + kCallSelectorCount, 0);
+  std::fill(call_seconds, call_seconds + kCallSelectorCount, 0.0);
+}
+
+void ParseStats::Merge(const ParseStats& other) {
+  for (const auto& entry : other.reductions) {
+    reductions[entry.first] += entry.second;
+  }
+  for (int i = 0; i < kCallSelectorCount; i++) {
+    calls[i] += other.calls[i];
+    call_seconds[i] += other.call_seconds[i];
+  }
+}
+
+std::atomic<bool> Context::collect_stats_(false);
+ParseStats Context::total_stats_;
+std::mutex Context::total_stats_mutex_;
+
+void Context::TotalStats(ParseStats* stats, bool reset) {
+  std::lock_guard<std::mutex> lock(total_stats_mutex_);
+  *stats = total_stats_;
+  if (reset) {
+    total_stats_.Reset();
+  }
+}
+
+void Context::MergeStats() {
+  if (stats_) {
+    std::lock_guard<std::mutex> lock(total_stats_mutex_);
+    total_stats_.Merge(*stats_);
+    stats_->Reset();
   }
+}
 
-  // Build args.
-  va_list va;
-  va_start(va, fmt);
-  PyObject* args = Py_VaBuildValue(fmt, va);
-  va_end(va);
-  if (!args) {
+PyObject* Context::Call(CallSelector selector, int count, PyObject** args) {
+  bool valid = initialized_ && selector >= 0 && selector < kCallSelectorCount;
+  for (int i = 0; i < count; i++) {
+    valid = valid && args[i] != NULL;
+  }
+  if (!valid) {
+    for (int i = 0; i < count; i++) {
+      Py_XDECREF(args[i]);
+    }
+    if (!PyErr_Occurred()) {
+      PyErr_SetString(PyExc_SystemError, "Invalid call of the parser peer.");
+    }
     return NULL;
   }
 
-  // Call and return result.
-  PyObject* result = PyObject_CallObject(callables_[selector], args);
-  Py_DECREF(args);
+  // Fill in the argument tuple, reusing the one from the last call if
+  // possible.  The method doesn't hold the tuple during the call, so that a
+  // nested call can't reuse it.
+  Method& method = methods_[selector];
+  int offset = method.self != NULL;
+  PyObject* tuple = method.args;
+  if (tuple != NULL && PyTuple_GET_SIZE(tuple) == offset + count) {
+    Py_INCREF(tuple);
+    method.args = NULL;
+  } else {
+    tuple = PyTuple_New(offset + count);
+    if (tuple == NULL) {
+      for (int i = 0; i < count; i++) {
+        Py_DECREF(args[i]);
+      }
+      return NULL;
+    }
+    PyObject_GC_UnTrack(tuple);
+  }
+  if (offset) {
+    PyObject* self = method.self;
+    Py_INCREF(self);
+    PyTuple_SET_ITEM(tuple, 0, self);
+  }
+  for (int i = 0; i < count; i++) {
+    PyTuple_SET_ITEM(tuple, offset + i, args[i]);
+  }
+
+  PyObject* result;
+  if (stats_) {
+    auto start = std::chrono::steady_clock::now();
+    result = PyObject_Call(method.function, tuple, NULL);
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    stats_->calls[selector]++;
+    stats_->call_seconds[selector] += elapsed.count();
+  } else {
+    result = PyObject_Call(method.function, tuple, NULL);
+  }
+
+  if (Py_REFCNT(tuple) == 1) {
+    for (int i = 0; i < offset + count; i++) {
+      PyObject* item = PyTuple_GET_ITEM(tuple, i);
+      PyTuple_SET_ITEM(tuple, i, NULL);
+      Py_DECREF(item);
+    }
+    method.args = tuple;
+  } else {
+    // The function kept a reference, leave the tuple to it.
+    PyObject_GC_Track(tuple);
+  }
+  Py_DECREF(tuple);
   return result;
 }
 
-void Context::SetErrorLocation(YYLTYPE* location) const {
-  PyObject* result = Call(kSetErrorLocation, "((iiii))",
-                          location->first_line, location->first_column,
-                          location->last_line, location->last_column);
-  Py_XDECREF(result);
+// A Handle is a PyObject* when building objects, and an IR value id when
+// emitting IR.
+static PyObject* AsObject(Handle value) {
+  return reinterpret_cast<PyObject*>(value);
 }
 
-}  // end namespace pytype
+static Handle FromObject(PyObject* object) {
+  return reinterpret_cast<Handle>(object);
+}
 
+static int AsId(Handle value) {
+  return static_cast<int>(reinterpret_cast<intptr_t>(value));
+}
 
-static PyObject* parse(PyObject* self, PyObject* args) {
-  const char* bytes;
-  Py_ssize_t length;
-  PyObject* peer;
-  pytype::Context ctx;
+static Handle FromId(int id) {
+  return reinterpret_cast<Handle>(static_cast<intptr_t>(id));
+}
 
-  if (!PyArg_ParseTuple(args, "Os#", &peer, &bytes, &length)) {
-    return NULL;
+// Return true if none of the first count items are NULL.  Otherwise release
+// them and set an error if there isn't one already.
+static bool CheckItems(int count, PyObject** items) {
+  bool valid = true;
+  for (int i = 0; i < count; i++) {
+    valid = valid && items[i] != NULL;
   }
+  if (!valid) {
+    for (int i = 0; i < count; i++) {
+      Py_XDECREF(items[i]);
+    }
+    if (!PyErr_Occurred()) {
+      PyErr_SetString(PyExc_SystemError, "Missing value in the parser.");
+    }
+  }
+  return valid;
+}
 
-  if (!ctx.Init(peer)) {
+// The following implement the IR ops on objects, consuming the references
+// to their arguments and returning a new reference, or NULL if there was an
+// error.
+
+// Return a tuple of count items.
+static PyObject* TupleObject(int count, PyObject** items) {
+  if (!CheckItems(count, items)) {
     return NULL;
   }
+  PyObject* result = PyTuple_New(count);
+  for (int i = 0; i < count; i++) {
+    if (result == NULL) {
+      Py_DECREF(items[i]);
+    } else {
+      PyTuple_SET_ITEM(result, i, items[i]);
+    }
+  }
+  return result;
+}
 
-  pytype::Lexer lexer(bytes, length);
-  int err = pytype::pytypeparse(lexer.scanner(), &ctx);
-  if (err) {
-    if (err != 1) {
-      // This wasn't a syntax error (which has already constructed an error
-      // message).  In theory the only other error code is #2 for memory
-      // exhaustion, but just in case there are other codes, build a generic
-      // error messsage.
-      PyErr_Format(PyExc_RuntimeError, "Parse error #%d.", err);
+// Return a tuple of the items of count sequences.
+static PyObject* ConcatObject(int count, PyObject** sequences) {
+  if (!CheckItems(count, sequences)) {
+    return NULL;
+  }
+  Py_ssize_t size = 0;
+  for (int i = 0; i < count; i++) {
+    PyObject* fast = PySequence_Fast(sequences[i], "Expected a sequence.");
+    Py_DECREF(sequences[i]);
+    sequences[i] = fast;
+    if (fast != NULL) {
+      size += PySequence_Fast_GET_SIZE(fast);
     }
+  }
+  if (!CheckItems(count, sequences)) {
     return NULL;
-  } else {
-    PyObject* result = ctx.GetResult();
+  }
+  PyObject* result = PyTuple_New(size);
+  Py_ssize_t index = 0;
+  for (int i = 0; i < count; i++) {
+    for (Py_ssize_t j = 0;
+         result != NULL && j < PySequence_Fast_GET_SIZE(sequences[i]); j++) {
+      PyObject* item = PySequence_Fast_GET_ITEM(sequences[i], j);
+      Py_INCREF(item);
+      PyTuple_SET_ITEM(result, index++, item);
+    }
+    Py_DECREF(sequences[i]);
+  }
+  return result;
+}
+
+static PyObject* BuildObject(IrOp op, int count, PyObject** items) {
+  return op == kIrConcat ? ConcatObject(count, items) :
+      TupleObject(count, items);
+}
+
+PyObject* Context::CallObjects(CallSelector selector, int count,
+                               PyObject** args) {
+  // Call() deals with missing arguments.
+  for (int i = 0; i < count; i++) {
+    if (args[i] == NULL) {
+      return Call(selector, count, args);
+    }
+  }
+  switch (selector) {
+    case kNewType:
+    case kNewUnionType:
+      return MemoizedTypeObject(selector, count, args);
+    case kNewConstant:
+      return NewConstantObject(args[0], args[1]);
+    case kNewFunction:
+      return NewFunctionObject(args);
+    case kIfBegin:
+    case kIfElif:
+    case kIfElse:
+    case kIfEnd:
+      return ConditionObject(selector, count, args);
+    case kAddImport:
+    case kAddAliasOrConstant:
+    case kRegisterClassName:
+      // These change the type map, which the memoized types depend on.
+      types_.Clear();
+      return Call(selector, count, args);
+    default:
+      return Call(selector, count, args);
+  }
+}
+
+PyObject* Context::MemoizedTypeObject(CallSelector selector, int count,
+                                      PyObject** args) {
+  PyObject* result = selector == kNewType ?
+      types_.LookupType(args[0], count == 2 ? args[1] : NULL) :
+      types_.LookupUnion(args[0], args[1]);
+  if (result != NULL) {
+    for (int i = 0; i < count; i++) {
+      Py_DECREF(args[i]);
+    }
     Py_INCREF(result);
     return result;
   }
+  // The key of the lookup refers to the arguments, which building the type
+  // consumes, so they are kept until the type is memoized.
+  RefHolder kept[] = {args[0], count == 2 ? args[1] : NULL};
+  result = selector == kNewType ?
+      NewTypeObject(args[0], count == 2 ? args[1] : NULL) :
+      NewUnionTypeObject(args[0], args[1]);
+  if (result != NULL) {
+    types_.Add(result);
+  }
+  return result;
 }
 
-static char parse_doc[] =
-    "parse(peer, text)\n\n"
-    "Parse text (a string) and return a pyi parse tree.  The peer is called\n"
-    "during parsing and must contain the methods and attributes described\n"
-    "in the selector tables defined in C++.";
+PyObject* Context::ConditionObject(CallSelector selector, int count,
+                                   PyObject** args) {
+  if (!conditions_.enabled()) {
+    return Call(selector, count, args);
+  }
+  PyObject* result;
+  switch (selector) {
+    case kIfBegin:
+    case kIfElif:
+      if (!(selector == kIfBegin ? conditions_.Begin(args[0], &result) :
+            conditions_.Elif(args[0], &result))) {
+        // The peer reports the error.
+        return Call(selector, count, args);
+      }
+      break;
+    case kIfElse:
+      result = conditions_.Else();
+      break;
+    default:
+      result = conditions_.End(args[0]);
+      break;
+  }
+  for (int i = 0; i < count; i++) {
+    Py_DECREF(args[i]);
+  }
+  // The clause that follows an inactive condition can't contribute to the
+  // result, so it is skipped rather than parsed.
+  if (result == Py_False) {
+    skip_state_ = kSkipPending;
+  }
+  return result;
+}
 
+PyObject* Context::NewTypeObject(PyObject* name, PyObject* parameters) {
+  PyObject* result;
+  if (nodes_.NewType(name, parameters, &result)) {
+    Py_DECREF(name);
+    Py_XDECREF(parameters);
+    return result;
+  }
+  if (parameters == NULL) {
+    Py_INCREF(Py_None);
+    parameters = Py_None;
+  }
+  return CallPeerObjects(kNewType, name, parameters);
+}
 
-static PyObject* tokenize(PyObject* self, PyObject* args) {
-  const char* bytes;
-  Py_ssize_t length;
+PyObject* Context::NewUnionTypeObject(PyObject* left, PyObject* right) {
+  PyObject* result;
+  if (nodes_.NewUnionType(left, right, &result)) {
+    Py_DECREF(left);
+    Py_DECREF(right);
+    return result;
+  }
+  PyObject* types = PyList_New(2);
+  if (types != NULL) {
+    PyList_SET_ITEM(types, 0, left);
+    PyList_SET_ITEM(types, 1, right);
+  } else {
+    Py_DECREF(left);
+    Py_DECREF(right);
+  }
+  return CallPeerObjects(kNewUnionType, types);
+}
 
-  if (!PyArg_ParseTuple(args, "s#", &bytes, &length))
-    return NULL;
+PyObject* Context::NewConstantObject(PyObject* name, PyObject* value) {
+  PyObject* result;
+  if (nodes_.NewConstant(name, value, &result)) {
+    Py_DECREF(name);
+    Py_DECREF(value);
+    return result;
+  }
+  return CallPeerObjects(kNewConstant, name, value);
+}
 
-  pytype::Lexer lexer(bytes, length);
-  PyObject* tokens = PyList_New(0);
-  while (1) {
-    YYSTYPE lval;
-    YYLTYPE lloc;
-    int t = pytypelex(&lval, &lloc, lexer.scanner());
-    if (!t) break;
-    PyObject* obj = lval.obj;
-    if (obj == NULL) {
-      Py_INCREF(Py_None);
-      obj = Py_None;
+// args are the decorators, name, params, return_type, raises and body.
+PyObject* Context::NewFunctionObject(PyObject** args) {
+  const int count = 6;
+  PyObject* result;
+  if (nodes_.NewFunction(args[0], args[1], args[2], args[3], args[4],
+                         args[5], &result)) {
+    for (int i = 0; i < count; i++) {
+      Py_DECREF(args[i]);
     }
+    return result;
+  }
+  return Call(kNewFunction, count, args);
+}
 
-    PyObject* token = Py_BuildValue(
-        "(iOiiii)", t, obj, lloc.first_line, lloc.first_column, lloc.last_line,
-        lloc.last_column);
-    PyList_Append(tokens, token);
-    Py_DECREF(token);
-    Py_DECREF(obj);
+void Context::SetErrorLocation(const IrLocation& location) {
+  PyObject* result = CallPeerObjects(kSetErrorLocation,
+                                     LocationTuple(location));
+  Py_XDECREF(result);
+}
+
+IrLocation Context::GetLocation(YYLTYPE* loc, Lexer* lexer) {
+  IrLocation location;
+  location.first_line = loc->first_line;
+  location.first_column = loc->first_column;
+  location.last_line = loc->last_line;
+  location.last_column = loc->last_column;
+  if (!lexer->GetLineSpan(loc->first_line, &location.line_start,
+                          &location.line_end)) {
+    location.line_start = location.line_end = -1;
+  }
+  return location;
+}
+
+int Context::NextToken(Lexer* lexer, YYSTYPE* lval, YYLTYPE* lloc) {
+  Token token;
+  lexer->Next(&token);
+  if (skip_state_ != kNotSkipping) {
+    SkipTokens(lexer, &token);
+  }
+  if (errors_ != NULL) {
+    if (resyncing_) {
+      Resync(lexer, &token);
+    }
+    NoteToken(token);
+  }
+  *lloc = token.location;
+  const char* text;
+  int length;
+  if (token.kind == NAME) {
+    // The string is only created once the name is complete, see Name().
+    lexer->GetValueText(token, &text, &length);
+    if (lexer->stable_text()) {
+      lval->name.text = text;
+      lval->name.length = length;
+    } else {
+      name_key_.assign(text, length);
+      lval->name = StoreName();
+    }
+    return token.kind;
+  }
+  if (ir_ == NULL) {
+    lval->obj = FromObject(lexer->MaterializeValue(token));
+    return token.kind;
+  }
+  std::string message;
+  if (lexer->GetValueText(token, &text, &length)) {
+    int op = token.value_kind == kIntValue ? kIrInt : kIrFloat;
+    lval->obj = FromId(ir_->Emit(op, ir_->AddString(text, length)));
+  } else if (lexer->GetErrorMessage(token, &message)) {
+    lex_error_ = ir_->AddString(message);
+    lval->obj = FromId(ir_->Emit(kIrString, lex_error_));
+  } else {
+    lval->obj = NULL;
+  }
+  return token.kind;
+}
+
+void Context::SkipTokens(Lexer* lexer, Token* token) {
+  if (skip_state_ == kSkipPending) {
+    // The ':' (unless it was already read) and INDENT of the clause are
+    // returned, anything else is a syntax error.
+    if (token->kind == INDENT) {
+      skip_state_ = kSkipping;
+      skip_depth_ = 0;
+    } else if (token->kind != ':') {
+      skip_state_ = kNotSkipping;
+    }
+    return;
   }
+  // Skip to the DEDENT that ends the clause, which is returned.  A LEXERROR
+  // or the end of the input ends skipping too, so that it is reported.
+  for (;; lexer->Next(token)) {
+    if (token->kind == INDENT) {
+      skip_depth_++;
+    } else if (token->kind == DEDENT) {
+      if (skip_depth_-- == 0) {
+        break;
+      }
+    } else if (token->kind == LEXERROR || token->kind == 0) {
+      break;
+    }
+  }
+  skip_state_ = kNotSkipping;
+}
 
-  return tokens;
+void Context::NoteToken(const Token& token) {
+  last_kind_ = token.kind;
+  last_location_ = token.location;
+  last_starts_line_ = StartsLine(token);
+  switch (token.kind) {
+    case '(':
+    case '[':
+      bracket_depth_++;
+      break;
+    case ')':
+    case ']':
+      // Like Lexer::CloseBracket().
+      if (bracket_depth_ > 0) {
+        bracket_depth_--;
+      }
+      break;
+    case INDENT:
+    case DEDENT:
+    case 0:
+      return;
+  }
+  last_line_ = token.location.last_line;
 }
 
-static char tokenize_doc[] = "Convert a string into a list of token tuples.";
+void Context::StartResync(bool lookahead) {
+  resyncing_ = true;
+  resync_depth_ = 0;
+  if (!lookahead) {
+    // Skip to the next statement, which may start with the next token.
+    return;
+  }
+  switch (last_kind_) {
+    case 0:
+    case DEDENT:
+      // The parser resumes with the token.
+      resyncing_ = false;
+      return;
+    case INDENT:
+      // The parser discards the token, skip its block.
+      resync_depth_ = 1;
+      return;
+    case NAME:
+    case DEF:
+    case CLASS:
+    case IMPORT:
+    case FROM:
+    case IF:
+    case RAISE:
+    case '@':
+      // A token that starts a statement is kept (if it is valid where the
+      // parser resumes).
+      resyncing_ = !last_starts_line_;
+      return;
+  }
+}
 
+void Context::Resync(Lexer* lexer, Token* token) {
+  for (;; NoteToken(*token), lexer->Next(token)) {
+    if (token->kind == INDENT) {
+      resync_depth_++;
+    } else if (token->kind == DEDENT) {
+      if (resync_depth_ == 0) {
+        break;
+      }
+      resync_depth_--;
+    } else if (token->kind == 0) {
+      break;
+    } else if (resync_depth_ == 0 && StartsLine(*token) &&
+               token->kind != ELIF && token->kind != ELSE) {
+      break;
+    }
+  }
+  resyncing_ = false;
+}
 
-static PyMethodDef methods[] = {
-  {"parse", (PyCFunction)parse, METH_VARARGS, parse_doc},
-  {"tokenize", (PyCFunction)tokenize, METH_VARARGS, tokenize_doc},
-  {NULL}
-};
+void Context::AddError(const IrLocation& location, PyObject* message) {
+  PyObject* tuple = message ? PyTuple_New(2) : NULL;
+  PyObject* location_tuple = tuple ? LocationTuple(location) : NULL;
+  if (location_tuple == NULL) {
+    Py_XDECREF(tuple);
+    Py_XDECREF(message);
+    return;
+  }
+  PyTuple_SET_ITEM(tuple, 0, location_tuple);
+  PyTuple_SET_ITEM(tuple, 1, message);
+  PyList_Append(errors_, tuple);
+  Py_DECREF(tuple);
+}
 
+bool Context::Recover() {
+  // An exception that wasn't recovered from is pending.
+  return errors_ != NULL && !PyErr_Occurred();
+}
 
-static void add_token(PyObject* dict, const char* name, int value) {
-  PyObject* pyval = PyInt_FromLong(value);
-  PyDict_SetItemString(dict, name, pyval);
-  Py_DECREF(pyval);
+void Context::DropCondition(Handle value) {
+  Drop(value);
+  if (Recover()) {
+    // The statement's action, which ends the condition scope, won't run.
+    Drop(IfEnd(Sequence(List())));
+  }
 }
 
-#define ADD_TOKEN(dict, name) add_token(dict, #name, name)
+void Context::DropCondition(HandleList* clauses) {
+  DropList(clauses);
+  if (Recover()) {
+    Drop(IfEnd(Sequence(List())));
+  }
+}
 
-// Create a TOKENS attribute that maps token names to integer values.
-static void add_tokens_dict(PyObject* module) {
-  PyObject* tokens = PyDict_New();
-  ADD_TOKEN(tokens, NAME);
-  ADD_TOKEN(tokens, NUMBER);
-  ADD_TOKEN(tokens, TRIPLEQUOTED);
-  ADD_TOKEN(tokens, TYPECOMMENT);
-  ADD_TOKEN(tokens, ARROW);
-  ADD_TOKEN(tokens, COLONEQUALS);
-  ADD_TOKEN(tokens, ELLIPSIS);
-  ADD_TOKEN(tokens, EQ);
-  ADD_TOKEN(tokens, NE);
-  ADD_TOKEN(tokens, LE);
-  ADD_TOKEN(tokens, GE);
-  ADD_TOKEN(tokens, INDENT);
-  ADD_TOKEN(tokens, DEDENT);
-  ADD_TOKEN(tokens, LEXERROR);
+bool Context::Check(Handle value, YYLTYPE* loc, Lexer* lexer) {
+  if (ir_) {
+    if (ir_->records_locations()) {
+      ir_->SetLocation(AsId(value), GetLocation(loc, lexer));
+    }
+    return true;
+  }
+  if (value == NULL) {
+    IrLocation location = GetLocation(loc, lexer);
+    if (errors_ != NULL && PyErr_ExceptionMatches(values_[kParseError])) {
+      PyObject* type;
+      PyObject* exception;
+      PyObject* traceback;
+      PyErr_Fetch(&type, &exception, &traceback);
+      PyErr_NormalizeException(&type, &exception, &traceback);
+      AddError(location, ExceptionMessage(exception));
+      Py_XDECREF(type);
+      Py_XDECREF(exception);
+      Py_XDECREF(traceback);
+      // The last token is the lookahead if it ends after loc.
+      StartResync(last_location_.last_line > loc->last_line ||
+                  (last_location_.last_line == loc->last_line &&
+                   last_location_.last_column > loc->last_column));
+    } else {
+      SetErrorLocation(location);
+    }
+    return false;
+  }
+  return true;
+}
 
-  // Reserved words.
-  ADD_TOKEN(tokens, CLASS);
-  ADD_TOKEN(tokens, DEF);
-  ADD_TOKEN(tokens, ELSE);
-  ADD_TOKEN(tokens, ELIF);
-  ADD_TOKEN(tokens, IF);
-  ADD_TOKEN(tokens, OR);
-  ADD_TOKEN(tokens, PASS);
-  ADD_TOKEN(tokens, IMPORT);
-  ADD_TOKEN(tokens, FROM);
-  ADD_TOKEN(tokens, AS);
-  ADD_TOKEN(tokens, RAISE);
-  ADD_TOKEN(tokens, PYTHONCODE);
-  ADD_TOKEN(tokens, NOTHING);
-  ADD_TOKEN(tokens, RAISES);
-  ADD_TOKEN(tokens, NAMEDTUPLE);
-  ADD_TOKEN(tokens, TYPEVAR);
+void Context::SyntaxError(YYLTYPE* loc, Lexer* lexer, const char* message) {
+  IrLocation location = GetLocation(loc, lexer);
+  if (ir_) {
+    ir_->EmitError(lex_error_ >= 0 ? lex_error_ :
+                   ir_->AddString(message, strlen(message)), location);
+    return;
+  }
+  if (errors_ != NULL) {
+    // The error is at the last token, thus it is the lookahead.
+    if (last_kind_ == LEXERROR && lexer->error_message_) {
+      Py_INCREF(lexer->error_message_);
+      AddError(location, lexer->error_message_);
+    } else {
+      AddError(location, PyString_FromString(message));
+    }
+    StartResync(true);
+    return;
+  }
+  SetErrorLocation(location);
+  if (lexer->error_message_) {
+    PyErr_SetObject(values_[kParseError], lexer->error_message_);
+  } else {
+    PyErr_SetString(values_[kParseError], message);
+  }
+}
 
-  // Add dict to module.
-  PyObject_SetAttrString(module, "TOKENS", tokens);
-  Py_DECREF(tokens);
+void Context::SetResult(Handle result) {
+  if (ir_) {
+    ir_->EmitStatement(kIrResult, AsId(result));
+  } else {
+    result_ = AsObject(result);
+    Py_XDECREF(AsObject(result));
+  }
 }
 
+Handle Context::Value(ValueSelector selector) {
+  if (ir_) {
+    return FromId(ir_->Emit(kIrValue, selector));
+  }
+  PyObject* value = values_[selector];
+  Py_INCREF(value);
+  return FromObject(value);
+}
 
-PyMODINIT_FUNC initparser_ext() {
-  // TODO(dbaum): Make this Python3 compatible.
-  PyObject* module = Py_InitModule("parser_ext", methods);
-  add_tokens_dict(module);
+Handle Context::None() {
+  if (ir_) {
+    return FromId(ir_->Emit(kIrNone));
+  }
+  Py_INCREF(Py_None);
+  return FromObject(Py_None);
+}
+
+Handle Context::String(const char* text) {
+  if (ir_) {
+    return FromId(ir_->Emit(kIrString, ir_->AddString(text, strlen(text))));
+  }
+  // Interned, so that the types named by strings are memoized (see
+  // TypeMemo).
+  return FromObject(PyString_InternFromString(text));
+}
+
+Handle Context::Dup(Handle value) {
+  if (ir_) {
+    return FromId(ir_->Emit(kIrDup, AsId(value)));
+  }
+  Py_XINCREF(AsObject(value));
+  return value;
+}
+
+void Context::Drop(Handle value) {
+  if (value == NULL) {
+    return;
+  }
+  if (ir_) {
+    ir_->EmitStatement(kIrDrop, AsId(value));
+  } else {
+    Py_DECREF(AsObject(value));
+  }
+}
+
+HandleList* Context::List() {
+  if (free_lists_.empty()) {
+    lists_.emplace_back();
+    return &lists_.back();
+  }
+  HandleList* list = free_lists_.back();
+  free_lists_.pop_back();
+  return list;
+}
+
+HandleList* Context::StartList(Handle item) {
+  return AppendList(List(), item);
+}
+
+HandleList* Context::AppendList(HandleList* list, Handle item) {
+  list->items.push_back(item);
+  return list;
+}
+
+HandleList* Context::ExtendList(HandleList* list, Handle items) {
+  list->spreads.push_back(list->items.size());
+  list->items.push_back(items);
+  return list;
+}
+
+Handle Context::Sequence(HandleList* list) {
+  std::vector<Handle>& items = list->items;
+  Handle result;
+  if (list->spreads.empty()) {
+    result = Build(kIrTuple, items.size(), items.data());
+  } else {
+    // Concatenate the runs of items that aren't spread, as tuples, with the
+    // spread items.
+    parts_.clear();
+    int start = 0;
+    for (int spread : list->spreads) {
+      if (spread > start) {
+        parts_.push_back(Build(kIrTuple, spread - start, &items[start]));
+      }
+      parts_.push_back(items[spread]);
+      start = spread + 1;
+    }
+    if (static_cast<int>(items.size()) > start) {
+      parts_.push_back(Build(kIrTuple, items.size() - start, &items[start]));
+    }
+    result = Build(kIrConcat, parts_.size(), parts_.data());
+  }
+  FreeList(list);
+  return result;
+}
+
+void Context::DropList(HandleList* list) {
+  if (list == NULL) {
+    return;
+  }
+  for (Handle item : list->items) {
+    Drop(item);
+  }
+  FreeList(list);
+}
+
+void Context::FreeList(HandleList* list) {
+  list->items.clear();
+  list->spreads.clear();
+  free_lists_.push_back(list);
+}
+
+Handle Context::Name(const NameSpan& name, Lexer* lexer) {
+  if (ir_) {
+    return FromId(ir_->Emit(kIrName, ir_->AddString(name.text, name.length)));
+  }
+  return FromObject(lexer->MaterializeName(name.text, name.length));
+}
+
+NameSpan Context::JoinDotted(const NameSpan& left, const NameSpan& right) {
+  // The character after a span is always readable: it is either in the
+  // input, or the terminating NUL of a string in names_.
+  const char* end = left.text + left.length;
+  if (*end == '.' && end + 1 == right.text) {
+    NameSpan joined = {left.text, left.length + 1 + right.length};
+    return joined;
+  }
+  // The names are quoted, or separated by whitespace or comments.
+  name_key_.assign(left.text, left.length);
+  name_key_.push_back('.');
+  name_key_.append(right.text, right.length);
+  return StoreName();
+}
+
+NameSpan Context::Prefix(const char* prefix, const NameSpan& name) {
+  name_key_.assign(prefix);
+  name_key_.append(name.text, name.length);
+  return StoreName();
+}
+
+NameSpan Context::StoreName() {
+  const std::string& stored = *names_.insert(name_key_).first;
+  NameSpan span = {stored.data(), static_cast<int>(stored.size())};
+  return span;
+}
+
+Handle Context::Build(IrOp op, int count, Handle* items) {
+  if (ir_) {
+    ids_.resize(count);
+    for (int i = 0; i < count; i++) {
+      ids_[i] = AsId(items[i]);
+    }
+    return FromId(ir_->EmitList(op, NULL, 0, ids_.data(), count));
+  }
+  objects_.resize(count);
+  for (int i = 0; i < count; i++) {
+    objects_[i] = AsObject(items[i]);
+  }
+  return FromObject(BuildObject(op, count, objects_.data()));
+}
+
+Handle Context::CallHandles(CallSelector selector, int count, Handle* args) {
+  if (ir_) {
+    int extra = selector;
+    int ids[kMaxCallArity];
+    for (int i = 0; i < count; i++) {
+      ids[i] = AsId(args[i]);
+    }
+    return FromId(ir_->EmitList(kIrCall, &extra, 1, ids, count));
+  }
+  PyObject* objects[kMaxCallArity];
+  for (int i = 0; i < count; i++) {
+    objects[i] = AsObject(args[i]);
+  }
+  return FromObject(CallObjects(selector, count, objects));
+}
+
+namespace {
+
+// The state of decoding IR: the position in its code and the values it has
+// produced.
+class IrDecoder {
+ public:
+  explicit IrDecoder(const IrReader& ir)
+      : ir_(ir), code_(ir.code()), pc_(0), values_(1), live_(1),
+        names_(ir.strings().size()) {}
+
+  ~IrDecoder() {
+    for (PyObject* value : values_) {
+      Py_XDECREF(value);
+    }
+    for (PyObject* name : names_) {
+      Py_XDECREF(name);
+    }
+  }
+
+  bool at_end() const { return pc_ == code_.size(); }
+
+  // The following return false if the code is invalid.
+
+  bool ReadWord(int* word) {
+    if (pc_ >= code_.size()) {
+      return false;
+    }
+    *word = code_[pc_++];
+    return true;
+  }
+
+  // Read a string operand.
+  bool ReadString(const char** text, int* length) {
+    int index;
+    if (!ReadWord(&index) || index < 0 ||
+        index >= static_cast<int>(ir_.strings().size())) {
+      return false;
+    }
+    *text = ir_.strings()[index].first;
+    *length = ir_.strings()[index].second;
+    return true;
+  }
+
+  // Read a string operand and return a new reference to it as an interned
+  // string (which may be NULL if there was an error).
+  bool ReadName(PyObject** name) {
+    int index;
+    if (!ReadWord(&index) || index < 0 ||
+        index >= static_cast<int>(names_.size())) {
+      return false;
+    }
+    PyObject*& cached = names_[index];
+    if (cached == NULL) {
+      cached = PyString_FromStringAndSize(ir_.strings()[index].first,
+                                          ir_.strings()[index].second);
+      if (cached != NULL) {
+        PyString_InternInPlace(&cached);
+      }
+    }
+    Py_XINCREF(cached);
+    *name = cached;
+    return true;
+  }
+
+  // Read a value operand, taking over the reference to it unless peek is
+  // true.  The value is NULL if the op that produced it failed.
+  bool ReadValue(PyObject** value, bool peek = false) {
+    int id;
+    if (!ReadWord(&id) || id <= 0 || id >= static_cast<int>(live_.size()) ||
+        !live_[id]) {
+      return false;
+    }
+    *value = values_[id];
+    if (!peek) {
+      values_[id] = NULL;
+      live_[id] = false;
+    }
+    return true;
+  }
+
+  // Read a count of at most max_count values, then the values.
+  bool ReadValues(int max_count, int* count, PyObject** values) {
+    if (!ReadWord(count) || *count < 0 || *count > max_count) {
+      return false;
+    }
+    return ReadValueArray(*count, values);
+  }
+
+  // Read a count of values, then the values.
+  bool ReadValues(std::vector<PyObject*>* values) {
+    int count;
+    // Each value takes a word.
+    if (!ReadWord(&count) || count < 0 ||
+        static_cast<size_t>(count) > code_.size() - pc_) {
+      return false;
+    }
+    values->resize(count);
+    return ReadValueArray(count, values->data());
+  }
+
+  // Read a location operand.
+  bool ReadLocation(IrLocation* location) {
+    int* fields = &location->first_line;
+    for (size_t i = 0; i < sizeof(*location) / sizeof(*fields); i++) {
+      if (!ReadWord(&fields[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Read count values.
+  bool ReadValueArray(int count, PyObject** values) {
+    for (int i = 0; i < count; i++) {
+      if (!ReadValue(&values[i])) {
+        for (int j = 0; j < i; j++) {
+          Py_XDECREF(values[j]);
+        }
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Define the next value, consuming the reference.  Returns its id.
+  int Define(PyObject* value) {
+    values_.push_back(value);
+    live_.push_back(true);
+    return values_.size() - 1;
+  }
+
+ private:
+  const IrReader& ir_;
+  const std::vector<int>& code_;
+  size_t pc_;
+  // The values by id, and whether they have been produced and not consumed
+  // yet.  Id 0 isn't used.
+  std::vector<PyObject*> values_;
+  std::vector<bool> live_;
+  // The interned strings for kIrName by string index, NULL until used.
+  std::vector<PyObject*> names_;
+};
+
+}  // end namespace
+
+// Whether count arguments are valid for a kIrCall of selector, see
+// Context::CallObjects().
+static bool ValidCall(int selector, int count) {
+  switch (selector) {
+    case kSetErrorLocation:
+      return false;
+    case kNewType:
+      return count == 1 || count == 2;
+    case kNewUnionType:
+      return count == 2;
+    default:
+      return selector > 0 && selector < kCallSelectorCount &&
+          count == call_arity[selector];
+  }
+}
+
+PyObject* Context::Decode(const IrReader& ir) {
+  // The IR contains the clauses of inactive conditions, which the peer's
+  // if_*() methods must know about so that it ignores them.
+  conditions_.Disable();
+  IrDecoder decoder(ir);
+  PyObject* args[kMaxCallArity];
+  std::vector<PyObject*> items;
+  PyObject* value = NULL;
+  const char* text;
+  int length;
+  int word;
+  int count;
+  IrLocation location;
+  std::string number_text;
+
+  while (!decoder.at_end()) {
+    int op = 0;
+    decoder.ReadWord(&op);
+    bool valid = true;
+    switch (op) {
+      case kIrNone:
+        Py_INCREF(Py_None);
+        value = Py_None;
+        break;
+      case kIrName:
+      case kIrString:
+        // Strings are interned like names, so that the types named by them
+        // are memoized (see TypeMemo).
+        valid = decoder.ReadName(&value);
+        break;
+      case kIrInt:
+      case kIrFloat:
+        valid = decoder.ReadString(&text, &length);
+        if (valid) {
+          number_text.assign(text, length);
+          value = op == kIrInt ?
+              PyInt_FromString(const_cast<char*>(number_text.c_str()), NULL,
+                               10) :
+              PyFloat_FromDouble(atof(number_text.c_str()));
+        }
+        break;
+      case kIrValue:
+        valid = decoder.ReadWord(&word) && word >= 0 &&
+            word < kValueSelectorCount;
+        if (valid) {
+          value = values_[word];
+          Py_INCREF(value);
+        }
+        break;
+      case kIrDup:
+        valid = decoder.ReadValue(&value, true);
+        if (valid) {
+          Py_XINCREF(value);
+        }
+        break;
+      case kIrTuple:
+      case kIrConcat:
+        valid = decoder.ReadValues(&items);
+        if (valid) {
+          value = BuildObject(static_cast<IrOp>(op), items.size(),
+                              items.data());
+        }
+        break;
+      case kIrCall:
+        valid = decoder.ReadWord(&word) &&
+            decoder.ReadValues(kMaxCallArity, &count, args);
+        if (valid && !ValidCall(word, count)) {
+          for (int i = 0; i < count; i++) {
+            Py_XDECREF(args[i]);
+          }
+          valid = false;
+        }
+        if (valid) {
+          value = CallObjects(static_cast<CallSelector>(word), count, args);
+        }
+        break;
+      case kIrDrop:
+      case kIrResult:
+        valid = decoder.ReadValue(&value);
+        if (!valid) {
+          break;
+        }
+        if (op == kIrResult) {
+          result_ = value;
+        }
+        Py_XDECREF(value);
+        continue;
+      case kIrError:
+        valid = decoder.ReadString(&text, &length) &&
+            decoder.ReadLocation(&location);
+        if (valid) {
+          SetErrorLocation(location);
+          value = PyString_FromStringAndSize(text, length);
+          if (value != NULL) {
+            PyErr_SetObject(values_[kParseError], value);
+            Py_DECREF(value);
+          }
+          return NULL;
+        }
+        break;
+      default:
+        valid = false;
+        break;
+    }
+    if (!valid) {
+      PyErr_SetString(PyExc_ValueError, "Invalid parse IR.");
+      return NULL;
+    }
+    // A failed op that the parser checked ends the parse, see Check().
+    // Without locations there's no record of the checked ops, so the first
+    // failure ends it, rather than calling the peer with the error pending.
+    int id = decoder.Define(value);
+    if (value == NULL) {
+      if (ir.GetLocation(id, &location)) {
+        SetErrorLocation(location);
+        return NULL;
+      }
+      if (!ir.has_locations() && PyErr_Occurred()) {
+        return NULL;
+      }
+    }
+  }
+  // The result is NULL if the op that produced it failed.
+  PyObject* result = result_;
+  Py_XINCREF(result);
+  return result;
+}
+
+int ParseToIr(Lexer* lexer, bool locations, std::string* data) {
+  IrWriter ir(locations);
+  Context ctx(&ir);
+  int err = pytypeparse(lexer, &ctx);
+  if (err <= 1) {
+    ir.Serialize(data);
+  }
+  return err;
+}
+
+}  // end namespace pytype
+
+
+// Run the parser over the lexer's input and return the result (a new
+// reference), or NULL if there was an error.
+static PyObject* RunParser(pytype::Lexer* lexer, pytype::Context* ctx) {
+  int err = ctx->recovering() ? pytype::pytyperecoverparse(lexer, ctx) :
+      pytype::pytypeparse(lexer, ctx);
+  if (err == 1 && ctx->recovering() && !PyErr_Occurred()) {
+    // Error recovery failed at the end of the input.  The errors have been
+    // recorded, and the result is an empty list.
+    err = 0;
+  }
+  if (err) {
+    if (err != 1) {
+      // This wasn't a syntax error (which has already constructed an error
+      // message).  In theory the only other error code is #2 for memory
+      // exhaustion, but just in case there are other codes, build a generic
+      // error messsage.
+      PyErr_Format(PyExc_RuntimeError, "Parse error #%d.", err);
+    }
+    return NULL;
+  } else {
+    PyObject* result = ctx->GetResult();
+    Py_INCREF(result);
+    return result;
+  }
+}
+
+
+// Run the parser over the lexer's input and return the result (a new
+// reference), or NULL if there was an error.  If pretokenize is true, the
+// entire input is tokenized with the GIL released before parsing.
+static PyObject* RunParser(pytype::Lexer* lexer, pytype::Context* ctx,
+                           bool pretokenize) {
+  if (pretokenize) {
+    Py_BEGIN_ALLOW_THREADS
+    lexer->Tokenize();
+    Py_END_ALLOW_THREADS
+  }
+  return RunParser(lexer, ctx);
+}
+
+
+static PyObject* parse(PyObject* self, PyObject* args, PyObject* kwargs) {
+  static const char* kwlist[] = {"peer", "text", "pretokenize", "errors",
+                                 NULL};
+  const char* bytes;
+  Py_ssize_t length;
+  PyObject* peer;
+  PyObject* pretokenize = Py_False;
+  PyObject* errors = Py_None;
+  pytype::Context ctx;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Os#|OO",
+                                   const_cast<char**>(kwlist),
+                                   &peer, &bytes, &length, &pretokenize,
+                                   &errors)) {
+    return NULL;
+  }
+  int do_pretokenize = PyObject_IsTrue(pretokenize);
+  if (do_pretokenize < 0) {
+    return NULL;
+  }
+
+  if (!ctx.Init(peer) ||
+      (errors != Py_None && !ctx.EnableRecovery(errors))) {
+    return NULL;
+  }
+
+  pytype::Lexer lexer(bytes, length);
+  return RunParser(&lexer, &ctx, do_pretokenize != 0);
+}
+
+static char parse_doc[] =
+    "parse(peer, text, pretokenize=False, errors=None)\n\n"
+    "Parse text (a string) and return a pyi parse tree.  The peer is called\n"
+    "during parsing and must contain the methods and attributes described\n"
+    "in the selector tables defined in C++.  If pretokenize is true, the\n"
+    "text is tokenized without holding the GIL before parsing starts.\n\n"
+    "If errors is a list, the parser recovers from syntax errors and from\n"
+    "the peer raising PARSE_ERROR: it appends a (location, message) tuple\n"
+    "for each to errors, where location is as passed to the peer's\n"
+    "set_error_location(), and skips to the next statement.  The tree then\n"
+    "holds the definitions that could be parsed.";
+
+
+static PyObject* parse_file(PyObject* self, PyObject* args,
+                            PyObject* kwargs) {
+  static const char* kwlist[] = {"peer", "path", "pretokenize", "errors",
+                                 NULL};
+  const char* path;
+  PyObject* peer;
+  PyObject* pretokenize = Py_False;
+  PyObject* errors = Py_None;
+  pytype::Context ctx;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Os|OO",
+                                   const_cast<char**>(kwlist),
+                                   &peer, &path, &pretokenize, &errors)) {
+    return NULL;
+  }
+  int do_pretokenize = PyObject_IsTrue(pretokenize);
+  if (do_pretokenize < 0) {
+    return NULL;
+  }
+
+  if (!ctx.Init(peer) ||
+      (errors != Py_None && !ctx.EnableRecovery(errors))) {
+    return NULL;
+  }
+
+  pytype::MappedFile file;
+  if (!file.Open(path)) {
+    return PyErr_SetFromErrnoWithFilename(PyExc_IOError, path);
+  }
+
+  pytype::Lexer lexer(file);
+  return RunParser(&lexer, &ctx, do_pretokenize != 0);
+}
+
+static char parse_file_doc[] =
+    "parse_file(peer, path, pretokenize=False, errors=None)\n\n"
+    "Parse the file at path and return a pyi parse tree.  This is equivalent\n"
+    "to parse(peer, open(path).read(), ...), except that the file is\n"
+    "memory-mapped and scanned in place instead of being copied into a\n"
+    "string.";
+
+
+static PyObject* parse_stream(PyObject* self, PyObject* args,
+                              PyObject* kwargs) {
+  static const char* kwlist[] = {"peer", "stream", "chunk_size", NULL};
+  PyObject* peer;
+  PyObject* stream;
+  int chunk_size = 65536;
+  pytype::Context ctx;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|i",
+                                   const_cast<char**>(kwlist),
+                                   &peer, &stream, &chunk_size)) {
+    return NULL;
+  }
+  if (chunk_size <= 0) {
+    PyErr_SetString(PyExc_ValueError, "chunk_size must be positive");
+    return NULL;
+  }
+
+  if (!ctx.Init(peer)) {
+    return NULL;
+  }
+
+  pytype::InputStream* input;
+  if (PyInt_Check(stream) || PyLong_Check(stream)) {
+    long fd = PyInt_AsLong(stream);
+    if (fd == -1 && PyErr_Occurred()) {
+      return NULL;
+    }
+    input = new pytype::FdInputStream(fd);
+  } else {
+    input = new pytype::PyFileInputStream(stream);
+  }
+
+  PyObject* result;
+  {
+    pytype::Lexer lexer(input, chunk_size);
+    result = RunParser(&lexer, &ctx);
+  }
+  // A read error ends the input early, thus it takes precedence over the
+  // result.
+  if (input->RaiseError()) {
+    Py_XDECREF(result);
+    result = NULL;
+  }
+  delete input;
+  return result;
+}
+
+static char parse_stream_doc[] =
+    "parse_stream(peer, stream, chunk_size=65536)\n\n"
+    "Parse the input read from stream and return a pyi parse tree.  The\n"
+    "stream is either a file descriptor or a file-like object whose read()\n"
+    "method returns str.  It is read chunk_size bytes at a time while\n"
+    "parsing, so the whole input is never held in memory.  The tree is\n"
+    "the same as parse() returns for the text, but errors don't report\n"
+    "their line's text.  Errors raised reading the stream are propagated.";
+
+
+static PyObject* parse_ir(PyObject* self, PyObject* args, PyObject* kwargs) {
+  static const char* kwlist[] = {"text", "locations", NULL};
+  const char* bytes;
+  Py_ssize_t length;
+  PyObject* locations = Py_True;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s#|O",
+                                   const_cast<char**>(kwlist),
+                                   &bytes, &length, &locations)) {
+    return NULL;
+  }
+  int record_locations = PyObject_IsTrue(locations);
+  if (record_locations < 0) {
+    return NULL;
+  }
+
+  std::string data;
+  int err;
+  {
+    pytype::Lexer lexer(bytes, length);
+    Py_BEGIN_ALLOW_THREADS
+    err = pytype::ParseToIr(&lexer, record_locations, &data);
+    Py_END_ALLOW_THREADS
+  }
+  if (err > 1) {
+    PyErr_Format(PyExc_RuntimeError, "Parse error #%d.", err);
+    return NULL;
+  }
+  return PyString_FromStringAndSize(data.data(), data.size());
+}
+
+static char parse_ir_doc[] =
+    "parse_ir(text, locations=True)\n\n"
+    "Parse text (a string) without holding the GIL, and return the parse as\n"
+    "IR (a string).  decode_ir() turns the IR into the same parse tree (or\n"
+    "error) as parse() would return for the text.  The IR is only valid for\n"
+    "this build of the extension on this machine.  If locations is false,\n"
+    "the IR is smaller, but only records the locations of syntax errors, so\n"
+    "an error raised by the peer when the IR is decoded has no location.";
+
+
+static PyObject* decode_ir(PyObject* self, PyObject* args) {
+  const char* bytes;
+  Py_ssize_t length;
+  PyObject* peer;
+  pytype::Context ctx;
+
+  if (!PyArg_ParseTuple(args, "Os#", &peer, &bytes, &length)) {
+    return NULL;
+  }
+
+  pytype::IrReader ir;
+  if (!ir.Read(bytes, length)) {
+    PyErr_SetString(PyExc_ValueError, "Invalid parse IR.");
+    return NULL;
+  }
+  if (!ctx.Init(peer)) {
+    return NULL;
+  }
+  return ctx.Decode(ir);
+}
+
+static char decode_ir_doc[] =
+    "decode_ir(peer, ir)\n\n"
+    "Return the pyi parse tree for IR returned by parse_ir(), calling the\n"
+    "peer like parse() does.  Raises ValueError if the IR is invalid.";
+
+
+// Convert a sequence of inputs for parse_ir_many() or scan_headers() to
+// *inputs.  Returns false if there was an error.
+static bool GetBatchInputs(PyObject* input_list,
+                           std::vector<pytype::BatchParser::Input>* inputs) {
+  PyObject* sequence = PySequence_Fast(input_list, "inputs must be a sequence");
+  if (sequence == NULL) {
+    return false;
+  }
+  Py_ssize_t count = PySequence_Fast_GET_SIZE(sequence);
+  inputs->resize(count);
+  for (Py_ssize_t i = 0; i < count; i++) {
+    pytype::BatchParser::Input& input = (*inputs)[i];
+    PyObject* item = PySequence_Fast_GET_ITEM(sequence, i);
+    input.is_path = PyTuple_Check(item);
+    if (input.is_path) {
+      if (PyTuple_GET_SIZE(item) != 1 ||
+          !PyString_Check(PyTuple_GET_ITEM(item, 0))) {
+        PyErr_SetString(PyExc_TypeError,
+                        "A path input must be a 1-tuple of a string");
+        Py_DECREF(sequence);
+        return false;
+      }
+      item = PyTuple_GET_ITEM(item, 0);
+    } else if (!PyString_Check(item)) {
+      PyErr_SetString(PyExc_TypeError,
+                      "An input must be a string or a 1-tuple of a string");
+      Py_DECREF(sequence);
+      return false;
+    }
+    input.text.assign(PyString_AS_STRING(item), PyString_GET_SIZE(item));
+  }
+  Py_DECREF(sequence);
+  return true;
+}
+
+static PyObject* parse_ir_many(PyObject* self, PyObject* args,
+                               PyObject* kwargs) {
+  static const char* kwlist[] = {"inputs", "callback", "threads",
+                                 "locations", NULL};
+  PyObject* input_list;
+  PyObject* callback;
+  int threads = 0;
+  PyObject* locations = Py_True;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|iO",
+                                   const_cast<char**>(kwlist),
+                                   &input_list, &callback, &threads,
+                                   &locations)) {
+    return NULL;
+  }
+  int record_locations = PyObject_IsTrue(locations);
+  if (record_locations < 0) {
+    return NULL;
+  }
+  std::vector<pytype::BatchParser::Input> inputs;
+  if (!GetBatchInputs(input_list, &inputs)) {
+    return NULL;
+  }
+  if (threads <= 0) {
+    threads = std::thread::hardware_concurrency();
+  }
+
+  // Workers take the GIL to merge lexer stats, which requires threads to
+  // have been initialized.
+  PyEval_InitThreads();
+  pytype::BatchParser* batch;
+  Py_BEGIN_ALLOW_THREADS
+  batch = new pytype::BatchParser(&inputs, threads, record_locations);
+  Py_END_ALLOW_THREADS
+
+  bool ok = true;
+  for (size_t i = 0; ok && i < batch->size(); i++) {
+    pytype::BatchParser::Result result;
+    Py_BEGIN_ALLOW_THREADS
+    batch->Take(i, &result);
+    Py_END_ALLOW_THREADS
+
+    PyObject* ir = NULL;
+    PyObject* error = NULL;
+    if (result.error_number) {
+      errno = result.error_number;
+      PyErr_SetFromErrnoWithFilename(PyExc_IOError,
+                                     batch->input(i).text.c_str());
+    } else if (result.status > 1) {
+      PyErr_Format(PyExc_RuntimeError, "Parse error #%d.", result.status);
+    } else {
+      ir = PyString_FromStringAndSize(result.ir.data(), result.ir.size());
+      if (ir == NULL) {
+        ok = false;
+        break;
+      }
+    }
+    if (ir == NULL) {
+      // Pass the error to the callback rather than raising it.
+      PyObject* type;
+      PyObject* traceback;
+      PyErr_Fetch(&type, &error, &traceback);
+      PyErr_NormalizeException(&type, &error, &traceback);
+      Py_XDECREF(type);
+      Py_XDECREF(traceback);
+    }
+    PyObject* callback_result = PyObject_CallFunction(
+        callback, const_cast<char*>("nOO"), static_cast<Py_ssize_t>(i),
+        ir ? ir : Py_None, error ? error : Py_None);
+    Py_XDECREF(ir);
+    Py_XDECREF(error);
+    ok = callback_result != NULL;
+    Py_XDECREF(callback_result);
+  }
+
+  // Workers may still be running if the callback raised.
+  Py_BEGIN_ALLOW_THREADS
+  delete batch;
+  Py_END_ALLOW_THREADS
+  if (!ok) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+static char parse_ir_many_doc[] =
+    "parse_ir_many(inputs, callback, threads=0, locations=True)\n\n"
+    "Parse many inputs into IR (see parse_ir()) on a pool of threads that\n"
+    "don't hold the GIL.  Each input is either source text (a string) or a\n"
+    "1-tuple of the path of a file to read it from.  For each input, in\n"
+    "order, callback(index, ir, error) is called on the calling thread as\n"
+    "soon as the input has been parsed: ir is the IR, or None, in which case\n"
+    "error is the exception (e.g. an IOError for an unreadable file), else\n"
+    "None.  Thus decoding the IR in the callback overlaps with parsing the\n"
+    "inputs that follow.  threads is the number of threads, or 0 for the\n"
+    "number of CPUs.  locations is as for parse_ir().  If the callback\n"
+    "raises an exception, no further inputs are parsed and the exception is\n"
+    "propagated.";
+
+
+// Return a new reference to a tuple of strings, or NULL if there was an
+// error.
+static PyObject* StringTuple(const std::vector<std::string>& strings) {
+  PyObject* tuple = PyTuple_New(strings.size());
+  for (size_t i = 0; tuple != NULL && i < strings.size(); i++) {
+    PyObject* item = PyString_FromStringAndSize(strings[i].data(),
+                                                strings[i].size());
+    if (item == NULL) {
+      Py_CLEAR(tuple);
+    } else {
+      PyTuple_SET_ITEM(tuple, i, item);
+    }
+  }
+  return tuple;
+}
+
+static PyObject* scan_headers(PyObject* self, PyObject* args,
+                              PyObject* kwargs) {
+  static const char* kwlist[] = {"inputs", "version", "platform", "threads",
+                                 NULL};
+  PyObject* input_list;
+  pytype::ScanConditions conditions;
+  const char* platform;
+  Py_ssize_t platform_length;
+  int threads = 0;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O(lll)s#|i",
+                                   const_cast<char**>(kwlist),
+                                   &input_list, &conditions.version[0],
+                                   &conditions.version[1],
+                                   &conditions.version[2], &platform,
+                                   &platform_length, &threads)) {
+    return NULL;
+  }
+  conditions.platform.assign(platform, platform_length);
+  std::vector<pytype::BatchParser::Input> inputs;
+  if (!GetBatchInputs(input_list, &inputs)) {
+    return NULL;
+  }
+  if (threads <= 0) {
+    threads = std::thread::hardware_concurrency();
+  }
+
+  // Threads take the GIL to merge lexer stats, see parse_ir_many().
+  PyEval_InitThreads();
+  std::vector<pytype::HeaderScan> scans;
+  Py_BEGIN_ALLOW_THREADS
+  pytype::ScanHeaders(inputs, conditions, threads, &scans);
+  Py_END_ALLOW_THREADS
+
+  PyObject* results = PyList_New(scans.size());
+  for (size_t i = 0; results != NULL && i < scans.size(); i++) {
+    const pytype::HeaderScan& scan = scans[i];
+    PyObject* result;
+    if (scan.error_number) {
+      errno = scan.error_number;
+      PyErr_SetFromErrnoWithFilename(PyExc_IOError, inputs[i].text.c_str());
+      // Return the error rather than raising it.
+      PyObject* type;
+      PyObject* traceback;
+      PyErr_Fetch(&type, &result, &traceback);
+      PyErr_NormalizeException(&type, &result, &traceback);
+      Py_XDECREF(type);
+      Py_XDECREF(traceback);
+    } else {
+      PyObject* dependencies = StringTuple(scan.dependencies);
+      PyObject* names = dependencies ? StringTuple(scan.names) : NULL;
+      result = names ? PyTuple_Pack(2, dependencies, names) : NULL;
+      Py_XDECREF(dependencies);
+      Py_XDECREF(names);
+    }
+    if (result == NULL) {
+      Py_CLEAR(results);
+    } else {
+      PyList_SET_ITEM(results, i, result);
+    }
+  }
+  return results;
+}
+
+static char scan_headers_doc[] =
+    "scan_headers(inputs, version, platform, threads=0)\n\n"
+    "Scan many inputs for the modules they depend on and the names they\n"
+    "define at the top level, without parsing them, on a pool of threads\n"
+    "that don't hold the GIL.  Inputs are as for parse_ir_many().\n"
+    "Conditions are evaluated for version (a tuple of three ints) and\n"
+    "platform, like the peer's native_conditions().  Returns a list with an\n"
+    "item for each input: a (dependencies, names) tuple of tuples of\n"
+    "strings, or the IOError for an unreadable file.  threads is the number\n"
+    "of threads, or 0 for the number of CPUs.";
+
+
+// Return a new reference to array.array, or NULL if there was an error.
+static PyObject* GetArrayClass() {
+  PyObject* array_module = PyImport_ImportModule("array");
+  if (array_module == NULL) {
+    return NULL;
+  }
+  PyObject* array_class = PyObject_GetAttrString(array_module, "array");
+  Py_DECREF(array_module);
+  return array_class;
+}
+
+// Return a new array.array of C ints holding a copy of values.
+static PyObject* NewIntArray(PyObject* array_class,
+                             const std::vector<int>& values) {
+  // Note that "s#" converts a NULL pointer to None, hence the empty string.
+  const char* data = values.empty() ?
+      "" : reinterpret_cast<const char*>(values.data());
+  return PyObject_CallFunction(
+      array_class, const_cast<char*>("ss#"), "i", data,
+      static_cast<Py_ssize_t>(values.size() * sizeof(int)));
+}
+
+static PyObject* tokenize(PyObject* self, PyObject* args, PyObject* kwargs) {
+  static const char* kwlist[] = {"text", "handwritten", "line_starts", NULL};
+  const char* bytes;
+  Py_ssize_t length;
+  PyObject* handwritten = Py_None;
+  PyObject* line_starts = Py_False;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s#|OO",
+                                   const_cast<char**>(kwlist),
+                                   &bytes, &length, &handwritten,
+                                   &line_starts))
+    return NULL;
+  int want_line_starts = PyObject_IsTrue(line_starts);
+  if (want_line_starts < 0) {
+    return NULL;
+  }
+
+  pytype::LexerBackend backend = pytype::kDefaultLexerBackend;
+  if (handwritten != Py_None) {
+    int value = PyObject_IsTrue(handwritten);
+    if (value < 0) {
+      return NULL;
+    }
+    backend = value ? pytype::kHandwrittenBackend : pytype::kFlexBackend;
+  }
+
+  pytype::Lexer lexer(bytes, length, backend);
+  Py_BEGIN_ALLOW_THREADS
+  lexer.Tokenize();
+  if (want_line_starts) {
+    lexer.LineStarts();
+  }
+  Py_END_ALLOW_THREADS
+
+  const std::vector<pytype::Token>& tokens = lexer.tokens();
+  // The final token marks the end of input and is not returned.
+  PyObject* result = PyList_New(tokens.size() - 1);
+  if (result == NULL) {
+    return NULL;
+  }
+  for (size_t i = 0; i + 1 < tokens.size(); ++i) {
+    const pytype::Token& t = tokens[i];
+    PyObject* obj = lexer.MaterializeValue(t);
+    if (obj == NULL) {
+      if (PyErr_Occurred()) {
+        Py_DECREF(result);
+        return NULL;
+      }
+      Py_INCREF(Py_None);
+      obj = Py_None;
+    }
+
+    PyObject* token = Py_BuildValue(
+        "(iNiiii)", t.kind, obj, t.location.first_line,
+        t.location.first_column, t.location.last_line,
+        t.location.last_column);
+    if (token == NULL) {
+      Py_DECREF(result);
+      return NULL;
+    }
+    PyList_SET_ITEM(result, i, token);
+  }
+
+  if (want_line_starts) {
+    PyObject* array_class = GetArrayClass();
+    if (array_class == NULL) {
+      Py_DECREF(result);
+      return NULL;
+    }
+    result = Py_BuildValue("(NN)", result,
+                           NewIntArray(array_class, lexer.LineStarts()));
+    Py_DECREF(array_class);
+  }
+  return result;
+}
+
+static char tokenize_doc[] =
+    "tokenize(text, handwritten=None, line_starts=False)\n\n"
+    "Convert a string into a list of token tuples.  If handwritten is not\n"
+    "None it selects the handwritten or the flex scanner, otherwise the\n"
+    "default scanner (see HANDWRITTEN_LEXER) is used.  If line_starts is\n"
+    "true, returns a tuple (tokens, line_starts) where line_starts is an\n"
+    "array.array('i') of the byte offsets at which the lines start: line n\n"
+    "(1-based, as in the token locations) starts at line_starts[n - 1].";
+
+// The smallest number of bytes after an edit that relex_columns() scans.
+static const int kMinRelexWindow = 4096;
+
+// The columns returned by tokenize_columns() and relex_columns().
+struct TokenColumns {
+  std::vector<int> kinds, starts, ends, lines, columns, values;
+  std::vector<int> line_starts;
+  std::vector<int> checkpoints;
+
+  size_t size() const { return kinds.size(); }
+
+  // Remove the tokens after the first size.
+  void Truncate(size_t size) {
+    kinds.resize(size);
+    starts.resize(size);
+    ends.resize(size);
+    lines.resize(size);
+    columns.resize(size);
+    values.resize(size);
+  }
+
+  // Append token i of other, moved by offset bytes and line_delta lines.
+  void AppendFrom(const TokenColumns& other, size_t i, int offset,
+                  int line_delta) {
+    kinds.push_back(other.kinds[i]);
+    starts.push_back(other.starts[i] + offset);
+    ends.push_back(other.ends[i] + offset);
+    lines.push_back(other.lines[i] + line_delta);
+    columns.push_back(other.columns[i]);
+    values.push_back(other.values[i]);
+  }
+};
+
+// Append the columns of a token scanned by lexer, moved by offset bytes.
+// Values are added to strings (a list) with string_index mapping the text of
+// each value to its index, thus identical values share an index.  Only names
+// are interned (like the parser's), numbers and error messages are shared
+// within strings alone.  Returns false if there was an error.
+static bool AppendToken(pytype::Lexer* lexer, const pytype::Token& t,
+                        int offset, TokenColumns* columns, PyObject* strings,
+                        std::unordered_map<std::string, int>* string_index) {
+  columns->kinds.push_back(t.kind);
+  columns->starts.push_back(t.start + offset);
+  columns->ends.push_back(t.end + offset);
+  columns->lines.push_back(t.location.first_line);
+  columns->columns.push_back(t.location.first_column);
+  if (t.value_kind == pytype::kNoValue) {
+    columns->values.push_back(-1);
+    return true;
+  }
+
+  std::string key;
+  const char* text;
+  int text_length;
+  if (lexer->GetValueText(t, &text, &text_length)) {
+    key.assign(text, text_length);
+  } else {
+    lexer->GetErrorMessage(t, &key);
+  }
+  std::unordered_map<std::string, int>::iterator it = string_index->find(key);
+  if (it != string_index->end()) {
+    columns->values.push_back(it->second);
+    return true;
+  }
+
+  PyObject* value;
+  if (t.value_kind == pytype::kNameValue ||
+      t.value_kind == pytype::kQuotedNameValue) {
+    value = lexer->Intern(key.data(), key.size());
+  } else {
+    value = PyString_FromStringAndSize(key.data(), key.size());
+  }
+  if (value == NULL) {
+    return false;
+  }
+  int index = PyList_GET_SIZE(strings);
+  int err = PyList_Append(strings, value);
+  Py_DECREF(value);
+  if (err < 0) {
+    return false;
+  }
+  string_index->insert(std::make_pair(key, index));
+  columns->values.push_back(index);
+  return true;
+}
+
+// Return a new dict holding columns and strings, plus the items of extra (a
+// dict, or NULL).  Consumes the reference to strings, even on error.
+static PyObject* BuildColumnsDict(const TokenColumns& columns,
+                                  PyObject* strings, PyObject* extra) {
+  PyObject* array_class = GetArrayClass();
+  if (array_class == NULL) {
+    Py_DECREF(strings);
+    return NULL;
+  }
+
+  PyObject* result = Py_BuildValue(
+      "{s:N,s:N,s:N,s:N,s:N,s:N,s:N,s:N,s:N}",
+      "kind", NewIntArray(array_class, columns.kinds),
+      "start", NewIntArray(array_class, columns.starts),
+      "end", NewIntArray(array_class, columns.ends),
+      "line", NewIntArray(array_class, columns.lines),
+      "column", NewIntArray(array_class, columns.columns),
+      "value", NewIntArray(array_class, columns.values),
+      "line_starts", NewIntArray(array_class, columns.line_starts),
+      "checkpoints", NewIntArray(array_class, columns.checkpoints),
+      "strings", strings);
+  Py_DECREF(array_class);
+  if (result && extra && PyDict_Update(result, extra) < 0) {
+    Py_CLEAR(result);
+  }
+  return result;
+}
+
+static PyObject* tokenize_columns(PyObject* self, PyObject* args) {
+  const char* bytes;
+  Py_ssize_t length;
+
+  if (!PyArg_ParseTuple(args, "s#", &bytes, &length))
+    return NULL;
+
+  pytype::Lexer lexer(bytes, length);
+  Py_BEGIN_ALLOW_THREADS
+  lexer.Tokenize();
+  lexer.LineStarts();
+  Py_END_ALLOW_THREADS
+
+  // The final token marks the end of input and is not returned.
+  const std::vector<pytype::Token>& tokens = lexer.tokens();
+  size_t count = tokens.size() - 1;
+  TokenColumns columns;
+  columns.line_starts = lexer.LineStarts();
+  columns.checkpoints = lexer.checkpoints();
+
+  PyObject* strings = PyList_New(0);
+  if (strings == NULL) {
+    return NULL;
+  }
+  std::unordered_map<std::string, int> string_index;
+  for (size_t i = 0; i < count; ++i) {
+    if (!AppendToken(&lexer, tokens[i], 0, &columns, strings,
+                     &string_index)) {
+      Py_DECREF(strings);
+      return NULL;
+    }
+  }
+
+  return BuildColumnsDict(columns, strings, NULL);
+}
+
+static char tokenize_columns_doc[] =
+    "tokenize_columns(text)\n\n"
+    "Tokenize text into columns rather than a list of tuples.  Returns a\n"
+    "dict of parallel array.array('i') columns (which support the buffer\n"
+    "protocol) with one entry per token:\n"
+    "  kind - The token code, as in TOKENS or a character code.\n"
+    "  start, end - The byte offsets of the token's text.\n"
+    "  line, column - The token's (1-based) starting location.\n"
+    "  value - An index into strings, -1 if the token has no value.\n"
+    "In addition there is 'strings', a list of the distinct values of the\n"
+    "NAME and NUMBER tokens (as their source text) and LEXERROR tokens (as\n"
+    "the message), 'line_starts', an array of the byte offsets at which\n"
+    "the lines start (see tokenize()), and 'checkpoints', an array of the\n"
+    "indexes of the tokens at which relex_columns() can restart the lexer.";
+
+
+// Copy the array('i') (or other buffer) dict[key] into values.  Returns
+// false if there was an error.
+static bool GetIntColumn(PyObject* dict, const char* key,
+                         std::vector<int>* values) {
+  PyObject* column = PyDict_GetItemString(dict, key);
+  if (column == NULL) {
+    PyErr_Format(PyExc_KeyError, "%s", key);
+    return false;
+  }
+  const void* data;
+  Py_ssize_t length;
+  if (PyObject_AsReadBuffer(column, &data, &length) < 0) {
+    return false;
+  }
+  if (length % sizeof(int)) {
+    PyErr_Format(PyExc_ValueError, "%s is not an array of ints", key);
+    return false;
+  }
+  const int* ints = static_cast<const int*>(data);
+  values->assign(ints, ints + length / sizeof(int));
+  return true;
+}
+
+// Read the columns returned by tokenize_columns().  Returns false if there
+// was an error.
+static bool GetColumns(PyObject* dict, TokenColumns* columns) {
+  if (!PyDict_Check(dict)) {
+    PyErr_SetString(PyExc_TypeError, "columns must be a dict");
+    return false;
+  }
+  if (!GetIntColumn(dict, "kind", &columns->kinds) ||
+      !GetIntColumn(dict, "start", &columns->starts) ||
+      !GetIntColumn(dict, "end", &columns->ends) ||
+      !GetIntColumn(dict, "line", &columns->lines) ||
+      !GetIntColumn(dict, "column", &columns->columns) ||
+      !GetIntColumn(dict, "value", &columns->values) ||
+      !GetIntColumn(dict, "line_starts", &columns->line_starts) ||
+      !GetIntColumn(dict, "checkpoints", &columns->checkpoints)) {
+    return false;
+  }
+  size_t count = columns->size();
+  if (columns->starts.size() != count || columns->ends.size() != count ||
+      columns->lines.size() != count || columns->columns.size() != count ||
+      columns->values.size() != count || columns->line_starts.empty()) {
+    PyErr_SetString(PyExc_ValueError, "inconsistent columns");
+    return false;
+  }
+  for (size_t i = 0; i < columns->checkpoints.size(); ++i) {
+    if (columns->checkpoints[i] < 0 ||
+        static_cast<size_t>(columns->checkpoints[i]) >= count) {
+      PyErr_SetString(PyExc_ValueError, "inconsistent columns");
+      return false;
+    }
+  }
+  return true;
+}
+
+static PyObject* relex_columns(PyObject* self, PyObject* args) {
+  const char* bytes;
+  Py_ssize_t length;
+  PyObject* old_dict;
+  int edit_start, old_end, new_end;
+
+  if (!PyArg_ParseTuple(args, "s#O!iii", &bytes, &length, &PyDict_Type,
+                        &old_dict, &edit_start, &old_end, &new_end)) {
+    return NULL;
+  }
+
+  TokenColumns old_columns;
+  if (!GetColumns(old_dict, &old_columns)) {
+    return NULL;
+  }
+  const TokenColumns& old = old_columns;
+  // The edit replaced old text [edit_start, old_end) with the new text
+  // [edit_start, new_end).
+  const int delta = new_end - old_end;
+  if (edit_start < 0 || edit_start > old_end || edit_start > new_end ||
+      new_end > length) {
+    PyErr_SetString(PyExc_ValueError, "invalid edit");
+    return NULL;
+  }
+
+  // Restart at the last checkpoint before the edit, or at the start.
+  std::vector<int>::const_iterator cp = std::upper_bound(
+      old.checkpoints.begin(), old.checkpoints.end(), edit_start,
+      [&old](int offset, int i) { return offset < old.starts[i]; });
+  size_t restart_token = 0;
+  int restart_offset = 0;
+  int restart_line = 1;
+  if (cp != old.checkpoints.begin()) {
+    restart_token = *(cp - 1);
+    restart_offset = old.starts[restart_token];
+    restart_line = old.lines[restart_token];
+  }
+
+  TokenColumns columns;
+  for (size_t i = 0; i < restart_token; ++i) {
+    columns.AppendFrom(old, i, 0, 0);
+  }
+  columns.checkpoints.assign(old.checkpoints.begin(), cp);
+  if (!columns.checkpoints.empty()) {
+    // The restart token is scanned again.
+    columns.checkpoints.pop_back();
+  }
+
+  // Lines that start at or before the edit are unchanged, lines that start
+  // within it are found by scanning the new text, and lines that start
+  // after it are moved.
+  std::vector<int>::const_iterator line = std::upper_bound(
+      old.line_starts.begin(), old.line_starts.end(), edit_start);
+  columns.line_starts.assign(old.line_starts.begin(), line);
+  const char* end = bytes + new_end;
+  for (const char* p = bytes + edit_start;
+       (p = pytype::FindNewline(p, end)) != end; ) {
+    ++p;
+    columns.line_starts.push_back(p - bytes);
+  }
+  line = std::upper_bound(line, old.line_starts.end(), old_end);
+  int line_delta = static_cast<int>(columns.line_starts.size()) -
+      (line - old.line_starts.begin());
+  for (; line != old.line_starts.end(); ++line) {
+    columns.line_starts.push_back(*line + delta);
+  }
+
+  PyObject* strings = PyDict_GetItemString(old_dict, "strings");
+  strings = strings ? PySequence_List(strings) : PyList_New(0);
+  if (strings == NULL) {
+    return NULL;
+  }
+  // Reuse the old values, except any that aren't strings.
+  std::unordered_map<std::string, int> string_index;
+  for (Py_ssize_t i = 0; i < PyList_GET_SIZE(strings); ++i) {
+    PyObject* value = PyList_GET_ITEM(strings, i);
+    if (PyString_Check(value)) {
+      string_index.insert(std::make_pair(
+          std::string(PyString_AS_STRING(value), PyString_GET_SIZE(value)),
+          i));
+    }
+  }
+
+  // Scan from the restart point until a checkpoint after the edit that is
+  // also a checkpoint of the old tokens.  The lexer is in the same state at
+  // both, so the old tokens from there on are still valid.  The lexer scans
+  // a copy of its input, thus rather than the rest of the text it is given
+  // a window that ends at a line boundary after the edit.  The tokens before
+  // a checkpoint don't depend on the text after its line, so rejoining
+  // within the window is rejoining within the text.  If the tokens don't
+  // rejoin, the window is doubled and the scan repeated, until it reaches
+  // the end of the text.
+  const size_t kept_tokens = columns.size();
+  const size_t kept_checkpoints = columns.checkpoints.size();
+  size_t rejoin_token;
+  int relexed;
+  for (int window = std::max(kMinRelexWindow, 2 * (new_end - restart_offset));
+       ; window *= 2) {
+    int window_end = length;
+    if (window < length - new_end) {
+      const char* p = pytype::FindNewline(bytes + new_end + window,
+                                          bytes + length);
+      if (p != bytes + length) {
+        window_end = p + 1 - bytes;
+      }
+    }
+    pytype::Lexer lexer(bytes + restart_offset, window_end - restart_offset);
+    lexer.SetStartLine(restart_line);
+    rejoin_token = old.size();
+    relexed = 0;
+    pytype::Token t;
+    bool checkpoint;
+    for (lexer.ScanToken(&t, &checkpoint); t.kind;
+         lexer.ScanToken(&t, &checkpoint), ++relexed) {
+      int start = t.start + restart_offset;
+      if (checkpoint) {
+        if (start > new_end) {
+          std::vector<int>::const_iterator it = std::lower_bound(
+              old.checkpoints.begin(), old.checkpoints.end(), start - delta,
+              [&old](int i, int offset) { return old.starts[i] < offset; });
+          if (it != old.checkpoints.end() &&
+              old.starts[*it] == start - delta) {
+            rejoin_token = *it;
+            line_delta = t.location.first_line - old.lines[rejoin_token];
+            break;
+          }
+        }
+        columns.checkpoints.push_back(columns.size());
+      }
+      if (!AppendToken(&lexer, t, restart_offset, &columns, strings,
+                       &string_index)) {
+        Py_DECREF(strings);
+        return NULL;
+      }
+    }
+    if (rejoin_token != old.size() || window_end == length) {
+      break;
+    }
+    // Values added to strings by this scan are left unused.
+    columns.Truncate(kept_tokens);
+    columns.checkpoints.resize(kept_checkpoints);
+  }
+
+  int rejoin_index = columns.size();
+  for (size_t i = rejoin_token; i < old.size(); ++i) {
+    columns.AppendFrom(old, i, delta, line_delta);
+  }
+  for (cp = std::lower_bound(old.checkpoints.begin(), old.checkpoints.end(),
+                             static_cast<int>(rejoin_token));
+       cp != old.checkpoints.end(); ++cp) {
+    columns.checkpoints.push_back(*cp - rejoin_token + rejoin_index);
+  }
+
+  PyObject* extra = Py_BuildValue("{s:i}", "relexed", relexed);
+  if (extra == NULL) {
+    Py_DECREF(strings);
+    return NULL;
+  }
+  PyObject* result = BuildColumnsDict(columns, strings, extra);
+  Py_DECREF(extra);
+  return result;
+}
+
+static char relex_columns_doc[] =
+    "relex_columns(text, columns, start, old_end, new_end)\n\n"
+    "Update the result of tokenize_columns() after an edit, which replaced\n"
+    "the text between the offsets start and old_end with the text between\n"
+    "start and new_end of text (the new text).  The lexer restarts at the\n"
+    "last checkpoint before the edit and stops once its tokens rejoin the\n"
+    "old ones at a checkpoint after the edit.  It scans a copy of a window\n"
+    "of the text after the edit, which is doubled (and the scan repeated)\n"
+    "until the tokens rejoin within it, thus the scanning depends on the\n"
+    "size of the edit rather than of the text, except that up to about\n"
+    "twice the rest of the text is scanned if the tokens never rejoin.\n"
+    "Reading and building the columns is still linear in the number of\n"
+    "tokens.  Returns the same columns as tokenize_columns(text), except\n"
+    "that 'strings' may contain values that are no longer used, plus\n"
+    "'relexed', the number of new tokens produced by the lexer.";
+
+
+static PyObject* set_global_interning(PyObject* self, PyObject* args) {
+  PyObject* enabled;
+
+  if (!PyArg_ParseTuple(args, "O", &enabled)) {
+    return NULL;
+  }
+  int value = PyObject_IsTrue(enabled);
+  if (value < 0) {
+    return NULL;
+  }
+
+  pytype::Lexer::set_global_interning(value);
+  Py_RETURN_NONE;
+}
+
+static char set_global_interning_doc[] =
+    "set_global_interning(enabled)\n\n"
+    "If enabled, NAME strings are interned in a process-wide table that\n"
+    "lives as long as the process, otherwise each parse uses its own table.";
+
+
+static PyObject* intern_stats(PyObject* self, PyObject* args) {
+  PyObject* reset = Py_False;
+
+  if (!PyArg_ParseTuple(args, "|O", &reset)) {
+    return NULL;
+  }
+  int do_reset = PyObject_IsTrue(reset);
+  if (do_reset < 0) {
+    return NULL;
+  }
+
+  PyObject* stats = Py_BuildValue(
+      "{s:l,s:l,s:i,s:O}",
+      "hits", pytype::InternTable::total_hits(),
+      "misses", pytype::InternTable::total_misses(),
+      "global_size", pytype::InternTable::Global()->size(),
+      "global", pytype::Lexer::global_interning() ? Py_True : Py_False);
+  if (stats && do_reset) {
+    pytype::InternTable::ResetTotals();
+  }
+  return stats;
+}
+
+static char intern_stats_doc[] =
+    "intern_stats(reset=False)\n\n"
+    "Return a dict of NAME interning statistics for all lexers since the\n"
+    "last reset: 'hits' and 'misses' count repeated and new spellings,\n"
+    "'global_size' is the size of the process-wide table and 'global' is\n"
+    "the current set_global_interning() setting.  If reset is true the\n"
+    "counters are then reset.";
+
+
+// The names of the tokens that are not single characters.
+#define TOKEN_NAME(name) {name, #name}
+static const struct {
+  int value;
+  const char* name;
+} token_names[] = {
+  TOKEN_NAME(NAME),
+  TOKEN_NAME(NUMBER),
+  TOKEN_NAME(TRIPLEQUOTED),
+  TOKEN_NAME(TYPECOMMENT),
+  TOKEN_NAME(ARROW),
+  TOKEN_NAME(COLONEQUALS),
+  TOKEN_NAME(ELLIPSIS),
+  TOKEN_NAME(EQ),
+  TOKEN_NAME(NE),
+  TOKEN_NAME(LE),
+  TOKEN_NAME(GE),
+  TOKEN_NAME(INDENT),
+  TOKEN_NAME(DEDENT),
+  TOKEN_NAME(LEXERROR),
+
+  // Reserved words.
+  TOKEN_NAME(CLASS),
+  TOKEN_NAME(DEF),
+  TOKEN_NAME(ELSE),
+  TOKEN_NAME(ELIF),
+  TOKEN_NAME(IF),
+  TOKEN_NAME(OR),
+  TOKEN_NAME(PASS),
+  TOKEN_NAME(IMPORT),
+  TOKEN_NAME(FROM),
+  TOKEN_NAME(AS),
+  TOKEN_NAME(RAISE),
+  TOKEN_NAME(PYTHONCODE),
+  TOKEN_NAME(NOTHING),
+  TOKEN_NAME(RAISES),
+  TOKEN_NAME(NAMEDTUPLE),
+  TOKEN_NAME(TYPEVAR),
+};
+#undef TOKEN_NAME
+
+
+static PyObject* set_lexer_stats(PyObject* self, PyObject* args) {
+  PyObject* enabled;
+
+  if (!PyArg_ParseTuple(args, "O", &enabled)) {
+    return NULL;
+  }
+  int value = PyObject_IsTrue(enabled);
+  if (value < 0) {
+    return NULL;
+  }
+
+  pytype::Lexer::set_collect_stats(value);
+  Py_RETURN_NONE;
+}
+
+static char set_lexer_stats_doc[] =
+    "set_lexer_stats(enabled)\n\n"
+    "If enabled, lexers created afterwards count what they scan, see\n"
+    "lexer_stats().  Counting is off by default.";
+
+
+// Add value to dict under key unless it is 0.  Returns false if there was an
+// error.
+static bool AddCount(PyObject* dict, const char* key, long value) {
+  if (value == 0) {
+    return true;
+  }
+  PyObject* count = PyInt_FromLong(value);
+  if (count == NULL) {
+    return false;
+  }
+  int result = PyDict_SetItemString(dict, key, count);
+  Py_DECREF(count);
+  return result == 0;
+}
+
+static PyObject* lexer_stats(PyObject* self, PyObject* args) {
+  // In the order of the start states in lexer.lex.
+  static const char* state_names[pytype::LexerStats::kStartStates] = {
+    "INITIAL", "NEWLINE", "PENDING", "TRIPLE1", "TRIPLE2", "COMMENT",
+  };
+  PyObject* reset = Py_False;
+
+  if (!PyArg_ParseTuple(args, "|O", &reset)) {
+    return NULL;
+  }
+  int do_reset = PyObject_IsTrue(reset);
+  if (do_reset < 0) {
+    return NULL;
+  }
+
+  // Lexers in other threads may add to the totals at any time, thus they
+  // are reset as they are read.
+  pytype::LexerStats totals;
+  pytype::Lexer::TotalStats(&totals, do_reset);
+  PyObject* state_bytes = PyDict_New();
+  PyObject* tokens = PyDict_New();
+  bool ok = state_bytes && tokens;
+  for (int i = 0; ok && i < pytype::LexerStats::kStartStates; ++i) {
+    ok = AddCount(state_bytes, state_names[i], totals.state_bytes[i]);
+  }
+  // Characters are their own names.
+  for (int i = 0; ok && i < 256; ++i) {
+    char name[] = {static_cast<char>(i), '\0'};
+    ok = AddCount(tokens, name, totals.tokens[i]);
+  }
+  for (const auto& token : token_names) {
+    if (!ok) {
+      break;
+    }
+    ok = AddCount(tokens, token.name, totals.tokens[token.value]);
+  }
+  PyObject* stats = NULL;
+  if (ok) {
+    stats = Py_BuildValue(
+        "{s:O,s:O,s:O,s:l,s:l,s:i,s:l,s:l}",
+        "enabled", pytype::Lexer::collect_stats() ? Py_True : Py_False,
+        "state_bytes", state_bytes,
+        "tokens", tokens,
+        "indents", totals.tokens[INDENT],
+        "dedents", totals.tokens[DEDENT],
+        "max_indent_depth", totals.max_indent_depth,
+        "values", totals.values,
+        "allocations", totals.allocations);
+  }
+  Py_XDECREF(state_bytes);
+  Py_XDECREF(tokens);
+  return stats;
+}
+
+static char lexer_stats_doc[] =
+    "lexer_stats(reset=False)\n\n"
+    "Return a dict of the counts of lexers that have finished since the\n"
+    "last reset, while set_lexer_stats() was enabled:\n"
+    "  'state_bytes': bytes scanned per start state of lexer.lex, with text\n"
+    "      skipped by an action counted for the state it bypasses.\n"
+    "  'tokens': tokens scanned per kind, keyed by the TOKENS name or the\n"
+    "      character for single character tokens.\n"
+    "  'indents', 'dedents': the INDENT and DEDENT counts.\n"
+    "  'max_indent_depth': the greatest number of indentation levels.\n"
+    "  'values': token value objects created, of which 'allocations' were\n"
+    "      new objects rather than interned names found in a table.\n"
+    "  'enabled': the current set_lexer_stats() setting.\n"
+    "Counts of zero are left out.  If reset is true the counts are reset\n"
+    "as they are read.";
+
+
+static PyObject* set_parse_stats(PyObject* self, PyObject* args) {
+  PyObject* enabled;
+
+  if (!PyArg_ParseTuple(args, "O", &enabled)) {
+    return NULL;
+  }
+  int value = PyObject_IsTrue(enabled);
+  if (value < 0) {
+    return NULL;
+  }
+
+  pytype::Context::set_collect_stats(value);
+  Py_RETURN_NONE;
+}
+
+static char set_parse_stats_doc[] =
+    "set_parse_stats(enabled)\n\n"
+    "If enabled, parses started afterwards count the reductions of the\n"
+    "grammar's rules and time their calls of the peer, see parse_stats().\n"
+    "Counting is off by default.";
+
+
+// Add value to dict under key unless it is 0.  Returns false if there was an
+// error.
+static bool AddSeconds(PyObject* dict, const char* key, double value) {
+  if (value == 0) {
+    return true;
+  }
+  PyObject* seconds = PyFloat_FromDouble(value);
+  if (seconds == NULL) {
+    return false;
+  }
+  int result = PyDict_SetItemString(dict, key, seconds);
+  Py_DECREF(seconds);
+  return result == 0;
+}
+
+static PyObject* parse_stats(PyObject* self, PyObject* args) {
+  PyObject* reset = Py_False;
+
+  if (!PyArg_ParseTuple(args, "|O", &reset)) {
+    return NULL;
+  }
+  int do_reset = PyObject_IsTrue(reset);
+  if (do_reset < 0) {
+    return NULL;
+  }
+
+  // Parses in other threads may add to the totals at any time, thus they
+  // are reset as they are read.
+  pytype::ParseStats totals;
+  pytype::Context::TotalStats(&totals, do_reset);
+  // The parsers have their own copies of the names.
+  std::unordered_map<std::string, long> symbols;
+  for (const auto& entry : totals.reductions) {
+    symbols[entry.first] += entry.second;
+  }
+  PyObject* reductions = PyDict_New();
+  PyObject* calls = PyDict_New();
+  PyObject* call_seconds = PyDict_New();
+  bool ok = reductions && calls && call_seconds;
+  for (const auto& symbol : symbols) {
+    if (!ok) {
+      break;
+    }
+    ok = AddCount(reductions, symbol.first.c_str(), symbol.second);
+  }
+  for (const auto& entry : pytype::call_attributes) {
+    if (!ok) {
+      break;
+    }
+    ok = AddCount(calls, entry.attribute_name, totals.calls[entry.selector]) &&
+        AddSeconds(call_seconds, entry.attribute_name,
+                   totals.call_seconds[entry.selector]);
+  }
+  PyObject* stats = NULL;
+  if (ok) {
+    stats = Py_BuildValue(
+        "{s:O,s:O,s:O,s:O}",
+        "enabled", pytype::Context::collect_stats() ? Py_True : Py_False,
+        "reductions", reductions,
+        "calls", calls,
+        "call_seconds", call_seconds);
+  }
+  Py_XDECREF(reductions);
+  Py_XDECREF(calls);
+  Py_XDECREF(call_seconds);
+  return stats;
+}
+
+static char parse_stats_doc[] =
+    "parse_stats(reset=False)\n\n"
+    "Return a dict of the counts of parses that have finished since the\n"
+    "last reset, while set_parse_stats() was enabled:\n"
+    "  'reductions': reductions of the grammar's rules, keyed by the\n"
+    "      nonterminal of parser.y that they reduce to.\n"
+    "  'calls': calls of the peer's methods by name.  Nodes and conditions\n"
+    "      built natively, and memoized types, don't call the peer.\n"
+    "  'call_seconds': the wall time spent in the peer's methods by name.\n"
+    "  'enabled': the current set_parse_stats() setting.\n"
+    "Counts of zero are left out.  If reset is true the counts are reset\n"
+    "as they are read.";
+
+
+static PyObject* fastscan(PyObject* self, PyObject* args) {
+  return PyString_FromString(pytype::FastScanName());
+}
+
+static char fastscan_doc[] =
+    "fastscan()\n\n"
+    "Return the name of the implementation the lexers use to skip\n"
+    "docstrings, comments and empty lines: 'avx2', 'sse2' or 'scalar'.";
+
+
+static PyObject* set_fastscan(PyObject* self, PyObject* args) {
+  const char* name;
+
+  if (!PyArg_ParseTuple(args, "s", &name)) {
+    return NULL;
+  }
+  if (!pytype::SelectFastScan(name)) {
+    PyErr_Format(PyExc_ValueError, "fastscan implementation not available: %s",
+                 name);
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+static char set_fastscan_doc[] =
+    "set_fastscan(name)\n\n"
+    "Select the implementation returned by fastscan().  Raises ValueError if\n"
+    "the name is unknown or the CPU does not support it.  All\n"
+    "implementations produce identical tokens, this is for tests and\n"
+    "benchmarks.";
+
+
+static PyObject* time_calls(PyObject* self, PyObject* args) {
+  PyObject* peer;
+  int iterations;
+  pytype::Context ctx;
+
+  if (!PyArg_ParseTuple(args, "Oi", &peer, &iterations)) {
+    return NULL;
+  }
+  if (iterations <= 0) {
+    PyErr_SetString(PyExc_ValueError, "iterations must be positive");
+    return NULL;
+  }
+  if (!ctx.Init(peer)) {
+    return NULL;
+  }
+
+  PyObject* rates = PyDict_New();
+  if (rates == NULL) {
+    return NULL;
+  }
+  for (const auto& entry : pytype::call_attributes) {
+    const int arity = pytype::call_arity[entry.selector];
+    auto start = std::chrono::steady_clock::now();
+    for (int n = 0; n < iterations; n++) {
+      PyObject* call_args[pytype::kMaxCallArity];
+      for (int i = 0; i < arity; i++) {
+        Py_INCREF(Py_None);
+        call_args[i] = Py_None;
+      }
+      PyObject* result = ctx.Call(entry.selector, arity, call_args);
+      if (result == NULL) {
+        Py_DECREF(rates);
+        return NULL;
+      }
+      Py_DECREF(result);
+    }
+    std::chrono::duration<double> seconds =
+        std::chrono::steady_clock::now() - start;
+    PyObject* rate = PyFloat_FromDouble(iterations / seconds.count());
+    if (rate == NULL ||
+        PyDict_SetItemString(rates, entry.attribute_name, rate) < 0) {
+      Py_XDECREF(rate);
+      Py_DECREF(rates);
+      return NULL;
+    }
+    Py_DECREF(rate);
+  }
+  return rates;
+}
+
+static char time_calls_doc[] =
+    "time_calls(peer, iterations)\n\n"
+    "Call each of the peer's methods iterations times with None for every\n"
+    "argument, the way the parser calls them, and return a dict that maps\n"
+    "the method names to calls per second.  This is for benchmarks, see\n"
+    "call_benchmark.py.";
+
+
+// A parser_ext.Parser: a Context initialized for a peer class, and a
+// Lexer, which all of its parses reuse.
+typedef struct {
+  PyObject_HEAD
+  pytype::Context* ctx;
+  // NULL until the first parse.
+  pytype::Lexer* lexer;
+  // Whether a parse is using ctx and lexer.  A parse started meanwhile (by
+  // the peer, or by another thread while the GIL is released) uses its own.
+  bool busy;
+} ParserObject;
+
+static PyObject* Parser_new(PyTypeObject* type, PyObject* args,
+                            PyObject* kwargs) {
+  static const char* kwlist[] = {"peer_class", NULL};
+  PyObject* peer_class;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O",
+                                   const_cast<char**>(kwlist),
+                                   &peer_class)) {
+    return NULL;
+  }
+  ParserObject* self = reinterpret_cast<ParserObject*>(type->tp_alloc(type, 0));
+  if (self == NULL) {
+    return NULL;
+  }
+  self->ctx = new pytype::Context;
+  self->lexer = NULL;
+  self->busy = false;
+  if (!self->ctx->InitClass(peer_class)) {
+    Py_DECREF(self);
+    return NULL;
+  }
+  return reinterpret_cast<PyObject*>(self);
+}
+
+static void Parser_dealloc(ParserObject* self) {
+  delete self->lexer;
+  delete self->ctx;
+  Py_TYPE(self)->tp_free(reinterpret_cast<PyObject*>(self));
+}
+
+// Run the parser over the input that self's lexer was reset to, with self's
+// Context bound to peer, and return the result (a new reference), or NULL
+// if there was an error.
+static PyObject* RunBoundParser(ParserObject* self, PyObject* peer,
+                                PyObject* errors, bool pretokenize) {
+  PyObject* result = NULL;
+  if (self->ctx->Bind(peer) &&
+      (errors == Py_None || self->ctx->EnableRecovery(errors))) {
+    self->busy = true;
+    result = RunParser(self->lexer, self->ctx, pretokenize);
+    self->busy = false;
+  }
+  self->ctx->Reset();
+  self->lexer->MergeStats();
+  return result;
+}
+
+static PyObject* Parser_parse(ParserObject* self, PyObject* args,
+                              PyObject* kwargs) {
+  if (self->busy) {
+    return parse(NULL, args, kwargs);
+  }
+  static const char* kwlist[] = {"peer", "text", "pretokenize", "errors",
+                                 NULL};
+  const char* bytes;
+  Py_ssize_t length;
+  PyObject* peer;
+  PyObject* pretokenize = Py_False;
+  PyObject* errors = Py_None;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Os#|OO",
+                                   const_cast<char**>(kwlist),
+                                   &peer, &bytes, &length, &pretokenize,
+                                   &errors)) {
+    return NULL;
+  }
+  int do_pretokenize = PyObject_IsTrue(pretokenize);
+  if (do_pretokenize < 0) {
+    return NULL;
+  }
+
+  if (self->lexer == NULL) {
+    self->lexer = new pytype::Lexer(bytes, length);
+  } else {
+    self->lexer->Reset(bytes, length);
+  }
+  return RunBoundParser(self, peer, errors, do_pretokenize != 0);
+}
+
+static PyObject* Parser_parse_file(ParserObject* self, PyObject* args,
+                                   PyObject* kwargs) {
+  if (self->busy) {
+    return parse_file(NULL, args, kwargs);
+  }
+  static const char* kwlist[] = {"peer", "path", "pretokenize", "errors",
+                                 NULL};
+  const char* path;
+  PyObject* peer;
+  PyObject* pretokenize = Py_False;
+  PyObject* errors = Py_None;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Os|OO",
+                                   const_cast<char**>(kwlist),
+                                   &peer, &path, &pretokenize, &errors)) {
+    return NULL;
+  }
+  int do_pretokenize = PyObject_IsTrue(pretokenize);
+  if (do_pretokenize < 0) {
+    return NULL;
+  }
+
+  pytype::MappedFile file;
+  if (!file.Open(path)) {
+    return PyErr_SetFromErrnoWithFilename(PyExc_IOError, path);
+  }
+  // The lexer isn't used again until it is reset to another input, thus it
+  // may outlive the file.
+  if (self->lexer == NULL) {
+    self->lexer = new pytype::Lexer(file);
+  } else {
+    self->lexer->Reset(file);
+  }
+  return RunBoundParser(self, peer, errors, do_pretokenize != 0);
+}
+
+static PyMethodDef Parser_methods[] = {
+  {"parse", (PyCFunction)Parser_parse, METH_VARARGS | METH_KEYWORDS,
+   "parse(peer, text, pretokenize=False, errors=None)\n\n"
+   "Like the module's parse(), but peer must be an instance of the class\n"
+   "this parser was created for."},
+  {"parse_file", (PyCFunction)Parser_parse_file,
+   METH_VARARGS | METH_KEYWORDS,
+   "parse_file(peer, path, pretokenize=False, errors=None)\n\n"
+   "Like the module's parse_file(), but peer must be an instance of the\n"
+   "class this parser was created for."},
+  {NULL}
+};
+
+static char Parser_doc[] =
+    "Parser(peer_class)\n\n"
+    "A parser for peers whose type is peer_class.  It looks up the peer's\n"
+    "methods and attributes once, on the class, and keeps its scanner and\n"
+    "other storage from one parse to the next, which saves the fixed cost of\n"
+    "a parse with the module's functions.  The peers may override the\n"
+    "class's methods (described in the selector tables defined in C++) in\n"
+    "their instance dicts, but not its other attributes.";
+
+static PyTypeObject ParserType = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+};
+
+// Fill in ParserType, returning false if there was an error.
+static bool InitParserType() {
+  ParserType.tp_name = "parser_ext.Parser";
+  ParserType.tp_basicsize = sizeof(ParserObject);
+  ParserType.tp_dealloc = reinterpret_cast<destructor>(Parser_dealloc);
+  ParserType.tp_flags = Py_TPFLAGS_DEFAULT;
+  ParserType.tp_doc = Parser_doc;
+  ParserType.tp_methods = Parser_methods;
+  ParserType.tp_new = Parser_new;
+  return PyType_Ready(&ParserType) >= 0;
+}
+
+
+static PyMethodDef methods[] = {
+  {"parse", (PyCFunction)parse, METH_VARARGS | METH_KEYWORDS, parse_doc},
+  {"parse_file", (PyCFunction)parse_file, METH_VARARGS | METH_KEYWORDS,
+   parse_file_doc},
+  {"parse_stream", (PyCFunction)parse_stream, METH_VARARGS | METH_KEYWORDS,
+   parse_stream_doc},
+  {"parse_ir", (PyCFunction)parse_ir, METH_VARARGS | METH_KEYWORDS,
+   parse_ir_doc},
+  {"decode_ir", (PyCFunction)decode_ir, METH_VARARGS, decode_ir_doc},
+  {"parse_ir_many", (PyCFunction)parse_ir_many, METH_VARARGS | METH_KEYWORDS,
+   parse_ir_many_doc},
+  {"scan_headers", (PyCFunction)scan_headers, METH_VARARGS | METH_KEYWORDS,
+   scan_headers_doc},
+  {"tokenize", (PyCFunction)tokenize, METH_VARARGS | METH_KEYWORDS,
+   tokenize_doc},
+  {"tokenize_columns", (PyCFunction)tokenize_columns, METH_VARARGS,
+   tokenize_columns_doc},
+  {"relex_columns", (PyCFunction)relex_columns, METH_VARARGS,
+   relex_columns_doc},
+  {"set_global_interning", (PyCFunction)set_global_interning, METH_VARARGS,
+   set_global_interning_doc},
+  {"intern_stats", (PyCFunction)intern_stats, METH_VARARGS, intern_stats_doc},
+  {"set_lexer_stats", (PyCFunction)set_lexer_stats, METH_VARARGS,
+   set_lexer_stats_doc},
+  {"lexer_stats", (PyCFunction)lexer_stats, METH_VARARGS, lexer_stats_doc},
+  {"set_parse_stats", (PyCFunction)set_parse_stats, METH_VARARGS,
+   set_parse_stats_doc},
+  {"parse_stats", (PyCFunction)parse_stats, METH_VARARGS, parse_stats_doc},
+  {"fastscan", (PyCFunction)fastscan, METH_NOARGS, fastscan_doc},
+  {"set_fastscan", (PyCFunction)set_fastscan, METH_VARARGS, set_fastscan_doc},
+  {"time_calls", (PyCFunction)time_calls, METH_VARARGS, time_calls_doc},
+  {NULL}
+};
+
+
+// Create a TOKENS attribute that maps token names to integer values.
+static void add_tokens_dict(PyObject* module) {
+  PyObject* tokens = PyDict_New();
+  for (const auto& token : token_names) {
+    PyObject* pyval = PyInt_FromLong(token.value);
+    PyDict_SetItemString(tokens, token.name, pyval);
+    Py_DECREF(pyval);
+  }
+
+  // Add dict to module.
+  PyObject_SetAttrString(module, "TOKENS", tokens);
+  Py_DECREF(tokens);
+}
+
+
+PyMODINIT_FUNC initparser_ext() {
+  // TODO(dbaum): Make this Python3 compatible.
+  PyObject* module = Py_InitModule("parser_ext", methods);
+  add_tokens_dict(module);
+  if (InitParserType()) {
+    PyObject* parser_type = reinterpret_cast<PyObject*>(&ParserType);
+    Py_INCREF(parser_type);
+    PyModule_AddObject(module, "Parser", parser_type);
+  }
+  PyModule_AddObject(module, "HANDWRITTEN_LEXER", PyBool_FromLong(
+      pytype::kDefaultLexerBackend == pytype::kHandwrittenBackend));
 }
@@ -1,12 +1,21 @@
+import collections
+import cStringIO
 import gc
 import hashlib
 import os
 import re
+import struct
 import sys
 import textwrap
+import threading
 
+from pytype import metrics
+from pytype import utils
+from pytype.pyi import call_benchmark
 from pytype.pyi import parser
+from pytype.pyi import parser_ext
 from pytype.pytd import pytd
+from pytype.pytd.parse import visitors
 
 import unittest
 
@@ -201,6 +210,21 @@ class ParserTest(_ParserTestBase):
                 
                 x = ...  # type: Union[int, str, float]""")
 
+  def test_dotted_name(self):
+    # Dotted names that aren't contiguous in the source.
+    self.check("x = ...  # type: foo . bar.Baz",
+               "x = ...  # type: foo.bar.Baz", prologue="import foo.bar")
+    self.check("x = ...  # type: foo.`bar`.Baz",
+               "x = ...  # type: foo.bar.Baz", prologue="import foo.bar")
+    self.check("x = ...  # type: foo.bar.Baz", prologue="import foo.bar")
+    self.check("from foo . bar import baz", "from foo.bar import baz")
+    self.check("def f(*args: foo.  bar, **kwargs) -> a.b: ...", """\
+                import a
+                import foo
+                from typing import Tuple
+
+                def f(*args: foo.bar, **kwargs) -> a.b: ...""")
+
   def test_empty_union_or_optional(self):
     self.check_error("def f(x: typing.Union): ...", 1,
                      "Missing options to typing.Union")
@@ -984,6 +1008,106 @@ class ConditionTest(_ParserTestBase):
                           "Unsupported condition: 'foo.bar'")
 
 
+class NativeConditionsTest(_ParserTestBase):
+
+  class _CountingParser(parser._Parser):
+    """A parser that counts the peer calls, optionally evaluating conditions.
+    """
+
+    def __init__(self, native_conditions):
+      super(NativeConditionsTest._CountingParser, self).__init__(None, None)
+      self._native = native_conditions
+      self.calls = collections.Counter()
+      for name in ("if_begin", "if_elif", "if_else", "if_end", "new_type",
+                   "new_constant"):
+        setattr(self, name, self._counter(name))
+
+    def _counter(self, name):
+      method = getattr(self, name)
+      def call(*args):
+        self.calls[name] += 1
+        return method(*args)
+      return call
+
+    def native_conditions(self):
+      if not self._native:
+        return None
+      return super(NativeConditionsTest._CountingParser,
+                   self).native_conditions()
+
+  def parse(self, src, native_conditions):
+    p = self._CountingParser(native_conditions)
+    ast = p.parse(textwrap.dedent(src), "foo", None)
+    return pytd.Print(ast), p.calls
+
+  def test_skip_inactive(self):
+    src = """\
+      if sys.version_info == (1, 2, 3):
+        x = ...  # type: List[int]
+        if sys.platform == "linux":
+          y = ...  # type: int
+      elif sys.platform == "linux":
+        z = ...  # type: str
+      else:
+        def f(x: int) -> str: ...
+      """
+    expected, peer_calls = self.parse(src, False)
+    self.assertEquals("foo.z = ...  # type: str", expected)
+    self.assertEquals(2, peer_calls["if_begin"])
+    # int, List[int] and str, the repeated types being memoized.
+    self.assertEquals(3, peer_calls["new_type"])
+    actual, calls = self.parse(src, True)
+    self.assertEquals(expected, actual)
+    self.assertEquals({"new_type": 1, "new_constant": 1}, calls)
+
+  def test_class(self):
+    self.check("""\
+      class Foo:
+        if sys.version_info >= (3,):
+          def f(self) -> str: ...
+        else:
+          def f(self) -> int: ...
+      """, """\
+      class Foo:
+          def f(self) -> int: ...
+      """)
+
+  def test_inactive_syntax_error(self):
+    # Inactive clauses are skipped without being parsed.
+    self.check("""\
+      if sys.version_info >= (3,):
+        this is not valid
+        if foo.bar == 1:
+          def f(
+      x = ...  # type: int
+      """, "x = ...  # type: int")
+
+  def test_inactive_lex_error(self):
+    self.check_error("""\
+      if sys.version_info >= (3,):
+        x = ...  # type: int
+        $ y
+      """, 3, "Illegal character '$'")
+
+  def test_inactive_condition_error(self):
+    self.check_error("""\
+      if sys.version_info >= (2,):
+        x = ...  # type: int
+      elif sys.version_info >= "foo":
+        y = ...  # type: int
+      """, 3, "sys.version_info must be compared to a tuple")
+
+  def test_not_skipped_without_indent(self):
+    self.check_error("""\
+      if sys.version_info >= (3,): x = ...  # type: int
+      """, 1, "syntax error")
+
+  def test_bad_native_conditions(self):
+    p = parser._Parser(None, None)
+    p.native_conditions = lambda: ((2, 7), "linux")
+    self.assertRaises(TypeError, p.parse, "x = ...  # type: int", "foo", None)
+
+
 class VerifyPythonCodeTest(_ParserTestBase):
 
   def test_pythoncode(self):
@@ -1218,12 +1342,1067 @@ class EntireFileTest(_ParserTestBase):
     self.check(get_builtins_source(), expected=IGNORE)
 
 
+class ParseFileTest(unittest.TestCase):
+
+  def check_file(self, src, name="foo"):
+    """Check that parse_file() and parse_string() agree on src."""
+    with utils.Tempdir() as d:
+      filename = d.create_file("foo.pyi", src)
+      ast = parser.parse_file(filename, name=name)
+    expected = parser.parse_string(src, name=name, filename=filename)
+    self.assertEquals(expected.name, ast.name)
+    self.assertTrue(expected.ASTeq(ast))
+    return ast
+
+  def test_file(self):
+    ast = self.check_file(textwrap.dedent("""\
+      import typing
+      x = ...  # type: int
+      class Foo(object):
+        def bar(self, y: str) -> typing.List[int]: ...
+      """))
+    self.assertEquals("foo", ast.name)
+
+  def test_empty_file(self):
+    self.check_file("")
+
+  def test_page_sized_file(self):
+    # The end of buffer sentinels start exactly at a page boundary.
+    src = "x = ...  # type: int\n"
+    src += "#" * (4095 - len(src)) + "\n"
+    self.assertEquals(4096, len(src))
+    self.check_file(src)
+
+  def test_builtins(self):
+    self.check_file(get_builtins_source(), name="__builtin__")
+
+  def test_no_module_name(self):
+    src = "x = ...  # type: int"
+    ast = self.check_file(src, name=None)
+    self.assertEquals(hashlib.md5(src).hexdigest(), ast.name)
+
+  def test_error(self):
+    with utils.Tempdir() as d:
+      filename = d.create_file("foo.pyi", """\
+        class Foo:
+          this is not valid
+        """)
+      try:
+        parser.parse_file(filename)
+        self.fail("ParseError expected")
+      except parser.ParseError as e:
+        self.assertEquals(2, e.line)
+        self.assertIn('File: "%s"' % filename, str(e))
+        self.assertIn("  this is not valid", str(e))
+
+  def test_missing_file(self):
+    with utils.Tempdir() as d:
+      self.assertRaises(IOError, parser.parse_file, d["missing.pyi"])
+
+
+class _ChunkedReader(object):
+  """A file-like object whose read() returns at most chunk_size bytes."""
+
+  def __init__(self, src, chunk_size):
+    self._src = src
+    self._pos = 0
+    self._chunk_size = chunk_size
+
+  def read(self, size):
+    end = self._pos + min(size, self._chunk_size)
+    data = self._src[self._pos:end]
+    self._pos = end
+    return data
+
+
+class ParseStreamTest(unittest.TestCase):
+
+  def check_stream(self, src, name="foo"):
+    """Check that parse_stream() and parse_string() agree on src."""
+    expected = parser.parse_string(src, name=name)
+    streams = [cStringIO.StringIO(src), _ChunkedReader(src, 1),
+               _ChunkedReader(src, 7)]
+    for stream in streams:
+      ast = parser.parse_stream(stream, name=name)
+      self.assertTrue(expected.ASTeq(ast))
+    return ast
+
+  def test_stream(self):
+    ast = self.check_stream(textwrap.dedent("""\
+      import typing
+      x = ...  # type: int
+      class Foo(object):
+        \"\"\"A docstring
+        over two lines.\"\"\"
+        def bar(self, y: str) -> typing.List[int]: ...
+      """))
+    self.assertEquals("foo", ast.name)
+
+  def test_empty_stream(self):
+    self.check_stream("")
+
+  def test_builtins(self):
+    self.check_stream(get_builtins_source(), name="__builtin__")
+
+  def test_file_descriptor(self):
+    src = "def f(x: int = ..., y: float = 1.5) -> str: ...\n"
+    with utils.Tempdir() as d:
+      with open(d.create_file("foo.pyi", src)) as f:
+        ast = parser.parse_stream(f.fileno(), name="foo")
+    self.assertEquals("def foo.f(x: int = ..., y: float = ...) -> str: ...",
+                      pytd.Print(ast))
+
+  def test_error(self):
+    src = textwrap.dedent("""\
+      class Foo:
+        # A comment.
+        this is not valid
+      """)
+    try:
+      parser.parse_string(src)
+      self.fail("ParseError expected")
+    except parser.ParseError as e:
+      expected = (e.line, e.message)
+    for stream in (cStringIO.StringIO(src), _ChunkedReader(src, 1)):
+      try:
+        parser.parse_stream(stream, name="foo", filename="foo.pyi")
+        self.fail("ParseError expected")
+      except parser.ParseError as e:
+        self.assertEquals(expected, (e.line, e.message))
+        self.assertIn('File: "foo.pyi"', str(e))
+
+  def test_read_error(self):
+    class BrokenReader(object):
+
+      def read(self, unused_size):
+        raise IOError("broken")
+
+    self.assertRaisesRegexp(IOError, "broken", parser.parse_stream,
+                            BrokenReader(), name="foo")
+
+  def test_read_unicode(self):
+    self.assertRaises(TypeError, parser.parse_stream,
+                      _ChunkedReader(u"x = ...  # type: int", 5), name="foo")
+
+  def test_bad_file_descriptor(self):
+    r, w = os.pipe()
+    os.close(r)
+    os.close(w)
+    self.assertRaises(IOError, parser.parse_stream, r, name="foo")
+
+  def test_no_module_name(self):
+    self.assertRaises(ValueError, parser.parse_stream,
+                      cStringIO.StringIO(""), name=None)
+
+
+class ErrorTextTest(unittest.TestCase):
+  """Test the source text of the line an error is reported on."""
+
+  def check(self, src, expected_line, expected_text):
+    with utils.Tempdir() as d:
+      filename = d.create_file("foo.pyi", src)
+      for parse in (lambda: parser.parse_string(src, filename=filename),
+                    lambda: parser.parse_file(filename)):
+        try:
+          parse()
+          self.fail("ParseError expected")
+        except parser.ParseError as e:
+          self.assertEquals(expected_line, e.line)
+          self.assertIn("\n    %s\n" % expected_text, str(e))
+
+  def test_first_line(self):
+    self.check("x y\nz = ...  # type: int\n", 1, "x y")
+
+  def test_middle_line(self):
+    self.check("a = ...  # type: int\nx y\nz = ...  # type: int\n", 2, "x y")
+
+  def test_last_line_without_newline(self):
+    self.check("a = ...  # type: int\nx y", 2, "x y")
+
+  def test_crlf(self):
+    self.check("a = ...  # type: int\r\n", 1, "a = ...  # type: int")
+
+
+class _BadFlag(object):
+  """A flag whose truth value can't be determined."""
+
+  def __nonzero__(self):
+    raise ZeroDivisionError()
+
+
+class PretokenizeTest(unittest.TestCase):
+
+  def check_error(self, src):
+    """Check that pretokenizing does not change the error for src."""
+    errors = []
+    for pretokenize in (False, True):
+      try:
+        parser.parse_string(textwrap.dedent(src), pretokenize=pretokenize)
+        self.fail("ParseError expected")
+      except parser.ParseError as e:
+        errors.append(str(e))
+    self.assertMultiLineEqual(errors[0], errors[1])
+
+  def test_builtins(self):
+    src = get_builtins_source()
+    expected = parser.parse_string(src, name="__builtin__")
+    ast = parser.parse_string(src, name="__builtin__", pretokenize=True)
+    self.assertTrue(expected.ASTeq(ast))
+
+  def test_file(self):
+    with utils.Tempdir() as d:
+      filename = d.create_file("foo.pyi", """\
+        def f(x: int = ..., y: float = 1.5) -> str: ...
+        """)
+      ast = parser.parse_file(filename, name="foo", pretokenize=True)
+    self.assertEquals("def foo.f(x: int = ..., y: float = ...) -> str: ...",
+                      pytd.Print(ast))
+
+  def test_syntax_error(self):
+    self.check_error("""\
+      class Foo:
+        this is not valid""")
+
+  def test_lex_error(self):
+    self.check_error("x = ...  # type: int\n$ y % z\n")
+
+  def test_indentation_error(self):
+    self.check_error("""\
+      class Foo:
+          x = ...  # type: int
+        y = ...  # type: int
+      """)
+
+  def test_bad_flag(self):
+    self.assertRaises(ZeroDivisionError, parser_ext.parse, None, "",
+                      pretokenize=_BadFlag())
+    self.assertRaises(ZeroDivisionError, parser_ext.parse_file, None,
+                      "/dev/null", pretokenize=_BadFlag())
+
+
+class _ModuleFunctionParser(parser._Parser):
+  """A parser that uses parser_ext's functions rather than a Parser."""
+
+  def _native_parser(self):
+    return parser_ext
+
+
+class NativeParserTest(unittest.TestCase):
+  """Test that reusing a parser_ext.Parser is the same as not reusing one."""
+
+  def parse(self, parser_class, src):
+    try:
+      return parser_class(None, None).parse(textwrap.dedent(src), "foo", None)
+    except parser.ParseError as e:
+      return str(e)
+
+  def test_reuse(self):
+    sources = [
+        get_builtins_source(),
+        "",
+        """\
+          class Foo:
+              x = ...  # type: int
+            y = ...  # type: int
+          """,
+        """\
+          if sys.version_info == (1, 2, 3):
+            x = ...  # type: int
+          else:
+            def f(x: int, *args) -> str:
+              \"\"\"Docstring.\"\"\"
+          """,
+        "x = (",
+        "def f(x: int = ..., y: float = 1.5) -> str: ...",
+        "x = ...  # type: int\n$ y % z\n",
+        "class A(object):\n  x = ...  # type: int\n",
+    ]
+    for src in sources:
+      expected = self.parse(_ModuleFunctionParser, src)
+      actual = self.parse(parser._Parser, src)
+      if isinstance(expected, str):
+        self.assertMultiLineEqual(expected, actual)
+      else:
+        self.assertTrue(expected.ASTeq(actual))
+
+  def test_nested_parse(self):
+    nested = []
+    class NestingParser(parser._Parser):
+
+      def new_constant(self, name, value):
+        if not nested:
+          nested.append(None)
+          nested[0] = NestingParser(None, None).parse(
+              "y = ...  # type: str", "bar", None)
+        return super(NestingParser, self).new_constant(name, value)
+
+    ast = NestingParser(None, None).parse("x = ...  # type: int", "foo", None)
+    self.assertEquals("foo.x = ...  # type: int", pytd.Print(ast))
+    self.assertEquals("bar.y = ...  # type: str", pytd.Print(nested[0]))
+
+  def test_wrong_peer(self):
+    native = parser_ext.Parser(parser._Parser)
+    self.assertRaises(TypeError, native.parse, object(), "")
+    self.assertRaises(TypeError, native.parse,
+                      _ModuleFunctionParser(None, None), "")
+    self.assertRaises(TypeError, parser_ext.Parser, 42)
+
+  def test_bad_flag(self):
+    native = parser_ext.Parser(parser._Parser)
+    peer = parser._Parser(None, None)
+    self.assertRaises(ZeroDivisionError, native.parse, peer, "",
+                      pretokenize=_BadFlag())
+    self.assertRaises(ZeroDivisionError, native.parse_file, peer,
+                      "/dev/null", pretokenize=_BadFlag())
+
+
+class LexerStatsTest(unittest.TestCase):
+
+  def setUp(self):
+    metrics._prepare_for_test()
+    parser_ext.set_lexer_stats(True)
+    parser_ext.lexer_stats(True)
+
+  def tearDown(self):
+    parser_ext.set_lexer_stats(False)
+    metrics._prepare_for_test(enabled=False)
+
+  def test_record(self):
+    parser.parse_string("class A:\n  x = ...  # type: int\n")
+    parser.record_lexer_stats()
+    self.assertEquals(
+        "lexer_tokens: 10 {:=1, ==1, CLASS=1, DEDENT=1, ELLIPSIS=1, "
+        "INDENT=1, NAME=3, TYPECOMMENT=1}", str(parser._lexer_tokens))
+    self.assertEquals("lexer_state_bytes: 32 {INITIAL=30, NEWLINE=2}",
+                      str(parser._lexer_state_bytes))
+    self.assertEquals("lexer_values: 6 {allocations=3, values=3}",
+                      str(parser._lexer_values))
+    self.assertEquals({}, parser_ext.lexer_stats()["tokens"])
+
+
+class ParseStatsTest(unittest.TestCase):
+
+  def setUp(self):
+    metrics._prepare_for_test()
+    parser_ext.set_parse_stats(True)
+    parser_ext.parse_stats(True)
+
+  def tearDown(self):
+    parser_ext.set_parse_stats(False)
+    metrics._prepare_for_test(enabled=False)
+
+  def test_stats(self):
+    parser.parse_string("x = ...  # type: int\ndef f(x: int) -> str: ...\n")
+    stats = parser_ext.parse_stats()
+    self.assertTrue(stats["enabled"])
+    self.assertEquals(1, stats["reductions"]["funcdef"])
+    self.assertEquals(1, stats["reductions"]["constantdef"])
+    self.assertEquals(3, stats["reductions"]["type"])
+    # The second int is memoized.
+    self.assertEquals(
+        {"new_constant": 1, "new_function": 1, "new_type": 2},
+        stats["calls"])
+    self.assertEquals(set(stats["calls"]), set(stats["call_seconds"]))
+    self.assertTrue(all(s > 0 for s in stats["call_seconds"].values()))
+
+  def test_parse_ir(self):
+    # Reductions are counted without the GIL, calls when the IR is decoded.
+    parser.parse_ir(parser.parse_to_ir("x = ...  # type: int\n"), "foo")
+    stats = parser_ext.parse_stats()
+    self.assertEquals(1, stats["reductions"]["constantdef"])
+    self.assertEquals({"new_constant": 1, "new_type": 1}, stats["calls"])
+
+  def test_disabled(self):
+    parser_ext.set_parse_stats(False)
+    parser.parse_string("x = ...  # type: int\n")
+    stats = parser_ext.parse_stats()
+    self.assertFalse(stats["enabled"])
+    self.assertEquals({}, stats["reductions"])
+    self.assertEquals({}, stats["calls"])
+
+  def test_record(self):
+    parser.parse_string("class B:\n  y = ...  # type: str\n")
+    parser.record_parse_stats()
+    self.assertEquals(
+        "parse_peer_calls: 4 {add_class=1, new_constant=1, new_type=1, "
+        "register_class_name=1}", str(parser._parse_peer_calls))
+    self.assertIn("classdef=1", str(parser._parse_reductions))
+    self.assertIn("count=1", str(parser._parse_peer_seconds))
+    self.assertEquals({}, parser_ext.parse_stats()["calls"])
+
+
+class NativeNodesTest(unittest.TestCase):
+
+  class _CountingParser(parser._Parser):
+    """A parser that counts calls of the methods that build nodes."""
+
+    def __init__(self, *args, **kwargs):
+      super(NativeNodesTest._CountingParser, self).__init__(*args, **kwargs)
+      self.calls = collections.Counter()
+
+    def new_type(self, *args):
+      self.calls["new_type"] += 1
+      return super(NativeNodesTest._CountingParser, self).new_type(*args)
+
+    def new_union_type(self, *args):
+      self.calls["new_union_type"] += 1
+      return super(NativeNodesTest._CountingParser, self).new_union_type(*args)
+
+    def new_constant(self, *args):
+      self.calls["new_constant"] += 1
+      return super(NativeNodesTest._CountingParser, self).new_constant(*args)
+
+    def new_function(self, *args):
+      self.calls["new_function"] += 1
+      return super(NativeNodesTest._CountingParser, self).new_function(*args)
+
+  def parse(self, src, native_nodes=True):
+    p = self._CountingParser(None, None, native_nodes=native_nodes)
+    return p.parse(textwrap.dedent(src), "foo", None), p.calls
+
+  def check(self, src, expected_calls=None):
+    """Check that native nodes give the same AST, return the peer calls."""
+    expected, _ = self.parse(src, native_nodes=False)
+    ast, calls = self.parse(src)
+    self.assertTrue(expected.ASTeq(ast))
+    return calls
+
+  def test_builtins(self):
+    src = get_builtins_source()
+    expected = parser.parse_string(src, name="__builtin__")
+    ast = parser.parse_string(src, name="__builtin__", native_nodes=True)
+    self.assertTrue(expected.ASTeq(ast))
+
+  def test_native(self):
+    calls = self.check("""\
+      from typing import List
+      x = ...  # type: List[int]
+      y = 0
+      z = ...  # type: int or str or int
+      def f(a, b: int = 1, c: str = None, d=2.5) -> str or None: ...
+      def __init__(self): ...
+      def g() -> int raises ValueError: ...
+      """)
+    self.assertEquals({}, calls)
+
+  def test_delegated(self):
+    calls = self.check("""\
+      from typing import Tuple
+      x = ...  # type: Tuple[int, str]
+      y = ...  # type: Tuple[int, ...]
+      def f(x, *args, **kwargs) -> int: ...
+      def g(...) -> int: ...
+      @staticmethod
+      def h() -> int: ...
+      def k(x) -> int:
+        x := str
+      """)
+    self.assertEquals({"new_type": 2, "new_function": 4}, calls)
+
+  def test_alias(self):
+    self.check("""\
+      import typing
+      X = List[int]
+      Y = typing.Dict[X, X]
+      def f(x: X = None) -> Y: ...
+      """)
+
+  def test_errors(self):
+    for src in ["x = ...  # type: typing.Union", "x = 1",
+                "@foo\ndef f() -> int: ..."]:
+      with self.assertRaises(parser.ParseError):
+        self.parse(src)
+
+  def test_bad_node_class(self):
+    class Peer(parser._Parser):
+
+      def native_nodes(self):
+        info = super(Peer, self).native_nodes()
+        info["Constant"] = pytd.NamedType
+        return info
+
+    with self.assertRaises(TypeError):
+      Peer(None, None, native_nodes=True).parse("x = 0", "foo", None)
+
+
+class TypeMemoTest(unittest.TestCase):
+
+  class _CountingParser(NativeNodesTest._CountingParser):
+    """A parser that counts node calls, optionally memoizing types."""
+
+    def __init__(self, memoize_types, **kwargs):
+      super(TypeMemoTest._CountingParser, self).__init__(None, None, **kwargs)
+      self._memoize_types = memoize_types
+
+    def memoize_types(self):
+      return self._memoize_types
+
+  def parse(self, src, memoize_types=True, **kwargs):
+    p = self._CountingParser(memoize_types, **kwargs)
+    return p.parse(textwrap.dedent(src), "foo", None), p.calls
+
+  def check(self, src, **kwargs):
+    """Check that memoizing types gives the same AST, return it."""
+    expected, _ = self.parse(src, memoize_types=False, **kwargs)
+    ast, _ = self.parse(src, **kwargs)
+    self.assertTrue(expected.ASTeq(ast))
+    return ast
+
+  def test_calls(self):
+    _, calls = self.parse("""\
+      x = ...  # type: List[int]
+      y = ...  # type: List[int] or str
+      def f(a: int, b: List[int] or str) -> Callable[[int], str]: ...
+      def g() -> Callable[[int], str]: ...
+      """)
+    # int, List[int], str, the tuple of Callable's arguments and Callable.
+    self.assertEquals(5, calls["new_type"])
+    self.assertEquals(1, calls["new_union_type"])
+    _, calls = self.parse("x = ...  # type: int\ny = ...  # type: int\n",
+                          memoize_types=False)
+    self.assertEquals(2, calls["new_type"])
+
+  def test_shared(self):
+    ast = self.check("""\
+      x = ...  # type: Dict[str, List[int]]
+      y = ...  # type: Dict[str, List[int]]
+      """)
+    self.assertIs(ast.Lookup("foo.x").type, ast.Lookup("foo.y").type)
+
+  def test_type_map_changes(self):
+    ast = self.check("""\
+      a = ...  # type: X
+      b = ...  # type: Y
+      X = List[int]
+      from bar import Y
+      c = ...  # type: X
+      d = ...  # type: Y
+      """)
+    self.assertIsNot(ast.Lookup("foo.a").type, ast.Lookup("foo.c").type)
+    self.assertIsNot(ast.Lookup("foo.b").type, ast.Lookup("foo.d").type)
+
+  def test_builtins(self):
+    for native_nodes in (False, True):
+      self.check(get_builtins_source(), native_nodes=native_nodes)
+
+
+class ParseIrTest(unittest.TestCase):
+
+  def parse(self, src, **kwargs):
+    return parser.parse_ir(parser.parse_to_ir(src), src=src, **kwargs)
+
+  def check_error(self, src):
+    """Check that going through the IR does not change the error for src."""
+    src = textwrap.dedent(src)
+    errors = []
+    for parse in (parser.parse_string, self.parse):
+      try:
+        parse(src)
+        self.fail("ParseError expected")
+      except parser.ParseError as e:
+        errors.append(str(e))
+    self.assertMultiLineEqual(errors[0], errors[1])
+
+  def test_builtins(self):
+    src = get_builtins_source()
+    expected = parser.parse_string(src, name="__builtin__")
+    ast = self.parse(src, name="__builtin__")
+    self.assertTrue(expected.ASTeq(ast))
+
+  def test_native_nodes(self):
+    src = get_builtins_source()
+    expected = parser.parse_string(src, name="__builtin__")
+    ast = self.parse(src, name="__builtin__", native_nodes=True)
+    self.assertTrue(expected.ASTeq(ast))
+
+  def test_no_module_name(self):
+    src = "x = ...  # type: int\n"
+    self.assertEquals(parser.parse_string(src).name, self.parse(src).name)
+
+  def test_syntax_error(self):
+    self.check_error("""\
+      class Foo:
+        this is not valid""")
+
+  def test_lex_error(self):
+    self.check_error("x = ...  # type: int\n$ y % z\n")
+
+  def test_peer_error(self):
+    self.check_error("""\
+      x = ...  # type: int
+      class Foo(x=int): ...
+      """)
+
+  def test_deterministic(self):
+    src = get_builtins_source()
+    self.assertEquals(parser.parse_to_ir(src), parser.parse_to_ir(src))
+
+  def test_no_locations(self):
+    src = get_builtins_source()
+    ir = parser.parse_to_ir(src, locations=False)
+    self.assertLess(len(ir), len(parser.parse_to_ir(src)))
+    expected = parser.parse_string(src, name="__builtin__")
+    ast = parser.parse_ir(ir, name="__builtin__", src=src)
+    self.assertTrue(expected.ASTeq(ast))
+
+  def test_no_locations_errors(self):
+    syntax_error = "x = ...  # type: int\nclass Foo:\n  this is not valid\n"
+    peer_error = "x = ...  # type: int\nclass Foo(x=int): ...\n"
+    for src in (syntax_error, peer_error):
+      ir = parser.parse_to_ir(src, locations=False)
+      with self.assertRaises(parser.ParseError) as e:
+        parser.parse_ir(ir, src=src)
+      # Only syntax errors keep their location.
+      self.assertEquals(src is syntax_error, e.exception.line is not None)
+
+  def test_no_locations_later_definitions(self):
+    # The peer error ends the parse, although definitions follow it.
+    followed = "z = 1\nx = ...  # type: int\ndef f() -> int: ...\n"
+    followed_by_if = ("z = 1\nif sys.version_info > (3,):\n  x = 0\n"
+                      "else:\n  x = 0\n")
+    for src in (followed, followed_by_if):
+      with self.assertRaises(parser.ParseError) as expected:
+        parser.parse_string(src)
+      ir = parser.parse_to_ir(src, locations=False)
+      with self.assertRaises(parser.ParseError) as e:
+        parser.parse_ir(ir, src=src)
+      self.assertEquals(expected.exception.message, e.exception.message)
+
+  def test_threads(self):
+    src = get_builtins_source()
+    expected = parser.parse_to_ir(src)
+    results = [None] * 4
+    def run(i):
+      results[i] = parser.parse_to_ir(src)
+    threads = [threading.Thread(target=run, args=(i,))
+               for i in range(len(results))]
+    for t in threads:
+      t.start()
+    for t in threads:
+      t.join()
+    self.assertEquals([expected] * len(results), results)
+
+  def test_invalid(self):
+    ir = parser.parse_to_ir("def f(x: int) -> str: ...\n")
+    for bad in ("", "PYIR", ir[:-1], ir + "x"):
+      self.assertRaises(ValueError, parser.parse_ir, bad, name="foo")
+
+  def test_invalid_code(self):
+    # IR (see ir.cc) with no strings, whose code is a kIrResult of value 1,
+    # which is never produced, and no locations.
+    ir_result = 12
+    ir = (parser.parse_to_ir("")[:8] +
+          struct.pack("=5i", 0, 2, ir_result, 1, 0))
+    self.assertRaises(ValueError, parser.parse_ir, ir, name="foo")
+
+  def test_invalid_dup(self):
+    # As test_invalid_code, with a kIrDup of a value that is never produced.
+    ir_dup = 7
+    ir = (parser.parse_to_ir("")[:8] +
+          struct.pack("=5i", 0, 2, ir_dup, 99, 0))
+    self.assertRaises(ValueError, parser.parse_ir, ir, name="foo")
+
+
+class ParseManyTest(unittest.TestCase):
+
+  VERSIONED = textwrap.dedent("""\
+      if sys.version_info >= (3,):
+        x = ...  # type: int
+      else:
+        x = ...  # type: str
+      """)
+
+  def test_results(self):
+    builtins = get_builtins_source()
+    entries = [("__builtin__", builtins, None, None),
+               ("foo", self.VERSIONED, (2, 7, 6), None),
+               ("foo", self.VERSIONED, (3, 6, 0), None)]
+    for threads in (0, 1, 4):
+      results = parser.parse_many(entries, threads=threads)
+      self.assertEquals(len(entries), len(results))
+      for (name, src, version, platform), ast in zip(entries, results):
+        expected = parser.parse_string(src, name=name, python_version=version,
+                                       platform=platform)
+        self.assertTrue(expected.ASTeq(ast))
+
+  def test_errors(self):
+    bad_src = "x = ...  # type: int\nclass Foo:\n  this is not valid\n"
+    with utils.Tempdir() as d:
+      filename = d.create_file("foo.pyi", self.VERSIONED)
+      missing = os.path.join(d.path, "missing.pyi")
+      results = parser.parse_many([
+          ("foo", parser.SourceFile(filename), None, None),
+          ("bar", parser.SourceFile(missing), None, None),
+          ("baz", bad_src, None, None),
+          ("qux", "y = ...  # type: int\n", None, None)])
+    self.assertEquals("foo", results[0].name)
+    self.assertIsInstance(results[1], IOError)
+    self.assertEquals(missing, results[1].filename)
+    self.assertIsInstance(results[2], parser.ParseError)
+    with self.assertRaises(parser.ParseError) as e:
+      parser.parse_string(bad_src, name="baz")
+    self.assertMultiLineEqual(str(e.exception), str(results[2]))
+    self.assertEquals("qux", results[3].name)
+
+  def test_peer_error(self):
+    src = "x = ...  # type: int\ny = 1\n"
+    with utils.Tempdir() as d:
+      filename = d.create_file("foo.pyi", src)
+      results = parser.parse_many([
+          ("foo", src, None, None),
+          ("foo", parser.SourceFile(filename), None, None)])
+      with self.assertRaises(parser.ParseError) as e:
+        parser.parse_file(filename, name="foo")
+    self.assertEquals(2, e.exception.line)
+    self.assertMultiLineEqual(str(e.exception), str(results[1]))
+    with self.assertRaises(parser.ParseError) as e:
+      parser.parse_string(src, name="foo")
+    self.assertMultiLineEqual(str(e.exception), str(results[0]))
+
+  def test_peer_error_before_syntax_error(self):
+    src = "T = TypeVar('U')\nfrom . import x\n"
+    result, = parser.parse_many([("foo", src, None, None)])
+    with self.assertRaises(parser.ParseError) as e:
+      parser.parse_string(src, name="foo")
+    self.assertEquals(1, e.exception.line)
+    self.assertMultiLineEqual(str(e.exception), str(result))
+
+  def test_peer_error_before_condition(self):
+    src = "z = 1\nif sys.version_info > (3,):\n  x = 0\nelse:\n  x = 0\n"
+    result, = parser.parse_many([("foo", src, None, None)])
+    with self.assertRaises(parser.ParseError) as e:
+      parser.parse_string(src, name="foo")
+    self.assertMultiLineEqual(str(e.exception), str(result))
+
+  def test_file_error_text(self):
+    with utils.Tempdir() as d:
+      filename = d.create_file("foo.pyi", "x = ...  # type: int\n$ y\n")
+      result, = parser.parse_many(
+          [("foo", parser.SourceFile(filename), None, None)])
+      with self.assertRaises(parser.ParseError) as e:
+        parser.parse_file(filename, name="foo")
+    self.assertMultiLineEqual(str(e.exception), str(result))
+
+  def test_empty(self):
+    self.assertEquals([], parser.parse_many([]))
+
+  def test_callback_error(self):
+    calls = []
+    def callback(index, ir, error):
+      calls.append(index)
+      raise ValueError("stop")
+    inputs = ["x = ...  # type: int\n"] * 100
+    self.assertRaises(ValueError, parser_ext.parse_ir_many, inputs, callback,
+                      threads=2)
+    self.assertEquals([0], calls)
+
+  def test_bad_inputs(self):
+    callback = lambda index, ir, error: None
+    for inputs in ([1], [("a", "b")], [(1,)], None):
+      self.assertRaises(TypeError, parser_ext.parse_ir_many, inputs, callback)
+
+
+class ScanDependenciesTest(unittest.TestCase):
+
+  def scan(self, src, **kwargs):
+    result, = parser.scan_dependencies([textwrap.dedent(src)], **kwargs)
+    return result
+
+  def test_imports_and_names(self):
+    result = self.scan("""
+        import a.b, c as d
+        from e import f, g as h
+        from typing import List
+        x = ...  # type: int
+        T = TypeVar("T")
+        Alias = List[int]
+        @overload
+        def foo(x: int) -> int: ...
+        class Bar(object):
+          y = ...  # type: int
+          def baz(self) -> None: ...
+        """)
+    self.assertEquals(("a.b", "c", "e", "typing"), result.dependencies)
+    self.assertEquals(("f", "h", "x", "T", "Alias", "foo", "Bar"),
+                      result.names)
+
+  def test_dotted_names(self):
+    result = self.scan("""
+        def foo(x: a.b.C, y: d.E = ...) -> f.G raises h.Error: ...
+        class Foo(i.J):
+          x = ...  # type: k.L
+        """)
+    self.assertEquals(("a.b", "d", "f", "h", "i", "k"), result.dependencies)
+
+  def test_conditions(self):
+    src = """
+        if sys.version_info >= (3,):
+          import a
+          x = ...  # type: int
+        elif sys.platform == "win32":
+          import b
+          y = ...  # type: int
+        else:
+          import c
+          z = ...  # type: c.D
+        """
+    self.assertEquals(("a",), self.scan(src, python_version=(3, 6)
+                                       ).dependencies)
+    self.assertEquals(("b",), self.scan(src, platform="win32").dependencies)
+    result = self.scan(src)
+    self.assertEquals(("c",), result.dependencies)
+    self.assertEquals(("z",), result.names)
+
+  def test_unknown_condition(self):
+    # The peer rejects the condition, so the clause is assumed to be active.
+    result = self.scan("""
+        if foo.bar:
+          x = ...  # type: int
+        else:
+          y = ...  # type: int
+        """)
+    self.assertEquals((), result.dependencies)
+    self.assertEquals(("x", "y"), result.names)
+
+  def test_files(self):
+    with utils.Tempdir() as d:
+      filename = d.create_file("foo.pyi", "import bar\nx = ...  # type: int\n")
+      missing = os.path.join(d.path, "missing.pyi")
+      for threads in (0, 1, 4):
+        results = parser.scan_dependencies(
+            [parser.SourceFile(filename), parser.SourceFile(missing), ""],
+            threads=threads)
+        self.assertEquals(parser.HeaderScan(("bar",), ("x",)), results[0])
+        self.assertIsInstance(results[1], IOError)
+        self.assertEquals(missing, results[1].filename)
+        self.assertEquals(parser.HeaderScan((), ()), results[2])
+
+  def test_builtins(self):
+    src = get_builtins_source()
+    for version in ((2, 7, 6), (3, 6, 0)):
+      result = self.scan(src, python_version=version)
+      ast = parser.parse_string(src, name="__builtin__", python_version=version)
+      prefix = "__builtin__."
+      names = set(x.name[len(prefix):] if x.name.startswith(prefix) else x.name
+                  for x in ast.constants + ast.functions + ast.classes +
+                  ast.aliases + ast.type_params)
+      self.assertEquals(names, set(result.names))
+      collect = visitors.CollectDependencies()
+      ast.Visit(collect)
+      self.assertLessEqual(collect.modules - {"__builtin__"},
+                           set(result.dependencies))
+
+
+class CheckTest(unittest.TestCase):
+
+  def check(self, src, expected):
+    """Check the (line, message) of the errors that check_string() finds."""
+    errors = parser.check_string(textwrap.dedent(src))
+    self.assertEquals(expected, [(e.line, e.message) for e in errors])
+
+  def test_valid(self):
+    self.assertEquals([], parser.check_string(get_builtins_source()))
+
+  def test_same_error(self):
+    src = textwrap.dedent("""\
+      x = ...  # type: int
+      class Foo:
+        this is not valid
+      y = ...  # type: int int
+      """)
+    with self.assertRaises(parser.ParseError) as e:
+      parser.parse_string(src, filename="foo.pyi")
+    errors = parser.check_string(src, filename="foo.pyi")
+    self.assertMultiLineEqual(str(e.exception), str(errors[0]))
+    self.assertEquals(2, len(errors))
+
+  def test_expected_tokens(self):
+    # The error rules are only in the recovering parser, so they don't cut
+    # the tokens that the messages of a normal parse list as expected.
+    with self.assertRaises(parser.ParseError) as e:
+      parser.parse_string("def ext() PYTHONCODE\n")
+    self.assertEquals(
+        "syntax error, unexpected PYTHONCODE, expecting DEF or '@'",
+        e.exception.message)
+    self.assertEquals(1, len(parser.check_string("def ext() PYTHONCODE\n")))
+
+  def test_statements(self):
+    self.check("""\
+      a = ...  # type: int
+      b = = 3
+      def f(x: int) -> ): ...
+      c = ...  # type: str
+      import
+      d = ...  # type: str
+      """, [(2, "syntax error, unexpected '='"),
+            (3, "syntax error, unexpected ')'"),
+            (6, "syntax error, unexpected '='")])
+
+  def test_class_body(self):
+    self.check("""\
+      class Foo:
+        this is not valid
+        def f(self) -> int: ...
+        also bad )
+        x = ...  # type: int
+      def g() -> str: ...
+      """, [(2, "syntax error, unexpected NAME, expecting ':' or '='"),
+            (4, "syntax error, unexpected NAME, expecting ':' or '='")])
+
+  def test_function_body(self):
+    self.check("""\
+      def f(x) -> int:
+        raise )
+        x := int
+        raise ValueError
+      def g() -> int: ...
+      """, [(2, "syntax error, unexpected ')', expecting NAME")])
+
+  def test_peer_errors(self):
+    self.check("""\
+      class Foo(x=int):
+        def f(self) -> int: ...
+      x = 1
+      def f(x: int) -> int:
+        y := int
+      z = ...  # type: int
+      """, [(1, "Only 'metaclass' allowed as classdef kwarg"),
+            (3, "Only '0' allowed as int literal"),
+            (4, "No parameter named y")])
+
+  def test_lexer_error(self):
+    self.check("""\
+      x = ...  # type: $
+      y = ...  # type: int
+      z = ...  # type: %
+      """, [(1, "Illegal character '$'"), (3, "Illegal character '%'")])
+
+  def test_blocks(self):
+    # A block that isn't expected is skipped as a whole, and so are the
+    # clauses of an "if" whose condition fails.
+    self.check("""\
+      x = ...  # type: int
+        y = ...  # type: int
+        class Foo:
+          z z
+      if sys.version_info >= "foo":
+        a a
+      elif sys.version_info >= (3,):
+        b b
+      else:
+        c c
+      d = ...  # type: int
+      """, [(2, "syntax error, unexpected INDENT"),
+            (5, "sys.version_info must be compared to a tuple")])
+
+  def test_brackets(self):
+    # An error ends at the end of its statement, which may span lines, but
+    # an unmatched bracket doesn't affect the statements that follow.
+    self.check("""\
+      def f(x: int,
+            y: str) -> ): ...
+      def g(x: ],
+            y: int) -> int: ...
+      class Foo:
+        def f(self) -> int: ...
+      x x
+      """, [(2, "syntax error, unexpected ')'"),
+            (3, "syntax error, unexpected ']'"),
+            (7, "syntax error, unexpected NAME, expecting ':' or '='")])
+
+  def test_inactive(self):
+    self.check("""\
+      if sys.version_info >= (3,):
+        x x
+      """, [(2, "syntax error, unexpected NAME, expecting ':' or '='")])
+
+  def test_conditions_ended(self):
+    p = parser._Parser(None, None)
+    errors = p.check(textwrap.dedent("""\
+      if sys.version_info >= (3,):
+        x = ...  # type: int
+      elif sys.version_info >= "foo":
+        y = ...  # type: int
+      if sys.version_info >= (3,):
+        class Foo:
+          def f(self) -> int: ...
+      """), "foo", None)
+    self.assertEquals(1, len(errors))
+    self.assertIsNone(p._current_condition.parent)
+
+  def test_after_parse(self):
+    self.check("""\
+      x = ...  # type: int
+      x = ...  # type: str
+      y y
+      """, [(3, "syntax error, unexpected NAME, expecting ':' or '='"),
+            (None, "Duplicate top-level identifier(s): x")])
+
+  def test_file(self):
+    src = "x = ...  # type: int\ny y\n"
+    with utils.Tempdir() as d:
+      filename = d.create_file("foo.pyi", src)
+      errors = parser.check_file(filename)
+      self.assertEquals(
+          [str(e) for e in parser.check_string(src, filename=filename)],
+          [str(e) for e in errors])
+    self.assertEquals("y y", errors[0]._text)
+
+  def test_other_exception(self):
+    class Peer(parser._Parser):
+      def new_constant(self, name, value):
+        raise ValueError(name)
+    with self.assertRaises(ValueError):
+      Peer(None, None).check("x y\nz = ...  # type: int\n", "foo", None)
+
+  def test_bad_errors(self):
+    peer = parser._Parser(None, None)
+    self.assertRaises(TypeError, parser_ext.parse, peer, "", errors=())
+
+
+class CallBenchmarkTest(unittest.TestCase):
+
+  def test_run(self):
+    rates = call_benchmark.run(10)
+    self.assertIn("new_function", rates)
+    self.assertIn("if_else", rates)
+    self.assertEquals(16, len(rates))
+    for rate in rates.values():
+      self.assertGreater(rate, 0)
+
+  def test_error(self):
+    class Peer(call_benchmark._NullPeer):
+
+      def if_end(self, clauses):
+        raise ValueError()
+
+    with self.assertRaises(ValueError):
+      parser_ext.time_calls(Peer(), 10)
+
+  def test_reused_arguments(self):
+    # A method that keeps its arguments must get a fresh tuple for the next
+    # call, which must not disturb the kept one.
+    kept = []
+
+    class Peer(call_benchmark._NullPeer):
+
+      def add_import(self, *args):
+        kept.append(args)
+
+    parser_ext.time_calls(Peer(), 3)
+    self.assertEquals([(None, None)] * 3, kept)
+
+
+def _parse_via_ir(src, **kwargs):
+  return parser.parse_ir(parser.parse_to_ir(src), src=src, **kwargs)
+
+
 class MemoryLeakTest(unittest.TestCase):
 
-  def check(self, src):
+  def check(self, src, parse_function=parser.parse_string, **kwargs):
     def parse():
       try:
-        parser.parse_string(src)
+        parse_function(src, **kwargs)
       except parser.ParseError:
         # It is essential to clear the error, otherwise the system exc_info
         # will hold references to lots of stuff hanging off the exception.
@@ -1262,6 +2441,18 @@ class MemoryLeakTest(unittest.TestCase):
     # This has a little of everything.
     self.check(get_builtins_source())
 
+  def test_builtins_native_nodes(self):
+    self.check(get_builtins_source(), native_nodes=True)
+
+  def test_builtins_ir(self):
+    self.check(get_builtins_source(), _parse_via_ir)
+
+  def test_error_in_class_ir(self):
+    self.check("""\
+      class Foo:
+        def m(): pass
+        an error""", _parse_via_ir)
+
   def test_error_in_class(self):
     self.check("""\
       class Foo:
@@ -1281,6 +2472,18 @@ class MemoryLeakTest(unittest.TestCase):
         this is an error
       """)
 
+  def test_recovery(self):
+    self.check("""\
+      class Foo:
+        def m(): pass
+        an error
+      if sys.version_info == (1, 2, 3):
+        x = ...  # type: $
+      elif sys.version_info == "foo":
+        y = ...  # type: int
+      def n(x: int, y: str) -> ->
+      """, parser.check_string)
+
 
 if __name__ == "__main__":
   unittest.main()
@@ -0,0 +1,3279 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 1
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+/* Substitute the variable and function names.  */
+#define yyparse         pytyperecoverparse
+#define yylex           pytyperecoverlex
+#define yyerror         pytyperecovererror
+#define yydebug         pytyperecoverdebug
+#define yynerrs         pytyperecovernerrs
+
+/* First part of user prologue.  */
+#line 56 "pyi/parser.y"
+
+#include "lexer.h"
+#include "parser.h"
+
+namespace pytype {
+// Note that the pytype namespace is not closed until the trailing block of
+// code after the parser skeleton is emitted.  Thus the entire parser (except
+// for a few #defines) is in the pytype namespace.
+
+// yyerror is renamed with the prefix of the parser, like yyparse.
+namespace {
+int yyerror(YYLTYPE* llocp, Lexer* lexer, pytype::Context* ctx,
+    const char *p);
+}  // end namespace
+
+
+// Check that a value is not NULL, see Context::Check().  This must be a
+// macro because it calls YYERROR (which is a goto).
+#define CHECK(x, loc) do { if (!ctx->Check(x, &loc, lexer)) {\
+    YYERROR; \
+  }} while(0)
+
+// Continue after an error if the Context recovers from it, otherwise abort
+// the parse, releasing the list of the rule's other symbol (which the parser
+// leaves to the action).  See Context::Recover().
+#define RECOVER(list) do { if (!ctx->Recover()) {\
+    ctx->DropList(list); \
+    YYABORT; \
+  }} while(0)
+
+// The default location of a rule's value, as bison computes it, which also
+// counts the reduction of the rule (yyn) by its nonterminal for
+// Context::collect_stats().  The parser computes the location of every
+// reduction into yyloc, and only that of the error token elsewhere.
+#define YYLLOC_DEFAULT(Current, Rhs, N) do { \
+    if (N) { \
+      (Current).first_line = YYRHSLOC(Rhs, 1).first_line; \
+      (Current).first_column = YYRHSLOC(Rhs, 1).first_column; \
+      (Current).last_line = YYRHSLOC(Rhs, N).last_line; \
+      (Current).last_column = YYRHSLOC(Rhs, N).last_column; \
+    } else { \
+      (Current).first_line = (Current).last_line = \
+          YYRHSLOC(Rhs, 0).last_line; \
+      (Current).first_column = (Current).last_column = \
+          YYRHSLOC(Rhs, 0).last_column; \
+    } \
+    if (&(Current) == &yyloc) { \
+      ctx->CountReduction(yytname[yyr1[yyn]]); \
+    } \
+  } while (0)
+
+
+#line 129 "pyi/recovering_parser.tab.cc"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "parser.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_NAME = 3,                       /* NAME  */
+  YYSYMBOL_NUMBER = 4,                     /* NUMBER  */
+  YYSYMBOL_LEXERROR = 5,                   /* LEXERROR  */
+  YYSYMBOL_CLASS = 6,                      /* CLASS  */
+  YYSYMBOL_DEF = 7,                        /* DEF  */
+  YYSYMBOL_ELSE = 8,                       /* ELSE  */
+  YYSYMBOL_ELIF = 9,                       /* ELIF  */
+  YYSYMBOL_IF = 10,                        /* IF  */
+  YYSYMBOL_OR = 11,                        /* OR  */
+  YYSYMBOL_PASS = 12,                      /* PASS  */
+  YYSYMBOL_IMPORT = 13,                    /* IMPORT  */
+  YYSYMBOL_FROM = 14,                      /* FROM  */
+  YYSYMBOL_AS = 15,                        /* AS  */
+  YYSYMBOL_RAISE = 16,                     /* RAISE  */
+  YYSYMBOL_PYTHONCODE = 17,                /* PYTHONCODE  */
+  YYSYMBOL_NOTHING = 18,                   /* NOTHING  */
+  YYSYMBOL_RAISES = 19,                    /* RAISES  */
+  YYSYMBOL_NAMEDTUPLE = 20,                /* NAMEDTUPLE  */
+  YYSYMBOL_TYPEVAR = 21,                   /* TYPEVAR  */
+  YYSYMBOL_ARROW = 22,                     /* ARROW  */
+  YYSYMBOL_COLONEQUALS = 23,               /* COLONEQUALS  */
+  YYSYMBOL_ELLIPSIS = 24,                  /* ELLIPSIS  */
+  YYSYMBOL_EQ = 25,                        /* EQ  */
+  YYSYMBOL_NE = 26,                        /* NE  */
+  YYSYMBOL_LE = 27,                        /* LE  */
+  YYSYMBOL_GE = 28,                        /* GE  */
+  YYSYMBOL_INDENT = 29,                    /* INDENT  */
+  YYSYMBOL_DEDENT = 30,                    /* DEDENT  */
+  YYSYMBOL_TRIPLEQUOTED = 31,              /* TRIPLEQUOTED  */
+  YYSYMBOL_TYPECOMMENT = 32,               /* TYPECOMMENT  */
+  YYSYMBOL_33_ = 33,                       /* ':'  */
+  YYSYMBOL_34_ = 34,                       /* '('  */
+  YYSYMBOL_35_ = 35,                       /* ')'  */
+  YYSYMBOL_36_ = 36,                       /* ','  */
+  YYSYMBOL_37_ = 37,                       /* '='  */
+  YYSYMBOL_38_ = 38,                       /* '<'  */
+  YYSYMBOL_39_ = 39,                       /* '>'  */
+  YYSYMBOL_40_ = 40,                       /* '*'  */
+  YYSYMBOL_41_ = 41,                       /* '@'  */
+  YYSYMBOL_42_ = 42,                       /* '['  */
+  YYSYMBOL_43_ = 43,                       /* ']'  */
+  YYSYMBOL_44_ = 44,                       /* '?'  */
+  YYSYMBOL_45_ = 45,                       /* '.'  */
+  YYSYMBOL_YYACCEPT = 46,                  /* $accept  */
+  YYSYMBOL_start = 47,                     /* start  */
+  YYSYMBOL_unit = 48,                      /* unit  */
+  YYSYMBOL_alldefs = 49,                   /* alldefs  */
+  YYSYMBOL_classdef = 50,                  /* classdef  */
+  YYSYMBOL_class_name = 51,                /* class_name  */
+  YYSYMBOL_parents = 52,                   /* parents  */
+  YYSYMBOL_parent_list = 53,               /* parent_list  */
+  YYSYMBOL_parent = 54,                    /* parent  */
+  YYSYMBOL_maybe_class_funcs = 55,         /* maybe_class_funcs  */
+  YYSYMBOL_class_funcs = 56,               /* class_funcs  */
+  YYSYMBOL_funcdefs = 57,                  /* funcdefs  */
+  YYSYMBOL_if_stmt = 58,                   /* if_stmt  */
+  YYSYMBOL_if_and_elifs = 59,              /* if_and_elifs  */
+  YYSYMBOL_class_if_stmt = 60,             /* class_if_stmt  */
+  YYSYMBOL_class_if_and_elifs = 61,        /* class_if_and_elifs  */
+  YYSYMBOL_if_cond = 62,                   /* if_cond  */
+  YYSYMBOL_elif_cond = 63,                 /* elif_cond  */
+  YYSYMBOL_else_cond = 64,                 /* else_cond  */
+  YYSYMBOL_condition = 65,                 /* condition  */
+  YYSYMBOL_version_tuple = 66,             /* version_tuple  */
+  YYSYMBOL_condition_op = 67,              /* condition_op  */
+  YYSYMBOL_constantdef = 68,               /* constantdef  */
+  YYSYMBOL_importdef = 69,                 /* importdef  */
+  YYSYMBOL_import_items = 70,              /* import_items  */
+  YYSYMBOL_import_item = 71,               /* import_item  */
+  YYSYMBOL_from_list = 72,                 /* from_list  */
+  YYSYMBOL_from_items = 73,                /* from_items  */
+  YYSYMBOL_from_item = 74,                 /* from_item  */
+  YYSYMBOL_alias_or_constant = 75,         /* alias_or_constant  */
+  YYSYMBOL_typevardef = 76,                /* typevardef  */
+  YYSYMBOL_funcdef = 77,                   /* funcdef  */
+  YYSYMBOL_decorators = 78,                /* decorators  */
+  YYSYMBOL_decorator = 79,                 /* decorator  */
+  YYSYMBOL_params = 80,                    /* params  */
+  YYSYMBOL_param_list = 81,                /* param_list  */
+  YYSYMBOL_param = 82,                     /* param  */
+  YYSYMBOL_param_type = 83,                /* param_type  */
+  YYSYMBOL_param_default = 84,             /* param_default  */
+  YYSYMBOL_param_star_name = 85,           /* param_star_name  */
+  YYSYMBOL_return = 86,                    /* return  */
+  YYSYMBOL_raises = 87,                    /* raises  */
+  YYSYMBOL_exceptions = 88,                /* exceptions  */
+  YYSYMBOL_maybe_body = 89,                /* maybe_body  */
+  YYSYMBOL_empty_body = 90,                /* empty_body  */
+  YYSYMBOL_body = 91,                      /* body  */
+  YYSYMBOL_body_stmt = 92,                 /* body_stmt  */
+  YYSYMBOL_type_parameters = 93,           /* type_parameters  */
+  YYSYMBOL_type_parameter = 94,            /* type_parameter  */
+  YYSYMBOL_type = 95,                      /* type  */
+  YYSYMBOL_named_tuple_fields = 96,        /* named_tuple_fields  */
+  YYSYMBOL_named_tuple_field_list = 97,    /* named_tuple_field_list  */
+  YYSYMBOL_named_tuple_field = 98,         /* named_tuple_field  */
+  YYSYMBOL_maybe_comma = 99,               /* maybe_comma  */
+  YYSYMBOL_maybe_type_list = 100,          /* maybe_type_list  */
+  YYSYMBOL_type_list = 101,                /* type_list  */
+  YYSYMBOL_dotted_name = 102,              /* dotted_name  */
+  YYSYMBOL_pass_or_ellipsis = 103          /* pass_or_ellipsis  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* 1 */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL \
+             && defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+  YYLTYPE yyls_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
+      + 2 * YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  6
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   310
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  46
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  58
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  144
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  257
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   287
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+      34,    35,    40,     2,    36,     2,    45,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,    33,     2,
+      38,    37,    39,    44,    41,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,    42,     2,    43,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,   204,   204,   205,   209,   213,   214,   215,   216,   217,
+     218,   219,   224,   225,   229,   236,   246,   247,   248,   252,
+     253,   257,   258,   262,   263,   264,   268,   269,   273,   274,
+     275,   280,   281,   286,   289,   294,   298,   317,   320,   325,
+     329,   341,   345,   349,   353,   357,   364,   365,   366,   372,
+     373,   374,   375,   376,   377,   381,   385,   389,   393,   397,
+     404,   408,   415,   416,   419,   420,   426,   427,   428,   432,
+     433,   437,   438,   439,   440,   441,   447,   454,   461,   478,
+     489,   490,   494,   499,   500,   504,   505,   509,   512,   513,
+     514,   518,   519,   523,   524,   525,   526,   530,   531,   535,
+     536,   540,   541,   545,   546,   550,   551,   555,   556,   557,
+     558,   562,   563,   564,   565,   569,   570,   571,   575,   576,
+     580,   581,   585,   589,   593,   603,   607,   608,   609,   610,
+     614,   615,   619,   622,   626,   632,   633,   637,   638,   642,
+     643,   648,   649,   653,   654
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "NAME", "NUMBER",
+  "LEXERROR", "CLASS", "DEF", "ELSE", "ELIF", "IF", "OR", "PASS", "IMPORT",
+  "FROM", "AS", "RAISE", "PYTHONCODE", "NOTHING", "RAISES", "NAMEDTUPLE",
+  "TYPEVAR", "ARROW", "COLONEQUALS", "ELLIPSIS", "EQ", "NE", "LE", "GE",
+  "INDENT", "DEDENT", "TRIPLEQUOTED", "TYPECOMMENT", "':'", "'('", "')'",
+  "','", "'='", "'<'", "'>'", "'*'", "'@'", "'['", "']'", "'?'", "'.'",
+  "$accept", "start", "unit", "alldefs", "classdef", "class_name",
+  "parents", "parent_list", "parent", "maybe_class_funcs", "class_funcs",
+  "funcdefs", "if_stmt", "if_and_elifs", "class_if_stmt",
+  "class_if_and_elifs", "if_cond", "elif_cond", "else_cond", "condition",
+  "version_tuple", "condition_op", "constantdef", "importdef",
+  "import_items", "import_item", "from_list", "from_items", "from_item",
+  "alias_or_constant", "typevardef", "funcdef", "decorators", "decorator",
+  "params", "param_list", "param", "param_type", "param_default",
+  "param_star_name", "return", "raises", "exceptions", "maybe_body",
+  "empty_body", "body", "body_stmt", "type_parameters", "type_parameter",
+  "type", "named_tuple_fields", "named_tuple_field_list",
+  "named_tuple_field", "maybe_comma", "maybe_type_list", "type_list",
+  "dotted_name", "pass_or_ellipsis", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-156)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-82)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+     -16,  -156,    52,    57,    23,    91,  -156,  -156,  -156,   117,
+      80,   134,   134,   134,  -156,  -156,   209,   107,  -156,  -156,
+    -156,  -156,  -156,     7,  -156,    87,    64,  -156,   109,  -156,
+    -156,   214,   112,  -156,    54,    -1,  -156,   134,   122,   125,
+     135,   163,   134,  -156,  -156,   141,    87,    87,  -156,     5,
+      74,  -156,   145,   153,   182,    83,   173,  -156,  -156,  -156,
+    -156,  -156,  -156,   205,    16,   134,   207,    25,  -156,   184,
+     193,  -156,    94,   181,   226,    20,   182,   190,   201,    87,
+     219,    29,     1,    87,   217,  -156,   210,  -156,   182,   199,
+    -156,  -156,   251,  -156,  -156,  -156,   241,  -156,  -156,   194,
+    -156,  -156,   221,  -156,  -156,  -156,   132,  -156,     1,   222,
+    -156,  -156,    87,  -156,  -156,  -156,    61,  -156,   182,   227,
+    -156,     3,   228,   225,  -156,   227,   182,    87,  -156,    92,
+    -156,  -156,   160,  -156,  -156,   229,   259,   212,   194,   146,
+     164,  -156,   231,   230,   182,    29,  -156,    87,   232,  -156,
+     261,  -156,     1,  -156,   182,  -156,   120,   237,    10,  -156,
+      31,  -156,  -156,   148,  -156,  -156,  -156,   246,    81,   235,
+    -156,   182,    89,  -156,  -156,  -156,   243,  -156,  -156,   124,
+    -156,   209,   238,  -156,  -156,   215,  -156,  -156,    87,   255,
+     272,  -156,   240,  -156,  -156,  -156,  -156,  -156,  -156,    14,
+     244,   245,   250,  -156,   276,   182,    87,   248,   247,   252,
+     239,   256,   258,  -156,   249,   253,   182,   220,  -156,  -156,
+      87,  -156,  -156,  -156,  -156,   179,  -156,    87,   200,  -156,
+      78,   189,   197,  -156,   182,  -156,   265,   287,   262,    93,
+    -156,   263,  -156,   260,  -156,  -156,    87,   257,  -156,  -156,
+    -156,  -156,  -156,  -156,   182,   264,  -156
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_uint8 yydefact[] =
+{
+      13,    13,     0,     0,     0,     0,     1,     2,    12,     0,
+       0,     0,     0,     0,     9,    11,    34,     0,     5,     7,
+       8,    10,     6,     0,     3,     0,     0,    15,    18,   141,
+      41,     0,    60,    63,    64,     0,    43,     0,     0,     0,
+       0,     0,     0,    80,   129,     0,     0,   138,   128,    58,
+     122,    55,     0,    56,    76,     0,     0,    53,    54,    51,
+      52,    49,    50,     0,     0,     0,     0,     0,    42,     0,
+       0,    13,     0,    82,     0,     0,   140,     0,   137,     0,
+       0,     0,    84,     0,   141,    17,     0,    20,    21,     0,
+     142,    44,     0,    45,    62,    65,    71,    72,    73,     0,
+      74,    61,    66,    70,    13,    13,     0,    79,    84,     0,
+     126,   124,     0,   127,    59,   121,     0,   119,   120,    92,
+      90,    88,     0,    83,    86,    92,    57,     0,    16,     0,
+     143,   144,    32,    14,    23,     0,     0,     0,     0,     0,
+       0,    35,     0,     0,   139,     0,   123,     0,    96,    97,
+       0,    77,     0,    89,    22,    19,    32,     0,     0,    26,
+       0,    75,    67,     0,    69,    36,    33,   100,     0,     0,
+     118,    91,     0,    87,    98,    85,     0,    24,    31,     0,
+      30,    38,     0,    28,    29,     0,    46,    68,     0,   102,
+       0,   131,   136,   133,   125,    93,    94,    95,    25,     0,
+       0,     0,     0,    47,     0,    99,     0,   110,     0,   135,
+       0,     0,     0,    32,     0,   101,   104,     0,    78,   106,
+       0,   132,   130,    32,    32,     0,    48,     0,     0,   107,
+     136,     0,     0,    39,   103,   114,     0,     0,     0,     0,
+     112,     0,   135,     0,    40,    37,     0,   116,   109,   113,
+     105,   111,   108,   134,   115,     0,   117
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+    -156,  -156,   293,   -44,  -156,  -156,  -156,  -156,   167,  -156,
+     142,    12,  -156,  -156,  -156,  -156,  -155,   116,   119,   266,
+    -156,  -156,  -153,  -156,  -156,   236,  -156,   203,   -63,  -156,
+    -156,  -151,  -156,  -156,   196,  -156,   154,   180,  -156,  -156,
+    -156,  -156,  -156,  -156,  -156,  -156,    68,  -156,   165,   -25,
+    -156,  -156,    99,    79,  -156,  -156,    -3,   -87
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
+{
+       0,     2,     3,     4,    14,    28,    56,    86,    87,   133,
+     157,   158,    15,    16,   180,   181,    17,    38,    39,    30,
+      93,    64,    18,    19,    32,    33,   101,   102,   103,    20,
+      21,    22,    23,    43,   122,   123,   124,   148,   173,   125,
+     189,   207,   215,   218,   219,   239,   240,   116,   117,    88,
+     169,   192,   193,   210,    77,    78,    50,   159
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
+{
+      49,    54,   134,   182,   119,   183,   149,   184,    31,    34,
+      35,   178,    67,   179,    41,     1,    79,   -81,    51,    91,
+      11,    75,    76,    -4,     8,   120,     9,   106,    96,    10,
+     -81,    79,    29,    11,    31,   185,    12,    13,    53,    73,
+     -27,   121,    80,   150,    63,    97,    98,    44,    42,    45,
+      92,   -81,     6,   115,   113,   110,   118,     7,   126,    99,
+     139,   140,    34,    46,   -81,   100,   186,    29,    51,    66,
+     182,    47,   183,    48,   184,   164,   182,   182,   183,   183,
+     184,   184,    44,    27,    45,    52,    84,   144,    53,    79,
+      29,    24,   195,   196,   249,    84,   236,   145,    46,    63,
+     164,    44,   154,    45,   146,    44,    47,    45,    48,   237,
+      44,   107,    45,   197,   242,   190,    81,    46,    85,    63,
+     118,    46,   171,   250,   191,    47,    46,    48,   108,    47,
+     229,    48,   130,     8,    47,     9,    48,    29,    10,   -81,
+      40,   241,    11,    55,   131,    12,    13,     8,    65,     9,
+      25,    96,    10,   -81,    26,    69,    11,    25,    70,    12,
+      13,   199,   141,   205,    71,     8,    72,     9,    97,    98,
+      10,   -81,   130,   -81,    11,    74,   165,    12,    13,    82,
+     178,   216,   179,   187,   131,    83,   -81,   -81,   100,    11,
+     178,   156,   179,    79,   166,   230,   -81,    96,   178,    11,
+     179,   235,   234,   236,   -81,   -81,    89,    11,    90,   233,
+      95,   130,   130,   104,    97,    98,   237,    36,    37,   244,
+     -81,   254,   105,   131,   131,   225,    63,   245,   132,   109,
+     -81,   238,   130,   111,   100,   231,   232,   112,   -81,    57,
+      58,    59,    60,   114,   131,   128,   129,   162,   163,   228,
+     203,   204,    61,    62,   127,   135,   136,   138,   143,    63,
+     147,   152,   161,   151,   174,   160,   167,   177,   188,   172,
+     194,   202,   168,   198,   206,   208,   209,   211,   212,   213,
+     214,   217,   222,   220,   226,   223,   190,   224,   246,   227,
+     247,   255,   248,   252,     5,   253,   155,   200,   176,   256,
+     201,    94,   137,    68,   142,   153,   175,   251,   221,   243,
+     170
+};
+
+static const yytype_uint8 yycheck[] =
+{
+      25,    26,    89,   158,     3,   158,     3,   158,    11,    12,
+      13,     1,    13,     3,     7,    31,    11,     7,     4,     3,
+      10,    46,    47,     0,     1,    24,     3,    71,     3,     6,
+       7,    11,     3,    10,    37,     4,    13,    14,    24,    42,
+      30,    40,    37,    40,    45,    20,    21,    18,    41,    20,
+      34,    41,     0,    24,    79,    35,    81,     0,    83,    34,
+     104,   105,    65,    34,    41,    40,    35,     3,     4,    15,
+     225,    42,   225,    44,   225,   138,   231,   232,   231,   232,
+     231,   232,    18,     3,    20,    21,     3,   112,    24,    11,
+       3,     0,     3,     4,     1,     3,     3,    36,    34,    45,
+     163,    18,   127,    20,    43,    18,    42,    20,    44,    16,
+      18,    17,    20,    24,    36,    34,    42,    34,    35,    45,
+     145,    34,   147,    30,    43,    42,    34,    44,    34,    42,
+     217,    44,    12,     1,    42,     3,    44,     3,     6,     7,
+      33,   228,    10,    34,    24,    13,    14,     1,    36,     3,
+      33,     3,     6,     7,    37,    33,    10,    33,    33,    13,
+      14,    37,    30,   188,    29,     1,     3,     3,    20,    21,
+       6,     7,    12,    41,    10,    34,    30,    13,    14,    34,
+       1,   206,     3,    35,    24,    32,     7,    41,    40,    10,
+       1,    31,     3,    11,    30,   220,     7,     3,     1,    10,
+       3,     1,   227,     3,     7,    41,    33,    10,     3,    30,
+       3,    12,    12,    29,    20,    21,    16,     8,     9,    30,
+      41,   246,    29,    24,    24,   213,    45,    30,    29,     3,
+      41,    31,    12,    43,    40,   223,   224,    36,    41,    25,
+      26,    27,    28,    24,    24,    35,    36,    35,    36,    29,
+      35,    36,    38,    39,    37,     4,    15,    36,    36,    45,
+      33,    36,     3,    35,     3,    36,    35,    30,    22,    37,
+      35,    33,    42,    30,    19,     3,    36,    33,    33,    29,
+       4,    33,    43,    36,    35,    29,    34,    29,    23,    36,
+       3,    34,    30,    30,     1,    35,   129,   181,   156,    35,
+     181,    65,    99,    37,   108,   125,   152,   239,   209,   230,
+     145
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
+{
+       0,    31,    47,    48,    49,    48,     0,     0,     1,     3,
+       6,    10,    13,    14,    50,    58,    59,    62,    68,    69,
+      75,    76,    77,    78,     0,    33,    37,     3,    51,     3,
+      65,   102,    70,    71,   102,   102,     8,     9,    63,    64,
+      33,     7,    41,    79,    18,    20,    34,    42,    44,    95,
+     102,     4,    21,    24,    95,    34,    52,    25,    26,    27,
+      28,    38,    39,    45,    67,    36,    15,    13,    65,    33,
+      33,    29,     3,   102,    34,    95,    95,   100,   101,    11,
+      37,    42,    34,    32,     3,    35,    53,    54,    95,    33,
+       3,     3,    34,    66,    71,     3,     3,    20,    21,    34,
+      40,    72,    73,    74,    29,    29,    49,    17,    34,     3,
+      35,    43,    36,    95,    24,    24,    93,    94,    95,     3,
+      24,    40,    80,    81,    82,    85,    95,    37,    35,    36,
+      12,    24,    29,    55,   103,     4,    15,    73,    36,    49,
+      49,    30,    80,    36,    95,    36,    43,    33,    83,     3,
+      40,    35,    36,    83,    95,    54,    31,    56,    57,   103,
+      36,     3,    35,    36,    74,    30,    30,    35,    42,    96,
+      94,    95,    37,    84,     3,    82,    56,    30,     1,     3,
+      60,    61,    62,    68,    77,     4,    35,    35,    22,    86,
+      34,    43,    97,    98,    35,     3,     4,    24,    30,    37,
+      63,    64,    33,    35,    36,    95,    19,    87,     3,    36,
+      99,    33,    33,    29,     4,    88,    95,    33,    89,    90,
+      36,    98,    43,    29,    29,    57,    35,    36,    29,   103,
+      95,    57,    57,    30,    95,     1,     3,    16,    31,    91,
+      92,   103,    36,    99,    30,    30,    23,     3,    30,     1,
+      30,    92,    30,    35,    95,    34,    35
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    46,    47,    47,    48,    49,    49,    49,    49,    49,
+      49,    49,    49,    49,    50,    51,    52,    52,    52,    53,
+      53,    54,    54,    55,    55,    55,    56,    56,    57,    57,
+      57,    57,    57,    58,    58,    59,    59,    60,    60,    61,
+      61,    62,    63,    64,    65,    65,    66,    66,    66,    67,
+      67,    67,    67,    67,    67,    68,    68,    68,    68,    68,
+      69,    69,    70,    70,    71,    71,    72,    72,    72,    73,
+      73,    74,    74,    74,    74,    74,    75,    76,    77,    77,
+      78,    78,    79,    80,    80,    81,    81,    82,    82,    82,
+      82,    83,    83,    84,    84,    84,    84,    85,    85,    86,
+      86,    87,    87,    88,    88,    89,    89,    90,    90,    90,
+      90,    91,    91,    91,    91,    92,    92,    92,    93,    93,
+      94,    94,    95,    95,    95,    95,    95,    95,    95,    95,
+      96,    96,    97,    97,    98,    99,    99,   100,   100,   101,
+     101,   102,   102,   103,   103
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     2,     3,     1,     2,     2,     2,     2,     2,
+       2,     2,     2,     0,     5,     1,     3,     2,     0,     3,
+       1,     1,     3,     1,     3,     4,     1,     1,     2,     2,
+       2,     2,     0,     6,     1,     5,     6,     6,     1,     5,
+       6,     2,     2,     1,     3,     3,     4,     5,     7,     1,
+       1,     1,     1,     1,     1,     3,     3,     5,     3,     5,
+       2,     4,     3,     1,     1,     3,     1,     3,     4,     3,
+       1,     1,     1,     1,     1,     3,     3,     6,     9,     4,
+       2,     0,     2,     1,     0,     3,     1,     3,     1,     2,
+       1,     2,     0,     2,     2,     2,     0,     2,     3,     2,
+       0,     2,     0,     3,     1,     4,     1,     2,     4,     4,
+       0,     2,     1,     2,     1,     3,     2,     4,     3,     1,
+       1,     1,     1,     4,     3,     6,     3,     3,     1,     1,
+       4,     2,     3,     1,     6,     1,     0,     1,     0,     3,
+       1,     1,     3,     1,     1
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (&yylloc, lexer, ctx, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
+   If N is 0, then set CURRENT to the empty location which ends
+   the previous symbol: RHS[0] (always defined).  */
+
+#ifndef YYLLOC_DEFAULT
+# define YYLLOC_DEFAULT(Current, Rhs, N)                                \
+    do                                                                  \
+      if (N)                                                            \
+        {                                                               \
+          (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;        \
+          (Current).first_column = YYRHSLOC (Rhs, 1).first_column;      \
+          (Current).last_line    = YYRHSLOC (Rhs, N).last_line;         \
+          (Current).last_column  = YYRHSLOC (Rhs, N).last_column;       \
+        }                                                               \
+      else                                                              \
+        {                                                               \
+          (Current).first_line   = (Current).last_line   =              \
+            YYRHSLOC (Rhs, 0).last_line;                                \
+          (Current).first_column = (Current).last_column =              \
+            YYRHSLOC (Rhs, 0).last_column;                              \
+        }                                                               \
+    while (0)
+#endif
+
+#define YYRHSLOC(Rhs, K) ((Rhs)[K])
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+/* YYLOCATION_PRINT -- Print the location on the stream.
+   This macro was not mandated originally: define only if we know
+   we won't break user code: when these are the locations we know.  */
+
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+
+/* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
+
+YY_ATTRIBUTE_UNUSED
+static int
+yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
+{
+  int res = 0;
+  int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
+  if (0 <= yylocp->first_line)
+    {
+      res += YYFPRINTF (yyo, "%d", yylocp->first_line);
+      if (0 <= yylocp->first_column)
+        res += YYFPRINTF (yyo, ".%d", yylocp->first_column);
+    }
+  if (0 <= yylocp->last_line)
+    {
+      if (yylocp->first_line < yylocp->last_line)
+        {
+          res += YYFPRINTF (yyo, "-%d", yylocp->last_line);
+          if (0 <= end_col)
+            res += YYFPRINTF (yyo, ".%d", end_col);
+        }
+      else if (0 <= end_col && yylocp->first_column < end_col)
+        res += YYFPRINTF (yyo, "-%d", end_col);
+    }
+  return res;
+}
+
+#   define YYLOCATION_PRINT  yy_location_print_
+
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, Location, lexer, ctx); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, pytype::Lexer* lexer, pytype::Context* ctx)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (lexer);
+  YY_USE (ctx);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, pytype::Lexer* lexer, pytype::Context* ctx)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, lexer, ctx);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, pytype::Lexer* lexer, pytype::Context* ctx)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), lexer, ctx);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule, lexer, ctx); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
+/* Return the length of YYSTR.  */
+static YYPTRDIFF_T
+yystrlen (const char *yystr)
+{
+  YYPTRDIFF_T yylen;
+  for (yylen = 0; yystr[yylen]; yylen++)
+    continue;
+  return yylen;
+}
+# endif
+#endif
+
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
+/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
+   YYDEST.  */
+static char *
+yystpcpy (char *yydest, const char *yysrc)
+{
+  char *yyd = yydest;
+  const char *yys = yysrc;
+
+  while ((*yyd++ = *yys++) != '\0')
+    continue;
+
+  return yyd - 1;
+}
+# endif
+#endif
+
+#ifndef yytnamerr
+/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
+   quotes and backslashes, so that it's suitable for yyerror.  The
+   heuristic is that double-quoting is unnecessary unless the string
+   contains an apostrophe, a comma, or backslash (other than
+   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
+   null, do not copy; instead, return the length of what the result
+   would have been.  */
+static YYPTRDIFF_T
+yytnamerr (char *yyres, const char *yystr)
+{
+  if (*yystr == '"')
+    {
+      YYPTRDIFF_T yyn = 0;
+      char const *yyp = yystr;
+      for (;;)
+        switch (*++yyp)
+          {
+          case '\'':
+          case ',':
+            goto do_not_strip_quotes;
+
+          case '\\':
+            if (*++yyp != '\\')
+              goto do_not_strip_quotes;
+            else
+              goto append;
+
+          append:
+          default:
+            if (yyres)
+              yyres[yyn] = *yyp;
+            yyn++;
+            break;
+
+          case '"':
+            if (yyres)
+              yyres[yyn] = '\0';
+            return yyn;
+          }
+    do_not_strip_quotes: ;
+    }
+
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
+    return yystrlen (yystr);
+}
+#endif
+
+
+static int
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  /* There are many possibilities here to consider:
+     - If this state is a consistent state with a default action, then
+       the only way this function was invoked is if the default action
+       is an error action.  In that case, don't check for expected
+       tokens because there are none.
+     - The only way there can be no lookahead present (in yychar) is if
+       this state is a consistent state with a default action.  Thus,
+       detecting the absence of a lookahead is sufficient to determine
+       that there is no unexpected or expected token to report.  In that
+       case, just report a simple "syntax error".
+     - Don't assume there isn't a lookahead just because this state is a
+       consistent state with a default action.  There might have been a
+       previous inconsistent state, consistent state with a non-default
+       action, or user semantic action that manipulated yychar.
+     - Of course, the expected token list depends on states to have
+       correct lookahead information, and it depends on the parser not
+       to perform extra reductions after fetching a lookahead from the
+       scanner and before detecting a syntax error.  Thus, state merging
+       (from LALR or IELR) and default reductions corrupt the expected
+       token list.  However, the list is correct for canonical LR with
+       one exception: it will still contain any token that will not be
+       accepted due to an error action in a later state.
+  */
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
+    {
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
+    }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
+
+  switch (yycount)
+    {
+#define YYCASE_(N, S)                       \
+      case N:                               \
+        yyformat = S;                       \
+        break
+    default: /* Avoid compiler warnings. */
+      YYCASE_(0, YY_("syntax error"));
+      YYCASE_(1, YY_("syntax error, unexpected %s"));
+      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
+      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
+      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
+      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
+#undef YYCASE_
+    }
+
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
+  {
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
+  }
+
+  if (*yymsg_alloc < yysize)
+    {
+      *yymsg_alloc = 2 * yysize;
+      if (! (yysize <= *yymsg_alloc
+             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
+        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
+      return -1;
+    }
+
+  /* Avoid sprintf, as that infringes on the user's name space.
+     Don't have undefined behavior even if the translation
+     produced a string with the wrong number of "%s"s.  */
+  {
+    char *yyp = *yymsg;
+    int yyi = 0;
+    while ((*yyp = *yyformat) != '\0')
+      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
+        {
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
+          yyformat += 2;
+        }
+      else
+        {
+          ++yyp;
+          ++yyformat;
+        }
+  }
+  return 0;
+}
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, pytype::Lexer* lexer, pytype::Context* ctx)
+{
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (lexer);
+  YY_USE (ctx);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  switch (yykind)
+    {
+    case YYSYMBOL_NUMBER: /* NUMBER  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1517 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_LEXERROR: /* LEXERROR  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1523 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_start: /* start  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1529 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_unit: /* unit  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1535 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_alldefs: /* alldefs  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1541 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_classdef: /* classdef  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1547 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_class_name: /* class_name  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1553 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_parents: /* parents  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1559 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_parent_list: /* parent_list  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1565 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_parent: /* parent  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1571 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_maybe_class_funcs: /* maybe_class_funcs  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1577 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_class_funcs: /* class_funcs  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1583 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_funcdefs: /* funcdefs  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1589 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_if_stmt: /* if_stmt  */
+#line 161 "pyi/parser.y"
+            { ctx->DropCondition(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1595 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_if_and_elifs: /* if_and_elifs  */
+#line 160 "pyi/parser.y"
+            { ctx->DropCondition(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1601 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_class_if_stmt: /* class_if_stmt  */
+#line 163 "pyi/parser.y"
+            { ctx->DropCondition(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1607 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_class_if_and_elifs: /* class_if_and_elifs  */
+#line 162 "pyi/parser.y"
+            { ctx->DropCondition(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1613 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_if_cond: /* if_cond  */
+#line 160 "pyi/parser.y"
+            { ctx->DropCondition(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1619 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_elif_cond: /* elif_cond  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1625 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_else_cond: /* else_cond  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1631 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_condition: /* condition  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1637 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_version_tuple: /* version_tuple  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1643 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_constantdef: /* constantdef  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1649 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_importdef: /* importdef  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1655 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_import_items: /* import_items  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1661 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_import_item: /* import_item  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1667 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_from_list: /* from_list  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1673 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_from_items: /* from_items  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1679 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_from_item: /* from_item  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1685 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_alias_or_constant: /* alias_or_constant  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1691 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_typevardef: /* typevardef  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1697 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_funcdef: /* funcdef  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1703 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_decorators: /* decorators  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1709 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_decorator: /* decorator  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1715 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_params: /* params  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1721 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_param_list: /* param_list  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1727 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_param: /* param  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1733 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_param_type: /* param_type  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1739 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_param_default: /* param_default  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1745 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_param_star_name: /* param_star_name  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1751 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_return: /* return  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1757 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_raises: /* raises  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1763 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_exceptions: /* exceptions  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1769 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_maybe_body: /* maybe_body  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1775 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_body: /* body  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1781 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_body_stmt: /* body_stmt  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1787 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_type_parameters: /* type_parameters  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1793 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_type_parameter: /* type_parameter  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1799 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_type: /* type  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1805 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_named_tuple_fields: /* named_tuple_fields  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1811 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_named_tuple_field_list: /* named_tuple_field_list  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1817 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_named_tuple_field: /* named_tuple_field  */
+#line 154 "pyi/parser.y"
+            { ctx->Drop(((*yyvaluep).obj)); ((*yyvaluep).obj) = NULL; }
+#line 1823 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_maybe_type_list: /* maybe_type_list  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1829 "pyi/recovering_parser.tab.cc"
+        break;
+
+    case YYSYMBOL_type_list: /* type_list  */
+#line 155 "pyi/parser.y"
+            { ctx->DropList(((*yyvaluep).list)); ((*yyvaluep).list) = NULL; }
+#line 1835 "pyi/recovering_parser.tab.cc"
+        break;
+
+      default:
+        break;
+    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (pytype::Lexer* lexer, pytype::Context* ctx)
+{
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+/* Location data for the lookahead symbol.  */
+static YYLTYPE yyloc_default
+# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+YYLTYPE yylloc = yyloc_default;
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+    /* The location stack: array, bottom, top.  */
+    YYLTYPE yylsa[YYINITDEPTH];
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+  YYLTYPE yyloc;
+
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
+  /* Buffer for error messages, and its allocated size.  */
+  char yymsgbuf[128];
+  char *yymsg = yymsgbuf;
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  yylsp[0] = yylloc;
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+        YYLTYPE *yyls1 = yyls;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+        yyls = yyls1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        YYSTACK_RELOCATE (yyls_alloc, yyls);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+      yylsp = yyls + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, &yylloc, lexer, ctx);
+    }
+
+  if (yychar <= END)
+    {
+      yychar = END;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+  *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+  /* Default location. */
+  YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 2: /* start: unit "end of file"  */
+#line 204 "pyi/parser.y"
+             { ctx->SetResult((yyvsp[-1].obj)); (yyval.obj) = NULL; }
+#line 2141 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 3: /* start: TRIPLEQUOTED unit "end of file"  */
+#line 205 "pyi/parser.y"
+                          { ctx->SetResult((yyvsp[-1].obj)); (yyval.obj) = NULL; }
+#line 2147 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 4: /* unit: alldefs  */
+#line 209 "pyi/parser.y"
+            { (yyval.obj) = ctx->Sequence((yyvsp[0].list)); }
+#line 2153 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 5: /* alldefs: alldefs constantdef  */
+#line 213 "pyi/parser.y"
+                        { (yyval.list) = ctx->AppendList((yyvsp[-1].list), (yyvsp[0].obj)); }
+#line 2159 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 6: /* alldefs: alldefs funcdef  */
+#line 214 "pyi/parser.y"
+                    { (yyval.list) = ctx->AppendList((yyvsp[-1].list), (yyvsp[0].obj)); }
+#line 2165 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 7: /* alldefs: alldefs importdef  */
+#line 215 "pyi/parser.y"
+                      { (yyval.list) = (yyvsp[-1].list); ctx->Drop((yyvsp[0].obj)); }
+#line 2171 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 8: /* alldefs: alldefs alias_or_constant  */
+#line 216 "pyi/parser.y"
+                              { (yyval.list) = (yyvsp[-1].list); ctx->Drop((yyvsp[0].obj)); }
+#line 2177 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 9: /* alldefs: alldefs classdef  */
+#line 217 "pyi/parser.y"
+                     { (yyval.list) = (yyvsp[-1].list); ctx->Drop((yyvsp[0].obj)); }
+#line 2183 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 10: /* alldefs: alldefs typevardef  */
+#line 218 "pyi/parser.y"
+                       { (yyval.list) = (yyvsp[-1].list); ctx->Drop((yyvsp[0].obj)); }
+#line 2189 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 11: /* alldefs: alldefs if_stmt  */
+#line 219 "pyi/parser.y"
+                    {
+      Handle tmp = ctx->IfEnd(ctx->Sequence((yyvsp[0].list)));
+      CHECK(tmp, (yylsp[0]));
+      (yyval.list) = ctx->ExtendList((yyvsp[-1].list), tmp);
+    }
+#line 2199 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 12: /* alldefs: alldefs error  */
+#line 224 "pyi/parser.y"
+                  { RECOVER((yyvsp[-1].list)); (yyval.list) = (yyvsp[-1].list); }
+#line 2205 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 13: /* alldefs: %empty  */
+#line 225 "pyi/parser.y"
+    { (yyval.list) = ctx->List(); }
+#line 2211 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 14: /* classdef: CLASS class_name parents ':' maybe_class_funcs  */
+#line 229 "pyi/parser.y"
+                                                   {
+      (yyval.obj) = ctx->AddClass((yyvsp[-3].obj), ctx->Sequence((yyvsp[-2].list)), ctx->Sequence((yyvsp[0].list)));
+      CHECK((yyval.obj), (yyloc));
+    }
+#line 2220 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 15: /* class_name: NAME  */
+#line 236 "pyi/parser.y"
+         {
+      // Do not give away $$ since it is also the value of the rule.
+      (yyval.obj) = ctx->Name((yyvsp[0].name), lexer);
+      Handle tmp = ctx->RegisterClassName(ctx->Dup((yyval.obj)));
+      CHECK(tmp, (yyloc));
+      ctx->Drop(tmp);
+    }
+#line 2232 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 16: /* parents: '(' parent_list ')'  */
+#line 246 "pyi/parser.y"
+                        { (yyval.list) = (yyvsp[-1].list); }
+#line 2238 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 17: /* parents: '(' ')'  */
+#line 247 "pyi/parser.y"
+            { (yyval.list) = ctx->List(); }
+#line 2244 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 18: /* parents: %empty  */
+#line 248 "pyi/parser.y"
+                 { (yyval.list) = ctx->List(); }
+#line 2250 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 19: /* parent_list: parent_list ',' parent  */
+#line 252 "pyi/parser.y"
+                           { (yyval.list) = ctx->AppendList((yyvsp[-2].list), (yyvsp[0].obj)); }
+#line 2256 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 20: /* parent_list: parent  */
+#line 253 "pyi/parser.y"
+           { (yyval.list) = ctx->StartList((yyvsp[0].obj)); }
+#line 2262 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 21: /* parent: type  */
+#line 257 "pyi/parser.y"
+         { (yyval.obj) = (yyvsp[0].obj); }
+#line 2268 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 22: /* parent: NAME '=' type  */
+#line 258 "pyi/parser.y"
+                  { (yyval.obj) = ctx->Tuple(ctx->Name((yyvsp[-2].name), lexer), (yyvsp[0].obj)); }
+#line 2274 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 23: /* maybe_class_funcs: pass_or_ellipsis  */
+#line 262 "pyi/parser.y"
+                     { (yyval.list) = ctx->List(); }
+#line 2280 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 24: /* maybe_class_funcs: INDENT class_funcs DEDENT  */
+#line 263 "pyi/parser.y"
+                              { (yyval.list) = (yyvsp[-1].list); }
+#line 2286 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 25: /* maybe_class_funcs: INDENT TRIPLEQUOTED class_funcs DEDENT  */
+#line 264 "pyi/parser.y"
+                                           { (yyval.list) = (yyvsp[-1].list); }
+#line 2292 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 26: /* class_funcs: pass_or_ellipsis  */
+#line 268 "pyi/parser.y"
+                     { (yyval.list) = ctx->List(); }
+#line 2298 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 28: /* funcdefs: funcdefs constantdef  */
+#line 273 "pyi/parser.y"
+                         { (yyval.list) = ctx->AppendList((yyvsp[-1].list), (yyvsp[0].obj)); }
+#line 2304 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 29: /* funcdefs: funcdefs funcdef  */
+#line 274 "pyi/parser.y"
+                     { (yyval.list) = ctx->AppendList((yyvsp[-1].list), (yyvsp[0].obj)); }
+#line 2310 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 30: /* funcdefs: funcdefs class_if_stmt  */
+#line 275 "pyi/parser.y"
+                           {
+      Handle tmp = ctx->IfEnd(ctx->Sequence((yyvsp[0].list)));
+      CHECK(tmp, (yylsp[0]));
+      (yyval.list) = ctx->ExtendList((yyvsp[-1].list), tmp);
+    }
+#line 2320 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 31: /* funcdefs: funcdefs error  */
+#line 280 "pyi/parser.y"
+                   { RECOVER((yyvsp[-1].list)); (yyval.list) = (yyvsp[-1].list); }
+#line 2326 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 32: /* funcdefs: %empty  */
+#line 281 "pyi/parser.y"
+                { (yyval.list) = ctx->List(); }
+#line 2332 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 33: /* if_stmt: if_and_elifs else_cond ':' INDENT alldefs DEDENT  */
+#line 286 "pyi/parser.y"
+                                                     {
+      (yyval.list) = ctx->AppendList((yyvsp[-5].list), ctx->Tuple((yyvsp[-4].obj), ctx->Sequence((yyvsp[-1].list))));
+    }
+#line 2340 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 35: /* if_and_elifs: if_cond ':' INDENT alldefs DEDENT  */
+#line 294 "pyi/parser.y"
+                                      {
+      (yyval.list) = ctx->StartList(ctx->Tuple((yyvsp[-4].obj), ctx->Sequence((yyvsp[-1].list))));
+    }
+#line 2348 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 36: /* if_and_elifs: if_and_elifs elif_cond ':' INDENT alldefs DEDENT  */
+#line 298 "pyi/parser.y"
+                                                     {
+      (yyval.list) = ctx->AppendList((yyvsp[-5].list), ctx->Tuple((yyvsp[-4].obj), ctx->Sequence((yyvsp[-1].list))));
+    }
+#line 2356 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 37: /* class_if_stmt: class_if_and_elifs else_cond ':' INDENT funcdefs DEDENT  */
+#line 317 "pyi/parser.y"
+                                                            {
+      (yyval.list) = ctx->AppendList((yyvsp[-5].list), ctx->Tuple((yyvsp[-4].obj), ctx->Sequence((yyvsp[-1].list))));
+    }
+#line 2364 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 39: /* class_if_and_elifs: if_cond ':' INDENT funcdefs DEDENT  */
+#line 325 "pyi/parser.y"
+                                       {
+      (yyval.list) = ctx->StartList(ctx->Tuple((yyvsp[-4].obj), ctx->Sequence((yyvsp[-1].list))));
+    }
+#line 2372 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 40: /* class_if_and_elifs: class_if_and_elifs elif_cond ':' INDENT funcdefs DEDENT  */
+#line 329 "pyi/parser.y"
+                                                            {
+      (yyval.list) = ctx->AppendList((yyvsp[-5].list), ctx->Tuple((yyvsp[-4].obj), ctx->Sequence((yyvsp[-1].list))));
+    }
+#line 2380 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 41: /* if_cond: IF condition  */
+#line 341 "pyi/parser.y"
+                 { (yyval.obj) = ctx->IfBegin((yyvsp[0].obj)); CHECK((yyval.obj), (yyloc)); }
+#line 2386 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 42: /* elif_cond: ELIF condition  */
+#line 345 "pyi/parser.y"
+                   { (yyval.obj) = ctx->IfElif((yyvsp[0].obj)); CHECK((yyval.obj), (yyloc)); }
+#line 2392 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 43: /* else_cond: ELSE  */
+#line 349 "pyi/parser.y"
+         { (yyval.obj) = ctx->IfElse(); CHECK((yyval.obj), (yyloc)); }
+#line 2398 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 44: /* condition: dotted_name condition_op NAME  */
+#line 353 "pyi/parser.y"
+                                  {
+      (yyval.obj) = ctx->Tuple(ctx->Name((yyvsp[-2].name), lexer), ctx->String((yyvsp[-1].str)),
+                      ctx->Name((yyvsp[0].name), lexer));
+    }
+#line 2407 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 45: /* condition: dotted_name condition_op version_tuple  */
+#line 357 "pyi/parser.y"
+                                           {
+      (yyval.obj) = ctx->Tuple(ctx->Name((yyvsp[-2].name), lexer), ctx->String((yyvsp[-1].str)), (yyvsp[0].obj));
+    }
+#line 2415 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 46: /* version_tuple: '(' NUMBER ',' ')'  */
+#line 364 "pyi/parser.y"
+                       { (yyval.obj) = ctx->Tuple((yyvsp[-2].obj)); }
+#line 2421 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 47: /* version_tuple: '(' NUMBER ',' NUMBER ')'  */
+#line 365 "pyi/parser.y"
+                              { (yyval.obj) = ctx->Tuple((yyvsp[-3].obj), (yyvsp[-1].obj)); }
+#line 2427 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 48: /* version_tuple: '(' NUMBER ',' NUMBER ',' NUMBER ')'  */
+#line 366 "pyi/parser.y"
+                                         {
+      (yyval.obj) = ctx->Tuple((yyvsp[-5].obj), (yyvsp[-3].obj), (yyvsp[-1].obj));
+    }
+#line 2435 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 49: /* condition_op: '<'  */
+#line 372 "pyi/parser.y"
+        { (yyval.str) = "<"; }
+#line 2441 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 50: /* condition_op: '>'  */
+#line 373 "pyi/parser.y"
+        { (yyval.str) = ">"; }
+#line 2447 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 51: /* condition_op: LE  */
+#line 374 "pyi/parser.y"
+        { (yyval.str) = "<="; }
+#line 2453 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 52: /* condition_op: GE  */
+#line 375 "pyi/parser.y"
+        { (yyval.str) = ">="; }
+#line 2459 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 53: /* condition_op: EQ  */
+#line 376 "pyi/parser.y"
+        { (yyval.str) = "=="; }
+#line 2465 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 54: /* condition_op: NE  */
+#line 377 "pyi/parser.y"
+        { (yyval.str) = "!="; }
+#line 2471 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 55: /* constantdef: NAME '=' NUMBER  */
+#line 381 "pyi/parser.y"
+                    {
+      (yyval.obj) = ctx->NewConstant(ctx->Name((yyvsp[-2].name), lexer), (yyvsp[0].obj));
+      CHECK((yyval.obj), (yyloc));
+    }
+#line 2480 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 56: /* constantdef: NAME '=' ELLIPSIS  */
+#line 385 "pyi/parser.y"
+                      {
+      (yyval.obj) = ctx->NewConstant(ctx->Name((yyvsp[-2].name), lexer), ctx->Value(kAnything));
+      CHECK((yyval.obj), (yyloc));
+    }
+#line 2489 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 57: /* constantdef: NAME '=' ELLIPSIS TYPECOMMENT type  */
+#line 389 "pyi/parser.y"
+                                       {
+      (yyval.obj) = ctx->NewConstant(ctx->Name((yyvsp[-4].name), lexer), (yyvsp[0].obj));
+      CHECK((yyval.obj), (yyloc));
+    }
+#line 2498 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 58: /* constantdef: NAME ':' type  */
+#line 393 "pyi/parser.y"
+                  {
+      (yyval.obj) = ctx->NewConstant(ctx->Name((yyvsp[-2].name), lexer), (yyvsp[0].obj));
+      CHECK((yyval.obj), (yyloc));
+    }
+#line 2507 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 59: /* constantdef: NAME ':' type '=' ELLIPSIS  */
+#line 397 "pyi/parser.y"
+                               {
+      (yyval.obj) = ctx->NewConstant(ctx->Name((yyvsp[-4].name), lexer), (yyvsp[-2].obj));
+      CHECK((yyval.obj), (yyloc));
+    }
+#line 2516 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 60: /* importdef: IMPORT import_items  */
+#line 404 "pyi/parser.y"
+                        {
+      (yyval.obj) = ctx->AddImport(ctx->None(), ctx->Sequence((yyvsp[0].list)));
+      CHECK((yyval.obj), (yyloc));
+    }
+#line 2525 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 61: /* importdef: FROM dotted_name IMPORT from_list  */
+#line 408 "pyi/parser.y"
+                                      {
+      (yyval.obj) = ctx->AddImport(ctx->Name((yyvsp[-2].name), lexer), ctx->Sequence((yyvsp[0].list)));
+      CHECK((yyval.obj), (yyloc));
+    }
+#line 2534 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 62: /* import_items: import_items ',' import_item  */
+#line 415 "pyi/parser.y"
+                                 { (yyval.list) = ctx->AppendList((yyvsp[-2].list), (yyvsp[0].obj)); }
+#line 2540 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 63: /* import_items: import_item  */
+#line 416 "pyi/parser.y"
+                { (yyval.list) = ctx->StartList((yyvsp[0].obj)); }
+#line 2546 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 64: /* import_item: dotted_name  */
+#line 419 "pyi/parser.y"
+                { (yyval.obj) = ctx->Name((yyvsp[0].name), lexer); }
+#line 2552 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 65: /* import_item: dotted_name AS NAME  */
+#line 420 "pyi/parser.y"
+                        {
+      (yyval.obj) = ctx->Tuple(ctx->Name((yyvsp[-2].name), lexer), ctx->Name((yyvsp[0].name), lexer));
+    }
+#line 2560 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 67: /* from_list: '(' from_items ')'  */
+#line 427 "pyi/parser.y"
+                       { (yyval.list) = (yyvsp[-1].list); }
+#line 2566 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 68: /* from_list: '(' from_items ',' ')'  */
+#line 428 "pyi/parser.y"
+                           { (yyval.list) = (yyvsp[-2].list); }
+#line 2572 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 69: /* from_items: from_items ',' from_item  */
+#line 432 "pyi/parser.y"
+                             { (yyval.list) = ctx->AppendList((yyvsp[-2].list), (yyvsp[0].obj)); }
+#line 2578 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 70: /* from_items: from_item  */
+#line 433 "pyi/parser.y"
+              { (yyval.list) = ctx->StartList((yyvsp[0].obj)); }
+#line 2584 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 71: /* from_item: NAME  */
+#line 437 "pyi/parser.y"
+         { (yyval.obj) = ctx->Name((yyvsp[0].name), lexer); }
+#line 2590 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 72: /* from_item: NAMEDTUPLE  */
+#line 438 "pyi/parser.y"
+               { (yyval.obj) = ctx->String("NamedTuple"); }
+#line 2596 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 73: /* from_item: TYPEVAR  */
+#line 439 "pyi/parser.y"
+            { (yyval.obj) = ctx->String("TypeVar"); }
+#line 2602 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 74: /* from_item: '*'  */
+#line 440 "pyi/parser.y"
+        { (yyval.obj) = ctx->String("*"); }
+#line 2608 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 75: /* from_item: NAME AS NAME  */
+#line 441 "pyi/parser.y"
+                 {
+      (yyval.obj) = ctx->Tuple(ctx->Name((yyvsp[-2].name), lexer), ctx->Name((yyvsp[0].name), lexer));
+    }
+#line 2616 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 76: /* alias_or_constant: NAME '=' type  */
+#line 447 "pyi/parser.y"
+                  {
+      (yyval.obj) = ctx->AddAliasOrConstant(ctx->Name((yyvsp[-2].name), lexer), (yyvsp[0].obj));
+      CHECK((yyval.obj), (yyloc));
+    }
+#line 2625 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 77: /* typevardef: NAME '=' TYPEVAR '(' params ')'  */
+#line 454 "pyi/parser.y"
+                                    {
+      (yyval.obj) = ctx->AddTypeVar(ctx->Name((yyvsp[-5].name), lexer), ctx->Sequence((yyvsp[-1].list)));
+      CHECK((yyval.obj), (yyloc));
+    }
+#line 2634 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 78: /* funcdef: decorators DEF NAME '(' params ')' return raises maybe_body  */
+#line 461 "pyi/parser.y"
+                                                                {
+      (yyval.obj) = ctx->NewFunction(ctx->Sequence((yyvsp[-8].list)), ctx->Name((yyvsp[-6].name), lexer),
+                            ctx->Sequence((yyvsp[-4].list)), (yyvsp[-2].obj), ctx->Sequence((yyvsp[-1].list)),
+                            ctx->Sequence((yyvsp[0].list)));
+      // Decorators is nullable and messes up the location tracking by
+      // using the previous symbol as the start location for this production,
+      // which is very misleading.  It is better to ignore decorators and
+      // pretend the production started with DEF.  Even when decorators are
+      // present the error line will be close enough to be helpful.
+      //
+      // TODO(dbaum): Consider making this smarter and only ignoring decorators
+      // when they are empty.  Making decorators non-nullable and having two
+      // productions for funcdef would be a reasonable solution.
+      (yyloc).first_line = (yylsp[-7]).first_line;
+      (yyloc).first_column = (yylsp[-7]).first_column;
+      CHECK((yyval.obj), (yyloc));
+    }
+#line 2656 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 79: /* funcdef: decorators DEF NAME PYTHONCODE  */
+#line 478 "pyi/parser.y"
+                                   {
+      // TODO(dbaum): Is PYTHONCODE necessary?
+      (yyval.obj) = ctx->NewExternalFunction(ctx->Sequence((yyvsp[-3].list)), ctx->Name((yyvsp[-1].name), lexer));
+      // See comment above about why @2 is used as the start.
+      (yyloc).first_line = (yylsp[-2]).first_line;
+      (yyloc).first_column = (yylsp[-2]).first_column;
+      CHECK((yyval.obj), (yyloc));
+    }
+#line 2669 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 80: /* decorators: decorators decorator  */
+#line 489 "pyi/parser.y"
+                         { (yyval.list) = ctx->AppendList((yyvsp[-1].list), (yyvsp[0].obj)); }
+#line 2675 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 81: /* decorators: %empty  */
+#line 490 "pyi/parser.y"
+                { (yyval.list) = ctx->List(); }
+#line 2681 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 82: /* decorator: '@' dotted_name  */
+#line 494 "pyi/parser.y"
+                    { (yyval.obj) = ctx->Name((yyvsp[0].name), lexer); }
+#line 2687 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 83: /* params: param_list  */
+#line 499 "pyi/parser.y"
+               { (yyval.list) = (yyvsp[0].list); }
+#line 2693 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 84: /* params: %empty  */
+#line 500 "pyi/parser.y"
+                { (yyval.list) = ctx->List(); }
+#line 2699 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 85: /* param_list: param_list ',' param  */
+#line 504 "pyi/parser.y"
+                         { (yyval.list) = ctx->AppendList((yyvsp[-2].list), (yyvsp[0].obj)); }
+#line 2705 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 86: /* param_list: param  */
+#line 505 "pyi/parser.y"
+          { (yyval.list) = ctx->StartList((yyvsp[0].obj)); }
+#line 2711 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 87: /* param: NAME param_type param_default  */
+#line 509 "pyi/parser.y"
+                                  {
+      (yyval.obj) = ctx->Tuple(ctx->Name((yyvsp[-2].name), lexer), (yyvsp[-1].obj), (yyvsp[0].obj));
+    }
+#line 2719 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 88: /* param: '*'  */
+#line 512 "pyi/parser.y"
+        { (yyval.obj) = ctx->Tuple(ctx->String("*"), ctx->None(), ctx->None()); }
+#line 2725 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 89: /* param: param_star_name param_type  */
+#line 513 "pyi/parser.y"
+                               { (yyval.obj) = ctx->Tuple((yyvsp[-1].obj), (yyvsp[0].obj), ctx->None()); }
+#line 2731 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 90: /* param: ELLIPSIS  */
+#line 514 "pyi/parser.y"
+             { (yyval.obj) = ctx->Value(kEllipsis); }
+#line 2737 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 91: /* param_type: ':' type  */
+#line 518 "pyi/parser.y"
+             { (yyval.obj) = (yyvsp[0].obj); }
+#line 2743 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 92: /* param_type: %empty  */
+#line 519 "pyi/parser.y"
+                { (yyval.obj) = ctx->None(); }
+#line 2749 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 93: /* param_default: '=' NAME  */
+#line 523 "pyi/parser.y"
+             { (yyval.obj) = ctx->Name((yyvsp[0].name), lexer); }
+#line 2755 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 94: /* param_default: '=' NUMBER  */
+#line 524 "pyi/parser.y"
+               { (yyval.obj) = (yyvsp[0].obj); }
+#line 2761 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 95: /* param_default: '=' ELLIPSIS  */
+#line 525 "pyi/parser.y"
+                 { (yyval.obj) = ctx->Value(kEllipsis); }
+#line 2767 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 96: /* param_default: %empty  */
+#line 526 "pyi/parser.y"
+    { (yyval.obj) = ctx->None(); }
+#line 2773 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 97: /* param_star_name: '*' NAME  */
+#line 530 "pyi/parser.y"
+             { (yyval.obj) = ctx->Name(ctx->Prefix("*", (yyvsp[0].name)), lexer); }
+#line 2779 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 98: /* param_star_name: '*' '*' NAME  */
+#line 531 "pyi/parser.y"
+                 { (yyval.obj) = ctx->Name(ctx->Prefix("**", (yyvsp[0].name)), lexer); }
+#line 2785 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 99: /* return: ARROW type  */
+#line 535 "pyi/parser.y"
+               { (yyval.obj) = (yyvsp[0].obj); }
+#line 2791 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 100: /* return: %empty  */
+#line 536 "pyi/parser.y"
+                { (yyval.obj) = ctx->Value(kAnything); }
+#line 2797 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 101: /* raises: RAISES exceptions  */
+#line 540 "pyi/parser.y"
+                      { (yyval.list) = (yyvsp[0].list); }
+#line 2803 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 102: /* raises: %empty  */
+#line 541 "pyi/parser.y"
+                { (yyval.list) = ctx->List(); }
+#line 2809 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 103: /* exceptions: exceptions ',' type  */
+#line 545 "pyi/parser.y"
+                        { (yyval.list) = ctx->AppendList((yyvsp[-2].list), (yyvsp[0].obj)); }
+#line 2815 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 104: /* exceptions: type  */
+#line 546 "pyi/parser.y"
+         { (yyval.list) = ctx->StartList((yyvsp[0].obj)); }
+#line 2821 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 105: /* maybe_body: ':' INDENT body DEDENT  */
+#line 550 "pyi/parser.y"
+                           { (yyval.list) = (yyvsp[-1].list); }
+#line 2827 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 106: /* maybe_body: empty_body  */
+#line 551 "pyi/parser.y"
+               { (yyval.list) = ctx->List(); }
+#line 2833 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 111: /* body: body body_stmt  */
+#line 562 "pyi/parser.y"
+                   { (yyval.list) = ctx->AppendList((yyvsp[-1].list), (yyvsp[0].obj)); }
+#line 2839 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 112: /* body: body_stmt  */
+#line 563 "pyi/parser.y"
+              { (yyval.list) = ctx->StartList((yyvsp[0].obj)); }
+#line 2845 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 113: /* body: body error  */
+#line 564 "pyi/parser.y"
+               { RECOVER((yyvsp[-1].list)); (yyval.list) = (yyvsp[-1].list); }
+#line 2851 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 114: /* body: error  */
+#line 565 "pyi/parser.y"
+          { RECOVER(NULL); (yyval.list) = ctx->List(); }
+#line 2857 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 115: /* body_stmt: NAME COLONEQUALS type  */
+#line 569 "pyi/parser.y"
+                          { (yyval.obj) = ctx->Tuple(ctx->Name((yyvsp[-2].name), lexer), (yyvsp[0].obj)); }
+#line 2863 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 116: /* body_stmt: RAISE NAME  */
+#line 570 "pyi/parser.y"
+               { (yyval.obj) = ctx->None(); }
+#line 2869 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 117: /* body_stmt: RAISE NAME '(' ')'  */
+#line 571 "pyi/parser.y"
+                       { (yyval.obj) = ctx->None(); }
+#line 2875 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 118: /* type_parameters: type_parameters ',' type_parameter  */
+#line 575 "pyi/parser.y"
+                                       { (yyval.list) = ctx->AppendList((yyvsp[-2].list), (yyvsp[0].obj)); }
+#line 2881 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 119: /* type_parameters: type_parameter  */
+#line 576 "pyi/parser.y"
+                   { (yyval.list) = ctx->StartList((yyvsp[0].obj)); }
+#line 2887 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 120: /* type_parameter: type  */
+#line 580 "pyi/parser.y"
+         { (yyval.obj) = (yyvsp[0].obj); }
+#line 2893 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 121: /* type_parameter: ELLIPSIS  */
+#line 581 "pyi/parser.y"
+             { (yyval.obj) = ctx->Value(kEllipsis); }
+#line 2899 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 122: /* type: dotted_name  */
+#line 585 "pyi/parser.y"
+                {
+      (yyval.obj) = ctx->NewType(ctx->Name((yyvsp[0].name), lexer), NULL);
+      CHECK((yyval.obj), (yyloc));
+    }
+#line 2908 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 123: /* type: dotted_name '[' type_parameters ']'  */
+#line 589 "pyi/parser.y"
+                                        {
+      (yyval.obj) = ctx->NewType(ctx->Name((yyvsp[-3].name), lexer), ctx->Sequence((yyvsp[-1].list)));
+      CHECK((yyval.obj), (yyloc));
+    }
+#line 2917 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 124: /* type: '[' maybe_type_list ']'  */
+#line 593 "pyi/parser.y"
+                            {
+      // TODO(dbaum): Is this rule necessary?  Seems like it may be old cruft.
+      //
+      // TODO(dbaum): This assumes kNewType will make this a GenericType and
+      // not try to convert it to HomogeneousContainerType (like it does with
+      // typing.Tuple).  This feels inconsistent and should be revisited once
+      // the parser is complete.
+      (yyval.obj) = ctx->NewType(ctx->String("tuple"), ctx->Sequence((yyvsp[-1].list)));
+      CHECK((yyval.obj), (yyloc));
+    }
+#line 2932 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 125: /* type: NAMEDTUPLE '(' NAME ',' named_tuple_fields ')'  */
+#line 603 "pyi/parser.y"
+                                                   {
+      (yyval.obj) = ctx->NewNamedTuple(ctx->Name((yyvsp[-3].name), lexer), ctx->Sequence((yyvsp[-1].list)));
+      CHECK((yyval.obj), (yyloc));
+    }
+#line 2941 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 126: /* type: '(' type ')'  */
+#line 607 "pyi/parser.y"
+                 { (yyval.obj) = (yyvsp[-1].obj); }
+#line 2947 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 127: /* type: type OR type  */
+#line 608 "pyi/parser.y"
+                 { (yyval.obj) = ctx->NewUnionType((yyvsp[-2].obj), (yyvsp[0].obj)); }
+#line 2953 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 128: /* type: '?'  */
+#line 609 "pyi/parser.y"
+        { (yyval.obj) = ctx->Value(kAnything); }
+#line 2959 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 129: /* type: NOTHING  */
+#line 610 "pyi/parser.y"
+            { (yyval.obj) = ctx->Value(kNothing); }
+#line 2965 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 130: /* named_tuple_fields: '[' named_tuple_field_list maybe_comma ']'  */
+#line 614 "pyi/parser.y"
+                                               { (yyval.list) = (yyvsp[-2].list); }
+#line 2971 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 131: /* named_tuple_fields: '[' ']'  */
+#line 615 "pyi/parser.y"
+            { (yyval.list) = ctx->List(); }
+#line 2977 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 132: /* named_tuple_field_list: named_tuple_field_list ',' named_tuple_field  */
+#line 619 "pyi/parser.y"
+                                                 {
+      (yyval.list) = ctx->AppendList((yyvsp[-2].list), (yyvsp[0].obj));
+    }
+#line 2985 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 133: /* named_tuple_field_list: named_tuple_field  */
+#line 622 "pyi/parser.y"
+                      { (yyval.list) = ctx->StartList((yyvsp[0].obj)); }
+#line 2991 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 134: /* named_tuple_field: '(' NAME ',' type maybe_comma ')'  */
+#line 626 "pyi/parser.y"
+                                       {
+      (yyval.obj) = ctx->Tuple(ctx->Name((yyvsp[-4].name), lexer), (yyvsp[-2].obj));
+    }
+#line 2999 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 137: /* maybe_type_list: type_list  */
+#line 637 "pyi/parser.y"
+              { (yyval.list) = (yyvsp[0].list); }
+#line 3005 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 138: /* maybe_type_list: %empty  */
+#line 638 "pyi/parser.y"
+                { (yyval.list) = ctx->List(); }
+#line 3011 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 139: /* type_list: type_list ',' type  */
+#line 642 "pyi/parser.y"
+                       { (yyval.list) = ctx->AppendList((yyvsp[-2].list), (yyvsp[0].obj)); }
+#line 3017 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 140: /* type_list: type  */
+#line 643 "pyi/parser.y"
+         { (yyval.list) = ctx->StartList((yyvsp[0].obj)); }
+#line 3023 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 141: /* dotted_name: NAME  */
+#line 648 "pyi/parser.y"
+         { (yyval.name) = (yyvsp[0].name); }
+#line 3029 "pyi/recovering_parser.tab.cc"
+    break;
+
+  case 142: /* dotted_name: dotted_name '.' NAME  */
+#line 649 "pyi/parser.y"
+                         { (yyval.name) = ctx->JoinDotted((yyvsp[-2].name), (yyvsp[0].name)); }
+#line 3035 "pyi/recovering_parser.tab.cc"
+    break;
+
+
+#line 3039 "pyi/recovering_parser.tab.cc"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+  *++yylsp = yyloc;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      {
+        yypcontext_t yyctx
+          = {yyssp, yytoken, &yylloc};
+        char const *yymsgp = YY_("syntax error");
+        int yysyntax_error_status;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+        if (yysyntax_error_status == 0)
+          yymsgp = yymsg;
+        else if (yysyntax_error_status == -1)
+          {
+            if (yymsg != yymsgbuf)
+              YYSTACK_FREE (yymsg);
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
+              {
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
+              }
+            else
+              {
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
+              }
+          }
+        yyerror (&yylloc, lexer, ctx, yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
+      }
+    }
+
+  yyerror_range[1] = yylloc;
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= END)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == END)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, &yylloc, lexer, ctx);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+      yyerror_range[1] = *yylsp;
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, lexer, ctx);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  yyerror_range[2] = yylloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (&yylloc, lexer, ctx, YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, &yylloc, lexer, ctx);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, lexer, ctx);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+  if (yymsg != yymsgbuf)
+    YYSTACK_FREE (yymsg);
+  return yyresult;
+}
+
+#line 657 "pyi/parser.y"
+
+
+namespace {
+
+int yyerror(
+    YYLTYPE* llocp, Lexer* lexer, pytype::Context* ctx, const char *p) {
+  ctx->SyntaxError(llocp, lexer, p);
+  return 0;
+}
+
+}  // end namespace
+}  // end namespace pytype
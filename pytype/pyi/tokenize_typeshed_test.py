@@ -0,0 +1,71 @@
+"""Check that the handwritten and flex lexers produce identical tokens."""
+
+import os
+import random
+import re
+
+from pytype.pyi import parser_ext
+from pytype.pytd import typeshed
+
+import unittest
+
+
+def _walk_dir(path):
+  for root, _, filenames in os.walk(path):
+    for f in filenames:
+      yield os.path.join(root, f)
+
+
+def _filename_to_testname(base, path, f):
+  f = os.path.splitext(os.path.relpath(f, path))[0]
+  return "test_%s_%s" % (base, re.sub(r"\W", "_", f))
+
+
+def _read(filename):
+  with open(filename, "rb") as f:
+    return f.read()
+
+
+class TestTokenizeTypeshed(unittest.TestCase):
+  """Compare the two lexers on typeshed and the pytd builtins."""
+
+  TYPESHED_DIR = typeshed.Typeshed().typeshed_path
+  PYTD_DIR = os.path.join(
+      os.path.dirname(os.path.dirname(os.path.abspath(__file__))), "pytd")
+
+  def check(self, text):
+    self.assertEquals(parser_ext.tokenize(text, handwritten=False),
+                      parser_ext.tokenize(text, handwritten=True))
+
+  # Generate test methods
+  # pylint: disable=no-self-argument,g-wrong-blank-lines,undefined-loop-variable
+  for base, path, wanted in [
+      ("typeshed", TYPESHED_DIR, r"\.pyi$"),
+      ("pytd", PYTD_DIR, r"/(builtins|stdlib)/.*\.pytd$")]:
+    for f in _walk_dir(path):
+      if re.search(wanted, f):
+        def _bind(f):
+          return lambda self: self.check(_read(f))
+        locals()[_filename_to_testname(base, path, f)] = _bind(f)
+        del _bind
+  del base, path, wanted, f
+
+  def test_mutations(self):
+    # Splice unusual fragments into the builtins, to exercise the corners of
+    # the lexer (and the errors) that well formed stubs do not reach.
+    fragments = ["\n", "  ", "\t", "\x00", "\xe9", "#", "# type:", "'''",
+                 '"""', "''", "`", "`~x`", "-", "->", "+.", "...", "1.", ".5",
+                 "!", "!=", ":=", "(", ")", "[", "]", "class", "classy", "$"]
+    src = _read(os.path.join(self.PYTD_DIR, "builtins", "__builtin__.pytd"))
+    rand = random.Random(0)
+    for _ in range(1000):
+      start = rand.randrange(len(src))
+      chars = list(src[start:start + rand.randrange(300)])
+      for _ in range(rand.randrange(5)):
+        if chars:
+          chars[rand.randrange(len(chars))] = rand.choice(fragments)
+      self.check("".join(chars))
+
+
+if __name__ == "__main__":
+  unittest.main()
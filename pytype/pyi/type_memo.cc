@@ -0,0 +1,106 @@
+#include "type_memo.h"
+
+namespace pytype {
+
+namespace {
+
+// The kinds of keys.
+enum KeyKind { kPlainType, kParameterizedType, kUnionType };
+
+// Whether a type or parameter is one that can be part of a key.  Plain
+// tuples and lists are built anew for each expression.
+bool Memoizable(PyObject* object) {
+  return !PyTuple_CheckExact(object) && !PyList_CheckExact(object);
+}
+
+}  // end namespace
+
+size_t TypeMemo::KeyHash::operator()(const Key& key) const {
+  size_t hash = key.kind;
+  for (PyObject* object : key.objects) {
+    // Objects are aligned, so the low bits of their addresses are zeros.
+    hash = hash * 1000003 ^ (reinterpret_cast<size_t>(object) >> 4);
+  }
+  return hash;
+}
+
+bool TypeMemo::Init(PyObject* info) {
+  int enabled = PyObject_IsTrue(info);
+  if (enabled < 0) {
+    return false;
+  }
+  enabled_ = enabled;
+  return true;
+}
+
+void TypeMemo::Reset() {
+  enabled_ = false;
+  Clear();
+}
+
+void TypeMemo::Clear() {
+  // Move the entries out first, since releasing them can run arbitrary
+  // code.
+  Map map;
+  map.swap(map_);
+  key_valid_ = false;
+  for (auto& entry : map) {
+    for (PyObject* object : entry.first.objects) {
+      Py_DECREF(object);
+    }
+    Py_DECREF(entry.second);
+  }
+}
+
+PyObject* TypeMemo::Lookup(int kind, int count, PyObject** args,
+                           PyObject* sequence) {
+  key_valid_ = false;
+  if (!enabled_) {
+    return NULL;
+  }
+  key_.kind = kind;
+  key_.objects.assign(args, args + count);
+  if (sequence != NULL) {
+    if (!PyTuple_CheckExact(sequence)) {
+      return NULL;
+    }
+    for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(sequence); i++) {
+      key_.objects.push_back(PyTuple_GET_ITEM(sequence, i));
+    }
+  }
+  for (PyObject* object : key_.objects) {
+    if (!Memoizable(object)) {
+      return NULL;
+    }
+  }
+  auto it = map_.find(key_);
+  if (it != map_.end()) {
+    return it->second;
+  }
+  key_valid_ = true;
+  return NULL;
+}
+
+PyObject* TypeMemo::LookupType(PyObject* name, PyObject* parameters) {
+  return Lookup(parameters ? kParameterizedType : kPlainType, 1, &name,
+                parameters);
+}
+
+PyObject* TypeMemo::LookupUnion(PyObject* left, PyObject* right) {
+  PyObject* args[] = {left, right};
+  return Lookup(kUnionType, 2, args, NULL);
+}
+
+void TypeMemo::Add(PyObject* type) {
+  if (!key_valid_) {
+    return;
+  }
+  key_valid_ = false;
+  for (PyObject* object : key_.objects) {
+    Py_INCREF(object);
+  }
+  Py_INCREF(type);
+  map_.emplace(key_, type);
+}
+
+}  // end namespace pytype
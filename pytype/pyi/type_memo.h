@@ -0,0 +1,100 @@
+#ifndef PYTYPE_PYI_TYPE_MEMO_H_
+#define PYTYPE_PYI_TYPE_MEMO_H_
+
+#include <Python.h>
+
+#include <stddef.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace pytype {
+
+// Remembers the types built for type expressions, so that an expression
+// that occurs again (e.g. "int" or "List[str]", which occur hundreds of
+// times in a large pyi file) is given the node built for it the first time
+// instead of calling the peer or building a new node.  Nodes are immutable,
+// so sharing them is safe, and it makes later equality checks cheaper.
+//
+// A type is keyed on the identities of the arguments it was built from:
+// the name (the lexer interns names) and parameters of a new_type() call,
+// or the two types of a new_union_type() call.  Since parameters are types
+// that are memoized too, structurally equal expressions have equal keys.
+// Arguments that are plain tuples or lists (e.g. the argument list of a
+// Callable), which are built anew for every expression, aren't memoized.
+// The memo holds references to the keys and types, thus the identities
+// stay valid until it is cleared.
+//
+// The types depend on the peer's type map, which add_import(),
+// add_alias_or_constant() and register_class_name() change, so the caller
+// must clear the memo after calling those.
+class TypeMemo {
+ public:
+  TypeMemo() : enabled_(false), key_valid_(false) {}
+  ~TypeMemo() { Clear(); }
+
+  // Initialize from the value returned by the peer's memoize_types()
+  // method: a true value enables the memo.  Returns false if there was an
+  // error.
+  bool Init(PyObject* info);
+
+  // Disable the memo and clear it, so that it can be initialized again.
+  void Reset();
+
+  // Whether Init() enabled the memo.  A disabled memo finds nothing.
+  bool enabled() const { return enabled_; }
+
+  // Forget the memoized types.
+  void Clear();
+
+  // Return a borrowed reference to the type memoized for a new_type() call
+  // (parameters is a tuple, or NULL if there are none), or NULL if there is
+  // none, in which case the type may be added by Add().
+  PyObject* LookupType(PyObject* name, PyObject* parameters);
+
+  // As LookupType(), for a union of two types.
+  PyObject* LookupUnion(PyObject* left, PyObject* right);
+
+  // Memoize a type for the arguments of the last lookup, if it missed and
+  // the arguments can be memoized.  The arguments must still be alive.
+  void Add(PyObject* type);
+
+ private:
+  // The kind of expression (a plain, parameterized or union type) and the
+  // identities of its arguments.
+  struct Key {
+    int kind;
+    std::vector<PyObject*> objects;
+
+    bool operator==(const Key& other) const {
+      return kind == other.kind && objects == other.objects;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  // Types by key, holding references to the objects of the keys and to
+  // the types.
+  typedef std::unordered_map<Key, PyObject*, KeyHash> Map;
+
+  bool enabled_;
+  Map map_;
+  // The key of the last lookup, reused so that a hit does not allocate,
+  // and whether it can be added.
+  Key key_;
+  bool key_valid_;
+
+  // Look up key_, which has kind and objects from the first count items of
+  // args, followed by the items of sequence if it isn't NULL.
+  PyObject* Lookup(int kind, int count, PyObject** args, PyObject* sequence);
+
+  // Not copyable.
+  TypeMemo(const TypeMemo&);
+  TypeMemo& operator=(const TypeMemo&);
+};
+
+}  // end namespace pytype
+
+#endif  // PYTYPE_PYI_TYPE_MEMO_H_
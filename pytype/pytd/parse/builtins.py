@@ -110,6 +110,8 @@ def ParsePyTD(src=None, filename=None, python_version=None, module=None,
 
   This loads a pytd and also makes sure that all names are resolved (i.e.,
   that all primitive types in the AST are ClassType, and not NameType).
+  The parse goes through the parser's cache, if one is set (see
+  pytype.pyi.parser.set_parse_cache()).
 
   Args:
     src: PyTD source code.
@@ -123,10 +125,11 @@ def ParsePyTD(src=None, filename=None, python_version=None, module=None,
   """
   assert python_version
   if src is None:
-    with open(filename, "rb") as fi:
-      src = fi.read()
-  ast = parser.parse_string(src, filename=filename, name=module,
+    ast = parser.parse_file(filename, name=module,
                             python_version=python_version)
+  else:
+    ast = parser.parse_string(src, filename=filename, name=module,
+                              python_version=python_version)
   if lookup_classes:
     ast = visitors.LookupClasses(ast, GetBuiltinsPyTD())
   return ast
@@ -2,10 +2,14 @@
 
 # pylint: disable=bad-indentation
 
-from distutils.core import setup, Extension
+from distutils import ccompiler
+from distutils import sysconfig
+from distutils.core import setup, Command, Extension
 
 import glob
 import os
+import subprocess
+import sys
 
 
 def scan_package_data(path, pattern):
@@ -21,16 +25,98 @@ def scan_package_data(path, pattern):
 typeshed = scan_package_data('typeshed', '*.pyi')
 assert 'typeshed/stdlib/2/*.pyi' in typeshed
 
+# Set PYTYPE_HANDWRITTEN_LEXER=1 in the environment to build the extension
+# with the handwritten lexer as the default instead of the flex lexer.
+define_macros = []
+if os.environ.get('PYTYPE_HANDWRITTEN_LEXER'):
+    define_macros.append(('PYTYPE_HANDWRITTEN_LEXER', None))
+
 parser_ext = Extension(
     'pytype.pyi.parser_ext',
+    define_macros = define_macros,
     sources = [
         'pytype/pyi/parser_ext.cc',
+        'pytype/pyi/batch_parser.cc',
+        'pytype/pyi/conditions.cc',
+        'pytype/pyi/fastscan.cc',
+        'pytype/pyi/hand_lexer.cc',
+        'pytype/pyi/header_scan.cc',
+        'pytype/pyi/input_stream.cc',
+        'pytype/pyi/intern_table.cc',
+        'pytype/pyi/ir.cc',
         'pytype/pyi/lexer.lex.cc',
+        'pytype/pyi/mapped_file.cc',
+        'pytype/pyi/node_factory.cc',
         'pytype/pyi/parser.tab.cc',
+        'pytype/pyi/recovering_parser.tab.cc',
+        'pytype/pyi/type_memo.cc',
         ],
+    # parse_ir_many() and scan_headers() run std::threads.
+    extra_compile_args = ['-pthread'],
+    extra_link_args = ['-pthread'],
 )
 
 
+class Bench(Command):
+    """Build the extension in place and the parser_bench driver (which
+    embeds Python), then run pytype.pyi.parser_benchmark with both."""
+
+    description = 'run the parser benchmarks'
+    user_options = [
+        ('repeat=', None, 'the number of times to time each stage'),
+        ('typeshed=', None, 'a typeshed checkout, instead of pytype\'s'),
+        ('output=', None, 'a file to write the results to, as JSON'),
+        ('baseline=', None, 'results written by --output to compare with'),
+    ]
+
+    def initialize_options(self):
+        self.repeat = None
+        self.typeshed = None
+        self.output = None
+        self.baseline = None
+        self.build_temp = None
+
+    def finalize_options(self):
+        self.set_undefined_options('build', ('build_temp', 'build_temp'))
+
+    def run(self):
+        build_ext = self.reinitialize_command('build_ext')
+        build_ext.inplace = 1
+        self.run_command('build_ext')
+        driver = self.build_driver()
+        args = [sys.executable, '-m', 'pytype.pyi.parser_benchmark',
+                '--driver', driver]
+        for option in ('repeat', 'typeshed', 'output', 'baseline'):
+            value = getattr(self, option)
+            if value is not None:
+                args += ['--' + option, value]
+        status = subprocess.call(args)
+        if status:
+            sys.exit(status)
+
+    def build_driver(self):
+        compiler = ccompiler.new_compiler()
+        sysconfig.customize_compiler(compiler)
+        compiler.add_include_dir(sysconfig.get_python_inc())
+        sources = parser_ext.sources + ['pytype/pyi/parser_bench.cc']
+        objects = compiler.compile(
+            sources, output_dir=os.path.join(self.build_temp, 'bench'),
+            macros=define_macros, extra_postargs=['-pthread'])
+        # Link with libpython like python-config --ldflags does, the static
+        # library being in LIBPL.
+        libdir = sysconfig.get_config_var('LIBDIR')
+        extra_args = ['-pthread']
+        for var in ('LIBS', 'SYSLIBS', 'LINKFORSHARED'):
+            extra_args += (sysconfig.get_config_var(var) or '').split()
+        compiler.link_executable(
+            objects, 'parser_bench', output_dir=self.build_temp,
+            libraries=['python' + sysconfig.get_python_version()],
+            library_dirs=[libdir, sysconfig.get_config_var('LIBPL')],
+            runtime_library_dirs=[libdir], extra_postargs=extra_args,
+            target_lang='c++')
+        return os.path.join(self.build_temp, 'parser_bench')
+
+
 setup(
     name='pytype',
     version='0.2',
@@ -53,4 +139,5 @@ setup(
     install_requires=['ply>=3.4', 'pyyaml>=3.11'],
     classifier=["Programming Language :: Python :: 2.7"],
     ext_modules = [parser_ext],
+    cmdclass = {'bench': Bench},
 )